@@ -0,0 +1,253 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <bench/bench.hh>
+#include <eos/utils/log.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <vector>
+
+namespace bench
+{
+    // Use a small, local singleton in order to avoid the static initialization fiasco
+    struct BenchmarksHolder
+    {
+        std::list<Benchmark *> benchmarks;
+
+        static BenchmarksHolder * instance()
+        {
+            static BenchmarksHolder result;
+
+            return &result;
+        }
+    };
+
+    Benchmark::Benchmark(const std::string & name, const unsigned & iterations) :
+        _name(name),
+        _iterations(std::max(iterations, 1u))
+    {
+        BenchmarksHolder::instance()->benchmarks.push_back(this);
+    }
+
+    Benchmark::~Benchmark()
+    {
+    }
+
+    std::string
+    Benchmark::name() const
+    {
+        return _name;
+    }
+
+    unsigned
+    Benchmark::iterations() const
+    {
+        return _iterations;
+    }
+
+    void
+    Benchmark::setup()
+    {
+    }
+
+    namespace
+    {
+        struct Result
+        {
+            std::string name;
+
+            unsigned iterations, repetitions;
+
+            // time per iteration in seconds
+            double min, median, mean;
+
+            std::string error;
+        };
+
+        std::string escape(const std::string & s)
+        {
+            std::string result;
+            for (char c : s)
+            {
+                if (('"' == c) || ('\\' == c))
+                    result += '\\';
+
+                result += c;
+            }
+
+            return result;
+        }
+
+        void write_json(const std::string & file_name, const std::string & program_name, const std::vector<Result> & results)
+        {
+            std::ofstream file(file_name);
+            file << std::setprecision(9);
+
+            file << "{" << std::endl;
+            file << "  \"program\": \"" << escape(program_name) << "\"," << std::endl;
+            file << "  \"revision\": \"" << escape(EOS_GITHEAD) << "\"," << std::endl;
+            file << "  \"benchmarks\": [" << std::endl;
+            for (auto r = results.cbegin(), r_begin = results.cbegin(), r_end = results.cend() ; r != r_end ; ++r)
+            {
+                file << ((r == r_begin) ? "" : ",\n") << "    { \"name\": \"" << escape(r->name) << "\"";
+                if (r->error.empty())
+                {
+                    file << ", \"iterations\": " << r->iterations
+                         << ", \"repetitions\": " << r->repetitions
+                         << ", \"min\": " << r->min
+                         << ", \"median\": " << r->median
+                         << ", \"mean\": " << r->mean;
+                }
+                else
+                {
+                    file << ", \"error\": \"" << escape(r->error) << "\"";
+                }
+                file << " }";
+            }
+            file << std::endl << "  ]" << std::endl;
+            file << "}" << std::endl;
+        }
+
+        Result measure(Benchmark & b, const unsigned & repetitions)
+        {
+            using clock = std::chrono::steady_clock;
+
+            Result result{ b.name(), b.iterations(), repetitions, 0.0, 0.0, 0.0, "" };
+
+            b.setup();
+
+            // warm-up
+            b.run();
+
+            std::vector<double> timings;
+            for (unsigned r = 0 ; r < repetitions ; ++r)
+            {
+                auto start = clock::now();
+                for (unsigned i = 0 ; i < b.iterations() ; ++i)
+                {
+                    b.run();
+                }
+                auto stop = clock::now();
+
+                timings.push_back(std::chrono::duration<double>(stop - start).count() / b.iterations());
+            }
+
+            std::sort(timings.begin(), timings.end());
+            result.min    = timings.front();
+            result.median = (timings.size() % 2) ? timings[timings.size() / 2]
+                          : 0.5 * (timings[timings.size() / 2 - 1] + timings[timings.size() / 2]);
+            result.mean   = std::accumulate(timings.cbegin(), timings.cend(), 0.0) / timings.size();
+
+            return result;
+        }
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    using namespace bench;
+
+    // Extract the program name from argv[0]
+    std::string program_name(argv[0]);
+    std::string::size_type pos = program_name.rfind('/');
+    if (std::string::npos != pos)
+        program_name.erase(0, pos + 1);
+
+    eos::Log::instance()->set_program_name(program_name);
+    eos::Log::instance()->set_log_level(eos::ll_error);
+
+    std::string json_file, filter;
+    unsigned repetitions = 5;
+    bool list = false;
+
+    for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+    {
+        std::string argument(*a);
+
+        if (("--filter" == argument) && (a + 1 != a_end))
+        {
+            filter = std::string(*(++a));
+            continue;
+        }
+
+        if (("--json" == argument) && (a + 1 != a_end))
+        {
+            json_file = std::string(*(++a));
+            continue;
+        }
+
+        if ("--list" == argument)
+        {
+            list = true;
+            continue;
+        }
+
+        if (("--repetitions" == argument) && (a + 1 != a_end))
+        {
+            repetitions = std::max(1, std::atoi(*(++a)));
+            continue;
+        }
+
+        std::cerr << "Unknown command line argument: " << argument << std::endl;
+        std::cerr << "Usage: " << program_name << " [--filter SUBSTRING] [--json FILE] [--list] [--repetitions NUMBER]" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Result> results;
+    for (auto b : BenchmarksHolder::instance()->benchmarks)
+    {
+        if ((! filter.empty()) && (std::string::npos == b->name().find(filter)))
+            continue;
+
+        if (list)
+        {
+            std::cout << b->name() << std::endl;
+            continue;
+        }
+
+        try
+        {
+            Result r = measure(*b, repetitions);
+            std::cout << std::left << std::setw(60) << r.name << std::right
+                      << "  median " << std::scientific << std::setprecision(3) << r.median << " s"
+                      << "  min " << r.min << " s" << std::endl;
+
+            results.push_back(r);
+        }
+        catch (std::exception & e)
+        {
+            std::cout << std::left << std::setw(60) << b->name() << "  failed: " << e.what() << std::endl;
+
+            results.push_back(Result{ b->name(), b->iterations(), repetitions, 0.0, 0.0, 0.0, e.what() });
+        }
+    }
+
+    if (! json_file.empty())
+        write_json(json_file, program_name, results);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,67 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_BENCH_BENCH_HH
+#define EOS_GUARD_BENCH_BENCH_HH 1
+
+#include <config.h>
+
+#include <string>
+
+namespace bench
+{
+    /*!
+     * A single benchmark.
+     *
+     * Benchmarks register themselves upon construction, in the same way as
+     * test cases do. The harness calls setup() once, outside of the timed
+     * region, then runs one untimed warm-up iteration, and finally times
+     * several repetitions of iterations() calls to run().
+     */
+    class Benchmark
+    {
+        private:
+            std::string _name;
+
+            unsigned _iterations;
+
+        public:
+            Benchmark(const std::string & name, const unsigned & iterations);
+
+            virtual ~Benchmark();
+
+            std::string name() const;
+
+            unsigned iterations() const;
+
+            /// Prepare the benchmark. Not timed.
+            virtual void setup();
+
+            /// Run one iteration of the benchmark.
+            virtual void run() = 0;
+    };
+
+    /// Prevent the compiler from optimising away the computation of value.
+    template <typename T_> inline void keep(const T_ & value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+}
+
+#endif
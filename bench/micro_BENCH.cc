@@ -0,0 +1,223 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <bench/bench.hh>
+#include <eos/form-factors/mesonic.hh>
+#include <eos/rare-b-decays/charm-loops.hh>
+#include <eos/rare-b-decays/qcdf_integrals.hh>
+#include <eos/utils/integrate-impl.hh>
+#include <eos/utils/polylog.hh>
+#include <eos/utils/qcd.hh>
+#include <eos/utils/wilson_coefficients.hh>
+
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+
+using namespace bench;
+using namespace eos;
+
+/* Special functions */
+
+class DilogBenchmark :
+    public Benchmark
+{
+    public:
+        DilogBenchmark() :
+            Benchmark("polylog::dilog", 10000)
+        {
+        }
+
+        virtual void run()
+        {
+            keep(dilog(complex<double>(0.3, 0.7)));
+            keep(dilog(complex<double>(-2.5, 0.1)));
+        }
+} dilog_benchmark;
+
+class TrilogBenchmark :
+    public Benchmark
+{
+    public:
+        TrilogBenchmark() :
+            Benchmark("polylog::trilog", 10000)
+        {
+        }
+
+        virtual void run()
+        {
+            keep(trilog(complex<double>(0.3, 0.7)));
+            keep(trilog(complex<double>(-2.5, 0.1)));
+        }
+} trilog_benchmark;
+
+/* Numerical integration */
+
+class Integrate1DBenchmark :
+    public Benchmark
+{
+    private:
+        std::function<std::array<double, 12> (const double &)> _f;
+
+    public:
+        Integrate1DBenchmark() :
+            Benchmark("integrate::integrate1D<12>", 1000),
+            _f([] (const double & x)
+            {
+                std::array<double, 12> result;
+                for (unsigned i = 0 ; i < 12 ; ++i)
+                    result[i] = std::exp(-x * (i + 1)) * std::sin(x);
+
+                return result;
+            })
+        {
+        }
+
+        virtual void run()
+        {
+            keep(integrate1D(_f, 64, 1.0, 6.0));
+        }
+} integrate_1d_benchmark;
+
+/* Charm loops and QCDF integrals */
+
+class CharmLoopsHBenchmark :
+    public Benchmark
+{
+    public:
+        CharmLoopsHBenchmark() :
+            Benchmark("CharmLoops::h", 10000)
+        {
+        }
+
+        virtual void run()
+        {
+            keep(CharmLoops::h(4.2, 3.0, 1.4));
+            keep(CharmLoops::h(4.2, 3.0));
+        }
+} charm_loops_h_benchmark;
+
+class CharmLoopsF27MassiveBenchmark :
+    public Benchmark
+{
+    public:
+        CharmLoopsF27MassiveBenchmark() :
+            Benchmark("CharmLoops::F27_massive", 100)
+        {
+        }
+
+        virtual void run()
+        {
+            keep(CharmLoops::F27_massive(4.2, 3.0, 4.6, 1.4));
+        }
+} charm_loops_f27_massive_benchmark;
+
+class CharmLoopsF27MasslessBenchmark :
+    public Benchmark
+{
+    public:
+        CharmLoopsF27MasslessBenchmark() :
+            Benchmark("CharmLoops::F27_massless", 10000)
+        {
+        }
+
+        virtual void run()
+        {
+            keep(CharmLoops::F27_massless(4.2, 3.0, 4.6));
+        }
+} charm_loops_f27_massless_benchmark;
+
+class QCDFIntegralsBenchmark :
+    public Benchmark
+{
+    public:
+        QCDFIntegralsBenchmark() :
+            Benchmark("QCDFIntegrals::dilepton_charm_case", 1000)
+        {
+        }
+
+        virtual void run()
+        {
+            keep(QCDFIntegrals::dilepton_charm_case(3.0, 1.4, 5.279, 0.896, 4.2, 0.1, 0.1, 0.1, 0.1));
+        }
+} qcdf_integrals_benchmark;
+
+/* Form factors */
+
+class FormFactorsBenchmark :
+    public Benchmark
+{
+    private:
+        std::string _label;
+
+        std::shared_ptr<FormFactors<PToV>> _form_factors;
+
+    public:
+        FormFactorsBenchmark(const std::string & label, const unsigned & iterations) :
+            Benchmark("FormFactors<PToV>::v[" + label + "]", iterations),
+            _label(label)
+        {
+        }
+
+        virtual void setup()
+        {
+            _form_factors = FormFactorFactory<PToV>::create(_label, Parameters::Defaults());
+        }
+
+        virtual void run()
+        {
+            keep(_form_factors->v(3.0));
+            keep(_form_factors->a_1(3.0));
+        }
+};
+
+FormFactorsBenchmark form_factors_kmpw2010_benchmark("B->K^*@KMPW2010", 10000);
+FormFactorsBenchmark form_factors_bsz2015_benchmark("B->K^*@BSZ2015", 10000);
+FormFactorsBenchmark form_factors_kmo2006_benchmark("B->K^*@KMO2006", 1);
+
+/* Renormalization group evolution */
+
+class EvolveBenchmark :
+    public Benchmark
+{
+    private:
+        std::array<complex<double>, 15> _wc_0, _wc_1, _wc_2;
+
+    public:
+        EvolveBenchmark() :
+            Benchmark("wilson_coefficients::evolve", 1000)
+        {
+            _wc_0.fill(0.0);
+            _wc_1.fill(0.0);
+            _wc_2.fill(0.0);
+
+            // a charm-sector like initial condition
+            _wc_0[1]  = 1.0;
+            _wc_1[3]  = -7.0 / 9.0;
+            _wc_1[11] = -4.0 / 9.0;
+            _wc_2[2]  = -0.5;
+            _wc_2[3]  = 0.3;
+        }
+
+        virtual void run()
+        {
+            keep(evolve(_wc_0, _wc_1, _wc_2, 0.1176 * 0.98, 0.2161, 5.0, QCD::beta_function_nf_5));
+        }
+} evolve_benchmark;
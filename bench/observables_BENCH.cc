@@ -0,0 +1,100 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <bench/bench.hh>
+#include <eos/observable.hh>
+#include <eos/utils/kinematic.hh>
+#include <eos/utils/options.hh>
+
+#include <memory>
+#include <vector>
+
+using namespace bench;
+using namespace eos;
+
+namespace
+{
+    // all observables share the default parameters; loading them is expensive
+    Parameters & default_parameters()
+    {
+        static Parameters result = Parameters::Defaults();
+
+        return result;
+    }
+
+    // a superset of all kinematic variables used by the registered observables
+    Kinematics default_kinematics()
+    {
+        return Kinematics{
+            { "s",              4.0 }, { "s_min",   1.0 }, { "s_max",   6.0 },
+            { "q2",             4.0 }, { "q2_min",  1.0 }, { "q2_max",  6.0 },
+            { "k2",             1.0 }, { "k2_min",  0.5 }, { "k2_max",  1.5 },
+            { "z",              0.3 }, { "z_min",  -1.0 }, { "z_max",   1.0 },
+            { "cos(theta_l)",   0.3 }, { "cos(theta_k)", 0.4 }, { "cos(theta_pi)", 0.5 }, { "phi", 0.6 },
+            { "E_min",          1.8 }
+        };
+    }
+}
+
+/*
+ * Evaluation of a single registered observable at the default parameters.
+ *
+ * Observables that cannot be constructed with the default kinematics
+ * and options are reported as failed.
+ */
+class ObservableBenchmark :
+    public Benchmark
+{
+    private:
+        QualifiedName _name;
+
+        ObservablePtr _observable;
+
+    public:
+        ObservableBenchmark(const QualifiedName & name) :
+            Benchmark("observable::" + name.str(), 1),
+            _name(name)
+        {
+        }
+
+        virtual void setup()
+        {
+            _observable = Observable::make(_name, default_parameters(), default_kinematics(), Options());
+        }
+
+        virtual void run()
+        {
+            keep(_observable->evaluate());
+        }
+};
+
+// register one benchmark per known observable
+struct ObservableBenchmarks
+{
+    std::vector<std::unique_ptr<ObservableBenchmark>> benchmarks;
+
+    ObservableBenchmarks()
+    {
+        Observables observables;
+        for (auto o = observables.begin(), o_end = observables.end() ; o != o_end ; ++o)
+        {
+            benchmarks.push_back(std::unique_ptr<ObservableBenchmark>(new ObservableBenchmark(o->first)));
+        }
+    }
+} observable_benchmarks;
@@ -0,0 +1,214 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <bench/bench.hh>
+#include <eos/constraint.hh>
+#include <eos/statistics/analysis.hh>
+#include <eos/statistics/log-likelihood.hh>
+#include <eos/statistics/log-prior.hh>
+#include <eos/statistics/markov-chain.hh>
+#include <eos/statistics/markov-chain-sampler.hh>
+#include <eos/statistics/proposal-functions.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/observable_stub.hh>
+#include <eos/utils/options.hh>
+
+#ifdef EOS_ENABLE_PMC
+#  include <eos/statistics/population-monte-carlo-sampler.hh>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace bench;
+using namespace eos;
+
+namespace
+{
+    // the reference set of constraints, covering b->s ll, b->s gamma and b->u l nu
+    const std::vector<std::string> reference_constraints
+    {
+        "B^0->K^*0mu^+mu^-::BR[1.00,6.00]@Belle-2009",
+        "B^0->K^*0mu^+mu^-::F_L[1.00,6.00]@Belle-2009",
+        "B^0->K^*0mu^+mu^-::BR[14.18,16.00]@Belle-2009",
+        "B^+->K^+mu^+mu^-::BR[1.00,6.00]@Belle-2009",
+        "B->X_sgamma::BR[1.8]+E_1[1.8]+E_2[1.8]@Belle-2009B",
+        "B^0->pi^+lnu::BR@BaBar-2010B"
+    };
+
+    LogLikelihood make_reference_log_likelihood(const Parameters & parameters)
+    {
+        LogLikelihood result(parameters);
+
+        for (const auto & name : reference_constraints)
+        {
+            result.add(Constraint::make(name, Options{ { "model", "WilsonScan" } }));
+        }
+
+        return result;
+    }
+
+    // a two-dimensional analysis of the reference constraints in the Wilson coefficients C9 and C10
+    std::shared_ptr<Analysis> make_reference_analysis()
+    {
+        Parameters parameters = Parameters::Defaults();
+
+        std::shared_ptr<Analysis> result(new Analysis(make_reference_log_likelihood(parameters)));
+        result->add(LogPrior::Flat(parameters, "b->smumu::Re{c9}",  ParameterRange{ +2.0, +6.0 }));
+        result->add(LogPrior::Flat(parameters, "b->smumu::Re{c10}", ParameterRange{ -6.0, -2.0 }));
+
+        return result;
+    }
+
+    // a cheap, two-dimensional analysis that isolates the overhead of the samplers
+    std::shared_ptr<Analysis> make_gaussian_analysis()
+    {
+        Parameters parameters = Parameters::Defaults();
+
+        LogLikelihood llh(parameters);
+        llh.add(ObservablePtr(new ObservableStub(parameters, "mass::b(MSbar)")), 4.10, 4.20, 4.30);
+        llh.add(ObservablePtr(new ObservableStub(parameters, "mass::c")),        1.22, 1.27, 1.32);
+
+        std::shared_ptr<Analysis> result(new Analysis(llh));
+        result->add(LogPrior::Flat(parameters, "mass::b(MSbar)", ParameterRange{ 3.5, 5.0 }));
+        result->add(LogPrior::Flat(parameters, "mass::c",        ParameterRange{ 0.9, 1.6 }));
+
+        return result;
+    }
+}
+
+/* Likelihood */
+
+class LogLikelihoodBenchmark :
+    public Benchmark
+{
+    private:
+        std::shared_ptr<LogLikelihood> _llh;
+
+    public:
+        LogLikelihoodBenchmark() :
+            Benchmark("LogLikelihood::operator()[reference]", 1)
+        {
+        }
+
+        virtual void setup()
+        {
+            _llh.reset(new LogLikelihood(make_reference_log_likelihood(Parameters::Defaults())));
+        }
+
+        virtual void run()
+        {
+            keep((*_llh)());
+        }
+} log_likelihood_benchmark;
+
+/* Markov chains */
+
+class MarkovChainBenchmark :
+    public Benchmark
+{
+    private:
+        std::string _label;
+
+        unsigned _steps;
+
+        std::shared_ptr<Analysis> (*_make_analysis)();
+
+        std::shared_ptr<MarkovChain> _chain;
+
+    public:
+        MarkovChainBenchmark(const std::string & label, const unsigned & steps, std::shared_ptr<Analysis> (*make_analysis)()) :
+            Benchmark("MarkovChain::run[" + label + "," + std::to_string(steps) + " steps]", 1),
+            _label(label),
+            _steps(steps),
+            _make_analysis(make_analysis)
+        {
+        }
+
+        virtual void setup()
+        {
+            std::shared_ptr<MarkovChain::ProposalFunction> proposal(new proposal_functions::MultivariateGaussian(2, std::vector<double>{ 0.01, 0.0, 0.0, 0.01 }));
+            _chain.reset(new MarkovChain(_make_analysis()->clone(), 1729, proposal));
+        }
+
+        virtual void run()
+        {
+            _chain->run(_steps);
+        }
+};
+
+MarkovChainBenchmark markov_chain_gaussian_benchmark("gaussian", 10000, &make_gaussian_analysis);
+MarkovChainBenchmark markov_chain_reference_benchmark("reference", 20, &make_reference_analysis);
+
+/* Population Monte Carlo */
+
+#ifdef EOS_ENABLE_PMC
+class PopulationMonteCarloBenchmark :
+    public Benchmark
+{
+    private:
+        std::shared_ptr<Analysis> _analysis;
+
+        static const std::string prerun_file;
+
+    public:
+        PopulationMonteCarloBenchmark() :
+            Benchmark("PopulationMonteCarloSampler::run[gaussian,1 step]", 1)
+        {
+        }
+
+        virtual void setup()
+        {
+            _analysis = make_gaussian_analysis();
+
+            // the prerun provides the initial mixture components
+            MarkovChainSampler::Config config = MarkovChainSampler::Config::Default();
+            config.need_main_run = false;
+            config.number_of_chains = 4;
+            config.output_file = prerun_file;
+            config.parallelize = false;
+            config.prerun_iterations_update = 500;
+            config.prerun_iterations_min = 1000;
+            config.prerun_iterations_max = 1000;
+            config.seed = 1729;
+
+            MarkovChainSampler sampler(_analysis->clone(), config);
+            sampler.run();
+        }
+
+        virtual void run()
+        {
+            PopulationMonteCarloSampler::Config config = PopulationMonteCarloSampler::Config::Default();
+            config.max_updates = 1;
+            config.samples_per_component = 1000;
+            config.final_samples = 0;
+            config.output_file = EOS_BUILDDIR "/bench/statistics_BENCH-pmc.hdf5";
+            config.parallelize = false;
+            config.seed = 1729;
+            config.patch_length = 100;
+            config.target_ncomponents = 2;
+
+            PopulationMonteCarloSampler sampler(_analysis->clone(), hdf5::File::Open(prerun_file), config);
+            sampler.run();
+        }
+} population_monte_carlo_benchmark;
+
+const std::string PopulationMonteCarloBenchmark::prerun_file(EOS_BUILDDIR "/bench/statistics_BENCH-prerun.hdf5");
+#endif
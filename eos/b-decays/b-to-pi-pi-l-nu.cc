@@ -19,12 +19,19 @@
 
 #include <eos/form-factors/form-factors.hh>
 #include <eos/b-decays/b-to-pi-pi-l-nu.hh>
-#include <eos/utils/integrate.hh>
+#include <eos/utils/integrate-impl.hh>
 #include <eos/utils/kinematic.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/model.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 
+#include <array>
+#include <map>
+#include <vector>
+
+#include <gsl/gsl_integration.h>
 #include <gsl/gsl_monte.h>
 #include <gsl/gsl_monte_miser.h>
 
@@ -49,11 +56,23 @@ namespace eos
 
         UsedParameter hbar;
 
-        // GSL elements for MC integration
+        Parameters parameters;
+
+        // integration method for the integrated observables: "cubature" (default) or "miser"
+        bool use_miser;
+
+        // Gauss-Legendre nodes and weights on [-1, +1] for the integration over z
+        std::vector<double> z_nodes, z_weights;
+
+        // GSL elements for MC integration, only allocated for the "miser" method
         gsl_rng * rng;
-        gsl_monte_function normalized_decay_width_integrand;
         gsl_monte_miser_state * state;
 
+        // integrated decay widths for the current parameter point, keyed by the integration limits
+        mutable std::map<std::array<double, 6>, double> cache;
+        mutable unsigned long cache_version;
+        mutable Mutex mutex;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "SM"), p, o)),
             m_B(p["mass::B_" + o.get("q", "d")], u),
@@ -62,9 +81,24 @@ namespace eos
             m_l(p["mass::" + o.get("l", "mu")], u),
             g_fermi(p["G_Fermi"], u),
             hbar(p["hbar"], u),
-            rng(gsl_rng_alloc(gsl_rng_mt19937)),
-            state(gsl_monte_miser_alloc(3u))
+            parameters(p),
+            use_miser(false),
+            rng(nullptr),
+            state(nullptr),
+            cache_version(0)
         {
+            const std::string integration = o.get("integration", "cubature");
+            if (integration == "miser")
+            {
+                use_miser = true;
+                rng = gsl_rng_alloc(gsl_rng_mt19937);
+                state = gsl_monte_miser_alloc(3u);
+            }
+            else if (integration != "cubature")
+            {
+                throw InternalError("BToPiPiLeptonNeutrino: integration = '" + integration + "' is not a valid option for this decay channel");
+            }
+
             if (o.get("l", "mu") == "tau")
             {
                 throw InternalError("BToPiPiLeptonNeutrino: l == 'tau' is not a valid option for this decay channel");
@@ -83,12 +117,25 @@ namespace eos
 
             u.uses(*form_factors);
             u.uses(*model);
+
+            static const size_t z_points = 16;
+            gsl_integration_glfixed_table * table = gsl_integration_glfixed_table_alloc(z_points);
+            z_nodes.resize(z_points);
+            z_weights.resize(z_points);
+            for (size_t i = 0 ; i < z_points ; ++i)
+            {
+                gsl_integration_glfixed_point(-1.0, +1.0, i, &z_nodes[i], &z_weights[i], table);
+            }
+            gsl_integration_glfixed_table_free(table);
         }
 
         ~Implementation()
         {
-            gsl_monte_miser_free(state);
-            gsl_rng_free(rng);
+            if (state)
+                gsl_monte_miser_free(state);
+
+            if (rng)
+                gsl_rng_free(rng);
         }
 
         // normalized to V_ub = 1
@@ -144,7 +191,64 @@ namespace eos
             return imp->normalized_differential_decay_width(q2, k2, z);
         }
 
-        double normalized_integrated_decay_width(const double & q2min, const double & q2max,
+        // integral over z of the normalized differential decay width, using Gauss-Legendre quadrature
+        double normalized_double_differential_decay_width(const double & q2, const double & k2,
+                const double & zmin, const double & zmax) const
+        {
+            const double half_width = (zmax - zmin) / 2.0, center = (zmax + zmin) / 2.0;
+
+            double result = 0.0;
+            for (size_t i = 0 ; i < z_nodes.size() ; ++i)
+            {
+                result += z_weights[i] * normalized_differential_decay_width(q2, k2, center + half_width * z_nodes[i]);
+            }
+
+            return half_width * result;
+        }
+
+        /*
+         * Integrate over z for each of the given ranges, and over q2 and k2
+         * within the physical phase space with cubature. For each q2, k2 is
+         * mapped onto [k2min, min(k2max, (m_B - sqrt(q2))^2)] such that the
+         * integrand remains smooth at the phase-space boundary.
+         */
+        template <size_t n_>
+        std::array<double, n_> normalized_integrated_decay_widths_cubature(const double & q2min, const double & q2max,
+                const double & k2min, const double & k2max,
+                const std::array<std::array<double, 2>, n_> & z_ranges) const
+        {
+            const double m_B = this->m_B();
+
+            std::function<std::array<double, n_> (const std::array<double, 2> &)> integrand = [&] (const std::array<double, 2> & x)
+            {
+                std::array<double, n_> result;
+                result.fill(0.0);
+
+                const double q2 = x[0];
+                const double k2_upper = std::min(k2max, power_of<2>(m_B - std::sqrt(q2)));
+                if (k2_upper <= k2min)
+                    return result;
+
+                const double jacobian = k2_upper - k2min;
+                const double k2 = k2min + x[1] * jacobian;
+                if (lambda(q2, k2, m_B * m_B) <= 0.0)
+                    return result;
+
+                for (size_t i = 0 ; i < n_ ; ++i)
+                {
+                    result[i] = jacobian * normalized_double_differential_decay_width(q2, k2, z_ranges[i][0], z_ranges[i][1]);
+                }
+
+                return result;
+            };
+
+            const std::array<double, 2> x_min{ { q2min, 0.0 } };
+            const std::array<double, 2> x_max{ { q2max, 1.0 } };
+
+            return integrate(integrand, x_min, x_max, cubature::Config().epsrel(5.0e-4));
+        }
+
+        double normalized_integrated_decay_width_miser(const double & q2min, const double & q2max,
                 const double k2min, const double & k2max,
                 const double & zmin, const double & zmax) const
         {
@@ -163,24 +267,80 @@ namespace eos
             return result;
         }
 
-        double normalized_integrated_forward_backward_asymmetry(const double & q2min, const double & q2max,
-                const double k2min, const double & k2max) const
+        // drop all cached results if the parameters have changed; requires the mutex to be locked
+        void validate_cache() const
         {
-            // Yields a numerical error of approximately 0.2%.
-            static const size_t calls = 50000;
+            const unsigned long version = parameters.version();
+            if (version != cache_version)
+            {
+                cache.clear();
+                cache_version = version;
+            }
+        }
+
+        double normalized_integrated_decay_width(const double & q2min, const double & q2max,
+                const double k2min, const double & k2max,
+                const double & zmin, const double & zmax) const
+        {
+            Lock l(mutex);
 
-            const double x_forward_min[3]  = { q2min, k2min,  0.0 };
-            const double x_forward_max[3]  = { q2max, k2max, +1.0 };
-            const double x_backward_min[3] = { q2min, k2min, -1.0 };
-            const double x_backward_max[3] = { q2max, k2max,  0.0 };
+            validate_cache();
 
-            gsl_monte_function integrand{ &normalized_differential_decay_width_gsl_adapter, 3u, const_cast<void *>(reinterpret_cast<const void *>(this)) };
+            const std::array<double, 6> key{ { q2min, q2max, k2min, k2max, zmin, zmax } };
+            auto i = cache.find(key);
+            if (cache.end() != i)
+                return i->second;
+
+            double result;
+            if (use_miser)
+            {
+                result = normalized_integrated_decay_width_miser(q2min, q2max, k2min, k2max, zmin, zmax);
+            }
+            else
+            {
+                result = normalized_integrated_decay_widths_cubature<1>(q2min, q2max, k2min, k2max,
+                        std::array<std::array<double, 2>, 1>{ { { { zmin, zmax } } } })[0];
+            }
 
-            double forward,  forward_error;
-            double backward, backward_error;
+            cache[key] = result;
 
-            gsl_monte_miser_integrate(&integrand, x_forward_min, x_forward_max, 3u, calls, rng, state, &forward, &forward_error);
-            gsl_monte_miser_integrate(&integrand, x_backward_min, x_backward_max, 3u, calls, rng, state, &backward, &backward_error);
+            return result;
+        }
+
+        double normalized_integrated_forward_backward_asymmetry(const double & q2min, const double & q2max,
+                const double k2min, const double & k2max) const
+        {
+            double forward, backward;
+            {
+                Lock l(mutex);
+
+                validate_cache();
+
+                const std::array<double, 6> key_forward{ { q2min, q2max, k2min, k2max, 0.0, +1.0 } };
+                const std::array<double, 6> key_backward{ { q2min, q2max, k2min, k2max, -1.0, 0.0 } };
+                auto i_forward = cache.find(key_forward), i_backward = cache.find(key_backward);
+                if ((cache.end() != i_forward) && (cache.end() != i_backward))
+                {
+                    forward  = i_forward->second;
+                    backward = i_backward->second;
+                }
+                else if (use_miser)
+                {
+                    forward  = normalized_integrated_decay_width_miser(q2min, q2max, k2min, k2max,  0.0, +1.0);
+                    backward = normalized_integrated_decay_width_miser(q2min, q2max, k2min, k2max, -1.0,  0.0);
+                }
+                else
+                {
+                    // both hemispheres from a single sweep over q2 and k2
+                    std::array<double, 2> result = normalized_integrated_decay_widths_cubature<2>(q2min, q2max, k2min, k2max,
+                            std::array<std::array<double, 2>, 2>{ { { { 0.0, +1.0 } }, { { -1.0, 0.0 } } } });
+                    forward  = result[0];
+                    backward = result[1];
+                }
+
+                cache[key_forward]  = forward;
+                cache[key_backward] = backward;
+            }
 
             return (forward - backward) / (forward + backward);
         }
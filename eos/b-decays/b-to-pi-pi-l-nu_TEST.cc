@@ -65,6 +65,23 @@ class BToPiPiLeptonNeutrinoTest :
                 TEST_CHECK_RELATIVE_ERROR(d.integrated_branching_ratio(0.02, 1.95, 15.00, 26.40, -1.0, +1.0), 8.8931904e-12, eps);
                 TEST_CHECK_RELATIVE_ERROR(d.integrated_forward_backward_asymmetry(0.02, 0.95, 18.60, 26.40), -0.22715,       eps);
                 TEST_CHECK_RELATIVE_ERROR(d.integrated_forward_backward_asymmetry(0.02, 1.95, 15.00, 26.40), -0.10447,       eps);
+
+                // deterministic integration yields identical results upon reevaluation
+                const double br = d.integrated_branching_ratio(0.02, 0.95, 18.60, 26.40, -1.0, +1.0);
+                TEST_CHECK_EQUAL(br, d.integrated_branching_ratio(0.02, 0.95, 18.60, 26.40, -1.0, +1.0));
+
+                // cached results are discarded once the parameters change
+                p["B->pipi::mu@BFvD2016"] = +2.0;
+                TEST_CHECK(br != d.integrated_branching_ratio(0.02, 0.95, 18.60, 26.40, -1.0, +1.0));
+                p["B->pipi::mu@BFvD2016"] = +1.5;
+                TEST_CHECK_EQUAL(br, d.integrated_branching_ratio(0.02, 0.95, 18.60, 26.40, -1.0, +1.0));
+
+                // the previous Monte Carlo integration remains available
+                oo.set("integration", "miser");
+                BToPiPiLeptonNeutrino d_miser(p, oo);
+
+                TEST_CHECK_RELATIVE_ERROR(d_miser.integrated_branching_ratio(0.02, 0.95, 18.60, 26.40, -1.0, +1.0), 5.7200653e-13, eps);
+                TEST_CHECK_RELATIVE_ERROR(d_miser.integrated_forward_backward_asymmetry(0.02, 0.95, 18.60, 26.40), -0.22715,       eps);
             }
         }
 } b_to_pi_pi_l_nu_test;
@@ -19,15 +19,19 @@
 
 #include <eos/form-factors/analytic-b-to-kstar.hh>
 #include <eos/form-factors/b-lcdas.hh>
+#include <eos/utils/destringify.hh>
 #include <eos/utils/exception.hh>
 #include <eos/utils/integrate.hh>
+#include <eos/utils/integrate-impl.hh>
 #include <eos/utils/kinematic.hh>
 #include <eos/utils/model.hh>
 #include <eos/utils/polylog.hh>
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qcd.hh>
+#include <eos/utils/tabulation.hh>
 
+#include <array>
 #include <functional>
 
 #include <gsl/gsl_sf_expint.h>
@@ -59,6 +63,11 @@ namespace eos
 
         BMesonLCDAs b_lcdas;
 
+        // interpolations in q^2, used if the option 'tabulate' is set
+        std::shared_ptr<Tabulation> v_tabulated;
+        std::shared_ptr<Tabulation> a_0_tabulated, a_1_tabulated, a_2_tabulated;
+        std::shared_ptr<Tabulation> t_1_tabulated, t_2_tabulated, t_3_tabulated;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make("SM", p, o)),
             m_B(p["mass::B_d"], u),
@@ -73,6 +82,38 @@ namespace eos
             b_lcdas(p, o)
         {
             u.uses(b_lcdas);
+
+            if (destringify<bool>(o.get("tabulate", "false")))
+            {
+                const bool check = destringify<bool>(o.get("tabulation-check", "false"));
+
+                v_tabulated   = tabulate("V",   &Implementation<AnalyticFormFactorBToKstarKMO2006>::v,   p, check);
+                a_0_tabulated = tabulate("A_0", &Implementation<AnalyticFormFactorBToKstarKMO2006>::a_0, p, check);
+                a_1_tabulated = tabulate("A_1", &Implementation<AnalyticFormFactorBToKstarKMO2006>::a_1, p, check);
+                a_2_tabulated = tabulate("A_2", &Implementation<AnalyticFormFactorBToKstarKMO2006>::a_2, p, check);
+                t_1_tabulated = tabulate("T_1", &Implementation<AnalyticFormFactorBToKstarKMO2006>::t_1, p, check);
+                t_2_tabulated = tabulate("T_2", &Implementation<AnalyticFormFactorBToKstarKMO2006>::t_2, p, check);
+                t_3_tabulated = tabulate("T_3", &Implementation<AnalyticFormFactorBToKstarKMO2006>::t_3, p, check);
+            }
+        }
+
+        std::shared_ptr<Tabulation> tabulate(const std::string & name,
+                double (Implementation<AnalyticFormFactorBToKstarKMO2006>::* f)(const double &) const,
+                const Parameters & p, const bool & check)
+        {
+            return std::make_shared<Tabulation>("B->K^*::" + name + "@KMO2006", p,
+                    std::bind(f, this, std::placeholders::_1), 0.0, 14.0, 29, check);
+        }
+
+        // use the interpolation if available, and the exact expression otherwise
+        double evaluate(const std::shared_ptr<Tabulation> & tabulated,
+                double (Implementation<AnalyticFormFactorBToKstarKMO2006>::* f)(const double &) const,
+                const double & q2) const
+        {
+            if (tabulated)
+                return (*tabulated)(q2);
+
+            return (this->*f)(q2);
         }
 
         double sigma0(const double & q2) const
@@ -733,14 +774,14 @@ namespace eos
 
         /* A_12 */
 
-        inline double a_12(const double & q2) const
+        inline double a_12(const double & q2, const double & a_1, const double & a_2) const
         {
             const auto m_B2     = pow(m_B(), 2);
             const auto m_Kstar2 = std::pow(m_Kstar(), 2);
             const auto lambda   = eos::lambda(m_B2, m_Kstar2, q2);
 
-            return (pow(m_B + m_Kstar, 2) * (m_B2 - m_Kstar2 - q2) * this->a_1(q2)
-                - lambda * this->a_2(q2)) / (16.0 * m_B * m_Kstar2 * (m_B + m_Kstar));
+            return (pow(m_B + m_Kstar, 2) * (m_B2 - m_Kstar2 - q2) * a_1
+                - lambda * a_2) / (16.0 * m_B * m_Kstar2 * (m_B + m_Kstar));
         }
 
         /* T_1 */
@@ -1330,13 +1371,147 @@ namespace eos
                 * (integral + delta);
         }
 
-        inline double t_23(const double & q2) const
+        inline double t_23(const double & q2, const double & t_2, const double & t_3) const
         {
             const auto m_B2     = pow(m_B(), 2);
             const auto m_Kstar2 = pow(m_Kstar(), 2);
             const auto lambda   = eos::lambda(m_B2, m_Kstar2, q2);
 
-            return (m_B + m_Kstar) / (8.0 * m_B * m_Kstar2) * ((m_B2 + 3.0 * m_Kstar2 - q2) * this->t_2(q2) - lambda / (m_B2 - m_Kstar2) * this->t_3(q2));
+            return (m_B + m_Kstar) / (8.0 * m_B * m_Kstar2) * ((m_B2 + 3.0 * m_Kstar2 - q2) * t_2 - lambda / (m_B2 - m_Kstar2) * t_3);
+        }
+
+        /* All form factors */
+
+        // indices into the vector-valued integrand
+        enum { idx_v = 0, idx_a_0, idx_a_1, idx_a_2, idx_t_1, idx_t_23a, idx_t_23b, n_integrands };
+
+        // the integrands of V, A_0, A_1, A_2, T_1, T_23A and T_23B, sharing the Borel exponential
+        // and the B-meson LCDAs at each point sigma
+        std::array<double, n_integrands> integrands(const double & q2, const double & sigma) const
+        {
+            const auto m_B2 = std::pow(m_B(), 2);
+            const auto m_B3 = std::pow(m_B(), 3);
+            const auto sigmabar = 1.0 - sigma, sigmabar2 = sigmabar * sigmabar;
+            const auto denominator = sigmabar2 * m_B2 - q2;
+
+            const auto borel = std::exp(-(m_B2 * sigma - q2 * sigma / sigmabar) / M2);
+
+            const auto phi_p     = b_lcdas.phi_plus(sigma * m_B());
+            const auto phi_m     = b_lcdas.phi_minus(sigma * m_B());
+            const auto Phi_bar   = b_lcdas.Phibar(sigma * m_B());
+            const auto phi_delta = phi_p - phi_m;
+
+            // the three-particle contributions differ only in the functions iota_{1,2,3}
+            const auto three_particle = [&] (const double & iota1, const double & iota2, const double & iota3)
+            {
+                return borel * (-iota1 + iota2 / M2 - iota3 / (2.0 * M2 * M2));
+            };
+
+            std::array<double, n_integrands> result;
+
+            result[idx_v] = borel * phi_p / sigmabar
+                + m_B() * three_particle(v_iota1(q2, sigma), v_iota2(q2, sigma), v_iota3(q2, sigma));
+
+            result[idx_a_0] = borel * (phi_m * sigma - Phi_bar / m_B()) / sigmabar
+                + three_particle(a_0_iota1(q2, sigma), a_0_iota2(q2, sigma), a_0_iota3(q2, sigma));
+
+            result[idx_a_1] = borel * phi_p * (m_B2 - q2 / sigmabar2)
+                + m_B2 * three_particle(a_1_iota1(q2, sigma), a_1_iota2(q2, sigma), a_1_iota3(q2, sigma));
+
+            {
+                const auto c_p     = 1.0 - sigma / sigmabar;
+                const auto c_delta = 2.0 * sigma * sigmabar * m_B2 / denominator;
+                const auto c_bar   = 4.0 * sigma * sigmabar2 * m_B3 / pow(denominator, 2)
+                                   + 2.0 * (1.0 - 2.0 * sigma) * m_B / denominator;
+
+                result[idx_a_2] = borel * (c_p * phi_p + c_delta * phi_delta + c_bar * Phi_bar)
+                    + three_particle(a_2_iota1(q2, sigma), a_2_iota2(q2, sigma), a_2_iota3(q2, sigma));
+            }
+
+            result[idx_t_1] = borel * phi_p
+                + three_particle(t_1_iota1(q2, sigma), t_1_iota2(q2, sigma), t_1_iota3(q2, sigma));
+
+            {
+                const auto c_p     = 1.0;
+                const auto c_delta = -2.0 * q2 * sigma / denominator;
+                const auto c_bar   = 2.0 * q2 * (q2 + m_B2 * (sigma * sigma - 1.0)) / (m_B * pow(denominator, 2));
+
+                result[idx_t_23a] = borel * (c_p * phi_p + c_delta * phi_delta + c_bar * Phi_bar)
+                    + three_particle(t_23a_iota1(q2, sigma), t_23a_iota2(q2, sigma), t_23a_iota3(q2, sigma));
+            }
+
+            {
+                const auto numerator = m_B2 * sigmabar2 + q2 * (2.0 * sigma - 1.0);
+                const auto c_p       = sigma / sigmabar;
+                const auto c_delta   = numerator * sigma / (sigmabar * denominator);
+                const auto c_bar     = -numerator * (q2 + m_B2 * (sigma * sigma - 1.0)) / (m_B * pow(denominator, 2) * sigmabar);
+
+                result[idx_t_23b] = -borel * (c_p * phi_p + c_delta * phi_delta + c_bar * Phi_bar)
+                    + three_particle(t_23b_iota1(q2, sigma), t_23b_iota2(q2, sigma), t_23b_iota3(q2, sigma));
+            }
+
+            return result;
+        }
+
+        // the surface term at sigma0, cf. the individual form factors
+        inline double delta(const double & q2, const double & sigma0, const double & iota20, const double & iota30, const double & Diota30) const
+        {
+            const auto m_B2   = pow(m_B(), 2);
+            const auto etaf0  = etaf(q2, sigma0);
+            const auto Detaf0 = Detaf(q2, sigma0);
+
+            return (iota20 - (1.0 / M2 + Detaf0 / m_B2) / 2.0 * iota30 - etaf0 / (2.0 * m_B2) * Diota30)
+                * std::exp(-s0 / M2) / m_B2 * etaf0;
+        }
+
+        // integrates all form factors in a single sweep over sigma
+        FormFactors<PToV>::Values values(const double & q2) const
+        {
+            const auto m_B2      = pow(m_B(), 2);
+            const auto m_Kstar2  = pow(m_Kstar(), 2);
+            const auto m_b       = model->m_b_msbar(mu());
+            const auto exp_kstar = std::exp(m_Kstar2 / M2);
+
+            const std::function<std::array<double, n_integrands> (const double &)> integrand = std::bind(&Implementation<AnalyticFormFactorBToKstarKMO2006>::integrands, this, q2, std::placeholders::_1);
+
+            // the absolute tolerance keeps a component with a vanishing integral from driving the
+            // refinement of all other components
+            const auto sigma0   = this->sigma0(q2);
+            const auto integral = integrate<n_integrands>(integrand, 0.0, sigma0, cubature::Config().epsabs(1.0e-10));
+
+            const auto delta_v     = delta(q2, sigma0, v_iota2(q2, sigma0),     v_iota3(q2, sigma0),     v_Diota3(q2, sigma0));
+            const auto delta_a_0   = delta(q2, sigma0, a_0_iota2(q2, sigma0),   a_0_iota3(q2, sigma0),   a_0_Diota3(q2, sigma0));
+            const auto delta_a_1   = delta(q2, sigma0, a_1_iota2(q2, sigma0),   a_1_iota3(q2, sigma0),   a_1_Diota3(q2, sigma0));
+            const auto delta_a_2   = delta(q2, sigma0, a_2_iota2(q2, sigma0),   a_2_iota3(q2, sigma0),   a_2_Diota3(q2, sigma0));
+            const auto delta_t_1   = delta(q2, sigma0, t_1_iota2(q2, sigma0),   t_1_iota3(q2, sigma0),   t_1_Diota3(q2, sigma0));
+            const auto delta_t_23a = delta(q2, sigma0, t_23a_iota2(q2, sigma0), t_23a_iota3(q2, sigma0), t_23a_Diota3(q2, sigma0));
+            const auto delta_t_23b = delta(q2, sigma0, t_23b_iota2(q2, sigma0), t_23b_iota3(q2, sigma0), t_23b_Diota3(q2, sigma0));
+
+            FormFactors<PToV>::Values result;
+            result.v   = f_B * m_B * (m_B + m_Kstar) / (2.0 * f_Kstar * m_Kstar) * exp_kstar
+                * (integral[idx_v] + m_B * delta_v);
+            result.a_0 = f_B * m_B2 * m_b / (2.0 * f_Kstar * m_Kstar2) * exp_kstar
+                * (integral[idx_a_0] + delta_a_0);
+            result.a_1 = f_B * m_B / (m_B + m_Kstar) / (2.0 * f_Kstar * m_Kstar) * exp_kstar
+                * (integral[idx_a_1] + m_B2 * delta_a_1);
+            result.a_2 = f_B * m_B * (m_B + m_Kstar) / (2.0 * f_Kstar * m_Kstar) * exp_kstar
+                * (integral[idx_a_2] + delta_a_2);
+            result.a_12 = a_12(q2, result.a_1, result.a_2);
+
+            // T_2 and T_3 are linear combinations of T_23A and T_23B, the latter carrying twice the prefactor
+            const auto prefactor_t = f_B * m_B2 / (2.0 * f_Kstar * m_Kstar) * exp_kstar;
+            const auto t_23a = prefactor_t * (integral[idx_t_23a] + delta_t_23a);
+            const auto t_23b = prefactor_t * (integral[idx_t_23b] + delta_t_23b);
+
+            const auto c_23a = (m_B2 - m_Kstar2 - q2) / (m_B2 - m_Kstar2);
+            const auto c_23b = 2.0 * q2 / (m_B2 - m_Kstar2);
+
+            result.t_1  = prefactor_t * (integral[idx_t_1] + delta_t_1);
+            result.t_2  = c_23a * t_23a + c_23b * t_23b;
+            result.t_3  = t_23a - 2.0 * t_23b;
+            result.t_23 = t_23(q2, result.t_2, result.t_3);
+
+            return result;
         }
 
         Diagnostics diagnostics() const
@@ -1611,58 +1786,74 @@ namespace eos
         return new AnalyticFormFactorBToKstarKMO2006(p, Options{});
     }
 
+    FormFactors<PToV> *
+    AnalyticFormFactorBToKstarKMO2006::make_tabulated(const Parameters & p, unsigned)
+    {
+        return new AnalyticFormFactorBToKstarKMO2006(p, Options{ { "tabulate", "true" } });
+    }
+
     double
     AnalyticFormFactorBToKstarKMO2006::v(const double & q2) const
     {
-        return _imp->v(q2);
+        return _imp->evaluate(_imp->v_tabulated, &Implementation<AnalyticFormFactorBToKstarKMO2006>::v, q2);
     }
 
     double
     AnalyticFormFactorBToKstarKMO2006::a_0(const double & q2) const
     {
-        return _imp->a_0(q2);
+        return _imp->evaluate(_imp->a_0_tabulated, &Implementation<AnalyticFormFactorBToKstarKMO2006>::a_0, q2);
     }
 
     double
     AnalyticFormFactorBToKstarKMO2006::a_1(const double & q2) const
     {
-        return _imp->a_1(q2);
+        return _imp->evaluate(_imp->a_1_tabulated, &Implementation<AnalyticFormFactorBToKstarKMO2006>::a_1, q2);
     }
 
     double
     AnalyticFormFactorBToKstarKMO2006::a_2(const double & q2) const
     {
-        return _imp->a_2(q2);
+        return _imp->evaluate(_imp->a_2_tabulated, &Implementation<AnalyticFormFactorBToKstarKMO2006>::a_2, q2);
     }
 
     double
     AnalyticFormFactorBToKstarKMO2006::a_12(const double & q2) const
     {
-        return _imp->a_12(q2);
+        return _imp->a_12(q2, this->a_1(q2), this->a_2(q2));
     }
 
     double
     AnalyticFormFactorBToKstarKMO2006::t_1(const double & q2) const
     {
-        return _imp->t_1(q2);
+        return _imp->evaluate(_imp->t_1_tabulated, &Implementation<AnalyticFormFactorBToKstarKMO2006>::t_1, q2);
     }
 
     double
     AnalyticFormFactorBToKstarKMO2006::t_2(const double & q2) const
     {
-        return _imp->t_2(q2);
+        return _imp->evaluate(_imp->t_2_tabulated, &Implementation<AnalyticFormFactorBToKstarKMO2006>::t_2, q2);
     }
 
     double
     AnalyticFormFactorBToKstarKMO2006::t_3(const double & q2) const
     {
-        return _imp->t_3(q2);
+        return _imp->evaluate(_imp->t_3_tabulated, &Implementation<AnalyticFormFactorBToKstarKMO2006>::t_3, q2);
     }
 
     double
     AnalyticFormFactorBToKstarKMO2006::t_23(const double & q2) const
     {
-        return _imp->t_23(q2);
+        return _imp->t_23(q2, this->t_2(q2), this->t_3(q2));
+    }
+
+    FormFactors<PToV>::Values
+    AnalyticFormFactorBToKstarKMO2006::values(const double & q2) const
+    {
+        // all form factors are tabulated together
+        if (_imp->v_tabulated)
+            return FormFactors<PToV>::values(q2);
+
+        return _imp->values(q2);
     }
 
     Diagnostics
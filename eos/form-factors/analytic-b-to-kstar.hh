@@ -38,6 +38,9 @@ namespace eos
 
             static FormFactors<PToV> * make(const Parameters &, unsigned);
 
+            /* Tabulates all form factors on a q^2 grid, cf. the option 'tabulate' */
+            static FormFactors<PToV> * make_tabulated(const Parameters &, unsigned);
+
             /* Form factors */
             virtual double v(const double & s) const;
 
@@ -51,6 +54,9 @@ namespace eos
             virtual double t_3(const double & s) const;
             virtual double t_23(const double & s) const;
 
+            /* Integrates all form factors in a single sweep, unless they are tabulated */
+            virtual Values values(const double & s) const;
+
             /* Diagnostics for unit tests */
             Diagnostics diagnostics() const;
     };
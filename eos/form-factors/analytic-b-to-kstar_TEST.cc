@@ -322,6 +322,7 @@ class KMO2006FormFactorsTest :
 
                 Parameters p = Parameters::Defaults();
                 std::shared_ptr<FormFactors<PToV>> ff = FormFactorFactory<PToV>::create("B->K^*@KMO2006", p);
+                std::shared_ptr<FormFactors<PToV>> ff_tab = FormFactorFactory<PToV>::create("B->K^*@KMO2006-tabulated", p);
 
                 p["mu"]                  = 4.2;
                 p["lambda_B_p"]          = 0.460;
@@ -368,6 +369,44 @@ class KMO2006FormFactorsTest :
                 TEST_CHECK_RELATIVE_ERROR( 0.476978, ff->t_23(-5.0), 2.0 * eps);
                 TEST_CHECK_RELATIVE_ERROR( 0.536617, ff->t_23(-1.0), 2.0 * eps);
                 TEST_CHECK_RELATIVE_ERROR( 0.554854, ff->t_23( 0.0), 2.0 * eps);
+
+                // tabulated form factors agree with the exact ones within the tabulated range, and
+                // coincide outside of it
+                static const double tab_eps = 1e-4;
+
+                TEST_CHECK_RELATIVE_ERROR(ff->v(3.3),    ff_tab->v(3.3),    tab_eps);
+                TEST_CHECK_RELATIVE_ERROR(ff->a_0(3.3),  ff_tab->a_0(3.3),  tab_eps);
+                TEST_CHECK_RELATIVE_ERROR(ff->a_1(3.3),  ff_tab->a_1(3.3),  tab_eps);
+                TEST_CHECK_RELATIVE_ERROR(ff->a_2(3.3),  ff_tab->a_2(3.3),  tab_eps);
+                TEST_CHECK_RELATIVE_ERROR(ff->a_12(3.3), ff_tab->a_12(3.3), tab_eps);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_1(3.3),  ff_tab->t_1(3.3),  tab_eps);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_2(3.3),  ff_tab->t_2(3.3),  tab_eps);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_3(3.3),  ff_tab->t_3(3.3),  tab_eps);
+                TEST_CHECK_RELATIVE_ERROR(ff->t_23(3.3), ff_tab->t_23(3.3), tab_eps);
+                TEST_CHECK_EQUAL(ff->v(-1.0), ff_tab->v(-1.0));
+
+                // the single-pass evaluation agrees with the individual form factors
+                static const double values_eps = 1e-3;
+
+                for (const double & q2 : { -5.0, 0.0, 3.3 })
+                {
+                    const FormFactors<PToV>::Values values = ff->values(q2);
+
+                    TEST_CHECK_RELATIVE_ERROR(ff->v(q2),    values.v,    values_eps);
+                    TEST_CHECK_RELATIVE_ERROR(ff->a_0(q2),  values.a_0,  values_eps);
+                    TEST_CHECK_RELATIVE_ERROR(ff->a_1(q2),  values.a_1,  values_eps);
+                    TEST_CHECK_RELATIVE_ERROR(ff->a_2(q2),  values.a_2,  values_eps);
+                    TEST_CHECK_RELATIVE_ERROR(ff->a_12(q2), values.a_12, values_eps);
+                    TEST_CHECK_RELATIVE_ERROR(ff->t_1(q2),  values.t_1,  values_eps);
+                    TEST_CHECK_RELATIVE_ERROR(ff->t_2(q2),  values.t_2,  values_eps);
+                    TEST_CHECK_RELATIVE_ERROR(ff->t_3(q2),  values.t_3,  values_eps);
+                    TEST_CHECK_RELATIVE_ERROR(ff->t_23(q2), values.t_23, values_eps);
+                }
+
+                // the tabulated form factors are reused as they are
+                const FormFactors<PToV>::Values values_tab = ff_tab->values(3.3);
+                TEST_CHECK_EQUAL(ff_tab->v(3.3),   values_tab.v);
+                TEST_CHECK_EQUAL(ff_tab->t_3(3.3), values_tab.t_3);
             }
         }
 } kmo2006_form_factors_test;
@@ -20,6 +20,7 @@
 #include <eos/form-factors/analytic-b-to-pi.hh>
 #include <eos/form-factors/pi-lcdas.hh>
 #include <eos/utils/derivative.hh>
+#include <eos/utils/destringify.hh>
 #include <eos/utils/exception.hh>
 #include <eos/utils/integrate.hh>
 #include <eos/utils/model.hh>
@@ -27,6 +28,7 @@
 #include <eos/utils/power_of.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qcd.hh>
+#include <eos/utils/tabulation.hh>
 
 #include <functional>
 
@@ -61,6 +63,9 @@ namespace eos
 
         PionLCDAs pi;
 
+        // interpolation of f_+ in q^2, used if the option 'tabulate' is set
+        std::shared_ptr<Tabulation> f_p_tabulated;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make("SM", p, o)),
             MB(p["mass::B_d"], u),
@@ -77,6 +82,12 @@ namespace eos
             r_vac(p["QCD::r_vac"], u),
             pi(p, o)
         {
+            if (destringify<bool>(o.get("tabulate", "false")))
+            {
+                f_p_tabulated.reset(new Tabulation("B->pi::f_+@DKMMO2008", p,
+                        std::bind(&Implementation<AnalyticFormFactorBToPiDKMMO2008>::f_p, this, std::placeholders::_1),
+                        0.0, 12.0, 25, destringify<bool>(o.get("tabulation-check", "false"))));
+            }
         }
 
         inline double m_b_msbar(const double & mu) const
@@ -228,8 +239,9 @@ namespace eos
         double F_lo_tw3_integrand(const double & u, const double & q2, const double & _M2) const
         {
             const double mb = this->m_b_msbar(mu), mb2 = mb * mb, mpi2 = mpi * mpi;
-            const double mupi = pi.mupi(mu);
-            const double omega3pi = pi.omega3pi(mu);
+            const PionLCDAs::Coefficients c = pi.coefficients(mu);
+            const double mupi = c.mupi;
+            const double omega3pi = c.omega3pi;
 
             // auxilliary functions and their first derivatives
             auto I3 = [&] (const double & u) -> double
@@ -270,7 +282,7 @@ namespace eos
                 * (I3bar_d1(u) - (2.0 * u * mpi2) / (mb2 - q2 + u2 * mpi2) * I3bar(u));
 
             return std::exp(-(mb2 - q2 * (1.0 - u) + mpi2 * u * (1.0 - u)) / (u * _M2))
-                * (mupi / mb * tw3a - pi.f3pi(mu) / (mb * fpi) * (tw3b + tw3c));
+                * (mupi / mb * tw3a - c.f3pi / (mb * fpi) * (tw3b + tw3c));
         }
 
         double F_lo_tw3(const double & q2, const double & _M2) const
@@ -287,9 +299,10 @@ namespace eos
         {
             const double mb = this->m_b_msbar(mu), mb2 = mb * mb, mpi2 = mpi * mpi, mpi4 = mpi2 * mpi2;
             const double u0 = std::max(1e-10, (mb2 - q2) / (s0B - q2));
-            const double a2pi = pi.a2pi(mu);
-            const double deltapipi = pi.deltapipi(mu);
-            const double omega4pi = pi.omega4pi(mu);
+            const PionLCDAs::Coefficients c = pi.coefficients(mu);
+            const double a2pi = c.a2pi;
+            const double deltapipi = c.deltapipi;
+            const double omega4pi = c.omega4pi;
 
             // auxilliary functions and their first derivatives
             auto I4 = [&] (const double & u) -> double
@@ -388,7 +401,8 @@ namespace eos
             // analytically continued. See also comment at beginning of Appendix B
             // of [DKMMO2008], p. 21.
             const double mb = this->m_b_msbar(mu), mb2 = mb * mb;
-            const double a2pi = pi.a2pi(mu), a4pi = pi.a4pi(mu);
+            const PionLCDAs::Coefficients c = pi.coefficients(mu);
+            const double a2pi = c.a2pi, a4pi = c.a4pi;
             const double r1 = q2 / mb2;
 
             // imaginary parts of the hard scattering kernel, integrated over rho.
@@ -873,6 +887,12 @@ namespace eos
         return new AnalyticFormFactorBToPiDKMMO2008(p, Options{ });
     }
 
+    FormFactors<PToP> *
+    AnalyticFormFactorBToPiDKMMO2008::make_tabulated(const Parameters & p, unsigned)
+    {
+        return new AnalyticFormFactorBToPiDKMMO2008(p, Options{ { "tabulate", "true" } });
+    }
+
     double
     AnalyticFormFactorBToPiDKMMO2008::F_lo_tw2(const double & q2) const
     {
@@ -906,6 +926,9 @@ namespace eos
     double
     AnalyticFormFactorBToPiDKMMO2008::f_p(const double & q2) const
     {
+        if (_imp->f_p_tabulated)
+            return (*_imp->f_p_tabulated)(q2);
+
         return _imp->f_p(q2);
     }
 
@@ -38,6 +38,9 @@ namespace eos
 
             static FormFactors<PToP> * make(const Parameters &, unsigned);
 
+            /* Tabulates f_+ on a q^2 grid, cf. the option 'tabulate' */
+            static FormFactors<PToP> * make_tabulated(const Parameters &, unsigned);
+
             /* Leading-order terms */
             double F_lo_tw2(const double & q2) const;
             double F_lo_tw3(const double & q2) const;
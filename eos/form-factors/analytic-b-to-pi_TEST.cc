@@ -147,6 +147,15 @@ class AnalyticFormFactorBToPiDKMMO2008Test :
                 TEST_CHECK_NEARLY_EQUAL( 0.3777, ff.f_p( 5.0), 10 * eps);
                 TEST_CHECK_NEARLY_EQUAL( 0.5346, ff.f_p(10.0), 10 * eps);
 
+                // tabulated form factor
+                AnalyticFormFactorBToPiDKMMO2008 ff_tab(p, Options{ { "tabulate", "true" } });
+                TEST_CHECK_RELATIVE_ERROR(ff.f_p( 3.1), ff_tab.f_p( 3.1), eps);
+                TEST_CHECK_RELATIVE_ERROR(ff.f_p( 7.3), ff_tab.f_p( 7.3), eps);
+                TEST_CHECK_EQUAL(         ff.f_p(15.0), ff_tab.f_p(15.0));
+
+                // the table follows changes of the parameters
+                p["B->pi::M^2@DKMMO2008"] = 10.0;
+                TEST_CHECK_RELATIVE_ERROR(ff.f_p( 7.3), ff_tab.f_p( 7.3), eps);
             }
         }
 } analytic_form_factor_b_to_pi_DKMMO2008_test;
@@ -19,10 +19,14 @@
 
 #include <eos/form-factors/kstar-lcdas.hh>
 #include <eos/utils/model.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qcd.hh>
 #include <eos/utils/stringify.hh>
 
+#include <limits>
+
 namespace eos
 {
     template <>
@@ -45,6 +49,14 @@ namespace eos
         UsedParameter _mu_b;
         UsedParameter _mu_t;
 
+        Parameters parameters;
+
+        // the coefficients at the most recently requested scale, and the parameter version they were evolved for
+        mutable KstarLCDAs::Coefficients cache;
+        mutable double cache_mu;
+        mutable unsigned long cache_version;
+        mutable Mutex mutex;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make("SM", p, o)),
             a_1_para_0(p["K^*::a_1_para@1GeV"], u),
@@ -55,7 +67,10 @@ namespace eos
             f_perp_0(p["K^*::f_perp@1GeV"], u),
             _mu_c(p["QCD::mu_c"], u),
             _mu_b(p["QCD::mu_b"], u),
-            _mu_t(p["QCD::mu_t"], u)
+            _mu_t(p["QCD::mu_t"], u),
+            parameters(p),
+            cache_mu(std::numeric_limits<double>::quiet_NaN()),
+            cache_version(0)
         {
         }
 
@@ -90,30 +105,35 @@ namespace eos
             throw InternalError("Implementation<KstarLCDAs>: RGE coefficient must not be evolved above mu_t = " + stringify(_mu_t()));
         }
 
-        inline double a_1_para(const double & mu) const
+        // evolves all parameters from mu_0 = 1 GeV to mu, using a single RGE coefficient
+        KstarLCDAs::Coefficients evolve(const double & mu) const
         {
-            return a_1_para_0 * std::pow(c_rge(mu), 32.0 / 9.0);
-        }
+            const double c = c_rge(mu);
 
-        inline double a_2_para(const double & mu) const
-        {
-            return a_2_para_0 * std::pow(c_rge(mu), 50.0 / 9.0);
-        }
+            KstarLCDAs::Coefficients result;
+            result.a_1_para = a_1_para_0 * std::pow(c, 32.0 / 9.0);
+            result.a_2_para = a_2_para_0 * std::pow(c, 50.0 / 9.0);
+            result.a_1_perp = a_1_perp_0 * std::pow(c, 36.0 / 9.0);
+            result.a_2_perp = a_2_perp_0 * std::pow(c, 52.0 / 9.0);
+            // gamma_0 / (beta_0^Nf=3) = 4 / 23, see [BFS2001], p. 14, below eq. (48)
+            result.f_perp   = f_perp_0 * std::pow(c, +4.0 / 23.0 * QCD::beta_function_nf_3[0]);
 
-        inline double a_1_perp(const double & mu) const
-        {
-            return a_1_perp_0 * std::pow(c_rge(mu), 36.0 / 9.0);
+            return result;
         }
 
-        inline double a_2_perp(const double & mu) const
+        KstarLCDAs::Coefficients coefficients(const double & mu) const
         {
-            return a_2_perp_0 * std::pow(c_rge(mu), 52.0 / 9.0);
-        }
+            Lock l(mutex);
 
-        inline double f_perp(const double & mu) const
-        {
-            // gamma_0 / (beta_0^Nf=3) = 4 / 23, see [BFS2001], p. 14, below eq. (48)
-            return f_perp_0 * std::pow(c_rge(mu), +4.0 / 23.0 * QCD::beta_function_nf_3[0]);
+            const unsigned long version = parameters.version();
+            if ((mu != cache_mu) || (version != cache_version))
+            {
+                cache = evolve(mu);
+                cache_mu = mu;
+                cache_version = version;
+            }
+
+            return cache;
         }
     };
 
@@ -126,16 +146,22 @@ namespace eos
     {
     }
 
+    KstarLCDAs::Coefficients
+    KstarLCDAs::coefficients(const double & mu) const
+    {
+        return _imp->coefficients(mu);
+    }
+
     double
     KstarLCDAs::a_1_para(const double & mu) const
     {
-        return _imp->a_1_para(mu);
+        return _imp->coefficients(mu).a_1_para;
     }
 
     double
     KstarLCDAs::a_2_para(const double & mu) const
     {
-        return _imp->a_2_para(mu);
+        return _imp->coefficients(mu).a_2_para;
     }
 
     double
@@ -147,19 +173,19 @@ namespace eos
     double
     KstarLCDAs::a_1_perp(const double & mu) const
     {
-        return _imp->a_1_perp(mu);
+        return _imp->coefficients(mu).a_1_perp;
     }
 
     double
     KstarLCDAs::a_2_perp(const double & mu) const
     {
-        return _imp->a_2_perp(mu);
+        return _imp->coefficients(mu).a_2_perp;
     }
 
     double
     KstarLCDAs::f_perp(const double & mu) const
     {
-        return _imp->f_perp(mu);
+        return _imp->coefficients(mu).f_perp;
     }
 
     double
@@ -170,7 +196,9 @@ namespace eos
         const double c1 = 3.0 * x;
         const double c2 = (15.0 * x2 - 3.0) / 2.0;
 
-        return 6.0 * u * (1.0 - u) * (1.0 + _imp->a_1_para(mu) * c1 + _imp->a_2_para(mu) * c2);
+        const Coefficients c = _imp->coefficients(mu);
+
+        return 6.0 * u * (1.0 - u) * (1.0 + c.a_1_para * c1 + c.a_2_para * c2);
     }
 
     double
@@ -181,7 +209,9 @@ namespace eos
         const double c1 = 3.0 * x;
         const double c2 = (15.0 * x2 - 3.0) / 2.0;
 
-        return 6.0 * u * (1.0 - u) * (1.0 + _imp->a_1_perp(mu) * c1 + _imp->a_2_perp(mu) * c2);
+        const Coefficients c = _imp->coefficients(mu);
+
+        return 6.0 * u * (1.0 - u) * (1.0 + c.a_1_perp * c1 + c.a_2_perp * c2);
     }
 
     double
@@ -193,7 +223,9 @@ namespace eos
         const double c1 = 6.0 * x - 3.0;
         const double c2 = (15.0 * x2 - 10.0 * x - 1.0) * 3.0 / 4.0;
 
-        return (1.0 + x) * (1.0 + x) / 4.0 * (c0 + _imp->a_1_para(mu) * c1 + _imp->a_2_para(mu) * c2);
+        const Coefficients c = _imp->coefficients(mu);
+
+        return (1.0 + x) * (1.0 + x) / 4.0 * (c0 + c.a_1_para * c1 + c.a_2_para * c2);
     }
 
     Diagnostics
@@ -34,6 +34,19 @@ namespace eos
             KstarLCDAs(const Parameters &, const Options &);
             ~KstarLCDAs();
 
+            /* All scale-dependent parameters at one scale */
+            struct Coefficients
+            {
+                double a_1_para, a_2_para;
+                double a_1_perp, a_2_perp, f_perp;
+            };
+
+            /*
+             * Evolves all parameters to the scale mu at once. The result is cached for
+             * the most recently requested scale, until any of the parameters changes.
+             */
+            Coefficients coefficients(const double & mu) const;
+
             /* Twist 2 LCDA for the vector current: Gegenbauer coefficients */
             double a_1_para(const double & mu) const;
             double a_2_para(const double & mu) const;
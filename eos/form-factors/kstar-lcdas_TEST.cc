@@ -96,5 +96,26 @@ class KstarLCDAsTest :
                 TEST_CHECK_NEARLY_EQUAL( 1.28268, kstar.phi_2_perp(0.7, 1.0),  eps);
                 TEST_CHECK_NEARLY_EQUAL( 0.77004, kstar.phi_2_perp(0.9, 1.0),  eps);
             }
+
+            /* Evolution of all coefficients at once, and invalidation of the cache */
+            {
+                Parameters p_copy = p.clone();
+                KstarLCDAs kstar(p_copy, Options{ });
+
+                KstarLCDAs::Coefficients c = kstar.coefficients(2.0);
+                TEST_CHECK_NEARLY_EQUAL( 0.02486,  c.a_1_para,   eps);
+                TEST_CHECK_NEARLY_EQUAL( 0.08200,  c.a_2_para,   eps);
+                TEST_CHECK_NEARLY_EQUAL( 0.03238,  c.a_1_perp,   eps);
+                TEST_CHECK_NEARLY_EQUAL( 0.07368,  c.a_2_perp,   eps);
+                TEST_CHECK_NEARLY_EQUAL( 0.14637,  c.f_perp,     eps);
+
+                // changing a parameter re-evolves the coefficients at the same scale
+                const double a_1_para = c.a_1_para;
+                p_copy["K^*::a_1_para@1GeV"] = 0.06;
+                c = kstar.coefficients(2.0);
+                TEST_CHECK_RELATIVE_ERROR(2.0 * a_1_para, c.a_1_para,           1e-12);
+                TEST_CHECK_RELATIVE_ERROR(2.0 * a_1_para, kstar.a_1_para(2.0),  1e-12);
+                TEST_CHECK_NEARLY_EQUAL( 0.08200,  c.a_2_para,   eps);
+            }
         }
 } kstar_lcdas_test;
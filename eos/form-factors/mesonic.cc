@@ -125,6 +125,23 @@ namespace eos
     {
     }
 
+    FormFactors<PToV>::Values
+    FormFactors<PToV>::values(const double & s) const
+    {
+        Values result;
+        result.v    = this->v(s);
+        result.a_0  = this->a_0(s);
+        result.a_1  = this->a_1(s);
+        result.a_2  = this->a_2(s);
+        result.a_12 = this->a_12(s);
+        result.t_1  = this->t_1(s);
+        result.t_2  = this->t_2(s);
+        result.t_3  = this->t_3(s);
+        result.t_23 = this->t_23(s);
+
+        return result;
+    }
+
     std::shared_ptr<FormFactors<PToV>>
     FormFactorFactory<PToV>::create(const std::string & label, const Parameters & parameters)
     {
@@ -142,7 +159,8 @@ namespace eos
             { KeyType("B_s->K^*",   "FMvD2015"), &FMvD2015FormFactors<BsToKstar>::make      },
             { KeyType("B_s->phi",   "BZ2004"),   &BZ2004FormFactors<BsToPhi, PToV>::make    },
             // analytic computations
-            { KeyType("B->K^*",     "KMO2006"),  &AnalyticFormFactorBToKstarKMO2006::make   }
+            { KeyType("B->K^*",     "KMO2006"),  &AnalyticFormFactorBToKstarKMO2006::make   },
+            { KeyType("B->K^*",     "KMO2006-tabulated"), &AnalyticFormFactorBToKstarKMO2006::make_tabulated }
         };
 
         /*
@@ -315,6 +333,7 @@ namespace eos
             { KeyType("B->D",     "BCL2008"),       &BCL2008FormFactors<BToD>::make          },
             // analytic computations
             { KeyType("B->pi",    "DKMMO2008"), &AnalyticFormFactorBToPiDKMMO2008::make      },
+            { KeyType("B->pi",    "DKMMO2008-tabulated"), &AnalyticFormFactorBToPiDKMMO2008::make_tabulated },
         };
 
         /*
@@ -64,6 +64,22 @@ namespace eos
             virtual double t_2(const double & s) const = 0;
             virtual double t_3(const double & s) const = 0;
             virtual double t_23(const double & s) const = 0;
+
+            /// The full set of form factors at one value of s.
+            struct Values
+            {
+                double v;
+                double a_0, a_1, a_2, a_12;
+                double t_1, t_2, t_3, t_23;
+            };
+
+            /*!
+             * Evaluate all form factors at one value of s.
+             *
+             * The default implementation calls the individual form factors. Implementations
+             * that share intermediate results between the form factors should override it.
+             */
+            virtual Values values(const double & s) const;
     };
 
     template <>
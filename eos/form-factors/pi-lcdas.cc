@@ -19,10 +19,14 @@
 
 #include <eos/form-factors/pi-lcdas.hh>
 #include <eos/utils/model.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/qcd.hh>
 #include <eos/utils/stringify.hh>
 
+#include <limits>
+
 namespace eos
 {
     template <>
@@ -51,6 +55,14 @@ namespace eos
         UsedParameter _mu_b;
         UsedParameter _mu_t;
 
+        Parameters parameters;
+
+        // the coefficients at the most recently requested scale, and the parameter version they were evolved for
+        mutable PionLCDAs::Coefficients cache;
+        mutable double cache_mu;
+        mutable unsigned long cache_version;
+        mutable Mutex mutex;
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make("SM", p, o)),
             a2pi_0(p["pi::a2@1GeV"], u),
@@ -63,7 +75,10 @@ namespace eos
             f_pi(p["decay-constant::pi"], u),
             _mu_c(p["QCD::mu_c"], u),
             _mu_b(p["QCD::mu_b"], u),
-            _mu_t(p["QCD::mu_t"], u)
+            _mu_t(p["QCD::mu_t"], u),
+            parameters(p),
+            cache_mu(std::numeric_limits<double>::quiet_NaN()),
+            cache_version(0)
         {
         }
 
@@ -98,49 +113,42 @@ namespace eos
             throw InternalError("Implementation<PionLCDAs>: RGE coefficient must not be evolved above mu_t = " + stringify(_mu_t()));
         }
 
-        inline double a2pi(const double & mu) const
-        {
-            return a2pi_0 * std::pow(c_rge(mu), 50.0 / 9.0);
-        }
-
-        inline double a4pi(const double & mu) const
-        {
-            return a4pi_0 * std::pow(c_rge(mu), 364.0 / 45.0);
-        }
-
         inline double m_ud_msbar(const double & mu) const
         {
             return this->model->m_ud_msbar(mu);
         }
 
-        inline double mupi(const double & mu) const
-        {
-            return m_pi * m_pi / this->m_ud_msbar(mu);
-        }
-
-        double f3pi(const double & mu) const
+        // evolves all parameters from mu_0 = 1 GeV to mu, using a single RGE coefficient
+        PionLCDAs::Coefficients evolve(const double & mu) const
         {
-            return f3pi_0 * std::pow(c_rge(mu), 55.0 / 9.0);
+            const double c = c_rge(mu);
+
+            PionLCDAs::Coefficients result;
+            result.a2pi      = a2pi_0 * std::pow(c, 50.0 / 9.0);
+            result.a4pi      = a4pi_0 * std::pow(c, 364.0 / 45.0);
+            result.mupi      = m_pi * m_pi / this->m_ud_msbar(mu);
+            result.f3pi      = f3pi_0 * std::pow(c, 55.0 / 9.0);
+            result.eta3pi    = result.f3pi / (f_pi() * result.mupi);
+            result.omega3pi  = omega3pi_0 * std::pow(c, 49.0 / 9.0);
+            result.deltapipi = deltapipi_0 * std::pow(c, 32.0 / 9.0);
+            result.omega4pi  = omega4pi_0 * std::pow(c, 58.0 / 9.0);
+
+            return result;
         }
 
-        inline double eta3pi(const double & mu) const
+        PionLCDAs::Coefficients coefficients(const double & mu) const
         {
-            return f3pi(mu) / (f_pi() * mupi(mu));
-        }
-
-        double omega3pi(const double & mu) const
-        {
-            return omega3pi_0 * std::pow(c_rge(mu), 49.0 / 9.0);
-        }
+            Lock l(mutex);
 
-        double deltapipi(const double & mu) const
-        {
-            return deltapipi_0 * std::pow(c_rge(mu), 32.0 / 9.0);
-        }
+            const unsigned long version = parameters.version();
+            if ((mu != cache_mu) || (version != cache_version))
+            {
+                cache = evolve(mu);
+                cache_mu = mu;
+                cache_version = version;
+            }
 
-        double omega4pi(const double & mu) const
-        {
-            return omega4pi_0 * std::pow(c_rge(mu), 58.0 / 9.0);
+            return cache;
         }
     };
 
@@ -153,52 +161,58 @@ namespace eos
     {
     }
 
+    PionLCDAs::Coefficients
+    PionLCDAs::coefficients(const double & mu) const
+    {
+        return _imp->coefficients(mu);
+    }
+
     double
     PionLCDAs::a2pi(const double & mu) const
     {
-        return _imp->a2pi(mu);
+        return _imp->coefficients(mu).a2pi;
     }
 
     double
     PionLCDAs::a4pi(const double & mu) const
     {
-        return _imp->a4pi(mu);
+        return _imp->coefficients(mu).a4pi;
     }
 
     double
     PionLCDAs::mupi(const double & mu) const
     {
-        return _imp->mupi(mu);
+        return _imp->coefficients(mu).mupi;
     }
 
     double
     PionLCDAs::f3pi(const double & mu) const
     {
-        return _imp->f3pi(mu);
+        return _imp->coefficients(mu).f3pi;
     }
 
     double
     PionLCDAs::eta3pi(const double & mu) const
     {
-        return _imp->eta3pi(mu);
+        return _imp->coefficients(mu).eta3pi;
     }
 
     double
     PionLCDAs::omega3pi(const double & mu) const
     {
-        return _imp->omega3pi(mu);
+        return _imp->coefficients(mu).omega3pi;
     }
 
     double
     PionLCDAs::deltapipi(const double & mu) const
     {
-        return _imp->deltapipi(mu);
+        return _imp->coefficients(mu).deltapipi;
     }
 
     double
     PionLCDAs::omega4pi(const double & mu) const
     {
-        return _imp->omega4pi(mu);
+        return _imp->coefficients(mu).omega4pi;
     }
 
     double
@@ -209,15 +223,18 @@ namespace eos
         const double c2 = (15.0 * x2 - 3.0) / 2.0;
         const double c4 = (15.0 - 210.0 * x2 + 315.0 * x4) / 8.0;
 
-        return 6.0 * u * (1.0 - u) * (1.0 + _imp->a2pi(mu) * c2 + _imp->a4pi(mu) * c4);
+        const Coefficients c = _imp->coefficients(mu);
+
+        return 6.0 * u * (1.0 - u) * (1.0 + c.a2pi * c2 + c.a4pi * c4);
     }
 
     double
     PionLCDAs::phi3p(const double & u, const double & mu) const
     {
         // Setting lambda3pi and rhopi to zero.
-        const double eta3pi = _imp->eta3pi(mu);
-        const double omega3pi = _imp->omega3pi(mu);
+        const Coefficients c = _imp->coefficients(mu);
+        const double eta3pi = c.eta3pi;
+        const double omega3pi = c.omega3pi;
 
         // Gegenbauer polynomials C_n^(1/2)
         const double x = 2.0 * u - 1.0, x2 = x * x, x4 = x2 * x2;
@@ -231,8 +248,9 @@ namespace eos
     PionLCDAs::phi3s(const double & u, const double & mu) const
     {
         // Setting lambda3pi and rhopi to zero.
-        const double eta3pi = _imp->eta3pi(mu);
-        const double omega3pi = _imp->omega3pi(mu);
+        const Coefficients c = _imp->coefficients(mu);
+        const double eta3pi = c.eta3pi;
+        const double omega3pi = c.omega3pi;
 
         // Gegenbauer polynomials C_n^(3/2)
         const double x = 2.0 * u - 1.0, x2 = x * x;
@@ -245,8 +263,9 @@ namespace eos
     PionLCDAs::phi3s_d1(const double & u, const double & mu) const
     {
         // Setting lambda3pi and rhopi to zero.
-        const double eta3pi = _imp->eta3pi(mu);
-        const double omega3pi = _imp->omega3pi(mu);
+        const Coefficients c = _imp->coefficients(mu);
+        const double eta3pi = c.eta3pi;
+        const double omega3pi = c.omega3pi;
 
         // Gegenbauer polynomials C_n^(3/2)
         const double x = 2.0 * u - 1.0, x2 = x * x;
@@ -259,10 +278,11 @@ namespace eos
     double
     PionLCDAs::phi4(const double & u, const double & mu) const
     {
+        const Coefficients c = _imp->coefficients(mu);
         const double u2 = u * u, u3 = u2 * u, lnu = std::log(u);
         const double ubar = 1.0 - u, ubar2 = ubar * ubar, ubar3 = ubar2 * ubar, lnubar = std::log(ubar);
 
-        return _imp->deltapipi(mu) * (200.0 / 3.0 * u2 * ubar2 + 21.0 * _imp->omega4pi(mu) * (
+        return c.deltapipi * (200.0 / 3.0 * u2 * ubar2 + 21.0 * c.omega4pi * (
                 u * ubar * (2.0 + 13.0 * u * ubar)
                 + 2.0 * u3    * (6.0 * u2    - 15.0 * u    + 10.0) * lnu
                 + 2.0 * ubar3 * (6.0 * ubar2 - 15.0 * ubar + 10.0) * lnubar
@@ -272,10 +292,11 @@ namespace eos
     double
     PionLCDAs::phi4_d1(const double & u, const double & mu) const
     {
+        const Coefficients c = _imp->coefficients(mu);
         const double u2 = u * u, u3 = u2 * u, lnu = std::log(u);
         const double ubar = 1.0 - u, ubar2 = ubar * ubar, lnubar = std::log(ubar);
 
-        return _imp->deltapipi(mu) * (400.0 / 3.0 * u * (1.0 - 3.0 * u + 2.0 * u2) + 21.0 * _imp->omega4pi(mu) * (
+        return c.deltapipi * (400.0 / 3.0 * u * (1.0 - 3.0 * u + 2.0 * u2) + 21.0 * c.omega4pi * (
                 2.0 + 22.0 * u - 78.0 * u2 + 52.0 * u3
                 + 2.0 * u2    * (6.0 * u2 - 15.0 * u + 10.0 + 30.0 * ubar2 * lnu)
                 - 2.0 * ubar2 * (6.0 * u2 +  3.0 * u +  1.0 + 30.0 * u2    * lnubar)
@@ -285,34 +306,38 @@ namespace eos
     double
     PionLCDAs::phi4_d2(const double & u, const double & mu) const
     {
+        const Coefficients c = _imp->coefficients(mu);
         const double u2 = u * u, lnu = std::log(u);
         const double ubar = 1.0 - u, lnubar = std::log(ubar);
 
-        return 20.0 / 3.0 * _imp->deltapipi(mu) * (
+        return 20.0 / 3.0 * c.deltapipi * (
                 20.0 * (1.0 - 6.0 * u + 6.0 * u2)
                 - 63.0 * (
                     -1.0 + 3.0 * u - 3.0 * u2
                     + 6.0 * u * (1.0 - 3.0 * u + 2.0 * u2) * (lnubar - lnu)
-                ) * _imp->omega4pi(mu)
+                ) * c.omega4pi
             );
     }
 
     double
     PionLCDAs::psi4(const double & u, const double & mu) const
     {
+        const Coefficients c = _imp->coefficients(mu);
+
         // Gegenbauer polynomials C_n^(1/2)
         const double x = 2.0 * u - 1.0, x2 = x * x;
         const double c2 = (3.0 * x2 - 1.0) / 2.0;
 
-        return _imp->deltapipi(mu) * 20.0 / 3.0 * c2;
+        return c.deltapipi * 20.0 / 3.0 * c2;
     }
 
     double
     PionLCDAs::psi4_i(const double & u, const double & mu) const
     {
+        const Coefficients c = _imp->coefficients(mu);
         const double u2 = u * u;
 
-        return _imp->deltapipi(mu) * 20.0 / 3.0 * u * (1.0 - 3.0 * u + 2.0 * u2);
+        return c.deltapipi * 20.0 / 3.0 * u * (1.0 - 3.0 * u + 2.0 * u2);
     }
 
     Diagnostics
@@ -34,6 +34,20 @@ namespace eos
             PionLCDAs(const Parameters &, const Options &);
             ~PionLCDAs();
 
+            /* All scale-dependent parameters at one scale */
+            struct Coefficients
+            {
+                double a2pi, a4pi;
+                double mupi, f3pi, eta3pi, omega3pi;
+                double deltapipi, omega4pi;
+            };
+
+            /*
+             * Evolves all parameters to the scale mu at once. The result is cached for
+             * the most recently requested scale, until any of the parameters changes.
+             */
+            Coefficients coefficients(const double & mu) const;
+
             /* Twist 2 LCDA (even) Gegenbauer coefficients */
             double a2pi(const double & mu) const;
             double a4pi(const double & mu) const;
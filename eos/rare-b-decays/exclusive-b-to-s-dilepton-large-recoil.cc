@@ -38,6 +38,8 @@
 #include <eos/utils/qcd.hh>
 #include <eos/utils/save.hh>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
 
@@ -116,10 +118,55 @@ namespace eos
 
         bool cp_conjugate;
 
+        // lepton masses for the tests of lepton-flavour universality
+        UsedParameter m_e, m_mu;
+
         std::string ff_relation;
 
         std::shared_ptr<FormFactors<PToV>> form_factors;
 
+        /*
+         * All inputs at a given q^2 that depend neither on the Wilson coefficients,
+         * nor on CP conjugation, nor on the lepton flavour. They are shared among
+         * the variants of the decay.
+         */
+        struct HadronicInputs
+        {
+            double s;
+
+            // full form factors and soft form factors
+            double ff_V, ff_A0, ff_A1, ff_A2, ff_T1, ff_T2, ff_T3;
+            double xi_perp, xi_par;
+
+            // masses and couplings
+            double m_c_pole, m_b_PS;
+            double a_mu, a_mu_f;
+            complex<double> lambda_hat_u;
+
+            // QCDF integrals and the inverse moment of the B-meson LCDA
+            QCDFIntegrals::Results qcdf_0, qcdf_c, qcdf_b;
+            complex<double> lambda_B_m_inv;
+
+            // charm loop functions
+            complex<double> h_c, h_b, h_0;
+            complex<double> F19_massive, F27_massive, F29_massive;
+            complex<double> F19_massless, F27_massless, F29_massless;
+            complex<double> F87_massless, F89_massless;
+        };
+
+        /*
+         * One variant of the decay, i.e., B or Bbar decaying to a given lepton flavour,
+         * together with the matching Wilson coefficients.
+         */
+        struct Variant
+        {
+            WilsonCoefficients<BToS> wc;
+
+            bool cp_conjugate;
+
+            double m_l;
+        };
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             model(Model::make(o.get("model", "WilsonScan"), p, o)),
             parameters(p),
@@ -149,7 +196,9 @@ namespace eos
             tau(p["life_time::B_" + o.get("q", "d")], u),
             e_q(-1.0/3.0),
             lepton_flavour(o.get("l", "mu")),
-            cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false")))
+            cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false"))),
+            m_e(p["mass::e"], u),
+            m_mu(p["mass::mu"], u)
         {
             if (0.0 == m_l())
             {
@@ -234,6 +283,83 @@ namespace eos
             return model->wilson_coefficients_b_to_s(lepton_flavour, cp_conjugate);
         }
 
+        Variant variant(const bool & cp_conjugate, const std::string & lepton_flavour, const double & m_l) const
+        {
+            return Variant{ model->wilson_coefficients_b_to_s(lepton_flavour, cp_conjugate), cp_conjugate, m_l };
+        }
+
+        // the variant selected by the options
+        Variant variant() const
+        {
+            return variant(cp_conjugate, lepton_flavour, m_l());
+        }
+
+        // the B and Bbar decays, for CP averages and asymmetries
+        std::array<Variant, 2> cp_variants() const
+        {
+            return std::array<Variant, 2>{{ variant(false, lepton_flavour, m_l()), variant(true, lepton_flavour, m_l()) }};
+        }
+
+        // the decays to electrons and to muons, for tests of lepton-flavour universality
+        std::array<Variant, 2> lepton_flavour_variants() const
+        {
+            return std::array<Variant, 2>{{ variant(cp_conjugate, "e", m_e()), variant(cp_conjugate, "mu", m_mu()) }};
+        }
+
+        HadronicInputs hadronic_inputs(const double & s) const
+        {
+            HadronicInputs result;
+            result.s = s;
+
+            // request all form factors at once, so that they can share intermediate results
+            const FormFactors<PToV>::Values ff = form_factors->values(s);
+            result.ff_V  = ff.v;
+            result.ff_A0 = ff.a_0;
+            result.ff_A1 = ff.a_1;
+            result.ff_A2 = ff.a_2;
+            result.ff_T1 = ff.t_1;
+            result.ff_T2 = ff.t_2;
+            result.ff_T3 = ff.t_3;
+
+            result.xi_perp = xi_perp(s, result.ff_V);
+            result.xi_par  = xi_par(s, result.ff_A1, result.ff_A2);
+
+            const double m_c_pole = model->m_c_pole(), m_b_PS = this->m_b_PS();
+            result.m_c_pole = m_c_pole;
+            result.m_b_PS   = m_b_PS;
+
+            // alpha_s at the hard scale and at the factorization scale
+            result.a_mu   = model->alpha_s(mu()) * QCD::casimir_f / 4.0 / M_PI;
+            result.a_mu_f = model->alpha_s(std::sqrt(mu() * 0.5)) * QCD::casimir_f / 4.0 / M_PI;
+            result.lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
+
+            result.qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            result.qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            result.qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+
+            // inverse of the "negative" moment of the B meson LCDA
+            // cf. [BFS2001], Eq. (54), p. 15
+            const double omega_0 = lambda_B_p;
+            result.lambda_B_m_inv = complex<double>(-gsl_sf_expint_Ei(s / m_B / omega_0), M_PI) * (std::exp(-s / m_B / omega_0) / omega_0);
+
+            // Use b pole mass according to [BFS2001], Sec. 3.1, paragraph Quark Masses,
+            // then replace b pole mass by the PS mass.
+            result.h_c = CharmLoops::h(mu, s, m_c_pole);
+            result.h_b = CharmLoops::h(mu, s, m_b_PS);
+            result.h_0 = CharmLoops::h(mu, s);
+
+            result.F19_massive  = memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole);
+            result.F27_massive  = memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole);
+            result.F29_massive  = memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole);
+            result.F19_massless = CharmLoops::F19_massless(mu, s, m_b_PS);
+            result.F27_massless = CharmLoops::F27_massless(mu, s, m_b_PS);
+            result.F29_massless = CharmLoops::F29_massless(mu, s, m_b_PS);
+            result.F87_massless = CharmLoops::F87_massless(mu, s, m_b_PS);
+            result.F89_massless = CharmLoops::F89_massless(s, m_b_PS);
+
+            return result;
+        }
+
         struct DipoleFormFactors
         {
             complex<double> calT_perp_left;
@@ -241,41 +367,41 @@ namespace eos
             complex<double> calT_parallel;
         };
 
-        DipoleFormFactors calT_BFS2004(const double & s, const WilsonCoefficients<BToS> & wc) const
+        DipoleFormFactors calT_BFS2004(const HadronicInputs & in, const Variant & v) const
         {
             // charges of down- and up-type quarks
             static const double e_d = -1.0/3.0;
             static const double e_u = +2.0/3.0;
 
+            const double & s = in.s;
+            const WilsonCoefficients<BToS> & wc = v.wc;
+
             // spectator contributions
             double delta_qu = (q == 'u' ? 1.0 : 0.0);
 
             // kinematics
-            double m_c_pole = model->m_c_pole();
-            double m_b_PS = this->m_b_PS(), m_b_PS2 = m_b_PS * m_b_PS;
+            double m_b_PS = in.m_b_PS, m_b_PS2 = m_b_PS * m_b_PS;
             double energy = this->energy(s);
             double L = -1.0 * (m_b_PS2 - s) / s * std::log(1.0 - s / m_b_PS2);
 
             // couplings
-            double alpha_s_mu = model->alpha_s(mu()); // alpha_s at the hard scale
-            double a_mu = alpha_s_mu * QCD::casimir_f / 4.0 / M_PI;
-            double alpha_s_mu_f = model->alpha_s(std::sqrt(mu() * 0.5)); // alpha_s at the factorization scale
-            double a_mu_f = alpha_s_mu_f * QCD::casimir_f / 4.0 / M_PI;
-            complex<double> lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
-            if (cp_conjugate)
+            double a_mu = in.a_mu;
+            double a_mu_f = in.a_mu_f;
+            complex<double> lambda_hat_u = in.lambda_hat_u;
+            if (v.cp_conjugate)
                 lambda_hat_u = std::conj(lambda_hat_u);
 
             // Compute the QCDF Integrals
             double invm1_par = 3.0 * (1.0 + a_1_par + a_2_par); // <ubar^-1>_par
             double invm1_perp = 3.0 * (1.0 + a_1_perp + a_2_perp); // <ubar^-1>_perp
-            QCDFIntegrals::Results qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
-            QCDFIntegrals::Results qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
-            QCDFIntegrals::Results qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            const QCDFIntegrals::Results & qcdf_0 = in.qcdf_0;
+            const QCDFIntegrals::Results & qcdf_c = in.qcdf_c;
+            const QCDFIntegrals::Results & qcdf_b = in.qcdf_b;
 
             // inverse of the "negative" moment of the B meson LCDA
             // cf. [BFS2001], Eq. (54), p. 15
-            double omega_0 = lambda_B_p, lambda_B_p_inv = 1.0 / lambda_B_p;
-            complex<double> lambda_B_m_inv = complex<double>(-gsl_sf_expint_Ei(s / m_B / omega_0), M_PI) * (std::exp(-s / m_B / omega_0) / omega_0);
+            double lambda_B_p_inv = 1.0 / lambda_B_p;
+            const complex<double> & lambda_B_m_inv = in.lambda_B_m_inv;
 
             /* Y(s) for the up and the top sector */
             // cf. [BFS2001], Eq. (10), p. 4
@@ -286,12 +412,12 @@ namespace eos
 
             // Use b pole mass according to [BFS2001], Sec. 3.1, paragraph Quark Masses,
             // then replace b pole mass by the PS mass.
-            complex<double> Y_top = Y_top_c * CharmLoops::h(mu, s, m_c_pole)
-                 + Y_top_b * CharmLoops::h(mu, s, m_b_PS)
-                 + Y_top_0 * CharmLoops::h(mu, s)
+            complex<double> Y_top = Y_top_c * in.h_c
+                 + Y_top_b * in.h_b
+                 + Y_top_0 * in.h_0
                  + Y_top_;
             // cf. [BFS2004], Eq. (43), p. 24
-            complex<double> Y_up = (4.0 / 3.0 * wc.c1() + wc.c2()) * (CharmLoops::h(mu, s, m_c_pole) - CharmLoops::h(mu, s));
+            complex<double> Y_up = (4.0 / 3.0 * wc.c1() + wc.c2()) * (in.h_c - in.h_0);
 
             /* Effective wilson coefficients */
             // cf. [BFS2001], below Eq. (9), p. 4
@@ -308,11 +434,11 @@ namespace eos
             complex<double> C1f_top_perp_right = (c7eff + wc.c7prime()) * (8.0 * std::log(m_b_PS / mu()) - L - 4.0 * (1.0 - mu_f() / m_b_PS));
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             complex<double> C1nf_top_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * in.F27_massive + c8eff * in.F87_massless
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
-                        + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
+                        wc.c1() * in.F19_massive
+                        + wc.c2() * in.F29_massive
+                        + c8eff * in.F89_massless));
 
             /* perpendicular, up sector */
             // cf. [BFS2004], comment before Eq. (43), p. 24
@@ -321,10 +447,10 @@ namespace eos
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
             complex<double> C1nf_up_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (in.F27_massive - in.F27_massless)
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (in.F19_massive - in.F19_massless)
+                        + wc.c2() * (in.F29_massive - in.F29_massless)));
 
             /* parallel, top sector */
             // cf. [BFS2001], Eqs. (14), (15), p. 5, in comparison with \delta_{2,3} = 1
@@ -333,12 +459,12 @@ namespace eos
             complex<double> C1f_top_par = -1.0 * (c7eff - wc.c7prime()) * (8.0 * std::log(m_b_PS / mu) + 2.0 * L - 4.0 * (1.0 - mu_f() / m_b_PS));
             // cf. [BFS2001], Eqs. (38), p. 9
             complex<double> C1nf_top_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
-                    + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * in.F27_massive
+                    + c8eff * in.F87_massless
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
-                        + c8eff * CharmLoops::F89_massless(s, m_b_PS)));
+                        wc.c1() * in.F19_massive
+                        + wc.c2() * in.F29_massive
+                        + c8eff * in.F89_massless));
 
             /* parallel, up sector */
             // cf. [BFS2004], comment before Eq. (43), p. 24
@@ -347,10 +473,10 @@ namespace eos
             // cf. [BFS2004], last paragraph in Sec A.1, p. 24
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
             complex<double> C1nf_up_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (in.F27_massive - in.F27_massless)
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (in.F19_massive - in.F19_massless)
+                        + wc.c2() * (in.F29_massive - in.F29_massless)));
 
             // compute the factorizing contributions
             complex<double> C_perp_left  = C0_top_perp_left  + lambda_hat_u * C0_up_perp
@@ -452,58 +578,54 @@ namespace eos
 
             // cf. [BFS2001], Eq. (15), and [BHP2008], Eq. (C.4)
             DipoleFormFactors result;
-            result.calT_perp_left  = xi_perp(s) * C_perp_left
+            result.calT_perp_left  = in.xi_perp * C_perp_left
                 + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_perp) / m_B * T_perp_left
                 + Delta_T_perp;
-            result.calT_perp_right = xi_perp(s) * C_perp_right
+            result.calT_perp_right = in.xi_perp * C_perp_right
                 + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_perp) / m_B * T_perp_right
                 + Delta_T_perp;
-            result.calT_parallel = xi_par(s) * C_par
+            result.calT_parallel = in.xi_par * C_par
                 + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_par * m_Kstar) / (m_B * energy) * T_par;
 
             return result;
         }
 
-        DipoleFormFactors calT_ABBBSW2008(const double & s, const WilsonCoefficients<BToS> & wc) const
+        DipoleFormFactors calT_ABBBSW2008(const HadronicInputs & in, const Variant & v) const
         {
             // charges of down- and up-type quarks
             static const double
                 e_d = -1.0 / 3.0,
                 e_u = +2.0 / 3.0;
 
+            const double & s = in.s;
+            const WilsonCoefficients<BToS> & wc = v.wc;
+
             // spectator contributions
             const double delta_qu = (q == 'u' ? 1.0 : 0.0);
 
             // kinematics
             const double
-                m_c_pole = model->m_c_pole(),
-                m_b_PS = this->m_b_PS(),
+                m_b_PS = in.m_b_PS,
                 energy = this->energy(s);
 
             // couplings
             const double
-                alpha_s_mu = model->alpha_s(mu()), // alpha_s at the hard scale
-                a_mu = alpha_s_mu * QCD::casimir_f / 4.0 / M_PI,
-                alpha_s_mu_f = model->alpha_s(std::sqrt(mu() * 0.5)), // alpha_s at the factorization scale
-                a_mu_f = alpha_s_mu_f * QCD::casimir_f / 4.0 / M_PI;
+                a_mu = in.a_mu,
+                a_mu_f = in.a_mu_f;
 
-            complex<double> lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
-            if (cp_conjugate)
+            complex<double> lambda_hat_u = in.lambda_hat_u;
+            if (v.cp_conjugate)
                 lambda_hat_u = std::conj(lambda_hat_u);
 
-            QCDFIntegrals::Results
-                qcdf_0 = QCDFIntegrals::dilepton_massless_case(s, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
-                qcdf_c = QCDFIntegrals::dilepton_charm_case(s, m_c_pole, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par),
-                qcdf_b = QCDFIntegrals::dilepton_bottom_case(s, m_b_PS, m_B, m_Kstar, mu, a_1_perp, a_2_perp, a_1_par, a_2_par);
+            const QCDFIntegrals::Results
+                & qcdf_0 = in.qcdf_0,
+                & qcdf_c = in.qcdf_c,
+                & qcdf_b = in.qcdf_b;
 
             // inverse of the "negative" moment of the B meson LCDA
             // cf. [BFS2001], Eq. (54), p. 15
-            const double
-                omega_0 = lambda_B_p,
-                lambda_B_p_inv = 1.0 / lambda_B_p;
-
-            const complex<double>
-                lambda_B_m_inv = complex<double>(-gsl_sf_expint_Ei(s / m_B / omega_0), M_PI) * (std::exp(-s / m_B / omega_0) / omega_0);
+            const double lambda_B_p_inv = 1.0 / lambda_B_p;
+            const complex<double> & lambda_B_m_inv = in.lambda_B_m_inv;
 
             /* Effective wilson coefficients */
             // cf. [BFS2001], below Eq. (26), p. 8
@@ -513,40 +635,40 @@ namespace eos
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             const complex<double>
                 C1nf_top_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
-                    + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * in.F27_massive
+                    + c8eff * in.F87_massless
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
-                        + c8eff * CharmLoops::F89_massless(s, m_b_PS))),
+                        wc.c1() * in.F19_massive
+                        + wc.c2() * in.F29_massive
+                        + c8eff * in.F89_massless)),
 
             /* perpendicular, up sector */
             // cf. [BFS2001], Eqs. (34), (37), p. 9
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
                 C1nf_up_perp = (-1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (in.F27_massive - in.F27_massless)
                     + (s / (2.0 * m_b_PS * m_B)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS)))),
+                        wc.c1() * (in.F19_massive - in.F19_massless)
+                        + wc.c2() * (in.F29_massive - in.F29_massless))),
 
             /* parallel, top sector */
             // cf. [BFS2001], Eqs. (38), p. 9
                 C1nf_top_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole)
-                    + c8eff * CharmLoops::F87_massless(mu, s, m_b_PS)
+                    (wc.c2() - wc.c1() / 6.0) * in.F27_massive
+                    + c8eff * in.F87_massless
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole)
-                        + wc.c2() * memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole)
-                        + c8eff * CharmLoops::F89_massless(s, m_b_PS))),
+                        wc.c1() * in.F19_massive
+                        + wc.c2() * in.F29_massive
+                        + c8eff * in.F89_massless)),
 
             /* parallel, up sector */
             // cf. [BFS2004], last paragraph in Sec A.1, p. 24
             // [BFS2004], [S2004] have a different sign convention for F{12}{79}_massless than we!
                 C1nf_up_par = (+1.0 / QCD::casimir_f) * (
-                    (wc.c2() - wc.c1() / 6.0) * (memoise(CharmLoops::F27_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F27_massless(mu, s, m_b_PS))
+                    (wc.c2() - wc.c1() / 6.0) * (in.F27_massive - in.F27_massless)
                     + (m_B / (2.0 * m_b_PS)) * (
-                        wc.c1() * (memoise(CharmLoops::F19_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F19_massless(mu, s, m_b_PS))
-                        + wc.c2() * (memoise(CharmLoops::F29_massive, mu(), s, m_b_PS, m_c_pole) - CharmLoops::F29_massless(mu, s, m_b_PS))));
+                        wc.c1() * (in.F19_massive - in.F19_massless)
+                        + wc.c2() * (in.F29_massive - in.F29_massless)));
 
             // compute the factorizing contributions
             // in ABBBSW2008: C0 is included in naively factorizing part and C1f = 0
@@ -641,9 +763,9 @@ namespace eos
 
             // cf. [BFS2001], Eq. (15), and [BHP2008], Eq. (C.4)
             DipoleFormFactors result;
-            result.calT_perp_left  = xi_perp(s) * C_perp + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_perp) / m_B * T_perp + Delta_T_perp;
+            result.calT_perp_left  = in.xi_perp * C_perp + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_perp) / m_B * T_perp + Delta_T_perp;
             result.calT_perp_right = result.calT_perp_left;
-            result.calT_parallel   = xi_par(s) * C_par   + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_par * m_Kstar) / (m_B * energy) * T_par;
+            result.calT_parallel   = in.xi_par * C_par   + power_of<2>(M_PI) / 3.0 * (f_B * f_Kstar_par * m_Kstar) / (m_B * energy) * T_par;
 
             return result;
         }
@@ -651,23 +773,38 @@ namespace eos
         /* Form factors */
         //  cf. [BHP2008], Eq. (E.4), p. 23
         double xi_perp(const double & s) const
+        {
+            return xi_perp(s, form_factors->v(s));
+        }
+
+        double xi_perp(const double & /*s*/, const double & ff_V) const
         {
             const double factor = m_B() / (m_B() + m_Kstar());
-            double result = uncertainty_xi_perp * factor * form_factors->v(s);
+            double result = uncertainty_xi_perp * factor * ff_V;
 
             return result;
         }
 
         double xi_par(const double & s) const
+        {
+            return xi_par(s, form_factors->a_1(s), form_factors->a_2(s));
+        }
+
+        double xi_par(const double & s, const double & ff_A1, const double & ff_A2) const
         {
             const double factor1 = (m_B() + m_Kstar()) / (2.0 * energy(s));
             const double factor2 = (1.0 - m_Kstar() / m_B());
-            double result = uncertainty_xi_par * (factor1 * form_factors->a_1(s) - factor2 * form_factors->a_2(s));
+            double result = uncertainty_xi_par * (factor1 * ff_A1 - factor2 * ff_A2);
 
             return result;
         }
 
         double beta_l(const double & s) const
+        {
+            return beta_l(s, m_l());
+        }
+
+        double beta_l(const double & s, const double & m_l) const
         {
             return std::sqrt(1.0 - 4.0 * m_l * m_l / s);
         }
@@ -677,13 +814,13 @@ namespace eos
             return lambda(m_B() * m_B(), m_Kstar() * m_Kstar(), s);
         }
 
-        double norm(const double & s) const
+        double norm(const double & s, const double & m_l) const
         {
             double lambda_t2 = std::norm(model->ckm_tb() * conj(model->ckm_ts()));
 
             return g_fermi() * alpha_e() * std::sqrt(
                       1.0 / 3.0 / 1024 / power_of<5>(M_PI) / m_B()
-                      * lambda_t2 * s_hat(s) * std::sqrt(lam(s)) * beta_l(s)
+                      * lambda_t2 * s_hat(s) * std::sqrt(lam(s)) * beta_l(s, m_l)
                    ); // cf. [BHP2008], Eq. (C.6), p. 21
         }
 
@@ -711,24 +848,25 @@ namespace eos
         /* Amplitudes */
         // cf. [BHP2008], p. 20
         // cf. [BHvD2012], app B, eqs. (B13 - B19)
-        Amplitudes amp_BFS2004(const double & s) const
+        Amplitudes amp_BFS2004(const HadronicInputs & in, const Variant & v) const
         {
             Amplitudes result;
 
-            WilsonCoefficients<BToS> wc = wilson_coefficients();
+            const double & s = in.s;
+            const WilsonCoefficients<BToS> & wc = v.wc;
 
             const double
                 shat = s_hat(s),
-                mbhat = m_b_PS() / m_B,
+                mbhat = in.m_b_PS / m_B,
                 mKhat2 = power_of<2>(m_Kstar() / m_B()),
                 m_K2 = power_of<2>(m_Kstar()),
                 m_B2 = power_of<2>(m_B()),
                 m2_diff = m_B2 - m_K2,
-                norm_s = this->norm(s),
+                norm_s = this->norm(s, v.m_l),
                 sqrt_lam = std::sqrt(lam(s)),
                 sqrt_s = std::sqrt(s);
 
-            DipoleFormFactors dff = calT_BFS2004(s, wc);
+            DipoleFormFactors dff = calT_BFS2004(in, v);
 
             const complex<double>
                 wilson_minus_right = (wc.c9() - wc.c9prime()) + (wc.c10() - wc.c10prime()),
@@ -740,8 +878,8 @@ namespace eos
             const double prefactor_long = -norm_s / (2.0 * m_Kstar() * std::sqrt(s));
 
             const complex<double>
-                a = (m2_diff - s) * 2.0 * energy(s) * xi_perp(s) - lam(s) * m_B() / m2_diff * (xi_perp(s) - xi_par(s)),
-                b = 2.0 * m_b_PS() * (
+                a = (m2_diff - s) * 2.0 * energy(s) * in.xi_perp - lam(s) * m_B() / m2_diff * (in.xi_perp - in.xi_par),
+                b = 2.0 * in.m_b_PS * (
                         ((m_B2 + 3.0 * m_K2 - s) * 2.0 * energy(s) / m_B() - lam(s) / m2_diff) * dff.calT_perp_left
                         - lam(s) / m2_diff * dff.calT_parallel
                     );
@@ -752,35 +890,35 @@ namespace eos
             // perpendicular amplitude
             const double prefactor_perp = +std::sqrt(2.0) * norm_s * m_B() * std::sqrt(lambda(1.0, mKhat2, shat));
 
-            result.a_perp_right = prefactor_perp * (wilson_plus_right * xi_perp(s) + uncertainty_perp() * (2.0 * mbhat / shat) * dff.calT_perp_right);
-            result.a_perp_left  = prefactor_perp * (wilson_plus_left  * xi_perp(s) + uncertainty_perp() * (2.0 * mbhat / shat) * dff.calT_perp_right);
+            result.a_perp_right = prefactor_perp * (wilson_plus_right * in.xi_perp + uncertainty_perp() * (2.0 * mbhat / shat) * dff.calT_perp_right);
+            result.a_perp_left  = prefactor_perp * (wilson_plus_left  * in.xi_perp + uncertainty_perp() * (2.0 * mbhat / shat) * dff.calT_perp_right);
 
             // parallel amplitude
             const double prefactor_par = -std::sqrt(2.0) * norm_s * m2_diff;
 
             result.a_par_right = prefactor_par * (
-                                    wilson_minus_right * xi_perp(s) * 2.0 * energy(s) / m2_diff
-                                    + uncertainty_para() * 4.0 * m_b_PS() * energy(s) / s / m_B() * dff.calT_perp_left
+                                    wilson_minus_right * in.xi_perp * 2.0 * energy(s) / m2_diff
+                                    + uncertainty_para() * 4.0 * in.m_b_PS * energy(s) / s / m_B() * dff.calT_perp_left
                                  );
             result.a_par_left  = prefactor_par * (
-                                    wilson_minus_left  * xi_perp(s) * 2.0 * energy(s) / m2_diff
-                                    + uncertainty_para() * 4.0 * m_b_PS() * energy(s) / s / m_B() * dff.calT_perp_left
+                                    wilson_minus_left  * in.xi_perp * 2.0 * energy(s) / m2_diff
+                                    + uncertainty_para() * 4.0 * in.m_b_PS * energy(s) / s / m_B() * dff.calT_perp_left
                                  );
 
             // timelike amplitude
             result.a_timelike = norm_s * sqrt_lam / sqrt_s
-                * (2.0 * (wc.c10() - wc.c10prime()) + s / m_l / (m_b_MSbar + m_s_MSbar) * (wc.cP() - wc.cPprime()))
-                * form_factors->a_0(s);
+                * (2.0 * (wc.c10() - wc.c10prime()) + s / v.m_l / (m_b_MSbar + m_s_MSbar) * (wc.cP() - wc.cPprime()))
+                * in.ff_A0;
 
             // scalar amplitude
-            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s_MSbar) * form_factors->a_0(s);
+            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s_MSbar) * in.ff_A0;
 
             // tensor amplitudes [BHvD2012]  eqs. (B18 - B20)
             // no form factor relations used
             const double
-                ff_T1  = form_factors->t_1(s),
-                ff_T2  = form_factors->t_2(s),
-                ff_T3  = form_factors->t_3(s),
+                & ff_T1 = in.ff_T1,
+                & ff_T2 = in.ff_T2,
+                & ff_T3 = in.ff_T3,
 
                 kin_tensor_1 = norm_s / m_Kstar() * ((m_B2 + 3.0 * m_K2 - s) * ff_T2 - lam(s) / m2_diff * ff_T3),
                 kin_tensor_2 = 2.0 * norm_s * sqrt_lam / sqrt_s * ff_T1,
@@ -805,11 +943,12 @@ namespace eos
         // cf. [BHvD2012] for tensor amplitudes
         // use full QCD form factors in leading QCDF (naively factorizing) amplitudes
         // use soft form factors in non-factorizable contributions (~ alpha_s)
-        Amplitudes amp_ABBBSW2008(const double & s) const
+        Amplitudes amp_ABBBSW2008(const HadronicInputs & in, const Variant & v) const
         {
             Amplitudes result;
 
-            WilsonCoefficients<BToS> wc = wilson_coefficients();
+            const double & s = in.s;
+            const WilsonCoefficients<BToS> & wc = v.wc;
 
             const double
                 shat = s_hat(s),
@@ -820,24 +959,20 @@ namespace eos
                 m_sum = m_B() + m_Kstar(),
                 m_diff = m_B() - m_Kstar(),
                 m2_diff = m_B2 - m_K2,
-                norm_s = this->norm(s),
+                norm_s = this->norm(s, v.m_l),
                 sqrt_lam = std::sqrt(lam(s));
 
             const double
-                ff_V   = form_factors->v(s),
-                ff_A0  = form_factors->a_0(s),
-                ff_A1  = form_factors->a_1(s),
-                ff_A2  = form_factors->a_2(s),
-                ff_T1  = form_factors->t_1(s),
-                ff_T2  = form_factors->t_2(s),
-                ff_T3  = form_factors->t_3(s);
-
-            const double
-                m_c_pole = model->m_c_pole(),
-                m_b_PS = this->m_b_PS();
-
-            complex<double> lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
-            if (cp_conjugate)
+                & ff_V  = in.ff_V,
+                & ff_A0 = in.ff_A0,
+                & ff_A1 = in.ff_A1,
+                & ff_A2 = in.ff_A2,
+                & ff_T1 = in.ff_T1,
+                & ff_T2 = in.ff_T2,
+                & ff_T3 = in.ff_T3;
+
+            complex<double> lambda_hat_u = in.lambda_hat_u;
+            if (v.cp_conjugate)
                 lambda_hat_u = std::conj(lambda_hat_u);
 
             /* Y(s) for the up and the top sector for effective Wilson coefficients */
@@ -850,12 +985,12 @@ namespace eos
 
             // Use b pole mass according to [BFS2001], Sec. 3.1, paragraph Quark Masses,
             // then replace b pole mass by the PS mass.
-            complex<double> Y_top = Y_top_c * CharmLoops::h(mu, s, m_c_pole)
-                 + Y_top_b * CharmLoops::h(mu, s, m_b_PS)
-                 + Y_top_0 * CharmLoops::h(mu, s)
+            complex<double> Y_top = Y_top_c * in.h_c
+                 + Y_top_b * in.h_b
+                 + Y_top_0 * in.h_0
                  + Y_top_;
             // cf. [BFS2004], Eq. (43), p. 24
-            complex<double> Y_up = (4.0 / 3.0 * wc.c1() + wc.c2()) * (CharmLoops::h(mu, s, m_c_pole) - CharmLoops::h(mu, s));
+            complex<double> Y_up = (4.0 / 3.0 * wc.c1() + wc.c2()) * (in.h_c - in.h_0);
 
             const complex<double>
                 // cf. [BFS2001], below Eq. (9), p. 4
@@ -898,7 +1033,7 @@ namespace eos
             // timelike amplitude
             result.a_timelike = norm_s * sqrt_lam / sqrt_s
                 * (2.0 * (wc.c10() - wc.c10prime())
-                   + s / m_l / (m_b_MSbar + m_s_MSbar) * (wc.cP() - wc.cPprime()))
+                   + s / v.m_l / (m_b_MSbar + m_s_MSbar) * (wc.cP() - wc.cPprime()))
                 * ff_A0;
 
             // scalar amplitude
@@ -926,7 +1061,7 @@ namespace eos
             // Beyond Naive factorization part - from QCDF
             //
 
-            DipoleFormFactors dff = calT_ABBBSW2008(s, wc);
+            DipoleFormFactors dff = calT_ABBBSW2008(in, v);
 
             // these kinematical factors reduce for mKstar = 0 to [ABBBSW2008] eq. (3.46)
 #if 0
@@ -965,19 +1100,24 @@ namespace eos
             return result;
         }
 
-        Amplitudes amplitudes(const double & s) const
+        Amplitudes amplitudes(const HadronicInputs & in, const Variant & v) const
         {
             Amplitudes amp;
 
             if (ff_relation == "BFS2004")
-                amp = amp_BFS2004(s);
+                amp = amp_BFS2004(in, v);
             else if (ff_relation == "ABBBSW2008")
-                amp = amp_ABBBSW2008(s);
+                amp = amp_ABBBSW2008(in, v);
             else
                 throw InvalidOptionValueError("large-recoil-ff", ff_relation, "BFS2004, ABBBSW2008");
             return amp;
         }
 
+        Amplitudes amplitudes(const double & s) const
+        {
+            return amplitudes(hadronic_inputs(s), variant());
+        }
+
         std::array<double, 12> differential_angular_coefficients_array(const double & s) const
         {
             return angular_coefficients_array(amplitudes(s), s, m_l());
@@ -990,13 +1130,55 @@ namespace eos
 
         AngularCoefficients integrated_angular_coefficients(const double & s_min, const double & s_max) const
         {
-            std::function<std::array<double, 12> (const double &)> integrand =
-                    std::bind(&Implementation<BToKstarDilepton<LargeRecoil>>::differential_angular_coefficients_array, this, std::placeholders::_1);
+            std::function<std::array<double, 12> (const double &)> integrand = [this] (const double & s)
+            {
+                return this->differential_angular_coefficients_array(s);
+            };
             std::array<double, 12> integrated_angular_coefficients_array = integrate1D(integrand, 64, s_min, s_max);
 
             return array_to_angular_coefficients(integrated_angular_coefficients_array);
         }
 
+        // angular coefficients of several variants, concatenated; the hadronic inputs are evaluated only once
+        template <std::size_t n_>
+        std::array<double, 12 * n_> differential_angular_coefficients_array(const double & s, const std::array<Variant, n_> & variants) const
+        {
+            const HadronicInputs in = hadronic_inputs(s);
+
+            std::array<double, 12 * n_> result;
+            for (std::size_t i = 0 ; i < n_ ; ++i)
+            {
+                const std::array<double, 12> a_c = angular_coefficients_array(amplitudes(in, variants[i]), s, variants[i].m_l);
+                std::copy(a_c.cbegin(), a_c.cend(), result.begin() + 12 * i);
+            }
+
+            return result;
+        }
+
+        std::array<AngularCoefficients, 2> differential_angular_coefficients(const double & s, const std::array<Variant, 2> & variants) const
+        {
+            return split_angular_coefficients(differential_angular_coefficients_array<2>(s, variants));
+        }
+
+        std::array<AngularCoefficients, 2> integrated_angular_coefficients(const double & s_min, const double & s_max, const std::array<Variant, 2> & variants) const
+        {
+            std::function<std::array<double, 24> (const double &)> integrand = [&] (const double & s)
+            {
+                return this->differential_angular_coefficients_array<2>(s, variants);
+            };
+
+            return split_angular_coefficients(integrate1D(integrand, 64, s_min, s_max));
+        }
+
+        static std::array<AngularCoefficients, 2> split_angular_coefficients(const std::array<double, 24> & a_c)
+        {
+            std::array<double, 12> first, second;
+            std::copy(a_c.cbegin(), a_c.cbegin() + 12, first.begin());
+            std::copy(a_c.cbegin() + 12, a_c.cend(), second.begin());
+
+            return std::array<AngularCoefficients, 2>{{ array_to_angular_coefficients(first), array_to_angular_coefficients(second) }};
+        }
+
         double a_fb_zero_crossing() const
         {
             // We trust QCDF results in a validity range from 0.5 GeV^2 < s < 6.0 GeV^2
@@ -1235,11 +1417,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_p_prime_4(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->differential_angular_coefficients(s, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         // cf. [DMRV2012], p. 9, eq. (15)
         return (a_c.j4 + a_c_bar.j4) / std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s));
@@ -1248,11 +1427,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_p_prime_5(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->differential_angular_coefficients(s, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         // cf. [DMRV2012], p. 9, eq. (16)
         return (a_c.j5 + a_c_bar.j5) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1261,11 +1437,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_p_prime_6(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->differential_angular_coefficients(s, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         // cf. [DMRV2012], p. 9, eq. (17)
         return -1.0 * (a_c.j7 + a_c_bar.j7) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1371,11 +1544,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_3_normalized_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->differential_angular_coefficients(s, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j3 + a_c_bar.j3) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1411,11 +1581,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_6c_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->differential_angular_coefficients(s, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return 0.5 * (a_c.j6c + a_c_bar.j6c);
     }
@@ -1451,11 +1618,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_9_normalized_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->differential_angular_coefficients(s, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j9 + a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1463,11 +1627,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_1c_plus_j_2c_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->differential_angular_coefficients(s, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return 0.5 * (a_c.j1c + a_c_bar.j1c + a_c.j2c + a_c_bar.j2c);
     }
@@ -1475,11 +1636,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_j_1s_minus_3j_2s_cp_averaged(const double & s) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->differential_angular_coefficients(s);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->differential_angular_coefficients(s);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->differential_angular_coefficients(s, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return 0.5 * (a_c.j1s + a_c_bar.j1s - 3.0 * (a_c.j2s + a_c_bar.j2s));
     }
@@ -1487,89 +1645,37 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::differential_d_4(const double & s) const
     {
-        double J4_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
-
-            J4_electrons = differential_j_4(s);
-        }
-
-        double J4_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-
-            J4_muons = differential_j_4(s);
-        }
+        const std::array<AngularCoefficients, 2> a_c_lf = _imp->differential_angular_coefficients(s, _imp->lepton_flavour_variants());
+        const AngularCoefficients & a_c_electrons = a_c_lf[0], & a_c_muons = a_c_lf[1];
 
-        return 4.0 / 3.0 * (J4_electrons - J4_muons) * _imp->tau() / _imp->hbar();
+        return 4.0 / 3.0 * (a_c_electrons.j4 - a_c_muons.j4) * _imp->tau() / _imp->hbar();
     }
 
     double
     BToKstarDilepton<LargeRecoil>::differential_d_5(const double & s) const
     {
-        double J5_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
-
-            J5_electrons = differential_j_5(s);
-        }
-
-        double J5_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-
-            J5_muons = differential_j_5(s);
-        }
+        const std::array<AngularCoefficients, 2> a_c_lf = _imp->differential_angular_coefficients(s, _imp->lepton_flavour_variants());
+        const AngularCoefficients & a_c_electrons = a_c_lf[0], & a_c_muons = a_c_lf[1];
 
-        return 3.0 / 4.0 * (J5_electrons - J5_muons) * _imp->tau() / _imp->hbar();
+        return 3.0 / 4.0 * (a_c_electrons.j5 - a_c_muons.j5) * _imp->tau() / _imp->hbar();
     }
 
     double
     BToKstarDilepton<LargeRecoil>::differential_d_6s(const double & s) const
     {
-        double J6s_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+        const std::array<AngularCoefficients, 2> a_c_lf = _imp->differential_angular_coefficients(s, _imp->lepton_flavour_variants());
+        const AngularCoefficients & a_c_electrons = a_c_lf[0], & a_c_muons = a_c_lf[1];
 
-            J6s_electrons = differential_j_6s(s);
-        }
-
-        double J6s_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-
-            J6s_muons = differential_j_6s(s);
-        }
-
-        return 3.0 / 4.0 * (J6s_electrons - J6s_muons) * _imp->tau() / _imp->hbar();
+        return 3.0 / 4.0 * (a_c_electrons.j6s - a_c_muons.j6s) * _imp->tau() / _imp->hbar();
     }
 
     double
     BToKstarDilepton<LargeRecoil>::differential_ratio_muons_electrons(const double & s) const
     {
-        double gamma_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+        const std::array<AngularCoefficients, 2> a_c_lf = _imp->differential_angular_coefficients(s, _imp->lepton_flavour_variants());
+        const AngularCoefficients & a_c_electrons = a_c_lf[0], & a_c_muons = a_c_lf[1];
 
-            gamma_electrons = differential_decay_width(s);
-        }
-
-        double gamma_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-
-            gamma_muons = differential_decay_width(s);
-        }
-
-        return gamma_muons / gamma_electrons;
+        return decay_width(a_c_muons) / decay_width(a_c_electrons);
     }
 
     double
@@ -1588,23 +1694,19 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_branching_ratio_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        double br = integrated_branching_ratio(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double br_bar = integrated_branching_ratio(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
-        return 0.5 * (br + br_bar);
+        return 0.5 * (decay_width(a_c) + decay_width(a_c_bar)) * _imp->tau() / _imp->hbar();
     }
 
     double
     BToKstarDilepton<LargeRecoil>::integrated_cp_asymmetry(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
-        double gamma = integrated_decay_width(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double gamma_bar = integrated_decay_width(s_min, s_max);
+        const double gamma = decay_width(a_c), gamma_bar = decay_width(a_c_bar);
 
         return (gamma - gamma_bar) / (gamma + gamma_bar);
     }
@@ -1635,11 +1737,13 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_forward_backward_asymmetry_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        // cf. [BHvD2012], eq. (A7)
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
-        double a_fb = integrated_forward_backward_asymmetry(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double a_fb_bar = integrated_forward_backward_asymmetry(s_min, s_max);
+        const double
+            a_fb     = (a_c.j6s + 0.5 * a_c.j6c) / decay_width(a_c),
+            a_fb_bar = (a_c_bar.j6s + 0.5 * a_c_bar.j6c) / decay_width(a_c_bar);
 
         return 0.5 * (a_fb + a_fb_bar);
     }
@@ -1655,11 +1759,13 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_longitudinal_polarisation_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        // cf. [BHvD2012], eq. (A9)
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
-        double f_l = integrated_longitudinal_polarisation(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double f_l_bar = integrated_longitudinal_polarisation(s_min, s_max);
+        const double
+            f_l     = (a_c.j1c - a_c.j2c / 3.0) / decay_width(a_c),
+            f_l_bar = (a_c_bar.j1c - a_c_bar.j2c / 3.0) / decay_width(a_c_bar);
 
         return 0.5 * (f_l + f_l_bar);
     }
@@ -1675,11 +1781,13 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_transversal_polarisation_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
+        // cf. [BHvD2012], eq. (A10)
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
-        double f_t = integrated_transversal_polarisation(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double f_t_bar = integrated_transversal_polarisation(s_min, s_max);
+        const double
+            f_t     = 2.0 * (a_c.j1s - a_c.j2s / 3.0) / decay_width(a_c),
+            f_t_bar = 2.0 * (a_c_bar.j1s - a_c_bar.j2s / 3.0) / decay_width(a_c_bar);
 
         return 0.5 * (f_t + f_t_bar);
     }
@@ -1696,11 +1804,12 @@ namespace eos
     BToKstarDilepton<LargeRecoil>::integrated_transverse_asymmetry_2_cp_averaged(const double & s_min, const double & s_max) const
     {
         // cf. [BHvD2010], eq. (2.10), p. 6
-        Save<bool> save(_imp->cp_conjugate, false);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
-        double a_t_2 = integrated_transverse_asymmetry_2(s_min, s_max);
-        _imp->cp_conjugate = true;
-        double a_t_2_bar = integrated_transverse_asymmetry_2(s_min, s_max);
+        const double
+            a_t_2     = 0.5 * a_c.j3 / a_c.j2s,
+            a_t_2_bar = 0.5 * a_c_bar.j3 / a_c_bar.j2s;
 
         return 0.5 * (a_t_2 + a_t_2_bar);
     }
@@ -1752,11 +1861,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_p_prime_4(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         // cf. [DMRV2012], p. 9, eq. (15)
         return (a_c.j4 + a_c_bar.j4) / std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s));
@@ -1765,11 +1871,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_p_prime_5(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         // cf. [DMRV2012], p. 9, eq. (16)
         return (a_c.j5 + a_c_bar.j5) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1778,11 +1881,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_p_prime_6(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         // cf. [DMRV2012], p. 9, eq. (17)
         return -1.0 * (a_c.j7 + a_c_bar.j7) / (2.0 * std::sqrt(-1.0 * (a_c.j2c + a_c_bar.j2c) * (a_c.j2s + a_c_bar.j2s)));
@@ -1878,11 +1978,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_3_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j3 + a_c_bar.j3) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1897,11 +1994,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_4_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j4 + a_c_bar.j4) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1916,11 +2010,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_5_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j5 + a_c_bar.j5) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1949,11 +2040,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_7_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j7 + a_c_bar.j7) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1968,11 +2056,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_8_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j8 + a_c_bar.j8) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -1994,11 +2079,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_j_9_normalized_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j9 + a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -2006,11 +2088,8 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_a_9(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-
-        AngularCoefficients a_c = _imp->integrated_angular_coefficients(s_min, s_max);
-        _imp->cp_conjugate = true;
-        AngularCoefficients a_c_bar = _imp->integrated_angular_coefficients(s_min, s_max);
+        const std::array<AngularCoefficients, 2> a_c_cp = _imp->integrated_angular_coefficients(s_min, s_max, _imp->cp_variants());
+        const AngularCoefficients & a_c = a_c_cp[0], & a_c_bar = a_c_cp[1];
 
         return (a_c.j9 - a_c_bar.j9) / (decay_width(a_c) + decay_width(a_c_bar));
     }
@@ -2018,90 +2097,37 @@ namespace eos
     double
     BToKstarDilepton<LargeRecoil>::integrated_d_4(const double & s_min, const double & s_max) const
     {
-        double J4_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+        const std::array<AngularCoefficients, 2> a_c_lf = _imp->integrated_angular_coefficients(s_min, s_max, _imp->lepton_flavour_variants());
+        const AngularCoefficients & a_c_electrons = a_c_lf[0], & a_c_muons = a_c_lf[1];
 
-            J4_electrons = integrated_j_4(s_min, s_max);
-        }
-
-        double J4_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-
-            J4_muons = integrated_j_4(s_min, s_max);
-        }
-
-        return 3.0 / 4.0 * (J4_electrons - J4_muons) * _imp->tau() / _imp->hbar();
+        return 3.0 / 4.0 * (a_c_electrons.j4 - a_c_muons.j4) * _imp->tau() / _imp->hbar();
     }
 
     double
     BToKstarDilepton<LargeRecoil>::integrated_d_5(const double & s_min, const double & s_max) const
     {
-        double J5_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+        const std::array<AngularCoefficients, 2> a_c_lf = _imp->integrated_angular_coefficients(s_min, s_max, _imp->lepton_flavour_variants());
+        const AngularCoefficients & a_c_electrons = a_c_lf[0], & a_c_muons = a_c_lf[1];
 
-            J5_electrons = integrated_j_5(s_min, s_max);
-        }
-
-        double J5_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-
-            J5_muons = integrated_j_5(s_min, s_max);
-        }
-
-        return 3.0 / 4.0 * (J5_electrons - J5_muons) * _imp->tau() / _imp->hbar();
+        return 3.0 / 4.0 * (a_c_electrons.j5 - a_c_muons.j5) * _imp->tau() / _imp->hbar();
     }
 
     double
     BToKstarDilepton<LargeRecoil>::integrated_d_6s(const double & s_min, const double & s_max) const
     {
-        double J6s_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
+        const std::array<AngularCoefficients, 2> a_c_lf = _imp->integrated_angular_coefficients(s_min, s_max, _imp->lepton_flavour_variants());
+        const AngularCoefficients & a_c_electrons = a_c_lf[0], & a_c_muons = a_c_lf[1];
 
-            J6s_electrons = integrated_j_6s(s_min, s_max);
-        }
-
-        double J6s_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-
-            J6s_muons = integrated_j_6s(s_min, s_max);
-        }
-
-        return 3.0 / 4.0 * (J6s_electrons - J6s_muons) * _imp->tau() / _imp->hbar();
+        return 3.0 / 4.0 * (a_c_electrons.j6s - a_c_muons.j6s) * _imp->tau() / _imp->hbar();
     }
 
     double
     BToKstarDilepton<LargeRecoil>::integrated_ratio_muons_electrons(const double & s_min, const double & s_max) const
     {
-        std::function<double (const double &)> integrand = std::bind(std::mem_fn(&BToKstarDilepton<LargeRecoil>::differential_branching_ratio),
-                this, std::placeholders::_1);
+        const std::array<AngularCoefficients, 2> a_c_lf = _imp->integrated_angular_coefficients(s_min, s_max, _imp->lepton_flavour_variants());
+        const AngularCoefficients & a_c_electrons = a_c_lf[0], & a_c_muons = a_c_lf[1];
 
-        double br_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
-            br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
-        }
-
-        double br_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-            br_muons = integrate<GSL::QNG>(integrand, s_min, s_max);
-        }
-
-        return br_muons / br_electrons;
+        return decay_width(a_c_muons) / decay_width(a_c_electrons);
     }
 
     double
@@ -2225,8 +2251,24 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
 
         bool cp_conjugate;
 
+        // lepton masses for the tests of lepton-flavour universality
+        UsedParameter m_e, m_mu;
+
         std::shared_ptr<FormFactors<PToP>> form_factors;
 
+        /*
+         * One variant of the decay, i.e., B or Bbar decaying to a given lepton flavour,
+         * together with the matching Wilson coefficients.
+         */
+        struct Variant
+        {
+            WilsonCoefficients<BToS> wc;
+
+            bool cp_conjugate;
+
+            double m_l;
+        };
+
         Implementation(const Parameters & p, const Options & o, ParameterUser & u) :
             parameters(p),
             model(Model::make(o.get("model", "SM"), p, o)),
@@ -2250,7 +2292,9 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
             sl_phase_psd(p["B->Pll::sl_phase_pseudo@LargeRecoil"], u),
             e_q(-1.0/3.0),
             lepton_flavour(o.get("l", "mu")),
-            cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false")))
+            cp_conjugate(destringify<bool>(o.get("cp-conjugate", "false"))),
+            m_e(p["mass::e"], u),
+            m_mu(p["mass::mu"], u)
         {
             form_factors = FormFactorFactory<PToP>::create("B->K@" + o.get("form-factors", "KMPW2010"), p);
 
@@ -2277,12 +2321,30 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
                 throw InternalError("Unsupported spectator quark");
         }
 
-        WilsonCoefficients<BToS> wilson_coefficients() const
+        Variant variant(const bool & cp_conjugate, const std::string & lepton_flavour, const double & m_l) const
         {
-            return model->wilson_coefficients_b_to_s(lepton_flavour, cp_conjugate);
+            return Variant{ model->wilson_coefficients_b_to_s(lepton_flavour, cp_conjugate), cp_conjugate, m_l };
         }
 
-        complex<double> calT(const double & s) const
+        // the variant selected by the options
+        Variant variant() const
+        {
+            return variant(cp_conjugate, lepton_flavour, m_l());
+        }
+
+        // the B and Bbar decays, for CP averages and asymmetries
+        std::array<Variant, 2> cp_variants() const
+        {
+            return std::array<Variant, 2>{{ variant(false, lepton_flavour, m_l()), variant(true, lepton_flavour, m_l()) }};
+        }
+
+        // the decays to muons and to electrons, for tests of lepton-flavour universality
+        std::array<Variant, 2> lepton_flavour_variants() const
+        {
+            return std::array<Variant, 2>{{ variant(cp_conjugate, "mu", m_mu()), variant(cp_conjugate, "e", m_e()) }};
+        }
+
+        complex<double> calT(const Variant & v, const double & s) const
         {
             // charges of down- and up-type quarks
             static const double e_d = -1.0 / 3.0;
@@ -2303,9 +2365,9 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
             double alpha_s_mu_f = model->alpha_s(std::sqrt(mu() * 0.5)); // alpha_s at the factorization scale
             double a_mu_f = alpha_s_mu_f * QCD::casimir_f / 4.0 / M_PI;
             complex<double> lambda_hat_u = (model->ckm_ub() * conj(model->ckm_us())) / (model->ckm_tb() * conj(model->ckm_ts()));
-            if (cp_conjugate)
+            if (v.cp_conjugate)
                 lambda_hat_u = std::conj(lambda_hat_u);
-            WilsonCoefficients<BToS> wc = wilson_coefficients();
+            const WilsonCoefficients<BToS> & wc = v.wc;
 
             // Compute the QCDF Integrals
             double invm1_psd = 3.0 * (1.0 + a_1 + a_2); // <ubar^-1>
@@ -2435,9 +2497,9 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
             return model->m_b_ps(mu_f());
         }
 
-        double beta_l(const double & s) const
+        double beta_l(const Variant & v, const double & s) const
         {
-            return std::sqrt(1.0 - 4.0 * m_l * m_l / s);
+            return std::sqrt(1.0 - 4.0 * v.m_l * v.m_l / s);
         }
 
         double lam(const double & s) const
@@ -2463,28 +2525,28 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
         }
 
         // cf. [BHP2007], Eq. (3.2), p. 3
-        std::complex<double> F_A(const WilsonCoefficients<BToS> & wc, const double &) const
+        std::complex<double> F_A(const Variant & v, const double &) const
         {
-            return wc.c10() + wc.c10prime();
+            return v.wc.c10() + v.wc.c10prime();
         }
 
-        double F_Tkin(const double & s) const
+        double F_Tkin(const Variant & v, const double & s) const
         {
-            double result = 2.0 * std::sqrt(lam(s)) * beta_l(s) / (m_B() + m_K());
+            double result = 2.0 * std::sqrt(lam(s)) * beta_l(v, s) / (m_B() + m_K());
             result *= f_t_over_f_p(s);
             return result;
         }
 
         // cf. [BHP2007], Eq. (3.2), p. 3
-        std::complex<double> F_T(const WilsonCoefficients<BToS> & wc, const double & s) const
+        std::complex<double> F_T(const Variant & v, const double & s) const
         {
-            return F_Tkin(s) * wc.cT();
+            return F_Tkin(v, s) * v.wc.cT();
         }
 
         // cf. [BHP2007], Eq. (3.2), p. 3
-        std::complex<double> F_T5(const WilsonCoefficients<BToS> & wc, const double & s) const
+        std::complex<double> F_T5(const Variant & v, const double & s) const
         {
-            return F_Tkin(s) * wc.cT5();
+            return F_Tkin(v, s) * v.wc.cT5();
         }
 
         double F_Skin(const double & s) const
@@ -2495,94 +2557,140 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
         }
 
         // cf. [BHP2007], Eq. (3.2), p. 4
-        std::complex<double> F_S(const WilsonCoefficients<BToS> & wc, const double & s) const
+        std::complex<double> F_S(const Variant & v, const double & s) const
         {
-            return F_Skin(s) * (wc.cS() + wc.cSprime());
+            return F_Skin(s) * (v.wc.cS() + v.wc.cSprime());
         }
 
         // cf. [BHP2007], Eq. (3.2), p. 4
-        std::complex<double> F_P(const WilsonCoefficients<BToS> & wc, const double & s) const
+        std::complex<double> F_P(const Variant & v, const double & s) const
         {
-            return F_Skin(s) * (wc.cP() + wc.cPprime()) + m_l() * (wc.c10() + wc.c10prime()) *
+            const WilsonCoefficients<BToS> & wc = v.wc;
+
+            return F_Skin(s) * (wc.cP() + wc.cPprime()) + v.m_l * (wc.c10() + wc.c10prime()) *
                     ((m_B() * m_B() - m_K() * m_K()) / s * (f_0_over_f_p(s) - 1.0) - 1.0);
         }
 
         // cf. [BHP2007], Eq. (3.2), p. 4
-        std::complex<double> F_V(const WilsonCoefficients<BToS> & wc, const double & s) const
+        std::complex<double> F_V(const Variant & v, const double & s) const
         {
+            const WilsonCoefficients<BToS> & wc = v.wc;
+
             std::complex<double> result = wc.c9() + wc.c9prime();
             result += 2.0 * m_b_PS() / m_B() / xi_pseudo(s) *
-                      (calT(s) + lambda_psd / m_B * std::polar(1.0, sl_phase_psd()));
-            result += 8.0 * m_l / (m_B() + m_K()) * f_t_over_f_p(s) * wc.cT();
+                      (calT(v, s) + lambda_psd / m_B * std::polar(1.0, sl_phase_psd()));
+            result += 8.0 * v.m_l / (m_B() + m_K()) * f_t_over_f_p(s) * wc.cT();
             return result;
         }
 
         // cf. [BHP2007], Eqs. (4.2), (4.4), (4.5), p. 5
-        double N(const double & s) const
+        double N(const Variant & v, const double & s) const
         {
             double lambda_t = abs(model->ckm_tb() * conj(model->ckm_ts()));
 
-            return power_of<2>(g_fermi * alpha_e() * lambda_t) * std::sqrt(lam(s)) * beta_l(s) * xi_pseudo(s) * xi_pseudo(s) /
+            return power_of<2>(g_fermi * alpha_e() * lambda_t) * std::sqrt(lam(s)) * beta_l(v, s) * xi_pseudo(s) * xi_pseudo(s) /
                     (512.0 * power_of<5>(M_PI) * power_of<3>(m_B()));
         }
 
         // cf. [BHP2007], Eq. (4.2)
-        double a_l(const WilsonCoefficients<BToS> & wc, const double & s) const
+        double a_l(const Variant & v, const double & s) const
         {
-            double result = s * (power_of<2>(beta_l(s)) * std::norm(F_S(wc, s)) + std::norm(F_P(wc, s)));
-            result += 0.25 * lam(s) * (std::norm(F_A(wc, s)) + std::norm(F_V(wc, s)));
-            result += 2.0 * m_l * (m_B() * m_B() - m_K() * m_K() + s) * std::real(F_P(wc, s) * std::conj(F_A(wc, s)));
-            result += 4.0 * m_l * m_l * m_B() * m_B() * std::norm(F_A(wc, s));
+            const double beta_l = this->beta_l(v, s);
 
-            return N(s) * result;
+            double result = s * (power_of<2>(beta_l) * std::norm(F_S(v, s)) + std::norm(F_P(v, s)));
+            result += 0.25 * lam(s) * (std::norm(F_A(v, s)) + std::norm(F_V(v, s)));
+            result += 2.0 * v.m_l * (m_B() * m_B() - m_K() * m_K() + s) * std::real(F_P(v, s) * std::conj(F_A(v, s)));
+            result += 4.0 * v.m_l * v.m_l * m_B() * m_B() * std::norm(F_A(v, s));
+
+            return N(v, s) * result;
         }
 
         // cf. [BHP2007], Eq. (4.3)
-        double b_l(const WilsonCoefficients<BToS> & wc, const double & s) const
+        double b_l(const Variant & v, const double & s) const
         {
-            double result = s * (power_of<2>(beta_l(s)) * std::real(F_S(wc, s) * std::conj(F_T(wc, s)))
-                                 + std::real(F_P(wc, s) * std::conj(F_T5(wc, s))));
-            result += m_l * (std::sqrt(lam(s)) * beta_l(s) * std::real(F_S(wc, s) * std::conj(F_V(wc, s)))
-                             + (m_B() * m_B() - m_K() * m_K() + s) * std::real(F_T5(wc, s) * std::conj(F_A(wc, s))));
+            const double beta_l = this->beta_l(v, s);
+
+            double result = s * (power_of<2>(beta_l) * std::real(F_S(v, s) * std::conj(F_T(v, s)))
+                                 + std::real(F_P(v, s) * std::conj(F_T5(v, s))));
+            result += v.m_l * (std::sqrt(lam(s)) * beta_l * std::real(F_S(v, s) * std::conj(F_V(v, s)))
+                             + (m_B() * m_B() - m_K() * m_K() + s) * std::real(F_T5(v, s) * std::conj(F_A(v, s))));
 
-            return 2.0 * N(s) * result;
+            return 2.0 * N(v, s) * result;
         }
 
         // cf. [BHP2007], Eq. (4.4)
-        double c_l(const WilsonCoefficients<BToS> & wc, const double & s) const
+        double c_l(const Variant & v, const double & s) const
         {
-            double result = s * (power_of<2>(beta_l(s)) * std::norm(F_T(wc, s)) + std::norm(F_T5(wc, s)));
-            result -= 0.25 * lam(s) * power_of<2>(beta_l(s)) * (std::norm(F_A(wc, s)) + std::norm(F_V(wc, s)));
-            result += 2.0 * m_l * std::sqrt(lam(s)) * beta_l(s) * std::real(F_T(wc, s) * std::conj(F_V(wc, s)));
-            return N(s) * result;
+            const double beta_l = this->beta_l(v, s);
+
+            double result = s * (power_of<2>(beta_l) * std::norm(F_T(v, s)) + std::norm(F_T5(v, s)));
+            result -= 0.25 * lam(s) * power_of<2>(beta_l) * (std::norm(F_A(v, s)) + std::norm(F_V(v, s)));
+            result += 2.0 * v.m_l * std::sqrt(lam(s)) * beta_l * std::real(F_T(v, s) * std::conj(F_V(v, s)));
+            return N(v, s) * result;
         }
 
         // cf. [BHP2007], Eq. (4.8)
+        double unnormalized_decay_width(const Variant & v, const double & s) const
+        {
+            return 2.0 * (a_l(v, s) + c_l(v, s) / 3.0);
+        }
+
         double unnormalized_decay_width(const double & s) const
         {
-            WilsonCoefficients<BToS> wc = wilson_coefficients();
+            return unnormalized_decay_width(variant(), s);
+        }
 
-            return 2.0 * (a_l(wc, s) + c_l(wc, s) / 3.0);
+        double differential_branching_ratio(const Variant & v, const double & s) const
+        {
+            return unnormalized_decay_width(v, s) * tau() / hbar();
         }
 
         double differential_branching_ratio(const double & s) const
         {
-            return unnormalized_decay_width(s) * tau() / hbar();
+            return differential_branching_ratio(variant(), s);
         }
 
         // cf. [BHP2007], Eq. (4.9)
         double differential_flat_term_numerator(const double & s) const
         {
-            WilsonCoefficients<BToS> wc = wilson_coefficients();
+            const Variant v = variant();
 
-            return 2.0 * (a_l(wc, s) + c_l(wc, s));
+            return 2.0 * (a_l(v, s) + c_l(v, s));
         }
 
         double differential_forward_backward_asymmetry_numerator(const double & s) const
         {
-            WilsonCoefficients<BToS> wc = wilson_coefficients();
+            return b_l(variant(), s);
+        }
+
+        // numerator of F_H and the unnormalized decay width at one point, cf. [BHP2007], Eqs. (4.8)-(4.9)
+        std::array<double, 2> differential_flat_term_components(const Variant & v, const double & s) const
+        {
+            double a = a_l(v, s), c = c_l(v, s);
+
+            return std::array<double, 2>{{ 2.0 * (a + c), 2.0 * (a + c / 3.0) }};
+        }
+
+        // numerator of A_FB and the unnormalized decay width at one point
+        std::array<double, 2> differential_forward_backward_asymmetry_components(const Variant & v, const double & s) const
+        {
+            return std::array<double, 2>{{ b_l(v, s), 2.0 * (a_l(v, s) + c_l(v, s) / 3.0) }};
+        }
 
-            return b_l(wc, s);
+        // sum of the components of B and Bbar decays at one point
+        std::array<double, 2> cp_summed(std::array<double, 2> (Implementation::* components)(const Variant &, const double &) const,
+                const std::array<Variant, 2> & variants, const double & s) const
+        {
+            std::array<double, 2> result = (this->*components)(variants[0], s);
+            std::array<double, 2> result_bar = (this->*components)(variants[1], s);
+
+            return std::array<double, 2>{{ result[0] + result_bar[0], result[1] + result_bar[1] }};
+        }
+
+        // branching ratios of two variants at one point, e.g. of B and Bbar decays, or of the decays to muons and electrons
+        std::array<double, 2> differential_branching_ratio_pair(const std::array<Variant, 2> & variants, const double & s) const
+        {
+            return std::array<double, 2>{{ differential_branching_ratio(variants[0], s), differential_branching_ratio(variants[1], s) }};
         }
     };
 
@@ -2598,64 +2706,64 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
     std::complex<double>
     BToKDilepton<LargeRecoil>::F_A(const double & s) const
     {
-        return _imp->F_A(_imp->wilson_coefficients(), s);
+        return _imp->F_A(_imp->variant(), s);
     }
 
     std::complex<double>
     BToKDilepton<LargeRecoil>::F_V(const double & s) const
     {
-        return _imp->F_V(_imp->wilson_coefficients(), s);
+        return _imp->F_V(_imp->variant(), s);
     }
 
     std::complex<double>
     BToKDilepton<LargeRecoil>::F_S(const double & s) const
     {
-        return _imp->F_S(_imp->wilson_coefficients(), s);
+        return _imp->F_S(_imp->variant(), s);
     }
 
     std::complex<double>
     BToKDilepton<LargeRecoil>::F_P(const double & s) const
     {
-        return _imp->F_P(_imp->wilson_coefficients(), s);
+        return _imp->F_P(_imp->variant(), s);
     }
 
     std::complex<double>
     BToKDilepton<LargeRecoil>::F_T(const double & s) const
     {
-        return _imp->F_T(_imp->wilson_coefficients(), s);
+        return _imp->F_T(_imp->variant(), s);
     }
 
     std::complex<double>
     BToKDilepton<LargeRecoil>::F_T5(const double & s) const
     {
-        return _imp->F_T5(_imp->wilson_coefficients(), s);
+        return _imp->F_T5(_imp->variant(), s);
     }
 
     double
     BToKDilepton<LargeRecoil>::a_l(const double & s) const
     {
-        return _imp->a_l(_imp->wilson_coefficients(), s);
+        return _imp->a_l(_imp->variant(), s);
     }
 
     double
     BToKDilepton<LargeRecoil>::b_l(const double & s) const
     {
-        return _imp->b_l(_imp->wilson_coefficients(), s);
+        return _imp->b_l(_imp->variant(), s);
     }
 
     double
     BToKDilepton<LargeRecoil>::c_l(const double & s) const
     {
-        return _imp->c_l(_imp->wilson_coefficients(), s);
+        return _imp->c_l(_imp->variant(), s);
     }
 
     double
     BToKDilepton<LargeRecoil>::two_differential_decay_width(const double & s, const double & c_theta_l) const
     {
-        auto wc = _imp->wilson_coefficients();
+        const auto v = _imp->variant();
 
         // cf. [BHP2007], Eq. (4.1)
-        return _imp->a_l(wc, s) + _imp->b_l(wc, s) * c_theta_l + _imp->c_l(wc, s) * c_theta_l * c_theta_l;
+        return _imp->a_l(v, s) + _imp->b_l(v, s) * c_theta_l + _imp->c_l(v, s) * c_theta_l * c_theta_l;
     }
 
     double
@@ -2679,29 +2787,17 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
     double
     BToKDilepton<LargeRecoil>::differential_ratio_muons_electrons(const double & s) const
     {
-        double br_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
-            br_electrons = BToKDilepton<LargeRecoil>::differential_branching_ratio(s);
-        }
+        std::array<double, 2> br = _imp->differential_branching_ratio_pair(_imp->lepton_flavour_variants(), s);
 
-        double br_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-            br_muons = BToKDilepton<LargeRecoil>::differential_branching_ratio(s);
-        }
-
-        return br_muons / br_electrons;
+        return br[0] / br[1];
     }
 
     // Integrated Observables
     double
     BToKDilepton<LargeRecoil>::integrated_decay_width(const double & s_min, const double & s_max) const
     {
-        std::function<double (const double &)> f = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::unnormalized_decay_width),
-                _imp, std::placeholders::_1);
+        const auto v = _imp->variant();
+        std::function<double (const double &)> f = [&] (const double & s) { return _imp->unnormalized_decay_width(v, s); };
 
         return integrate<GSL::QNG>(f, s_min, s_max);
     }
@@ -2718,123 +2814,85 @@ The azimuthal angle between the Kbar-pi plane and the l^+l^- plane.";
     double
     BToKDilepton<LargeRecoil>::integrated_branching_ratio_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-        std::function<double (const double &)> f = std::bind(&BToKDilepton<LargeRecoil>::differential_branching_ratio,
-                this, std::placeholders::_1);
+        const auto variants = _imp->cp_variants();
+        std::function<std::array<double, 2> (const double &)> f = [&] (const double & s) { return _imp->differential_branching_ratio_pair(variants, s); };
 
-        double br = integrate<GSL::QNG>(f, s_min, s_max);
-        _imp->cp_conjugate = true;
-        double br_bar = integrate<GSL::QNG>(f, s_min, s_max);
+        std::array<double, 2> br = integrate(f, s_min, s_max);
 
-        return (br + br_bar) / 2.0;
+        return (br[0] + br[1]) / 2.0;
     }
 
     double
     BToKDilepton<LargeRecoil>::integrated_cp_asymmetry(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-        std::function<double (const double &)> f = std::bind(&BToKDilepton<LargeRecoil>::differential_branching_ratio,
-                this, std::placeholders::_1);
+        const auto variants = _imp->cp_variants();
+        std::function<std::array<double, 2> (const double &)> f = [&] (const double & s) { return _imp->differential_branching_ratio_pair(variants, s); };
 
-        double br = integrate<GSL::QNG>(f, s_min, s_max);
-        _imp->cp_conjugate = true;
-        double br_bar = integrate<GSL::QNG>(f, s_min, s_max);
+        std::array<double, 2> br = integrate(f, s_min, s_max);
 
-        return (br - br_bar) / (br + br_bar);
+        return (br[0] - br[1]) / (br[0] + br[1]);
     }
 
     double
     BToKDilepton<LargeRecoil>::integrated_flat_term(const double & s_min, const double & s_max) const
     {
-        std::function<double (const double &)> num = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::differential_flat_term_numerator),
-                _imp, std::placeholders::_1);
-        std::function<double (const double &)> denom = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::unnormalized_decay_width),
-                _imp, std::placeholders::_1);
+        const auto v = _imp->variant();
+        std::function<std::array<double, 2> (const double &)> f = [&] (const double & s) { return _imp->differential_flat_term_components(v, s); };
 
-        double num_integrated = integrate<GSL::QNG>(num, s_min, s_max);
-        double denom_integrated = integrate<GSL::QNG>(denom, s_min, s_max);
+        // numerator and denominator from a single sweep
+        std::array<double, 2> integrated = integrate(f, s_min, s_max);
 
-        return num_integrated / denom_integrated;
+        return integrated[0] / integrated[1];
     }
 
     double
     BToKDilepton<LargeRecoil>::integrated_flat_term_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-        std::function<double (const double &)> num = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::differential_flat_term_numerator),
-                _imp, std::placeholders::_1);
-        std::function<double (const double &)> denom = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::unnormalized_decay_width),
-                _imp, std::placeholders::_1);
-
-        double num_integrated = integrate<GSL::QNG>(num, s_min, s_max);
-        double denom_integrated = integrate<GSL::QNG>(denom, s_min, s_max);
-
-        _imp->cp_conjugate = true;
+        const auto variants = _imp->cp_variants();
+        std::function<std::array<double, 2> (const double &)> f = [&] (const double & s) {
+            return _imp->cp_summed(&Implementation<BToKDilepton<LargeRecoil>>::differential_flat_term_components, variants, s);
+        };
 
-        num_integrated += integrate<GSL::QNG>(num, s_min, s_max);
-        denom_integrated += integrate<GSL::QNG>(denom, s_min, s_max);
+        std::array<double, 2> integrated = integrate(f, s_min, s_max);
 
-        return num_integrated / denom_integrated;
+        return integrated[0] / integrated[1];
     }
 
-    // todo caching of denominator?
     double
     BToKDilepton<LargeRecoil>::integrated_forward_backward_asymmetry(const double & s_min, const double & s_max) const
     {
-        std::function<double (const double &)> num = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::differential_forward_backward_asymmetry_numerator),
-                _imp, std::placeholders::_1);
-        std::function<double (const double &)> denom = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::unnormalized_decay_width),
-                _imp, std::placeholders::_1);
+        const auto v = _imp->variant();
+        std::function<std::array<double, 2> (const double &)> f = [&] (const double & s) { return _imp->differential_forward_backward_asymmetry_components(v, s); };
 
-        double num_integrated = integrate<GSL::QNG>(num, s_min, s_max);
-        double denom_integrated = integrate<GSL::QNG>(denom, s_min, s_max);
+        // numerator and denominator from a single sweep
+        std::array<double, 2> integrated = integrate(f, s_min, s_max);
 
-        return num_integrated / denom_integrated;
+        return integrated[0] / integrated[1];
     }
 
     double
     BToKDilepton<LargeRecoil>::integrated_forward_backward_asymmetry_cp_averaged(const double & s_min, const double & s_max) const
     {
-        Save<bool> save(_imp->cp_conjugate, false);
-        std::function<double (const double &)> num = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::differential_forward_backward_asymmetry_numerator),
-                _imp, std::placeholders::_1);
-        std::function<double (const double &)> denom = std::bind(std::mem_fn(&Implementation<BToKDilepton<LargeRecoil>>::unnormalized_decay_width),
-                _imp, std::placeholders::_1);
-
-        double num_integrated = integrate<GSL::QNG>(num, s_min, s_max);
-        double denom_integrated = integrate<GSL::QNG>(denom, s_min, s_max);
-
-        _imp->cp_conjugate = true;
+        const auto variants = _imp->cp_variants();
+        std::function<std::array<double, 2> (const double &)> f = [&] (const double & s) {
+            return _imp->cp_summed(&Implementation<BToKDilepton<LargeRecoil>>::differential_forward_backward_asymmetry_components, variants, s);
+        };
 
-        num_integrated += integrate<GSL::QNG>(num, s_min, s_max);
-        denom_integrated += integrate<GSL::QNG>(denom, s_min, s_max);
+        std::array<double, 2> integrated = integrate(f, s_min, s_max);
 
-        return num_integrated / denom_integrated;
+        return integrated[0] / integrated[1];
     }
 
     double
     BToKDilepton<LargeRecoil>::integrated_ratio_muons_electrons(const double & s_min, const double & s_max) const
     {
-        std::function<double (const double &)> integrand = std::bind(std::mem_fn(&BToKDilepton<LargeRecoil>::differential_branching_ratio),
-                this, std::placeholders::_1);
-
-        double br_electrons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::e"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "e");
-            // br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
-            br_electrons = integrate<GSL::QNG>(integrand, s_min, s_max);
-        }
+        const auto variants = _imp->lepton_flavour_variants();
+        std::function<std::array<double, 2> (const double &)> f = [&] (const double & s) { return _imp->differential_branching_ratio_pair(variants, s); };
 
-        double br_muons;
-        {
-            Save<Parameter, double> save_m_l(_imp->m_l, _imp->parameters["mass::mu"]());
-            Save<std::string> save_lepton_flavour(_imp->lepton_flavour, "mu");
-            br_muons = integrate<GSL::QNG>(integrand, s_min, s_max);
-        }
+        std::array<double, 2> br = integrate(f, s_min, s_max);
 
         // cf. [BHP2007], Eq. (4.10), p. 6
-        return br_muons / br_electrons;
+        return br[0] / br[1];
     }
 
     const std::string
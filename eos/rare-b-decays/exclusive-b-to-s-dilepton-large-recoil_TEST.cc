@@ -176,6 +176,21 @@ class BToKstarDileptonLargeRecoilBobethCompatibilityTest :
             TEST_CHECK_RELATIVE_ERROR_C(d.a_long_perp(s), complex<double>(-2.70244e-11, -4.05366e-11), eps);
             TEST_CHECK_RELATIVE_ERROR_C(d.a_t_par(s),     complex<double>(-3.24769e-11, -4.87154e-11), eps);
             TEST_CHECK_RELATIVE_ERROR_C(d.a_long_par(s),  complex<double>( 2.92292e-11, 4.54677e-11), eps);
+
+            // the joint evaluation of both CP-conjugate decays agrees with separate evaluations
+            {
+                BToKstarDilepton<LargeRecoil> d_bar(p, oo + Options{ { "cp-conjugate", "true" } });
+
+                const double
+                    gamma     = d.integrated_decay_width(1.0, 6.0),
+                    gamma_bar = d_bar.integrated_decay_width(1.0, 6.0);
+
+                eps = 1e-10;
+                TEST_CHECK_RELATIVE_ERROR(d.integrated_cp_asymmetry(1.0, 6.0), (gamma - gamma_bar) / (gamma + gamma_bar), eps);
+                TEST_CHECK_RELATIVE_ERROR(d.integrated_branching_ratio_cp_averaged(1.0, 6.0),
+                        0.5 * (d.integrated_branching_ratio(1.0, 6.0) + d_bar.integrated_branching_ratio(1.0, 6.0)), eps);
+                TEST_CHECK_RELATIVE_ERROR(d.differential_p_prime_5(s), d_bar.differential_p_prime_5(s), eps);
+            }
        }
     }
 } b_to_kstar_dilepton_large_recoil_bobeth_compatibility_test;
@@ -261,5 +276,33 @@ class BToKDileptonLargeRecoilBobethCompatibilityTest :
             TEST_CHECK_RELATIVE_ERROR(d.integrated_flat_term(1, 6), 0.2788261376, eps);
             TEST_CHECK_RELATIVE_ERROR(d.integrated_ratio_muons_electrons(1, 6), 1.073039657, eps);
             TEST_CHECK_RELATIVE_ERROR(d.integrated_cp_asymmetry(1, 6), 0.00455162022, 5 * eps);
+
+            // the joint integrals agree with separate integrals of each variant
+            {
+                Options oo_bar(oo), oo_e(oo);
+                oo_bar.set("cp-conjugate", "true");
+                oo_e.set("l", "e");
+
+                BToKDilepton<LargeRecoil> d_bar(p, oo_bar), d_e(p, oo_e);
+
+                const double br = d.integrated_branching_ratio(1, 6);
+                const double br_bar = d_bar.integrated_branching_ratio(1, 6);
+                const double br_e = d_e.integrated_branching_ratio(1, 6);
+
+                TEST_CHECK_RELATIVE_ERROR(d.integrated_branching_ratio_cp_averaged(1, 6), (br + br_bar) / 2.0, 1e-4);
+                TEST_CHECK_NEARLY_EQUAL(d.integrated_cp_asymmetry(1, 6), (br - br_bar) / (br + br_bar), 1e-4);
+                TEST_CHECK_RELATIVE_ERROR(d.integrated_ratio_muons_electrons(1, 6), br / br_e, 1e-4);
+            }
+
+            // evaluating the variants does not modify any parameter
+            {
+                const unsigned long version = p.version();
+
+                d.integrated_ratio_muons_electrons(1, 6);
+                d.integrated_flat_term_cp_averaged(1, 6);
+                d.integrated_cp_asymmetry(1, 6);
+
+                TEST_CHECK_EQUAL(version, p.version());
+            }
         }
 } b_to_k_dilepton_large_recoil_bobeth_compatibility_test;
@@ -231,7 +231,9 @@ namespace eos
             const double m_Kstarhat = m_Kstar / m_B;
             const double m_Kstarhat2 = std::pow(m_Kstarhat, 2);
             const double s_hat = s / m_B / m_B;
-            const double a_1 = form_factors->a_1(s), a_2 = form_factors->a_2(s);
+            // request all form factors at once, so that they can share intermediate results
+            const FormFactors<PToV>::Values ff = form_factors->values(s);
+            const double a_1 = ff.a_1, a_2 = ff.a_2;
             const double alpha_s = model->alpha_s(mu());
             const double norm_s = this->norm(s);
             const double lam = lambda(m_B2, m_Kstar2, s);
@@ -270,7 +272,7 @@ namespace eos
             complex<double> wilson_perp_right = c910_plus_right + c7_plus * (m_b_MSbar() + m_s() + lambda_perp()) - subleading_perp;
             complex<double> wilson_perp_left  = c910_plus_left  + c7_plus * (m_b_MSbar() + m_s() + lambda_perp()) - subleading_perp;
 
-            double formfactor_perp = std::sqrt(2.0 * lambda(1.0, m_Kstarhat2, s_hat)) / (1.0 + m_Kstarhat) * form_factors->v(s);
+            double formfactor_perp = std::sqrt(2.0 * lambda(1.0, m_Kstarhat2, s_hat)) / (1.0 + m_Kstarhat) * ff.v;
             // cf. [BHvD2010], Eq. (3.13), p. 10
             result.a_perp_right = norm_s * prefactor_perp * wilson_perp_right * formfactor_perp;
             result.a_perp_left  = norm_s * prefactor_perp * wilson_perp_left  * formfactor_perp;
@@ -287,16 +289,16 @@ namespace eos
             // timelike
             result.a_timelike = norm_s * sqrt_lam / sqrt_s
                 * (2.0 * (wc.c10() - wc.c10prime()) + s / m_l / (m_b_MSbar + m_s()) * (wc.cP() - wc.cPprime()))
-                * form_factors->a_0(s);
+                * ff.a_0;
 
             // scalar amplitude
-            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s()) * form_factors->a_0(s);
+            result.a_scalar = -2.0 * norm_s * sqrt_lam * (wc.cS() - wc.cSprime()) / (m_b_MSbar + m_s()) * ff.a_0;
 
             // tensor amplitudes [BHvD2012]  eqs. (B18 - B20)
             // no form factor relations used
-            const double ff_T1  = form_factors->t_1(s);
-            const double ff_T2  = form_factors->t_2(s);
-            const double ff_T3  = form_factors->t_3(s);
+            const double ff_T1  = ff.t_1;
+            const double ff_T2  = ff.t_2;
+            const double ff_T3  = ff.t_3;
 
             const double kin_tensor_1 = norm_s / m_Kstar * ((m_B2 + 3.0 * m_Kstar2 - s) * ff_T2 - lam / m2_diff * ff_T3);
             const double kin_tensor_2 = 2.0 * norm_s * sqrt_lam / sqrt_s * ff_T1;
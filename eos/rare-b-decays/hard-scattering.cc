@@ -19,11 +19,14 @@
 
 #include <eos/rare-b-decays/charm-loops.hh>
 #include <eos/rare-b-decays/hard-scattering.hh>
+#include <eos/utils/memoise.hh>
 #include <eos/utils/power_of.hh>
 
+#include <gsl/gsl_integration.h>
 #include <gsl/gsl_sf_dilog.h>
 
 #include <limits>
+#include <vector>
 
 namespace eos
 {
@@ -321,4 +324,107 @@ namespace eos
 
         return lcda_tw2(u, a_1, a_2) / power_of<2>(ubar + u * s / power_of<2>(m_B));
     }
+
+    namespace
+    {
+        // nodes and weights of the Gauss-Legendre rule on [0, 1]
+        struct GaussLegendreRule
+        {
+            std::vector<double> nodes, weights;
+
+            GaussLegendreRule(const size_t & points) :
+                nodes(points),
+                weights(points)
+            {
+                gsl_integration_glfixed_table * table = gsl_integration_glfixed_table_alloc(points);
+                for (size_t i = 0 ; i < points ; ++i)
+                {
+                    gsl_integration_glfixed_point(0.0, 1.0, i, &nodes[i], &weights[i], table);
+                }
+                gsl_integration_glfixed_table_free(table);
+            }
+        };
+
+        inline void accumulate(HardScattering::Convolutions::Coefficients & c, const complex<double> & value,
+                const double & g_1, const double & g_2)
+        {
+            c[0] += value;
+            c[1] += value * g_1;
+            c[2] += value * g_2;
+        }
+    }
+
+    HardScattering::Convolutions
+    HardScattering::compute_convolutions(const double & s, const double & m_q, const double & m_B,
+            const double & m_M, const double & mu)
+    {
+        static const GaussLegendreRule rule(64);
+
+        Convolutions result;
+        for (auto c : { &result.j0, &result.j1, &result.j2, &result.j2_massless, &result.j3, &result.j3_massless,
+                        &result.j4, &result.j5, &result.j6, &result.j7, &result.I1, &result.t_perp, &result.t_par })
+        {
+            c->fill(complex<double>(0.0, 0.0));
+        }
+
+        // split the integration at the threshold ubar * m_B^2 + u * s = 4 m_q^2 of the loop functions
+        std::vector<double> boundaries{ 0.0, 1.0 };
+        const double u_threshold = (m_B * m_B - 4.0 * m_q * m_q) / (m_B * m_B - s);
+        if ((m_q > 0.0) && (0.0 < u_threshold) && (u_threshold < 1.0))
+            boundaries.insert(boundaries.begin() + 1, u_threshold);
+
+        for (size_t k = 0 ; k + 1 < boundaries.size() ; ++k)
+        {
+            const double length = boundaries[k + 1] - boundaries[k];
+
+            for (size_t i = 0 ; i < rule.nodes.size() ; ++i)
+            {
+                const double u = boundaries[k] + length * rule.nodes[i], w = length * rule.weights[i];
+                const double xi = 2.0 * u - 1.0;
+
+                // ratios of the Gegenbauer terms to the asymptotic LCDA
+                const double g_1 = 3.0 * xi, g_2 = 3.0 / 2.0 * (5.0 * xi * xi - 1.0);
+                // ratios for the first inverse moment entering j6, cf. [BFS2004], eq. (52)
+                const double h_1 = -3.0 + 4.0 * u, h_2 = 6.0 - 20.0 * u + 15.0 * u * u;
+
+                const double phi = w * lcda_tw2(u, 0.0, 0.0);
+
+                accumulate(result.j0,          w * j0(s, u, m_B, 0.0, 0.0),                   g_1, g_2);
+                accumulate(result.j1,          w * j1(s, u, m_q, m_B, 0.0, 0.0),              g_1, g_2);
+                if (m_q > 0.0)
+                {
+                    accumulate(result.j2,      w * j2(s, u, m_q, m_B, 0.0, 0.0),              g_1, g_2);
+                    accumulate(result.j3,      w * j3(s, u, m_q, m_B, 0.0, 0.0),              g_1, g_2);
+                }
+                if (s > 0.0)
+                {
+                    accumulate(result.j2_massless, w * j2_massless(s, u, m_B, 0.0, 0.0),      g_1, g_2);
+                    accumulate(result.j3_massless, w * j3_massless(s, u, m_B, 0.0, 0.0),      g_1, g_2);
+                }
+                accumulate(result.j4,          w * j4(s, u, m_q, m_B, mu, 0.0, 0.0),          g_1, g_2);
+                accumulate(result.j5,          w * j5(s, u, m_q, m_B, mu, 0.0, 0.0),          g_1, g_2);
+                accumulate(result.j6,          w * j6(s, u, m_q, m_B, mu, 0.0, 0.0),          h_1, h_2);
+                accumulate(result.j7,          w * j7(s, u, m_B, 0.0, 0.0),                   g_1, g_2);
+                accumulate(result.I1,          phi * I1(s, u, m_q, m_B),                      g_1, g_2);
+                accumulate(result.t_perp,      phi * t_perp(s, u, m_q, m_B, m_M),             g_1, g_2);
+                accumulate(result.t_par,       phi * t_par(s, u, m_q, m_B, m_M),              g_1, g_2);
+            }
+        }
+
+        // j2 and j3 reduce to their massless counterparts for m_q = 0, which are defined for s > 0 only
+        if (m_q == 0.0)
+        {
+            result.j2 = result.j2_massless;
+            result.j3 = result.j3_massless;
+        }
+
+        return result;
+    }
+
+    HardScattering::Convolutions
+    HardScattering::convolutions(const double & s, const double & m_q, const double & m_B,
+            const double & m_M, const double & mu)
+    {
+        return memoise(&HardScattering::compute_convolutions, s, m_q, m_B, m_M, mu);
+    }
 }
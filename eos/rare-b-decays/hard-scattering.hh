@@ -20,6 +20,7 @@
 #ifndef EOS_GUARD_SRC_RARE_B_DECAYS_HARD_SCATTERING_HH
 #define EOS_GUARD_SRC_RARE_B_DECAYS_HARD_SCATTERING_HH 1
 
+#include <array>
 #include <complex>
 
 namespace eos
@@ -194,6 +195,50 @@ namespace eos
          * @param a_2 Second Gegenbauer coefficient
          */
         static double j7(const double & s, const double & u, const double & m_B, const double & a_1, const double & a_2);
+
+        /*!
+         * Convolutions of the hard-scattering kernels with the twist-2 LCDA, projected onto its Gegenbauer expansion.
+         *
+         * Each convolution int_0^1 du j_n(s, u, ..., a_1, a_2) is linear in the Gegenbauer coefficients,
+         * and follows as c[0] + a_1 * c[1] + a_2 * c[2] from the respective coefficients c.
+         */
+        struct Convolutions
+        {
+            typedef std::array<complex<double>, 3> Coefficients;
+
+            /// j2_massless and j3_massless are undefined for s <= 0, and set to zero there
+            Coefficients j0, j1, j2, j2_massless, j3, j3_massless, j4, j5, j6, j7;
+
+            /// I1, t_perp and t_par weighted with the twist-2 LCDA
+            Coefficients I1, t_perp, t_par;
+
+            /*!
+             * Evaluate a convolution for given Gegenbauer coefficients.
+             * @param c   Coefficients of the convolution
+             * @param a_1 First Gegenbauer coefficient
+             * @param a_2 Second Gegenbauer coefficient
+             */
+            static complex<double> evaluate(const Coefficients & c, const double & a_1, const double & a_2)
+            {
+                return c[0] + a_1 * c[1] + a_2 * c[2];
+            }
+        };
+
+        /*!
+         * Convolutions of all kernels for the given kinematics, using a 64-point Gauss-Legendre
+         * rule in u on either side of the threshold of the loop functions. The results are memoised.
+         * @param s Dilepton invariant mass
+         * @param m_q Mass of the internal loop quark
+         * @param m_B Mass of the B meson
+         * @param m_M Mass of the K(K*) meson
+         * @param mu Renormalization scale
+         */
+        static Convolutions convolutions(const double & s, const double & m_q, const double & m_B,
+                const double & m_M, const double & mu);
+
+        /// As convolutions(), but without memoisation.
+        static Convolutions compute_convolutions(const double & s, const double & m_q, const double & m_B,
+                const double & m_M, const double & mu);
     };
 }
 
@@ -19,6 +19,7 @@
 
 #include <test/test.hh>
 #include <eos/rare-b-decays/hard-scattering.hh>
+#include <eos/utils/integrate.hh>
 
 #include <cmath>
 #include <iostream>
@@ -80,5 +81,33 @@ class HardScatteringTest :
                     TEST_CHECK_NEARLY_EQUAL(-4.45749,   imag(HardScattering::I1(s, 0.9, m_c, m_B)), eps);
                 }
             }
+
+            /* Convolutions projected onto the Gegenbauer moments */
+            {
+                static const double s = 1.0, m_c = 1.4, m_B = 5.279, m_Kstar = 0.896, mu = 4.2;
+                static const double a_1 = 0.1, a_2 = 0.2, eps = 1.0e-4;
+
+                const HardScattering::Convolutions c = HardScattering::convolutions(s, m_c, m_B, m_Kstar, mu);
+                const auto config = GSL::QAGS::Config().epsrel(1.0e-8);
+
+                std::function<double (const double &)> j0 = [&] (const double & u) { return HardScattering::j0(s, u, m_B, a_1, a_2); };
+                TEST_CHECK_RELATIVE_ERROR(integrate<GSL::QAGS>(j0, 0.0, 1.0, config),
+                        real(HardScattering::Convolutions::evaluate(c.j0, a_1, a_2)), eps);
+
+                std::function<double (const double &)> re_j4 = [&] (const double & u) { return real(HardScattering::j4(s, u, m_c, m_B, mu, a_1, a_2)); };
+                std::function<double (const double &)> im_j4 = [&] (const double & u) { return imag(HardScattering::j4(s, u, m_c, m_B, mu, a_1, a_2)); };
+                TEST_CHECK_RELATIVE_ERROR(integrate<GSL::QAGS>(re_j4, 0.0, 1.0, config),
+                        real(HardScattering::Convolutions::evaluate(c.j4, a_1, a_2)), eps);
+                TEST_CHECK_RELATIVE_ERROR(integrate<GSL::QAGS>(im_j4, 0.0, 1.0, config),
+                        imag(HardScattering::Convolutions::evaluate(c.j4, a_1, a_2)), eps);
+
+                std::function<double (const double &)> re_j6 = [&] (const double & u) { return real(HardScattering::j6(s, u, m_c, m_B, mu, a_1, a_2)); };
+                TEST_CHECK_RELATIVE_ERROR(integrate<GSL::QAGS>(re_j6, 0.0, 1.0, config),
+                        real(HardScattering::Convolutions::evaluate(c.j6, a_1, a_2)), eps);
+
+                // memoised results are identical
+                const HardScattering::Convolutions c2 = HardScattering::convolutions(s, m_c, m_B, m_Kstar, mu);
+                TEST_CHECK_EQUAL(real(c.j1[2]), real(c2.j1[2]));
+            }
         }
 } hard_scattering_test;
@@ -108,8 +108,8 @@ namespace eos
        LogPriorPtr prior_clone = prior->clone(_parameters);
 
        // check if param exists already
-       // read out parameters from prior
-       for (auto d = prior->begin(), d_end = prior->end() ; d != d_end ; ++d)
+       // read out parameters from the clone, which refers to our Parameters object
+       for (auto d = prior_clone->begin(), d_end = prior_clone->end() ; d != d_end ; ++d)
        {
            auto result = _parameter_names.insert(d->parameter->name());
            if (! result.second)
@@ -144,10 +144,10 @@ namespace eos
        LogLikelihood llh = _log_likelihood.clone();
        Analysis * result = new Analysis(llh);
 
-       // add parameters via prior clones
+       // add parameters via prior clones, which add() creates
        for (auto i = _priors.cbegin(), i_end = _priors.cend(); i != i_end; ++i)
        {
-           result->add((*i)->clone(result->parameters()));
+           result->add(*i);
        }
 
        // copy proper range for subspace sampling
@@ -584,6 +584,18 @@ namespace eos
        }
    }
 
+   unsigned
+   Analysis::use_polynomials(const std::list<std::string> & coefficients)
+   {
+       std::set<Parameter::Id> floating;
+       for (auto d = _parameter_descriptions.cbegin(), d_end = _parameter_descriptions.cend() ; d != d_end ; ++d)
+       {
+           floating.insert(_parameters[d->parameter->name()].id());
+       }
+
+       return _log_likelihood.use_polynomials(coefficients, floating);
+   }
+
    MutablePtr
    Analysis::operator[] (const unsigned & index) const
    {
@@ -195,6 +195,19 @@ namespace eos
             bool nuisance(const std::string & name) const;
             ///@}
 
+            /*!
+             * Predict the likelihood's observables by means of polynomials in the given coefficients, wherever possible.
+             *
+             * All parameters of the analysis are considered to vary. Observables which use any of
+             * them other than the coefficients are evaluated directly. Call this method only
+             * after all priors have been added. Clones of this Analysis inherit the polynomials.
+             *
+             * @param coefficients The names of the coefficients, typically Wilson coefficients.
+             *
+             * @return The number of observables that are predicted by means of a polynomial.
+             */
+            unsigned use_polynomials(const std::list<std::string> & coefficients);
+
             /*!
              * Optimize the posterior using the Nelder-Mead simplex algorithm.
              * @param initial_guess Starting point for simplex construction
@@ -52,6 +52,16 @@ namespace eos
             {
             }
 
+            TestObservable(const Parameters & p, const Kinematics & k, const QualifiedName & mass_name, const QualifiedName & name) :
+                p(p),
+                k(k),
+                o(),
+                n(name),
+                mass_name(mass_name),
+                mass(p[mass_name.str()], *this)
+            {
+            }
+
             virtual ~TestObservable()
             {
             }
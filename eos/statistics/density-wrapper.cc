@@ -56,17 +56,36 @@ namespace eos
         return _parameters;
     }
 
+    void
+    DensityWrapper::set_gradient(const WrappedGradient & gradient)
+    {
+        _gradient = gradient;
+    }
+
     double
     DensityWrapper::evaluate() const
     {
         return _density(_parameters.values());
     }
 
+    bool
+    DensityWrapper::gradient(std::vector<double> & gradient) const
+    {
+        if (! _gradient)
+            return false;
+
+        gradient.resize(_parameters.values().size());
+        _gradient(_parameters.values(), gradient);
+
+        return true;
+    }
+
     DensityPtr
     DensityWrapper::clone() const
     {
         DensityWrapper * density = new DensityWrapper(_density);
         density->_parameters = this->_parameters.clone();
+        density->_gradient = this->_gradient;
         return DensityPtr(density);
     }
 
@@ -42,6 +42,7 @@ namespace eos
         public:
             typedef double (* RawDensity)(const std::vector<double> &);
             typedef std::function< double (const std::vector<double> &)> WrappedDensity;
+            typedef std::function< void (const std::vector<double> &, std::vector<double> &)> WrappedGradient;
 
             /// Initialize with a WrappedDensity, that could point for example to a member method
             DensityWrapper(const WrappedDensity &);
@@ -65,9 +66,15 @@ namespace eos
             /// Access to container managing the underlying parameters.
             SimpleParameters & parameters();
 
+            /// Provide the analytic gradient of the density on the log scale.
+            void set_gradient(const WrappedGradient & gradient);
+
             /// Evaluate the density function at the current parameter point on the log scale.
             virtual double evaluate() const;
 
+            /// Evaluate the analytic gradient at the current parameter point, if provided.
+            virtual bool gradient(std::vector<double> & gradient) const;
+
             /// Create an independent copy of this density function.
             virtual DensityPtr clone() const;
 
@@ -78,6 +85,7 @@ namespace eos
             ///@}
         private:
             WrappedDensity _density;
+            WrappedGradient _gradient;
             SimpleParameters _parameters;
     };
 }
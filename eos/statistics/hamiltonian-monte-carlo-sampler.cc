@@ -0,0 +1,908 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/hamiltonian-monte-carlo-sampler.hh>
+#include <eos/utils/density.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <limits>
+
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_rng.h>
+
+namespace eos
+{
+    HamiltonianMonteCarloSampler::Config::Config() :
+        seed(0),
+        parallelize(true),
+        use_analytic_gradient(true),
+        gradient_step_size(std::numeric_limits<double>::epsilon(), 0.1, 1e-4),
+        use_nuts(true),
+        max_tree_depth(1, 30, 10),
+        leapfrog_steps(1, std::numeric_limits<unsigned>::max(), 16),
+        warmup_iterations(1000),
+        target_acceptance(0, 1, 0.8),
+        adapt_mass_matrix(true),
+        dense_mass_matrix(true),
+        iterations(1000)
+    {
+    }
+
+    HamiltonianMonteCarloSampler::Config
+    HamiltonianMonteCarloSampler::Config::Default()
+    {
+        return Config();
+    }
+
+    template <>
+    struct Implementation<HamiltonianMonteCarloSampler>
+    {
+        /*
+         * A point in phase space, together with the log(density) and its gradient there.
+         */
+        struct Node
+        {
+            std::vector<double> point;
+
+            std::vector<double> momentum;
+
+            std::vector<double> gradient;
+
+            double log_density;
+        };
+
+        /*
+         * A subtree of the NUTS trajectory, cf. [HG2014], algorithm 3.
+         */
+        struct Tree
+        {
+            // the leftmost and rightmost nodes
+            Node minus, plus;
+
+            // the node sampled from all nodes within the slice
+            Node proposal;
+
+            // the number of nodes within the slice
+            double size;
+
+            // false if the trajectory has made a U-turn, or diverged
+            bool valid;
+
+            bool divergent;
+
+            // sum of the acceptance probabilities of all nodes, and number of nodes
+            double sum_of_acceptance;
+            unsigned steps;
+        };
+
+        /*
+         * Computes the finite-difference derivatives with respect to every stride-th parameter,
+         * using its own clone of the density.
+         */
+        struct GradientWorker
+        {
+            DensityPtr density;
+
+            std::vector<MutablePtr> parameters;
+
+            // the allowed ranges of the parameters
+            std::vector<double> minima, maxima;
+
+            double relative_step;
+
+            std::exception_ptr exception;
+
+            GradientWorker(const DensityPtr & density, const double & relative_step) :
+                density(density->clone()),
+                relative_step(relative_step)
+            {
+                for (auto & d : *this->density)
+                {
+                    parameters.push_back(d.parameter);
+                    minima.push_back(d.min);
+                    maxima.push_back(d.max);
+                }
+            }
+
+            void run(const std::vector<double> * point, const unsigned & first, const unsigned & stride, double * gradient)
+            {
+                try
+                {
+                    for (unsigned i = 0 ; i < parameters.size() ; ++i)
+                    {
+                        parameters[i]->set((*point)[i]);
+                    }
+
+                    for (unsigned i = first ; i < parameters.size() ; i += stride)
+                    {
+                        MutablePtr & p = parameters[i];
+                        const double & x = (*point)[i];
+                        auto f = [&] (const double & value) -> double
+                        {
+                            p->set(value);
+                            return density->evaluate();
+                        };
+
+                        // the step scales with the parameter's range, and the stencil must not leave that range
+                        double h = relative_step * (maxima[i] - minima[i]);
+                        const double room = 0.5 * std::min(x - minima[i], maxima[i] - x);
+                        if (room > 0.0)
+                            h = std::min(h, room);
+
+                        // use a 5-point stencil for the central difference quotient
+                        gradient[i] = (f(x - 2.0 * h) - 8.0 * f(x - h) + 8.0 * f(x + h) - f(x + 2.0 * h)) / (12.0 * h);
+                        p->set(x);
+                    }
+                }
+                catch (...)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        };
+
+        // a trajectory is considered divergent once the error in the energy exceeds this value
+        static constexpr double max_energy_error = 1000.0;
+
+        DensityPtr density;
+
+        HamiltonianMonteCarloSampler::Config config;
+
+        std::vector<ParameterDescription> descriptions;
+
+        unsigned dimension;
+
+        bool analytic_gradient;
+
+        std::vector<std::shared_ptr<GradientWorker>> workers;
+
+        gsl_rng * rng;
+
+        // the current state of the chain
+        Node current;
+
+        double step_size;
+
+        // the inverse mass matrix and its Cholesky factor, both in row-major order
+        std::vector<double> inverse_metric;
+        std::vector<double> cholesky_factor;
+
+        // dual averaging of the step size, cf. [HG2014], section 3.2
+        double log_step_size_target, log_step_size_average, h_average;
+        unsigned adaptation_steps;
+
+        // running estimate of the covariance matrix (Welford's method)
+        unsigned number_of_covariance_samples;
+        std::vector<double> sample_mean, sample_m2;
+
+        MarkovChain::History history;
+
+        HamiltonianMonteCarloSampler::Statistics statistics;
+
+        Implementation(const DensityPtr & density, const HamiltonianMonteCarloSampler::Config & config) :
+            density(density->clone()),
+            config(config),
+            analytic_gradient(false),
+            rng(gsl_rng_alloc(gsl_rng_mt19937)),
+            step_size(1.0),
+            statistics{ 0, 0, 0, 0.0 }
+        {
+            gsl_rng_set(rng, config.seed);
+
+            for (auto & d : *this->density)
+            {
+                descriptions.push_back(d);
+            }
+            dimension = descriptions.size();
+
+            if (0 == dimension)
+                throw InternalError("HamiltonianMonteCarloSampler: Cannot operate on zero dimensional parameter space");
+
+            inverse_metric.assign(dimension * dimension, 0.0);
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                inverse_metric[i * dimension + i] = 1.0;
+            }
+            cholesky_factor = inverse_metric;
+
+            history.keep = true;
+        }
+
+        ~Implementation()
+        {
+            gsl_rng_free(rng);
+        }
+
+        /* linear algebra */
+
+        // compute the lower triangular L with A = L L^T; returns false if A is not positive definite
+        bool cholesky(const std::vector<double> & a, std::vector<double> & l) const
+        {
+            l.assign(dimension * dimension, 0.0);
+
+            for (unsigned j = 0 ; j < dimension ; ++j)
+            {
+                double diagonal = a[j * dimension + j];
+                for (unsigned k = 0 ; k < j ; ++k)
+                {
+                    diagonal -= l[j * dimension + k] * l[j * dimension + k];
+                }
+
+                if (! (diagonal > 0.0))
+                    return false;
+
+                l[j * dimension + j] = std::sqrt(diagonal);
+
+                for (unsigned i = j + 1 ; i < dimension ; ++i)
+                {
+                    double value = a[i * dimension + j];
+                    for (unsigned k = 0 ; k < j ; ++k)
+                    {
+                        value -= l[i * dimension + k] * l[j * dimension + k];
+                    }
+
+                    l[i * dimension + j] = value / l[j * dimension + j];
+                }
+            }
+
+            return true;
+        }
+
+        // the velocity M^-1 p
+        std::vector<double> velocity(const std::vector<double> & momentum) const
+        {
+            std::vector<double> result(dimension, 0.0);
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                for (unsigned j = 0 ; j < dimension ; ++j)
+                {
+                    result[i] += inverse_metric[i * dimension + j] * momentum[j];
+                }
+            }
+
+            return result;
+        }
+
+        double kinetic_energy(const std::vector<double> & momentum) const
+        {
+            const std::vector<double> v = velocity(momentum);
+
+            double result = 0.0;
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                result += momentum[i] * v[i];
+            }
+
+            return 0.5 * result;
+        }
+
+        // log of the joint density of position and momentum
+        double log_joint(const Node & node) const
+        {
+            const double result = node.log_density - kinetic_energy(node.momentum);
+
+            return std::isnan(result) ? -std::numeric_limits<double>::infinity() : result;
+        }
+
+        // draw the momentum from N(0, M), with M^-1 = L L^T, by solving L^T p = z
+        void sample_momentum(Node & node)
+        {
+            node.momentum.resize(dimension);
+
+            for (unsigned i = dimension ; i-- > 0 ; )
+            {
+                double value = gsl_ran_ugaussian(rng);
+                for (unsigned k = i + 1 ; k < dimension ; ++k)
+                {
+                    value -= cholesky_factor[k * dimension + i] * node.momentum[k];
+                }
+
+                node.momentum[i] = value / cholesky_factor[i * dimension + i];
+            }
+        }
+
+        /* evaluation of the density */
+
+        void compute_gradient(const std::vector<double> & point, std::vector<double> & gradient)
+        {
+            gradient.resize(dimension);
+            ++statistics.gradient_evaluations;
+
+            if (analytic_gradient)
+            {
+                density->gradient(gradient);
+                return;
+            }
+
+            statistics.density_evaluations += 4 * dimension;
+
+            std::vector<Ticket> tickets;
+            for (unsigned w = 0 ; w < workers.size() ; ++w)
+            {
+                std::function<void (void)> f = std::bind(&GradientWorker::run, workers[w].get(), &point, w, unsigned(workers.size()), gradient.data());
+
+                if (config.parallelize)
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue(f));
+                }
+                else
+                {
+                    f();
+                }
+            }
+
+            for (auto & t : tickets)
+            {
+                t.wait();
+            }
+
+            for (auto & w : workers)
+            {
+                if (w->exception)
+                {
+                    std::exception_ptr e = w->exception;
+                    w->exception = nullptr;
+                    std::rethrow_exception(e);
+                }
+            }
+        }
+
+        // evaluate the log(density) and its gradient at the node's point
+        void evaluate(Node & node)
+        {
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                // points outside the parameter ranges are invalid, as in MarkovChain
+                if ((node.point[i] < descriptions[i].min) || (node.point[i] > descriptions[i].max))
+                {
+                    node.log_density = -std::numeric_limits<double>::infinity();
+                    node.gradient.assign(dimension, 0.0);
+
+                    return;
+                }
+
+                descriptions[i].parameter->set(node.point[i]);
+            }
+
+            node.log_density = density->evaluate();
+            ++statistics.density_evaluations;
+
+            if (! std::isfinite(node.log_density))
+            {
+                node.gradient.assign(dimension, 0.0);
+
+                return;
+            }
+
+            compute_gradient(node.point, node.gradient);
+        }
+
+        // one step of the leapfrog integrator
+        void leapfrog(const Node & from, Node & to, const double & epsilon)
+        {
+            to.momentum = from.momentum;
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                to.momentum[i] += 0.5 * epsilon * from.gradient[i];
+            }
+
+            const std::vector<double> v = velocity(to.momentum);
+            to.point = from.point;
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                to.point[i] += epsilon * v[i];
+            }
+
+            evaluate(to);
+
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                to.momentum[i] += 0.5 * epsilon * to.gradient[i];
+            }
+        }
+
+        // true as long as the trajectory between minus and plus keeps expanding in both directions
+        bool no_u_turn(const Node & minus, const Node & plus) const
+        {
+            const std::vector<double> v_minus = velocity(minus.momentum), v_plus = velocity(plus.momentum);
+
+            double dot_minus = 0.0, dot_plus = 0.0;
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                const double delta = plus.point[i] - minus.point[i];
+                dot_minus += delta * v_minus[i];
+                dot_plus  += delta * v_plus[i];
+            }
+
+            return (dot_minus >= 0.0) && (dot_plus >= 0.0);
+        }
+
+        /* transitions */
+
+        void build_tree(const Node & start, const double & log_u, const int & direction, const unsigned & depth, const double & log_joint_0, Tree & tree)
+        {
+            if (0 == depth)
+            {
+                Node node;
+                leapfrog(start, node, direction * step_size);
+
+                const double log_joint_1 = log_joint(node);
+                tree.size = (log_u <= log_joint_1) ? 1.0 : 0.0;
+                tree.valid = (log_u < log_joint_1 + max_energy_error);
+                tree.divergent = ! tree.valid;
+                tree.sum_of_acceptance = std::min(1.0, std::exp(log_joint_1 - log_joint_0));
+                tree.steps = 1;
+                tree.minus = node;
+                tree.plus = node;
+                tree.proposal = node;
+
+                return;
+            }
+
+            build_tree(start, log_u, direction, depth - 1, log_joint_0, tree);
+            if (! tree.valid)
+                return;
+
+            Tree subtree;
+            build_tree((direction < 0) ? tree.minus : tree.plus, log_u, direction, depth - 1, log_joint_0, subtree);
+            if (direction < 0)
+            {
+                tree.minus = subtree.minus;
+            }
+            else
+            {
+                tree.plus = subtree.plus;
+            }
+
+            if ((subtree.size > 0.0) && (gsl_rng_uniform(rng) * (tree.size + subtree.size) < subtree.size))
+            {
+                tree.proposal = subtree.proposal;
+            }
+
+            tree.size += subtree.size;
+            tree.sum_of_acceptance += subtree.sum_of_acceptance;
+            tree.steps += subtree.steps;
+            tree.divergent = tree.divergent || subtree.divergent;
+            tree.valid = subtree.valid && no_u_turn(tree.minus, tree.plus);
+        }
+
+        // one iteration of NUTS, cf. [HG2014], algorithm 6; returns the average acceptance probability
+        double nuts_transition(bool & divergent)
+        {
+            Node start = current;
+            sample_momentum(start);
+
+            const double log_joint_0 = log_joint(start);
+            const double log_u = log_joint_0 + std::log(gsl_rng_uniform_pos(rng));
+
+            Tree tree;
+            tree.minus = start;
+            tree.plus = start;
+            tree.size = 1.0;
+
+            double sum_of_acceptance = 0.0;
+            unsigned steps = 0;
+            divergent = false;
+
+            for (unsigned depth = 0 ; depth < config.max_tree_depth ; ++depth)
+            {
+                const int direction = (gsl_rng_uniform(rng) < 0.5) ? -1 : +1;
+
+                Tree subtree;
+                build_tree((direction < 0) ? tree.minus : tree.plus, log_u, direction, depth, log_joint_0, subtree);
+                if (direction < 0)
+                {
+                    tree.minus = subtree.minus;
+                }
+                else
+                {
+                    tree.plus = subtree.plus;
+                }
+
+                sum_of_acceptance += subtree.sum_of_acceptance;
+                steps += subtree.steps;
+                divergent = divergent || subtree.divergent;
+
+                if (! subtree.valid)
+                    break;
+
+                if (gsl_rng_uniform(rng) * tree.size < subtree.size)
+                {
+                    current = subtree.proposal;
+                }
+
+                tree.size += subtree.size;
+
+                if (! no_u_turn(tree.minus, tree.plus))
+                    break;
+            }
+
+            return sum_of_acceptance / steps;
+        }
+
+        // one iteration of HMC with a fixed number of leapfrog steps; returns the acceptance probability
+        double static_transition(bool & divergent)
+        {
+            Node start = current;
+            sample_momentum(start);
+
+            const double log_joint_0 = log_joint(start);
+
+            Node node = start, next;
+            for (unsigned i = 0 ; i < config.leapfrog_steps ; ++i)
+            {
+                leapfrog(node, next, step_size);
+                std::swap(node, next);
+
+                if (! std::isfinite(node.log_density))
+                    break;
+            }
+
+            const double log_joint_1 = log_joint(node);
+            divergent = (log_joint_0 - log_joint_1 > max_energy_error);
+
+            const double acceptance = std::min(1.0, std::exp(log_joint_1 - log_joint_0));
+            if (gsl_rng_uniform(rng) < acceptance)
+            {
+                current = node;
+            }
+
+            return acceptance;
+        }
+
+        double transition(bool & divergent)
+        {
+            return config.use_nuts ? nuts_transition(divergent) : static_transition(divergent);
+        }
+
+        /* adaptation */
+
+        // a step size for which a single leapfrog step has an acceptance probability of roughly one half, cf. [HG2014], algorithm 4
+        void find_step_size()
+        {
+            Node start = current, next;
+            sample_momentum(start);
+
+            const double log_joint_0 = log_joint(start);
+            static const double log_half = std::log(0.5);
+
+            leapfrog(start, next, step_size);
+            double delta = log_joint(next) - log_joint_0;
+
+            const double direction = (delta > log_half) ? +1.0 : -1.0;
+            for (unsigned i = 0 ; (i < 100) && (direction * delta > direction * log_half) ; ++i)
+            {
+                step_size *= std::pow(2.0, direction);
+
+                leapfrog(start, next, step_size);
+                delta = log_joint(next) - log_joint_0;
+            }
+        }
+
+        void restart_step_size_adaptation()
+        {
+            find_step_size();
+
+            log_step_size_target = std::log(10.0 * step_size);
+            log_step_size_average = 0.0;
+            h_average = 0.0;
+            adaptation_steps = 0;
+        }
+
+        void adapt_step_size(const double & acceptance)
+        {
+            static const double gamma = 0.05, t0 = 10.0, kappa = 0.75;
+
+            ++adaptation_steps;
+
+            const double w = 1.0 / (adaptation_steps + t0);
+            h_average = (1.0 - w) * h_average + w * (config.target_acceptance - acceptance);
+
+            const double log_step_size = log_step_size_target - std::sqrt(adaptation_steps) / gamma * h_average;
+            const double eta = std::pow(adaptation_steps, -kappa);
+            log_step_size_average = eta * log_step_size + (1.0 - eta) * log_step_size_average;
+
+            step_size = std::exp(log_step_size);
+        }
+
+        void reset_covariance()
+        {
+            number_of_covariance_samples = 0;
+            sample_mean.assign(dimension, 0.0);
+            sample_m2.assign(dimension * dimension, 0.0);
+        }
+
+        void add_to_covariance(const std::vector<double> & point)
+        {
+            ++number_of_covariance_samples;
+
+            std::vector<double> delta(dimension);
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                delta[i] = point[i] - sample_mean[i];
+                sample_mean[i] += delta[i] / number_of_covariance_samples;
+            }
+
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                for (unsigned j = 0 ; j < dimension ; ++j)
+                {
+                    sample_m2[i * dimension + j] += delta[i] * (point[j] - sample_mean[j]);
+                }
+            }
+        }
+
+        // replace the inverse mass matrix by the regularized sample covariance
+        void update_metric()
+        {
+            const double n = number_of_covariance_samples;
+            if (n < 2)
+                return;
+
+            std::vector<double> metric(dimension * dimension, 0.0), factor;
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                for (unsigned j = 0 ; j < dimension ; ++j)
+                {
+                    if ((i != j) && (! config.dense_mass_matrix))
+                        continue;
+
+                    metric[i * dimension + j] = n / (n + 5.0) * sample_m2[i * dimension + j] / (n - 1.0);
+                }
+
+                // shrink towards a small multiple of the unit matrix
+                metric[i * dimension + i] += 1e-3 * 5.0 / (n + 5.0);
+            }
+
+            if (! cholesky(metric, factor))
+            {
+                Log::instance()->message("hamiltonian_monte_carlo_sampler.update_metric", ll_warning)
+                    << "Sample covariance is not positive definite, keeping the previous mass matrix";
+
+                return;
+            }
+
+            inverse_metric.swap(metric);
+            cholesky_factor.swap(factor);
+
+            Log::instance()->message("hamiltonian_monte_carlo_sampler.update_metric", ll_debug)
+                << "Updated the mass matrix from " << number_of_covariance_samples << " samples";
+        }
+
+        /* sampling */
+
+        void initialize()
+        {
+            current.point = config.initial_point;
+            if (current.point.empty())
+            {
+                for (auto & d : descriptions)
+                {
+                    current.point.push_back(d.parameter->evaluate());
+                }
+            }
+
+            if (current.point.size() != dimension)
+                throw InternalError("HamiltonianMonteCarloSampler: Dimension of the initial point (" + stringify(current.point.size())
+                        + ") does not match the dimension of the parameter space (" + stringify(dimension) + ")");
+
+            // prefer the analytic gradient, if provided
+            std::vector<double> gradient(dimension);
+            for (unsigned i = 0 ; i < dimension ; ++i)
+            {
+                descriptions[i].parameter->set(current.point[i]);
+            }
+            analytic_gradient = config.use_analytic_gradient && density->gradient(gradient);
+
+            if (! analytic_gradient)
+            {
+                const unsigned number_of_workers = config.parallelize
+                    ? std::max(1u, std::min(ThreadPool::instance()->number_of_threads(), dimension))
+                    : 1u;
+
+                workers.clear();
+                for (unsigned w = 0 ; w < number_of_workers ; ++w)
+                {
+                    workers.push_back(std::make_shared<GradientWorker>(density, config.gradient_step_size));
+                }
+            }
+
+            Log::instance()->message("hamiltonian_monte_carlo_sampler.initialize", ll_informational)
+                << "Using " << (analytic_gradient ? std::string("the analytic gradient") : "finite differences on " + stringify(workers.size()) + " threads");
+
+            evaluate(current);
+            if (! std::isfinite(current.log_density))
+                throw InternalError("HamiltonianMonteCarloSampler: log(density) at the initial point is not finite");
+        }
+
+        void warmup()
+        {
+            const unsigned iterations = config.warmup_iterations;
+
+            Log::instance()->message("hamiltonian_monte_carlo_sampler.warmup", ll_informational)
+                << "Commencing the warmup with " << iterations << " iterations";
+
+            restart_step_size_adaptation();
+
+            // windows for the estimation of the mass matrix, as in Stan: a fast initial and final phase,
+            // and in between windows of doubling size
+            unsigned initial_buffer = 75, final_buffer = 50, window = 25;
+            if (initial_buffer + final_buffer + window > iterations)
+            {
+                initial_buffer = 0.15 * iterations;
+                final_buffer = 0.1 * iterations;
+                window = iterations - initial_buffer - final_buffer;
+            }
+            const unsigned windows_end = iterations - final_buffer;
+            unsigned window_end = initial_buffer + window;
+            const bool adapt_mass_matrix = config.adapt_mass_matrix && (iterations >= 20);
+
+            reset_covariance();
+
+            for (unsigned i = 0 ; i < iterations ; ++i)
+            {
+                bool divergent;
+                const double acceptance = transition(divergent);
+                adapt_step_size(acceptance);
+
+                if ((! adapt_mass_matrix) || (i < initial_buffer) || (i >= windows_end))
+                    continue;
+
+                add_to_covariance(current.point);
+
+                if (i + 1 != window_end)
+                    continue;
+
+                update_metric();
+                reset_covariance();
+                restart_step_size_adaptation();
+
+                // extend the next window to the end of the adaptation if the window after it would not fit
+                window *= 2;
+                window_end = (window_end + 3 * window > windows_end) ? windows_end : window_end + window;
+            }
+
+            if (iterations > 0)
+            {
+                step_size = std::exp(log_step_size_average);
+            }
+
+            Log::instance()->message("hamiltonian_monte_carlo_sampler.warmup", ll_informational)
+                << "Finished the warmup with step size " << step_size;
+        }
+
+        void main_run()
+        {
+            Log::instance()->message("hamiltonian_monte_carlo_sampler.main_run", ll_informational)
+                << "Commencing the main run with " << config.iterations << " iterations";
+
+            statistics = HamiltonianMonteCarloSampler::Statistics{ 0, 0, 0, 0.0 };
+
+            history.states.clear();
+            history.states.reserve(config.iterations);
+
+            double sum_of_acceptance = 0.0;
+            for (unsigned i = 0 ; i < config.iterations ; ++i)
+            {
+                bool divergent;
+                sum_of_acceptance += transition(divergent);
+
+                if (divergent)
+                    ++statistics.divergent_transitions;
+
+                MarkovChain::State state;
+                state.point = current.point;
+                state.log_density = current.log_density;
+                history.states.push_back(state);
+            }
+
+            statistics.mean_acceptance = (config.iterations > 0) ? sum_of_acceptance / config.iterations : 0.0;
+
+            Log::instance()->message("hamiltonian_monte_carlo_sampler.main_run", ll_informational)
+                << "Finished the main run: mean acceptance = " << statistics.mean_acceptance
+                << ", divergent transitions = " << statistics.divergent_transitions
+                << ", density evaluations = " << statistics.density_evaluations;
+        }
+
+        void store() const
+        {
+            if (config.output_file.empty())
+                return;
+
+            hdf5::File file = hdf5::File::Create(config.output_file);
+
+            // use the layout of a single chain of MarkovChainSampler, as expected by SampleStore::MarkovChains
+            density->dump_descriptions(file, "/descriptions/main run/chain #0");
+
+            MarkovChain::Stats stats = MarkovChain::Stats();
+            stats.mode = -std::numeric_limits<double>::infinity();
+            stats.parameters_at_mode = current.point;
+            for (auto & s : history.states)
+            {
+                if (s.log_density <= stats.mode)
+                    continue;
+
+                stats.mode = s.log_density;
+                stats.parameters_at_mode = s.point;
+            }
+
+            MarkovChain::dump_states(file, "/main run/chain #0", history.states, stats);
+        }
+
+        void run()
+        {
+            initialize();
+
+            warmup();
+
+            main_run();
+
+            store();
+        }
+    };
+
+    constexpr double Implementation<HamiltonianMonteCarloSampler>::max_energy_error;
+
+    HamiltonianMonteCarloSampler::HamiltonianMonteCarloSampler(const DensityPtr & density, const HamiltonianMonteCarloSampler::Config & config) :
+        PrivateImplementationPattern<HamiltonianMonteCarloSampler>(new Implementation<HamiltonianMonteCarloSampler>(density, config))
+    {
+    }
+
+    HamiltonianMonteCarloSampler::~HamiltonianMonteCarloSampler()
+    {
+    }
+
+    void
+    HamiltonianMonteCarloSampler::run()
+    {
+        _imp->run();
+    }
+
+    const MarkovChain::History &
+    HamiltonianMonteCarloSampler::history() const
+    {
+        return _imp->history;
+    }
+
+    double
+    HamiltonianMonteCarloSampler::step_size() const
+    {
+        return _imp->step_size;
+    }
+
+    const std::vector<double> &
+    HamiltonianMonteCarloSampler::inverse_mass_matrix() const
+    {
+        return _imp->inverse_metric;
+    }
+
+    const HamiltonianMonteCarloSampler::Statistics &
+    HamiltonianMonteCarloSampler::statistics() const
+    {
+        return _imp->statistics;
+    }
+}
@@ -0,0 +1,180 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_HAMILTONIAN_MONTE_CARLO_SAMPLER_HH
+#define EOS_GUARD_EOS_STATISTICS_HAMILTONIAN_MONTE_CARLO_SAMPLER_HH 1
+
+#include <eos/statistics/markov-chain.hh>
+#include <eos/utils/density-fwd.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+#include <eos/utils/verify.hh>
+
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Sample from a density with Hamiltonian Monte Carlo (HMC), optionally using
+     * the No-U-Turn criterion (NUTS) to choose the length of each trajectory,
+     * cf. [HG2014], arXiv:1111.4246.
+     *
+     * During the warmup, the step size of the leapfrog integrator is tuned by dual
+     * averaging towards a target acceptance rate, and the mass matrix is estimated
+     * from the covariance of the samples in windows of increasing size.
+     *
+     * The gradient of the log(density) is taken from Density::gradient() where available.
+     * Otherwise it is computed from central finite differences, with steps proportional
+     * to the ranges of the parameters. Their evaluations are distributed among the threads
+     * of the ThreadPool, each of which uses its own clone of the density.
+     */
+    class HamiltonianMonteCarloSampler :
+        public PrivateImplementationPattern<HamiltonianMonteCarloSampler>
+    {
+        public:
+            struct Config;
+            struct Statistics;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param density The density to sample from.
+             * @param config  The configuration of the sampler.
+             */
+            HamiltonianMonteCarloSampler(const DensityPtr & density, const HamiltonianMonteCarloSampler::Config & config);
+
+            /// Destructor.
+            ~HamiltonianMonteCarloSampler();
+            ///@}
+
+            ///@name Sampling
+            ///@{
+            /// Perform the warmup, and collect the samples thereafter.
+            void run();
+
+            /// Retrieve the samples collected after the warmup, comprising the points and their log(density).
+            const MarkovChain::History & history() const;
+
+            /// Retrieve the step size of the leapfrog integrator.
+            double step_size() const;
+
+            /// Retrieve the inverse of the mass matrix, i.e., the estimate of the covariance matrix, in row-major order.
+            const std::vector<double> & inverse_mass_matrix() const;
+
+            /// Retrieve statistics on the sampling after the warmup.
+            const HamiltonianMonteCarloSampler::Statistics & statistics() const;
+            ///@}
+    };
+
+    /*!
+     * Stores all configuration options for a HamiltonianMonteCarloSampler.
+     */
+    struct HamiltonianMonteCarloSampler::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            /// Constructor with the default settings.
+            static Config Default();
+
+            ///@name Basic options
+            ///@{
+            /// The seed that is used to initialize the random number generator.
+            unsigned long seed;
+
+            /*!
+             * If true, distribute the evaluations of finite-difference gradients among the threads of the ThreadPool.
+             * If false, use only one thread.
+             */
+            bool parallelize;
+
+            /// The starting point of the chain. If empty, the current values of the density's parameters are used.
+            std::vector<double> initial_point;
+
+            /// Whether to use the gradient provided by the density, if any.
+            bool use_analytic_gradient;
+
+            /// The step of the finite-difference gradient, relative to the range of each parameter.
+            VerifiedRange<double> gradient_step_size;
+            ///@}
+
+            ///@name Trajectory options
+            ///@{
+            /// If true, choose the number of leapfrog steps according to the No-U-Turn criterion.
+            bool use_nuts;
+
+            /// The maximal depth of the trajectory tree built by NUTS, i.e., at most 2^max_tree_depth - 1 leapfrog steps.
+            VerifiedRange<unsigned> max_tree_depth;
+
+            /// The number of leapfrog steps per trajectory if NUTS is not used.
+            VerifiedRange<unsigned> leapfrog_steps;
+            ///@}
+
+            ///@name Warmup options
+            ///@{
+            /// The number of warmup iterations, during which the step size and the mass matrix are adapted.
+            unsigned warmup_iterations;
+
+            /// The step size is adapted such that the average acceptance probability approaches this value.
+            VerifiedRange<double> target_acceptance;
+
+            /// Whether to estimate the mass matrix during the warmup. If false, the unit matrix is used.
+            bool adapt_mass_matrix;
+
+            /// Whether to estimate a dense mass matrix, or only its diagonal.
+            bool dense_mass_matrix;
+            ///@}
+
+            ///@name Main run options
+            ///@{
+            /// The number of samples collected after the warmup.
+            unsigned iterations;
+
+            /*!
+             * The HDF5 output file to store the samples, in the layout of a single chain of
+             * MarkovChainSampler below '/main run'. If empty, the samples are not stored.
+             */
+            std::string output_file;
+            ///@}
+    };
+
+    /*!
+     * Statistics on the sampling after the warmup.
+     */
+    struct HamiltonianMonteCarloSampler::Statistics
+    {
+        /// The number of evaluations of the density, including those for finite-difference gradients.
+        unsigned long density_evaluations;
+
+        /// The number of evaluations of the gradient.
+        unsigned long gradient_evaluations;
+
+        /// The number of trajectories that diverged, i.e., where the energy error became too large.
+        unsigned divergent_transitions;
+
+        /// The average acceptance probability of the proposals.
+        double mean_acceptance;
+    };
+}
+
+#endif
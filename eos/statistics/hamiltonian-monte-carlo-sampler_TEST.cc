@@ -0,0 +1,220 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/density-wrapper.hh>
+#include <eos/statistics/hamiltonian-monte-carlo-sampler.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/power_of.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+// correlated normal distribution with sigma_x = 1, sigma_y = 2, and correlation rho = 0.9
+namespace
+{
+    const double rho = 0.9;
+
+    double correlated_normal(const std::vector<double> & x)
+    {
+        const double u = x[0] / 1.0, v = x[1] / 2.0;
+
+        return -0.5 * (u * u - 2.0 * rho * u * v + v * v) / (1.0 - rho * rho);
+    }
+
+    // the same, with a large constant that amplifies the round-off errors of finite differences
+    double offset_correlated_normal(const std::vector<double> & x)
+    {
+        return 1.0e8 + correlated_normal(x);
+    }
+
+    void correlated_normal_gradient(const std::vector<double> & x, std::vector<double> & gradient)
+    {
+        const double u = x[0] / 1.0, v = x[1] / 2.0;
+
+        gradient[0] = -(u - rho * v) / (1.0 - rho * rho) / 1.0;
+        gradient[1] = -(v - rho * u) / (1.0 - rho * rho) / 2.0;
+    }
+
+    DensityWrapper make_density(double (* f)(const std::vector<double> &) = &correlated_normal)
+    {
+        DensityWrapper density(f);
+        density.add_parameter("x", -10.0, +10.0);
+        density.add_parameter("y", -20.0, +20.0);
+        density.parameters()[0] = 0.5;
+        density.parameters()[1] = -0.5;
+
+        return density;
+    }
+
+    void check_moments(const HamiltonianMonteCarloSampler & sampler, const unsigned & iterations)
+    {
+        const MarkovChain::History & history = sampler.history();
+        TEST_CHECK_EQUAL(history.states.size(), iterations);
+
+        std::vector<double> means, variances;
+        history.mean_and_variance(history.states.cbegin(), history.states.cend(), means, variances);
+
+        TEST_CHECK_NEARLY_EQUAL(means[0],      0.0, 0.15);
+        TEST_CHECK_NEARLY_EQUAL(means[1],      0.0, 0.30);
+        TEST_CHECK_RELATIVE_ERROR(variances[0], 1.0, 0.15);
+        TEST_CHECK_RELATIVE_ERROR(variances[1], 4.0, 0.15);
+
+        // the mass matrix approximates the covariance matrix
+        const std::vector<double> & inverse_mass_matrix = sampler.inverse_mass_matrix();
+        TEST_CHECK_RELATIVE_ERROR(inverse_mass_matrix[0], 1.0,       0.3);
+        TEST_CHECK_RELATIVE_ERROR(inverse_mass_matrix[1], 2.0 * rho, 0.3);
+        TEST_CHECK_RELATIVE_ERROR(inverse_mass_matrix[3], 4.0,       0.3);
+    }
+}
+
+class HamiltonianMonteCarloSamplerTest :
+    public TestCase
+{
+    public:
+        HamiltonianMonteCarloSamplerTest() :
+            TestCase("hamiltonian_monte_carlo_sampler_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // NUTS with finite-difference gradients
+            {
+                DensityWrapper density = make_density();
+
+                HamiltonianMonteCarloSampler::Config config = HamiltonianMonteCarloSampler::Config::Default();
+                config.seed = 1234;
+                config.warmup_iterations = 1000;
+                config.iterations = 4000;
+                config.parallelize = true;
+
+                HamiltonianMonteCarloSampler sampler(density.clone(), config);
+                sampler.run();
+
+                check_moments(sampler, 4000);
+
+                const HamiltonianMonteCarloSampler::Statistics & statistics = sampler.statistics();
+                TEST_CHECK_EQUAL(statistics.divergent_transitions, 0);
+                TEST_CHECK(statistics.mean_acceptance > 0.7);
+
+                // four evaluations per dimension and gradient, and one for the log(density)
+                TEST_CHECK(statistics.density_evaluations >= 4 * 2 * statistics.gradient_evaluations);
+            }
+
+            // finite-difference steps that scale with the parameter ranges are robust against a large log(density)
+            {
+                DensityWrapper density = make_density(&offset_correlated_normal);
+
+                HamiltonianMonteCarloSampler::Config config = HamiltonianMonteCarloSampler::Config::Default();
+                config.seed = 1234;
+                config.warmup_iterations = 1000;
+                config.iterations = 4000;
+                config.parallelize = false;
+
+                HamiltonianMonteCarloSampler sampler(density.clone(), config);
+                sampler.run();
+
+                check_moments(sampler, 4000);
+                TEST_CHECK_EQUAL(sampler.statistics().divergent_transitions, 0);
+            }
+
+            // NUTS with the analytic gradient
+            {
+                DensityWrapper density = make_density();
+                density.set_gradient(&correlated_normal_gradient);
+
+                HamiltonianMonteCarloSampler::Config config = HamiltonianMonteCarloSampler::Config::Default();
+                config.seed = 1234;
+                config.warmup_iterations = 1000;
+                config.iterations = 4000;
+
+                HamiltonianMonteCarloSampler sampler(density.clone(), config);
+                sampler.run();
+
+                check_moments(sampler, 4000);
+
+                const HamiltonianMonteCarloSampler::Statistics & statistics = sampler.statistics();
+                TEST_CHECK_EQUAL(statistics.density_evaluations, statistics.gradient_evaluations);
+            }
+
+            // static HMC with a fixed number of leapfrog steps
+            {
+                DensityWrapper density = make_density();
+
+                HamiltonianMonteCarloSampler::Config config = HamiltonianMonteCarloSampler::Config::Default();
+                config.seed = 4321;
+                config.use_nuts = false;
+                config.leapfrog_steps = 8;
+                config.warmup_iterations = 1000;
+                config.iterations = 4000;
+                config.parallelize = false;
+
+                HamiltonianMonteCarloSampler sampler(density.clone(), config);
+                sampler.run();
+
+                check_moments(sampler, 4000);
+            }
+
+            // the samples are stored in the layout of MarkovChainSampler
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/hamiltonian-monte-carlo-sampler_TEST.hdf5");
+
+                DensityWrapper density = make_density();
+                density.set_gradient(&correlated_normal_gradient);
+
+                HamiltonianMonteCarloSampler::Config config = HamiltonianMonteCarloSampler::Config::Default();
+                config.seed = 1234;
+                config.warmup_iterations = 100;
+                config.iterations = 50;
+                config.output_file = file_name;
+
+                HamiltonianMonteCarloSampler sampler(density.clone(), config);
+                sampler.run();
+
+                auto file = hdf5::File::Open(file_name, H5F_ACC_RDONLY);
+                TEST_CHECK(file.group_exists("/descriptions/main run/chain #0"));
+
+                auto data_set = file.open_data_set("/main run/chain #0/samples", hdf5::Array<1, double>("samples", { 3 }));
+                TEST_CHECK_EQUAL(data_set.records(), 50u);
+
+                std::vector<double> record(3);
+                for (const auto & state : sampler.history().states)
+                {
+                    data_set >> record;
+                    TEST_CHECK_EQUAL(record[0], state.point[0]);
+                    TEST_CHECK_EQUAL(record[1], state.point[1]);
+                    TEST_CHECK_EQUAL(record[2], state.log_density);
+                }
+            }
+
+            // invalid initial point
+            {
+                DensityWrapper density = make_density();
+
+                HamiltonianMonteCarloSampler::Config config = HamiltonianMonteCarloSampler::Config::Default();
+                config.initial_point = std::vector<double>{ 0.0 };
+
+                HamiltonianMonteCarloSampler sampler(density.clone(), config);
+                TEST_CHECK_THROWS(InternalError, sampler.run());
+            }
+        }
+} hamiltonian_monte_carlo_sampler_test;
@@ -0,0 +1,427 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/importance-reweighting.hh>
+#include <eos/statistics/log-likelihood.hh>
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace eos
+{
+    ImportanceReweighting::Config::Config() :
+        parallelize(true),
+        number_of_workers(4),
+        output_base("/data")
+    {
+    }
+
+    ImportanceReweighting::Config
+    ImportanceReweighting::Config::Default()
+    {
+        return Config();
+    }
+
+    ImportanceReweighting::Status::Status() :
+        number_of_samples(0),
+        eff_sample_size(0.0),
+        perplexity(0.0),
+        log_evidence_ratio(-std::numeric_limits<double>::infinity())
+    {
+    }
+
+    template <>
+    struct Implementation<ImportanceReweighting>
+    {
+        struct Worker
+        {
+            // Independent copy of the additional likelihood.
+            LogLikelihood log_likelihood;
+
+            // Descriptions bound to the parameters of our copy of the likelihood.
+            std::vector<ParameterDescription> descriptions;
+
+            Worker(const LogLikelihood & log_likelihood, const std::vector<ParameterDescription> & descriptions) :
+                log_likelihood(log_likelihood.clone())
+            {
+                Parameters p = this->log_likelihood.parameters();
+                for (const auto & d : descriptions)
+                {
+                    this->descriptions.push_back(ParameterDescription{ p[d.parameter->name()].clone(), d.min, d.max, d.nuisance });
+                }
+            }
+
+            /*!
+             * Evaluate the additional likelihood for all samples in [first, last),
+             * and store the results starting at result.
+             */
+            void evaluate(ImportanceReweighting::SamplesList::const_iterator first,
+                    ImportanceReweighting::SamplesList::const_iterator last,
+                    std::vector<double>::iterator result)
+            {
+                for ( ; first != last ; ++first, ++result)
+                {
+                    *result = evaluate(first->cbegin());
+                }
+            }
+
+            /*!
+             * Evaluate the additional likelihood for all samples in the store,
+             * and store the results and the samples' log weights starting at result
+             * and log_weight, respectively.
+             */
+            void evaluate_store(const SampleStore & samples,
+                    std::vector<double>::iterator result,
+                    std::vector<double>::iterator log_weight)
+            {
+                for (unsigned i = 0 ; i < samples.size() ; ++i, ++result, ++log_weight)
+                {
+                    auto row = samples[i];
+                    *result = evaluate(row.begin());
+                    *log_weight = row.log_weight();
+                }
+            }
+
+            template <typename Iterator_>
+            double evaluate(Iterator_ values)
+            {
+                for (auto d = descriptions.begin(), d_end = descriptions.end() ; d != d_end ; ++d, ++values)
+                {
+                    d->parameter->set(*values);
+                }
+
+                return log_likelihood();
+            }
+        };
+
+        typedef std::function<void (Worker &, const unsigned &, const unsigned &)> Job;
+
+        ImportanceReweighting::Config config;
+
+        Parameters parameters;
+
+        std::vector<ParameterDescription> descriptions;
+
+        LogLikelihood log_likelihood;
+
+        ImportanceReweighting::Status status;
+
+        Implementation(const Parameters & parameters, const std::vector<ParameterDescription> & descriptions,
+                const ImportanceReweighting::Config & config) :
+            config(config),
+            parameters(parameters),
+            log_likelihood(parameters)
+        {
+            if (0 == config.number_of_workers)
+                throw InternalError("ImportanceReweighting: Need at least one worker");
+
+            for (const auto & d : descriptions)
+            {
+                this->descriptions.push_back(ParameterDescription{ this->parameters[d.parameter->name()].clone(), d.min, d.max, d.nuisance });
+            }
+        }
+
+        std::vector<double> run(const ImportanceReweighting::SamplesList & samples, const std::vector<double> & log_weights)
+        {
+            if (samples.empty())
+                throw InternalError("ImportanceReweighting::run: No samples given");
+
+            if ((! log_weights.empty()) && (log_weights.size() != samples.size()))
+                throw InternalError("ImportanceReweighting::run: Mismatch between number of samples (" + stringify(samples.size())
+                        + ") and number of weights (" + stringify(log_weights.size()) + ")");
+
+            for (const auto & s : samples)
+            {
+                if (s.size() < descriptions.size())
+                    throw InternalError("ImportanceReweighting::run: Sample dimension " + stringify(s.size())
+                            + " is smaller than number of parameters " + stringify(descriptions.size()));
+            }
+
+            std::vector<double> delta_log_likelihood(samples.size(), 0.0);
+            distribute(samples.size(), [&] (Worker & w, const unsigned & first, const unsigned & last)
+            {
+                w.evaluate(samples.cbegin() + first, samples.cbegin() + last, delta_log_likelihood.begin() + first);
+            });
+
+            return combine(delta_log_likelihood, log_weights);
+        }
+
+        std::vector<double> run(const SampleStore & samples)
+        {
+            if (0 == samples.size())
+                throw InternalError("ImportanceReweighting::run: No samples given");
+
+            if (samples.dimension() < descriptions.size())
+                throw InternalError("ImportanceReweighting::run: Sample dimension " + stringify(samples.dimension())
+                        + " is smaller than number of parameters " + stringify(descriptions.size()));
+
+            std::vector<double> delta_log_likelihood(samples.size(), 0.0);
+            std::vector<double> log_weights(samples.size(), 0.0);
+            distribute(samples.size(), [&] (Worker & w, const unsigned & first, const unsigned & last)
+            {
+                w.evaluate_store(samples.slice(first, last), delta_log_likelihood.begin() + first, log_weights.begin() + first);
+            });
+
+            return combine(delta_log_likelihood, samples.weighted() ? log_weights : std::vector<double>());
+        }
+
+        /*
+         * Distribute disjoint ranges of samples among the workers.
+         */
+        void distribute(const unsigned & number_of_samples, const Job & job)
+        {
+            Log::instance()->message("importance_reweighting.run", ll_informational)
+                << "Evaluating " << log_likelihood.number_of_observations() << " additional observations for "
+                << number_of_samples << " samples";
+
+            const unsigned number_of_workers = std::min<unsigned>(config.number_of_workers, number_of_samples);
+            const unsigned average_samples_per_worker = number_of_samples / number_of_workers;
+            const unsigned remainder = number_of_samples % number_of_workers;
+
+            std::vector<std::shared_ptr<Worker>> workers;
+            std::vector<Ticket> tickets;
+            for (unsigned w = 0 ; w < number_of_workers ; ++w)
+            {
+                workers.push_back(std::make_shared<Worker>(log_likelihood, descriptions));
+
+                unsigned samples_per_worker = average_samples_per_worker;
+
+                // last worker gets the remainder
+                if (w == number_of_workers - 1)
+                    samples_per_worker += remainder;
+
+                const unsigned first = w * average_samples_per_worker;
+                std::function<void (void)> f = std::bind(job, std::ref(*workers.back()), first, first + samples_per_worker);
+
+                if (config.parallelize)
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue(f));
+                }
+                else
+                {
+                    f();
+                }
+            }
+
+            for (auto & t : tickets)
+            {
+                t.wait();
+            }
+        }
+
+        /*
+         * Combine the old weights with the additional likelihood.
+         */
+        std::vector<double> combine(std::vector<double> & delta_log_likelihood, const std::vector<double> & log_weights)
+        {
+            const unsigned number_of_samples = delta_log_likelihood.size();
+
+            std::vector<double> result(number_of_samples);
+            unsigned invalid = 0;
+            for (unsigned i = 0 ; i < number_of_samples ; ++i)
+            {
+                if (! std::isfinite(delta_log_likelihood[i]))
+                {
+                    ++invalid;
+                    delta_log_likelihood[i] = -std::numeric_limits<double>::infinity();
+                }
+
+                result[i] = delta_log_likelihood[i] + (log_weights.empty() ? 0.0 : log_weights[i]);
+            }
+
+            if (invalid > 0)
+            {
+                Log::instance()->message("importance_reweighting.run", ll_warning)
+                    << "Additional likelihood is not finite for " << invalid << " samples; assigning zero weight";
+            }
+
+            status = ImportanceReweighting::Status();
+            ImportanceReweighting::diagnostics(result, status);
+
+            // log(Z_new / Z_old) = log(sum w_new) - log(sum w_old)
+            {
+                const double max_new = *std::max_element(result.cbegin(), result.cend());
+                double sum_new = 0.0, sum_old = 0.0;
+                double max_old = 0.0;
+                if (! log_weights.empty())
+                    max_old = *std::max_element(log_weights.cbegin(), log_weights.cend());
+
+                for (unsigned i = 0 ; i < number_of_samples ; ++i)
+                {
+                    sum_new += std::exp(result[i] - max_new);
+                    sum_old += log_weights.empty() ? 1.0 : std::exp(log_weights[i] - max_old);
+                }
+
+                if (std::isfinite(max_new))
+                    status.log_evidence_ratio = (max_new + std::log(sum_new)) - (max_old + std::log(sum_old));
+            }
+
+            Log::instance()->message("importance_reweighting.run", ll_informational)
+                << "Relative effective sample size = " << status.eff_sample_size
+                << ", relative perplexity = " << status.perplexity
+                << ", log(Z_new / Z_old) = " << status.log_evidence_ratio;
+
+            if (config.output_file)
+                dump(delta_log_likelihood, result);
+
+            return result;
+        }
+
+        void dump(const std::vector<double> & delta_log_likelihood, const std::vector<double> & log_weights)
+        {
+            auto weight_data_set = config.output_file->create_or_open_data_set(config.output_base + "/weights",
+                    ImportanceReweighting::Output::weight_type());
+            auto weight_record = std::make_tuple(0.0, 0.0);
+            for (unsigned i = 0 ; i < log_weights.size() ; ++i)
+            {
+                std::get<0>(weight_record) = delta_log_likelihood[i];
+                std::get<1>(weight_record) = log_weights[i];
+                weight_data_set << weight_record;
+            }
+
+            auto statistics_data_set = config.output_file->create_or_open_data_set(config.output_base + "/statistics",
+                    ImportanceReweighting::Output::statistics_type());
+            auto statistics_record = std::make_tuple(status.eff_sample_size, status.perplexity, status.log_evidence_ratio);
+            statistics_data_set << statistics_record;
+
+            // record the constraints used for reweighting
+            unsigned counter = 0;
+            for (auto c = log_likelihood.begin(), c_end = log_likelihood.end() ; c != c_end ; ++c, ++counter)
+            {
+                auto attr = statistics_data_set.create_or_open_attribute("constraint #" + stringify(counter), hdf5::Scalar<const char *>("name"));
+                attr = c->name().str().c_str();
+            }
+        }
+    };
+
+    ImportanceReweighting::ImportanceReweighting(const Parameters & parameters, const std::vector<ParameterDescription> & descriptions,
+            const ImportanceReweighting::Config & config) :
+        PrivateImplementationPattern<ImportanceReweighting>(new Implementation<ImportanceReweighting>(parameters, descriptions, config))
+    {
+    }
+
+    ImportanceReweighting::~ImportanceReweighting()
+    {
+    }
+
+    void
+    ImportanceReweighting::add(const Constraint & constraint)
+    {
+        _imp->log_likelihood.add(constraint);
+    }
+
+    void
+    ImportanceReweighting::add(const ObservablePtr & observable, const double & min,
+            const double & central, const double & max, const unsigned & number_of_observations)
+    {
+        _imp->log_likelihood.add(observable, min, central, max, number_of_observations);
+    }
+
+    const ImportanceReweighting::Config &
+    ImportanceReweighting::config() const
+    {
+        return _imp->config;
+    }
+
+    const ImportanceReweighting::Status &
+    ImportanceReweighting::status() const
+    {
+        return _imp->status;
+    }
+
+    std::vector<double>
+    ImportanceReweighting::run(const ImportanceReweighting::SamplesList & samples, const std::vector<double> & log_weights)
+    {
+        return _imp->run(samples, log_weights);
+    }
+
+    std::vector<double>
+    ImportanceReweighting::run(const SampleStore & samples)
+    {
+        return _imp->run(samples);
+    }
+
+    void
+    ImportanceReweighting::diagnostics(const std::vector<double> & log_weights, ImportanceReweighting::Status & status)
+    {
+        status.number_of_samples = log_weights.size();
+        status.eff_sample_size = 0.0;
+        status.perplexity = 0.0;
+
+        if (log_weights.empty())
+            return;
+
+        // rescale by the largest weight to avoid overflow
+        const double max = *std::max_element(log_weights.cbegin(), log_weights.cend());
+        if (! std::isfinite(max))
+            return;
+
+        double sum = 0.0, sum_of_squares = 0.0;
+        for (const auto & l : log_weights)
+        {
+            const double w = std::exp(l - max);
+            sum += w;
+            sum_of_squares += w * w;
+        }
+
+        // Kish's effective sample size
+        status.eff_sample_size = sum * sum / sum_of_squares / log_weights.size();
+
+        // perplexity exp(H), with H the Shannon entropy of the normalized weights
+        double entropy = 0.0;
+        for (const auto & l : log_weights)
+        {
+            const double w = std::exp(l - max) / sum;
+            if (w > 0.0)
+                entropy -= w * std::log(w);
+        }
+        status.perplexity = std::exp(entropy) / log_weights.size();
+    }
+
+    ImportanceReweighting::Output::WeightType
+    ImportanceReweighting::Output::weight_type()
+    {
+        return WeightType
+        {
+            "weights",
+            hdf5::Scalar<double>("delta log likelihood"),
+            hdf5::Scalar<double>("log weight"),
+        };
+    }
+
+    ImportanceReweighting::Output::StatisticsType
+    ImportanceReweighting::Output::statistics_type()
+    {
+        return StatisticsType
+        {
+            "statistics",
+            hdf5::Scalar<double>("effective sample size"),
+            hdf5::Scalar<double>("perplexity"),
+            hdf5::Scalar<double>("log evidence ratio"),
+        };
+    }
+}
@@ -0,0 +1,199 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_STATISTICS_IMPORTANCE_REWEIGHTING_HH
+#define EOS_GUARD_SRC_STATISTICS_IMPORTANCE_REWEIGHTING_HH 1
+
+#include <eos/constraint.hh>
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/hdf5-fwd.hh>
+#include <eos/utils/parameters.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Update existing posterior samples to account for additional constraints.
+     *
+     * Each stored sample is assigned a new importance weight
+     *
+     *   log w_new = log w_old + log L_new(theta),
+     *
+     * where L_new is the product of all LogLikelihoodBlocks that have been added
+     * to this object. Only the added likelihood blocks are evaluated, which is
+     * considerably cheaper than rerunning the sampling of the full posterior.
+     * The result is trustworthy only as long as the effective sample size remains
+     * large.
+     */
+    class ImportanceReweighting :
+        public PrivateImplementationPattern<ImportanceReweighting>
+    {
+        public:
+            struct Config;
+            struct Output;
+            struct Status;
+
+            typedef std::vector<std::vector<double>> SamplesList;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param parameters   The Parameters object to which all added constraints are bound.
+             * @param descriptions The descriptions of the parameters, in the order in which they appear in each sample.
+             * @param config       The configuration options.
+             */
+            ImportanceReweighting(const Parameters & parameters, const std::vector<ParameterDescription> & descriptions,
+                    const Config & config);
+
+            /// Destructor.
+            ~ImportanceReweighting();
+            ///@}
+
+            ///@name Access
+            ///@{
+            /*!
+             * Add one of the library's experimental constraints to the
+             * likelihood used for reweighting.
+             *
+             * @param constraint The new experimental constraint, cf. Constraint::make
+             */
+            void add(const Constraint & constraint);
+
+            /*!
+             * Add an observable and its associated measurement to the likelihood used for
+             * reweighting.
+             *
+             * @param observable                The Observable that shall be added to the calculation of the likelihood.
+             * @param min                       The lower bound on the measurement.
+             * @param central                   The central value of the measurement.
+             * @param max                       The upper bound on the measurement.
+             * @param number_of_observations    The number of observations associated with the measurement. Defaults to 1.
+             */
+            void add(const ObservablePtr & observable, const double & min,
+                    const double & central, const double & max, const unsigned & number_of_observations = 1u);
+
+            /// Retrieve the configuration from which this object was constructed.
+            const ImportanceReweighting::Config & config() const;
+
+            /// Retrieve the status of the last reweighting.
+            const ImportanceReweighting::Status & status() const;
+            ///@}
+
+            ///@name Reweighting
+            ///@{
+            /*!
+             * Compute the new importance weights for the given samples.
+             *
+             * @param samples     The parameter samples. Only the first descriptions.size() entries of each sample are used.
+             * @param log_weights The logarithm of the samples' current weights. If empty, all samples are weighted equally.
+             * @return The logarithm of the new, unnormalized importance weights.
+             */
+            std::vector<double> run(const SamplesList & samples, const std::vector<double> & log_weights = std::vector<double>());
+
+            /*!
+             * Compute the new importance weights for the samples in a SampleStore.
+             *
+             * The samples' stored weights are used as the old weights, if present.
+             *
+             * @param samples The parameter samples. Only the first descriptions.size() parameters of each sample are used.
+             * @return The logarithm of the new, unnormalized importance weights.
+             */
+            std::vector<double> run(const SampleStore & samples);
+            ///@}
+
+            /*!
+             * Compute the normalized effective sample size and the normalized perplexity
+             * of a set of importance weights.
+             *
+             * @param log_weights The logarithm of the unnormalized importance weights.
+             * @param status      Upon return, contains the diagnostics.
+             */
+            static void diagnostics(const std::vector<double> & log_weights, ImportanceReweighting::Status & status);
+    };
+
+    /*!
+     * Store configuration options
+     */
+    struct ImportanceReweighting::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            /// Constructor with the default settings.
+            static Config Default();
+
+            /*!
+             * If true, use as many threads as there are cores available.
+             * If false, use only one thread.
+             */
+            bool parallelize;
+
+            /// Number of workers among which the samples are distributed.
+            unsigned number_of_workers;
+
+            /// The file where the new weights and diagnostics are stored. May be empty.
+            std::shared_ptr<hdf5::File> output_file;
+
+            /// The directory within the output file.
+            std::string output_base;
+    };
+
+    /*!
+     * Diagnostics of the reweighted samples.
+     */
+    struct ImportanceReweighting::Status
+    {
+        Status();
+
+        /// The number of samples that were reweighted.
+        unsigned number_of_samples;
+
+        /// Effective sample size in units of the number of samples, within [0, 1].
+        double eff_sample_size;
+
+        /// Perplexity of the normalized weights in units of the number of samples, within [0, 1].
+        double perplexity;
+
+        /*!
+         * Logarithm of the mean of the likelihood ratio with respect to the old weights,
+         * i.e., log(Z_new / Z_old) for the ratio of the evidences.
+         */
+        double log_evidence_ratio;
+    };
+
+    /*!
+     * Access to the HDF5 types used in output.
+     */
+    struct ImportanceReweighting::Output
+    {
+        typedef hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>> WeightType;
+        typedef hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>, hdf5::Scalar<double>> StatisticsType;
+
+        static WeightType weight_type();
+        static StatisticsType statistics_type();
+    };
+}
+
+#endif
@@ -0,0 +1,125 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/importance-reweighting.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/observable_stub.hh>
+
+#include <cmath>
+#include <limits>
+
+using namespace test;
+using namespace eos;
+
+class ImportanceReweightingTest :
+    public TestCase
+{
+    public:
+        ImportanceReweightingTest() :
+            TestCase("importance_reweighting_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1e-12;
+
+            static const std::string file_name(EOS_BUILDDIR "/eos/statistics/importance-reweighting_TEST.hdf5");
+
+            // diagnostics of equal and degenerate weights
+            {
+                ImportanceReweighting::Status status;
+
+                ImportanceReweighting::diagnostics(std::vector<double>(10, -3.0), status);
+                TEST_CHECK_EQUAL(10u, status.number_of_samples);
+                TEST_CHECK_NEARLY_EQUAL(1.0, status.eff_sample_size, eps);
+                TEST_CHECK_NEARLY_EQUAL(1.0, status.perplexity,      eps);
+
+                std::vector<double> log_weights(4, -std::numeric_limits<double>::infinity());
+                log_weights[2] = 7.0;
+                ImportanceReweighting::diagnostics(log_weights, status);
+                TEST_CHECK_NEARLY_EQUAL(0.25, status.eff_sample_size, eps);
+                TEST_CHECK_NEARLY_EQUAL(0.25, status.perplexity,      eps);
+            }
+
+            // reweighting with a single Gaussian measurement
+            for (bool parallelize : { false, true })
+            {
+                Parameters p = Parameters::Defaults();
+                std::vector<ParameterDescription> descriptions
+                {
+                    ParameterDescription{ p["mass::b(MSbar)"].clone(), 3.7, 4.7, false },
+                };
+
+                ImportanceReweighting::Config config = ImportanceReweighting::Config::Default();
+                config.parallelize = parallelize;
+                config.number_of_workers = 3;
+                if (parallelize)
+                    config.output_file.reset(new hdf5::File(hdf5::File::Create(file_name)));
+
+                ImportanceReweighting reweighting(p, descriptions, config);
+                reweighting.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)")), 4.1, 4.2, 4.3);
+
+                ImportanceReweighting::SamplesList samples
+                {
+                    { 4.0 }, { 4.1 }, { 4.2 }, { 4.3 }, { 4.4 },
+                };
+                std::vector<double> log_weights{ 0.0, 0.0, std::log(2.0), 0.0, 0.0 };
+
+                auto result = reweighting.run(samples, log_weights);
+                TEST_CHECK_EQUAL(5u, result.size());
+
+                // differences with respect to the central sample are independent of the normalization
+                TEST_CHECK_NEARLY_EQUAL(-2.0 - std::log(2.0), result[0] - result[2], eps);
+                TEST_CHECK_NEARLY_EQUAL(-0.5 - std::log(2.0), result[1] - result[2], eps);
+                TEST_CHECK_NEARLY_EQUAL(-0.5 - std::log(2.0), result[3] - result[2], eps);
+                TEST_CHECK_NEARLY_EQUAL(-2.0 - std::log(2.0), result[4] - result[2], eps);
+
+                const ImportanceReweighting::Status & status = reweighting.status();
+                TEST_CHECK_EQUAL(5u, status.number_of_samples);
+                TEST_CHECK(status.eff_sample_size > 0.2);
+                TEST_CHECK(status.eff_sample_size < 1.0);
+                TEST_CHECK(status.perplexity > 0.2);
+                TEST_CHECK(status.perplexity < 1.0);
+
+                // parameters are left unchanged
+                TEST_CHECK_EQUAL(p["mass::b(MSbar)"](), Parameters::Defaults()["mass::b(MSbar)"]());
+            }
+
+            // read back the stored weights
+            {
+                hdf5::File file = hdf5::File::Open(file_name, H5F_ACC_RDONLY);
+                auto data_set = file.open_data_set("/data/weights", ImportanceReweighting::Output::weight_type());
+                TEST_CHECK_EQUAL(5u, data_set.records());
+
+                std::vector<double> log_weights;
+                auto record = std::make_tuple(0.0, 0.0);
+                for (unsigned i = 0 ; i < 5 ; ++i)
+                {
+                    data_set >> record;
+                    log_weights.push_back(std::get<1>(record));
+                }
+                TEST_CHECK_NEARLY_EQUAL(-2.0 - std::log(2.0), log_weights[0] - log_weights[2], eps);
+
+                auto statistics_data_set = file.open_data_set("/data/statistics", ImportanceReweighting::Output::statistics_type());
+                TEST_CHECK_EQUAL(1u, statistics_data_set.records());
+            }
+        }
+} importance_reweighting_test;
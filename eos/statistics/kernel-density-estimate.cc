@@ -0,0 +1,1031 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/kernel-density-estimate.hh>
+#include <eos/statistics/t-digest.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include <gsl/gsl_fft_complex.h>
+
+namespace eos
+{
+    namespace
+    {
+        // weighted running mean and variance, cf. West, Commun. ACM 22 (1979) 532
+        struct WeightedMoments
+        {
+            unsigned number_of_samples = 0;
+
+            double sum_of_weights = 0.0, sum_of_squared_weights = 0.0;
+
+            double mean = 0.0, m2 = 0.0;
+
+            void add(const double & value, const double & weight)
+            {
+                ++number_of_samples;
+
+                if (weight <= 0.0)
+                    return;
+
+                const double old_mean = mean;
+                sum_of_weights += weight;
+                sum_of_squared_weights += weight * weight;
+                mean += weight / sum_of_weights * (value - old_mean);
+                m2 += weight * (value - old_mean) * (value - mean);
+            }
+
+            void scale(const double & factor)
+            {
+                sum_of_weights *= factor;
+                sum_of_squared_weights *= factor * factor;
+                m2 *= factor;
+            }
+
+            double effective_sample_size() const
+            {
+                if (0.0 == sum_of_squared_weights)
+                    return 0.0;
+
+                return sum_of_weights * sum_of_weights / sum_of_squared_weights;
+            }
+
+            double std_deviation() const
+            {
+                if (0.0 == sum_of_weights)
+                    return 0.0;
+
+                const double normalization = sum_of_weights - sum_of_squared_weights / sum_of_weights;
+
+                return (normalization > 0.0) ? std::sqrt(m2 / normalization) : 0.0;
+            }
+        };
+
+        // a robust estimate of the standard deviation, using the interquartile range if available
+        double robust_spread(const WeightedMoments & moments, const TDigest & digest)
+        {
+            const double sigma = moments.std_deviation();
+
+            if (0.0 == digest.total_weight())
+                return sigma;
+
+            const double iqr = (digest.quantile(0.75) - digest.quantile(0.25)) / 1.349;
+            if (iqr <= 0.0)
+                return sigma;
+
+            return std::min(sigma, iqr);
+        }
+
+        // the standard normal density
+        inline double phi(const double & z)
+        {
+            return std::exp(-0.5 * z * z) / std::sqrt(2.0 * M_PI);
+        }
+
+        /*
+         * Estimate the density functional psi_r = int f^(r)(x) f(x) dx, r = 4 or r = 6,
+         * from the binned weights, using a Gaussian kernel with bandwidth g.
+         */
+        double psi(const unsigned & r, const double & g, const std::vector<double> & counts, const double & delta, const double & sum_of_weights)
+        {
+            const unsigned n = counts.size();
+            const unsigned support = std::min<double>(n - 1, std::ceil(6.0 * g / delta));
+
+            std::vector<double> kernel(support + 1);
+            for (unsigned l = 0 ; l <= support ; ++l)
+            {
+                const double z = l * delta / g, z2 = z * z;
+                const double hermite = (4 == r)
+                    ? (z2 * z2 - 6.0 * z2 + 3.0)
+                    : (z2 * z2 * z2 - 15.0 * z2 * z2 + 45.0 * z2 - 15.0);
+
+                kernel[l] = hermite * phi(z) / std::pow(g, r + 1);
+            }
+
+            double result = 0.0;
+            for (unsigned k = 0 ; k < n ; ++k)
+            {
+                if (0.0 == counts[k])
+                    continue;
+
+                double sum = counts[k] * kernel[0];
+                for (unsigned l = 1 ; (l <= support) && (k + l < n) ; ++l)
+                {
+                    sum += 2.0 * counts[k + l] * kernel[l];
+                }
+
+                result += counts[k] * sum;
+            }
+
+            return result / (sum_of_weights * sum_of_weights);
+        }
+
+        /*
+         * Select the bandwidth with the two-stage direct plug-in rule,
+         * cf. Sheather and Jones, J. R. Stat. Soc. B 53 (1991) 683, and Wand and Jones (1995), sec. 3.6.
+         * Returns zero if the estimated functionals have the wrong sign.
+         */
+        double plug_in_bandwidth(const std::vector<double> & counts, const double & delta, const double & sum_of_weights,
+                const double & n, const double & spread)
+        {
+            const double psi8 = 105.0 / (32.0 * std::sqrt(M_PI) * std::pow(spread, 9));
+            const double g1 = std::pow(30.0 / (std::sqrt(2.0 * M_PI) * psi8 * n), 1.0 / 9.0);
+            const double psi6 = psi(6, g1, counts, delta, sum_of_weights);
+            if (psi6 >= 0.0)
+                return 0.0;
+
+            const double g2 = std::pow(-6.0 / (std::sqrt(2.0 * M_PI) * psi6 * n), 1.0 / 7.0);
+            const double psi4 = psi(4, g2, counts, delta, sum_of_weights);
+            if (psi4 <= 0.0)
+                return 0.0;
+
+            return std::pow(1.0 / (2.0 * std::sqrt(M_PI) * psi4 * n), 1.0 / 5.0);
+        }
+
+        // the Gaussian kernel on the grid, truncated at four standard deviations and normalized on the grid
+        std::vector<double> gaussian_kernel(const double & bandwidth, const double & delta, const unsigned & size)
+        {
+            const unsigned support = std::min<double>(size - 1, std::ceil(4.0 * bandwidth / delta));
+
+            std::vector<double> result(2 * support + 1);
+            double sum = 0.0;
+            for (unsigned l = 0 ; l <= support ; ++l)
+            {
+                result[support + l] = result[support - l] = phi(l * delta / bandwidth);
+                sum += (0 == l ? 1.0 : 2.0) * result[support + l];
+            }
+
+            for (auto & k : result)
+            {
+                k /= sum * delta;
+            }
+
+            return result;
+        }
+
+        // convolve the values with a symmetric kernel, using a zero-padded FFT
+        void convolve(std::vector<double> & values, const std::vector<double> & kernel)
+        {
+            const unsigned size = values.size();
+            const unsigned support = (kernel.size() - 1) / 2;
+
+            // pad to avoid wrap-around
+            unsigned padded_size = 1;
+            while (padded_size < size + 2 * support + 1)
+                padded_size <<= 1;
+
+            // complex numbers are stored as pairs of real and imaginary part
+            std::vector<double> a(2 * padded_size, 0.0), b(2 * padded_size, 0.0);
+            for (unsigned i = 0 ; i < size ; ++i)
+            {
+                a[2 * i] = values[i];
+            }
+
+            for (unsigned l = 0 ; l <= support ; ++l)
+            {
+                b[2 * l] = kernel[support + l];
+                b[2 * ((padded_size - l) % padded_size)] = kernel[support - l];
+            }
+
+            gsl_fft_complex_radix2_forward(a.data(), 1, padded_size);
+            gsl_fft_complex_radix2_forward(b.data(), 1, padded_size);
+
+            for (unsigned i = 0 ; i < padded_size ; ++i)
+            {
+                const double re = a[2 * i] * b[2 * i] - a[2 * i + 1] * b[2 * i + 1];
+                const double im = a[2 * i] * b[2 * i + 1] + a[2 * i + 1] * b[2 * i];
+                a[2 * i] = re;
+                a[2 * i + 1] = im;
+            }
+
+            gsl_fft_complex_radix2_inverse(a.data(), 1, padded_size);
+
+            for (unsigned i = 0 ; i < size ; ++i)
+            {
+                values[i] = a[2 * i];
+            }
+        }
+
+        // the smallest density value of the region of highest density that holds the given probability
+        double hpd_level(const std::vector<double> & density, const double & cell_volume, const double & probability)
+        {
+            if ((probability < 0.0) || (probability > 1.0))
+                throw InternalError("KernelDensityEstimate: probability '" + stringify(probability) + "' is outside [0, 1]");
+
+            std::vector<double> sorted(density);
+            std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+
+            double total = 0.0;
+            for (const auto & d : sorted)
+            {
+                total += d * cell_volume;
+            }
+
+            double mass = 0.0;
+            for (const auto & d : sorted)
+            {
+                mass += d * cell_volume;
+                if (mass >= probability * total)
+                    return d;
+            }
+
+            return sorted.back();
+        }
+    }
+
+    /* KernelDensityEstimate<1> */
+
+    KernelDensityEstimate<1>::Config::Config() :
+        bandwidth(bw_silverman),
+        bandwidth_factor(1.0),
+        number_of_bins(1024)
+    {
+    }
+
+    KernelDensityEstimate<1>::Config
+    KernelDensityEstimate<1>::Config::Default()
+    {
+        return Config();
+    }
+
+    template <>
+    struct Implementation<KernelDensityEstimate<1>>
+    {
+        KernelDensityEstimate<1>::Config config;
+
+        double lower, upper, delta;
+
+        // linearly binned weights
+        std::vector<double> counts;
+
+        WeightedMoments moments;
+
+        TDigest digest;
+
+        // the density is recomputed lazily after samples have been added
+        mutable bool dirty;
+
+        // the robust spread of the samples, as of the last smoothing
+        mutable double spread;
+
+        mutable double bandwidth;
+
+        mutable std::vector<double> density;
+
+        Implementation(const double & lower, const double & upper, const KernelDensityEstimate<1>::Config & config) :
+            config(config),
+            lower(lower),
+            upper(upper),
+            delta((upper - lower) / (config.number_of_bins - 1)),
+            counts(config.number_of_bins, 0.0),
+            dirty(true),
+            spread(0.0),
+            bandwidth(0.0)
+        {
+            if (config.number_of_bins < 2)
+                throw InternalError("KernelDensityEstimate<1>: need at least two grid points");
+
+            if (! (lower < upper))
+                throw InternalError("KernelDensityEstimate<1>: lower end of the grid '" + stringify(lower)
+                        + "' is not smaller than the upper end '" + stringify(upper) + "'");
+        }
+
+        void add(const double & value, const double & weight)
+        {
+            moments.add(value, weight);
+
+            if (weight <= 0.0)
+                return;
+
+            digest.add(value, weight);
+            dirty = true;
+
+            const double t = (value - lower) / delta;
+            if ((t < 0.0) || (t > counts.size() - 1))
+                return;
+
+            const unsigned k = std::min<unsigned>(t, counts.size() - 2);
+            const double f = t - k;
+            counts[k]     += weight * (1.0 - f);
+            counts[k + 1] += weight * f;
+        }
+
+        void scale_weights(const double & factor)
+        {
+            if (factor <= 0.0)
+                throw InternalError("KernelDensityEstimate<1>: scaling factor must be positive, but is " + stringify(factor));
+
+            for (auto & c : counts)
+            {
+                c *= factor;
+            }
+
+            moments.scale(factor);
+            digest.scale(factor);
+            dirty = true;
+        }
+
+        double select_bandwidth() const
+        {
+            const double n = moments.effective_sample_size();
+            double result = 0.0;
+
+            switch (config.bandwidth)
+            {
+                case bw_silverman:
+                    result = 0.9 * spread * std::pow(n, -1.0 / 5.0);
+                    break;
+
+                case bw_scott:
+                    result = 1.06 * moments.std_deviation() * std::pow(n, -1.0 / 5.0);
+                    break;
+
+                case bw_plug_in:
+                    result = plug_in_bandwidth(counts, delta, moments.sum_of_weights, n, spread);
+                    if (result <= 0.0)
+                    {
+                        Log::instance()->message("kernel_density_estimate.bandwidth", ll_warning)
+                            << "Plug-in bandwidth selection failed; falling back to Silverman's rule";
+
+                        result = 0.9 * spread * std::pow(n, -1.0 / 5.0);
+                    }
+                    break;
+
+                default:
+                    throw InternalError("KernelDensityEstimate<1>: unknown bandwidth rule '" + stringify(config.bandwidth) + "'");
+            }
+
+            result *= config.bandwidth_factor;
+
+            // degenerate samples: smooth over a single bin
+            if (! (result > 0.0))
+                result = delta;
+
+            return result;
+        }
+
+        void compute() const
+        {
+            if (! dirty)
+                return;
+
+            density.assign(counts.size(), 0.0);
+            spread = 0.0;
+            bandwidth = 0.0;
+            dirty = false;
+
+            if (0.0 == moments.sum_of_weights)
+                return;
+
+            spread = robust_spread(moments, digest);
+            bandwidth = select_bandwidth();
+
+            for (unsigned i = 0 ; i < counts.size() ; ++i)
+            {
+                density[i] = counts[i] / moments.sum_of_weights;
+            }
+
+            convolve(density, gaussian_kernel(bandwidth, delta, counts.size()));
+        }
+
+        double evaluate(const double & value) const
+        {
+            compute();
+
+            const double t = (value - lower) / delta;
+            if ((t < 0.0) || (t > density.size() - 1))
+                return 0.0;
+
+            const unsigned k = std::min<unsigned>(t, density.size() - 2);
+            const double f = t - k;
+
+            return density[k] * (1.0 - f) + density[k + 1] * f;
+        }
+
+        std::vector<std::array<double, 2>> hpd_intervals(const double & probability) const
+        {
+            compute();
+
+            const double level = eos::hpd_level(density, delta, probability);
+
+            std::vector<std::array<double, 2>> result;
+            bool inside = false;
+            double start = lower;
+            for (unsigned i = 0 ; i < density.size() ; ++i)
+            {
+                if (inside == (density[i] >= level))
+                    continue;
+
+                // locate the crossing of the level between the grid points i - 1 and i
+                double crossing = lower;
+                if (i > 0)
+                    crossing = lower + delta * (i - 1 + (level - density[i - 1]) / (density[i] - density[i - 1]));
+
+                if (! inside)
+                {
+                    start = crossing;
+                }
+                else
+                {
+                    result.push_back(std::array<double, 2>{{ start, crossing }});
+                }
+
+                inside = ! inside;
+            }
+
+            if (inside)
+                result.push_back(std::array<double, 2>{{ start, upper }});
+
+            return result;
+        }
+    };
+
+    KernelDensityEstimate<1>::KernelDensityEstimate(const double & lower, const double & upper, const KernelDensityEstimate<1>::Config & config) :
+        PrivateImplementationPattern<KernelDensityEstimate<1>>(new Implementation<KernelDensityEstimate<1>>(lower, upper, config))
+    {
+    }
+
+    KernelDensityEstimate<1>::~KernelDensityEstimate()
+    {
+    }
+
+    void
+    KernelDensityEstimate<1>::add(const double & value, const double & weight)
+    {
+        _imp->add(value, weight);
+    }
+
+    void
+    KernelDensityEstimate<1>::scale_weights(const double & factor)
+    {
+        _imp->scale_weights(factor);
+    }
+
+    unsigned
+    KernelDensityEstimate<1>::number_of_samples() const
+    {
+        return _imp->moments.number_of_samples;
+    }
+
+    double
+    KernelDensityEstimate<1>::effective_sample_size() const
+    {
+        return _imp->moments.effective_sample_size();
+    }
+
+    double
+    KernelDensityEstimate<1>::bandwidth() const
+    {
+        _imp->compute();
+
+        return _imp->bandwidth;
+    }
+
+    std::vector<double>
+    KernelDensityEstimate<1>::grid() const
+    {
+        std::vector<double> result(_imp->counts.size());
+        for (unsigned i = 0 ; i < result.size() ; ++i)
+        {
+            result[i] = _imp->lower + i * _imp->delta;
+        }
+
+        return result;
+    }
+
+    const std::vector<double> &
+    KernelDensityEstimate<1>::density() const
+    {
+        _imp->compute();
+
+        return _imp->density;
+    }
+
+    double
+    KernelDensityEstimate<1>::operator() (const double & value) const
+    {
+        return _imp->evaluate(value);
+    }
+
+    double
+    KernelDensityEstimate<1>::hpd_level(const double & probability) const
+    {
+        _imp->compute();
+
+        return eos::hpd_level(_imp->density, _imp->delta, probability);
+    }
+
+    std::vector<std::array<double, 2>>
+    KernelDensityEstimate<1>::hpd_intervals(const double & probability) const
+    {
+        return _imp->hpd_intervals(probability);
+    }
+
+    /* KernelDensityEstimate<2> */
+
+    KernelDensityEstimate<2>::Config::Config() :
+        bandwidth(bw_silverman),
+        bandwidth_factor(1.0),
+        number_of_bins(128)
+    {
+    }
+
+    KernelDensityEstimate<2>::Config
+    KernelDensityEstimate<2>::Config::Default()
+    {
+        return Config();
+    }
+
+    template <>
+    struct Implementation<KernelDensityEstimate<2>>
+    {
+        KernelDensityEstimate<2>::Config config;
+
+        unsigned size;
+
+        std::array<double, 2> lower, upper, delta;
+
+        // linearly binned weights, row by row
+        std::vector<double> counts;
+
+        std::array<WeightedMoments, 2> moments;
+
+        std::array<TDigest, 2> digests;
+
+        // if set, the moments and spreads along the axes are taken from these estimates
+        std::array<std::shared_ptr<const Implementation<KernelDensityEstimate<1>>>, 2> axes;
+
+        // the density is recomputed lazily after samples have been added
+        mutable bool dirty;
+
+        mutable std::array<double, 2> bandwidth;
+
+        mutable std::vector<double> density;
+
+        Implementation(const std::array<double, 2> & lower, const std::array<double, 2> & upper, const KernelDensityEstimate<2>::Config & config,
+                const std::array<std::shared_ptr<const Implementation<KernelDensityEstimate<1>>>, 2> & axes = { { nullptr, nullptr } }) :
+            config(config),
+            size(config.number_of_bins),
+            lower(lower),
+            upper(upper),
+            delta{{ (upper[0] - lower[0]) / (size - 1), (upper[1] - lower[1]) / (size - 1) }},
+            counts(size * size, 0.0),
+            axes(axes),
+            dirty(true),
+            bandwidth{{ 0.0, 0.0 }}
+        {
+            if (size < 2)
+                throw InternalError("KernelDensityEstimate<2>: need at least two grid points per axis");
+
+            for (unsigned a = 0 ; a < 2 ; ++a)
+            {
+                if (! (lower[a] < upper[a]))
+                    throw InternalError("KernelDensityEstimate<2>: lower end of the grid '" + stringify(lower[a])
+                            + "' is not smaller than the upper end '" + stringify(upper[a]) + "' along axis " + stringify(a));
+            }
+        }
+
+        const WeightedMoments & axis_moments(const unsigned & axis) const
+        {
+            return axes[axis] ? axes[axis]->moments : moments[axis];
+        }
+
+        double axis_spread(const unsigned & axis) const
+        {
+            if (! axes[axis])
+                return robust_spread(moments[axis], digests[axis]);
+
+            axes[axis]->compute();
+
+            return axes[axis]->spread;
+        }
+
+        void add(const std::array<double, 2> & value, const double & weight)
+        {
+            if (! axes[0])
+            {
+                moments[0].add(value[0], weight);
+                moments[1].add(value[1], weight);
+            }
+
+            if (weight <= 0.0)
+                return;
+
+            if (! axes[0])
+            {
+                digests[0].add(value[0], weight);
+                digests[1].add(value[1], weight);
+            }
+            dirty = true;
+
+            const double t0 = (value[0] - lower[0]) / delta[0];
+            const double t1 = (value[1] - lower[1]) / delta[1];
+            if ((t0 < 0.0) || (t0 > size - 1) || (t1 < 0.0) || (t1 > size - 1))
+                return;
+
+            const unsigned k0 = std::min<unsigned>(t0, size - 2), k1 = std::min<unsigned>(t1, size - 2);
+            const double f0 = t0 - k0, f1 = t1 - k1;
+            counts[k0 * size + k1]           += weight * (1.0 - f0) * (1.0 - f1);
+            counts[k0 * size + k1 + 1]       += weight * (1.0 - f0) * f1;
+            counts[(k0 + 1) * size + k1]     += weight * f0 * (1.0 - f1);
+            counts[(k0 + 1) * size + k1 + 1] += weight * f0 * f1;
+        }
+
+        void scale_weights(const double & factor)
+        {
+            if (factor <= 0.0)
+                throw InternalError("KernelDensityEstimate<2>: scaling factor must be positive, but is " + stringify(factor));
+
+            for (auto & c : counts)
+            {
+                c *= factor;
+            }
+
+            for (unsigned a = 0 ; a < 2 ; ++a)
+            {
+                moments[a].scale(factor);
+                digests[a].scale(factor);
+            }
+
+            dirty = true;
+        }
+
+        double select_bandwidth(const unsigned & axis) const
+        {
+            const WeightedMoments & m = axis_moments(axis);
+            const double n = m.effective_sample_size();
+            double result = 0.0;
+
+            switch (config.bandwidth)
+            {
+                case bw_silverman:
+                    result = axis_spread(axis) * std::pow(n, -1.0 / 6.0);
+                    break;
+
+                case bw_scott:
+                    result = m.std_deviation() * std::pow(n, -1.0 / 6.0);
+                    break;
+
+                case bw_plug_in:
+                    {
+                        // apply the one-dimensional rule to the marginal counts...
+                        std::vector<double> marginal(size, 0.0);
+                        for (unsigned i = 0 ; i < size ; ++i)
+                        {
+                            for (unsigned j = 0 ; j < size ; ++j)
+                            {
+                                marginal[0 == axis ? i : j] += counts[i * size + j];
+                            }
+                        }
+
+                        const double spread = axis_spread(axis);
+                        result = plug_in_bandwidth(marginal, delta[axis], m.sum_of_weights, n, spread);
+
+                        // ... and convert it to the two-dimensional rate by the ratio of the normal reference rules
+                        result *= std::pow(n, 1.0 / 5.0 - 1.0 / 6.0) / 1.06;
+
+                        if (result <= 0.0)
+                        {
+                            Log::instance()->message("kernel_density_estimate.bandwidth", ll_warning)
+                                << "Plug-in bandwidth selection failed; falling back to Silverman's rule";
+
+                            result = spread * std::pow(n, -1.0 / 6.0);
+                        }
+                    }
+                    break;
+
+                default:
+                    throw InternalError("KernelDensityEstimate<2>: unknown bandwidth rule '" + stringify(config.bandwidth) + "'");
+            }
+
+            result *= config.bandwidth_factor;
+
+            // degenerate samples: smooth over a single bin
+            if (! (result > 0.0))
+                result = delta[axis];
+
+            return result;
+        }
+
+        void compute() const
+        {
+            if (! dirty)
+                return;
+
+            density.assign(counts.size(), 0.0);
+            bandwidth = std::array<double, 2>{{ 0.0, 0.0 }};
+            dirty = false;
+
+            const double sum_of_weights = axis_moments(0).sum_of_weights;
+            if (0.0 == sum_of_weights)
+                return;
+
+            bandwidth = std::array<double, 2>{{ select_bandwidth(0), select_bandwidth(1) }};
+
+            for (unsigned i = 0 ; i < counts.size() ; ++i)
+            {
+                density[i] = counts[i] / sum_of_weights;
+            }
+
+            // the kernel is separable, so we convolve along the rows and then along the columns
+            const std::vector<double> kernel0 = gaussian_kernel(bandwidth[0], delta[0], size);
+            const std::vector<double> kernel1 = gaussian_kernel(bandwidth[1], delta[1], size);
+            std::vector<double> line(size);
+            for (unsigned i = 0 ; i < size ; ++i)
+            {
+                std::copy(density.begin() + i * size, density.begin() + (i + 1) * size, line.begin());
+                convolve(line, kernel1);
+                std::copy(line.begin(), line.end(), density.begin() + i * size);
+            }
+
+            for (unsigned j = 0 ; j < size ; ++j)
+            {
+                for (unsigned i = 0 ; i < size ; ++i)
+                {
+                    line[i] = density[i * size + j];
+                }
+
+                convolve(line, kernel0);
+
+                for (unsigned i = 0 ; i < size ; ++i)
+                {
+                    density[i * size + j] = line[i];
+                }
+            }
+        }
+
+        double evaluate(const std::array<double, 2> & value) const
+        {
+            compute();
+
+            const double t0 = (value[0] - lower[0]) / delta[0];
+            const double t1 = (value[1] - lower[1]) / delta[1];
+            if ((t0 < 0.0) || (t0 > size - 1) || (t1 < 0.0) || (t1 > size - 1))
+                return 0.0;
+
+            const unsigned k0 = std::min<unsigned>(t0, size - 2), k1 = std::min<unsigned>(t1, size - 2);
+            const double f0 = t0 - k0, f1 = t1 - k1;
+
+            return density[k0 * size + k1] * (1.0 - f0) * (1.0 - f1)
+                + density[k0 * size + k1 + 1] * (1.0 - f0) * f1
+                + density[(k0 + 1) * size + k1] * f0 * (1.0 - f1)
+                + density[(k0 + 1) * size + k1 + 1] * f0 * f1;
+        }
+    };
+
+    KernelDensityEstimate<2>::KernelDensityEstimate(const std::array<double, 2> & lower, const std::array<double, 2> & upper,
+            const KernelDensityEstimate<2>::Config & config) :
+        PrivateImplementationPattern<KernelDensityEstimate<2>>(new Implementation<KernelDensityEstimate<2>>(lower, upper, config))
+    {
+    }
+
+    KernelDensityEstimate<2>::KernelDensityEstimate(const KernelDensityEstimate<1> & axis0, const KernelDensityEstimate<1> & axis1,
+            const KernelDensityEstimate<2>::Config & config) :
+        PrivateImplementationPattern<KernelDensityEstimate<2>>(new Implementation<KernelDensityEstimate<2>>(
+                std::array<double, 2>{{ axis0._imp->lower, axis1._imp->lower }},
+                std::array<double, 2>{{ axis0._imp->upper, axis1._imp->upper }},
+                config,
+                std::array<std::shared_ptr<const Implementation<KernelDensityEstimate<1>>>, 2>{{ axis0._imp, axis1._imp }}))
+    {
+    }
+
+    KernelDensityEstimate<2>::~KernelDensityEstimate()
+    {
+    }
+
+    void
+    KernelDensityEstimate<2>::add(const std::array<double, 2> & value, const double & weight)
+    {
+        _imp->add(value, weight);
+    }
+
+    void
+    KernelDensityEstimate<2>::scale_weights(const double & factor)
+    {
+        _imp->scale_weights(factor);
+    }
+
+    unsigned
+    KernelDensityEstimate<2>::number_of_samples() const
+    {
+        return _imp->axis_moments(0).number_of_samples;
+    }
+
+    double
+    KernelDensityEstimate<2>::effective_sample_size() const
+    {
+        return _imp->axis_moments(0).effective_sample_size();
+    }
+
+    std::array<double, 2>
+    KernelDensityEstimate<2>::bandwidth() const
+    {
+        _imp->compute();
+
+        return _imp->bandwidth;
+    }
+
+    std::vector<double>
+    KernelDensityEstimate<2>::grid(const unsigned & axis) const
+    {
+        if (axis > 1)
+            throw InternalError("KernelDensityEstimate<2>: axis '" + stringify(axis) + "' does not exist");
+
+        std::vector<double> result(_imp->size);
+        for (unsigned i = 0 ; i < result.size() ; ++i)
+        {
+            result[i] = _imp->lower[axis] + i * _imp->delta[axis];
+        }
+
+        return result;
+    }
+
+    const std::vector<double> &
+    KernelDensityEstimate<2>::density() const
+    {
+        _imp->compute();
+
+        return _imp->density;
+    }
+
+    double
+    KernelDensityEstimate<2>::operator() (const std::array<double, 2> & value) const
+    {
+        return _imp->evaluate(value);
+    }
+
+    double
+    KernelDensityEstimate<2>::hpd_level(const double & probability) const
+    {
+        _imp->compute();
+
+        return eos::hpd_level(_imp->density, _imp->delta[0] * _imp->delta[1], probability);
+    }
+
+    /* MarginalDensities */
+
+    MarginalDensities
+    estimate_marginal_densities(const SampleStore & samples,
+            const KernelDensityEstimate<1>::Config & config_1d, const KernelDensityEstimate<2>::Config & config_2d,
+            const bool & parallelize)
+    {
+        static const unsigned chunk_size = 10000;
+
+        const unsigned dimension = samples.dimension();
+        const auto & descriptions = samples.descriptions();
+
+        Log::instance()->message("kernel_density_estimate.marginals", ll_informational)
+            << "Estimating " << dimension << " one-dimensional and " << dimension * (dimension - 1) / 2
+            << " two-dimensional marginal densities from " << samples.size() << " samples";
+
+        MarginalDensities result;
+        for (unsigned i = 0 ; i < dimension ; ++i)
+        {
+            result.one_dimensional.push_back(KernelDensityEstimate<1>(descriptions[i].min, descriptions[i].max, config_1d));
+        }
+
+        // the pairs (i, j) with i < j, in the order of storage
+        std::vector<std::array<unsigned, 2>> pairs;
+        for (unsigned i = 0 ; i < dimension ; ++i)
+        {
+            for (unsigned j = i + 1 ; j < dimension ; ++j)
+            {
+                pairs.push_back(std::array<unsigned, 2>{{ i, j }});
+                result.two_dimensional.push_back(KernelDensityEstimate<2>(result.one_dimensional[i], result.one_dimensional[j], config_2d));
+            }
+        }
+
+        // distribute the indices [0, count) in contiguous blocks of similar size, several per thread
+        auto for_each_block = [&] (const unsigned & count, const std::function<void (const unsigned &, const unsigned &)> & task)
+        {
+            if ((! parallelize) || (count < 2))
+            {
+                task(0, count);
+                return;
+            }
+
+            const unsigned number_of_blocks = std::min(count, 4 * std::max(ThreadPool::instance()->number_of_threads(), 1u));
+
+            std::vector<Ticket> tickets;
+            for (unsigned b = 0 ; b < number_of_blocks ; ++b)
+            {
+                const unsigned first = std::size_t(count) * b / number_of_blocks;
+                const unsigned last  = std::size_t(count) * (b + 1) / number_of_blocks;
+                tickets.push_back(ThreadPool::instance()->enqueue(std::bind(task, first, last)));
+            }
+
+            for (auto & t : tickets)
+            {
+                t.wait();
+            }
+        };
+
+        // weights are stored relative to the largest weight seen so far
+        double log_reference = -std::numeric_limits<double>::infinity();
+
+        std::vector<double> values, weights;
+        values.reserve(chunk_size * dimension);
+        weights.reserve(chunk_size);
+        for (unsigned first = 0 ; first < samples.size() ; first += chunk_size)
+        {
+            const unsigned last = std::min(first + chunk_size, samples.size());
+
+            values.clear();
+            weights.clear();
+            for (unsigned s = first ; s < last ; ++s)
+            {
+                SampleStore::Row row = samples[s];
+                values.insert(values.end(), row.begin(), row.end());
+                weights.push_back(row.log_weight());
+            }
+
+            const double log_max = *std::max_element(weights.begin(), weights.end());
+            if ((log_max > log_reference) && (log_reference > -std::numeric_limits<double>::infinity()))
+            {
+                const double factor = std::exp(log_reference - log_max);
+                for (auto & e : result.one_dimensional)
+                {
+                    e.scale_weights(factor);
+                }
+
+                for (auto & e : result.two_dimensional)
+                {
+                    e.scale_weights(factor);
+                }
+            }
+            log_reference = std::max(log_reference, log_max);
+
+            for (auto & w : weights)
+            {
+                w = std::exp(w - log_reference);
+            }
+
+            // the one-dimensional estimates come first, followed by the pairs
+            for_each_block(dimension + pairs.size(), [&] (const unsigned & first_estimate, const unsigned & last_estimate)
+            {
+                for (unsigned e = first_estimate ; e < last_estimate ; ++e)
+                {
+                    if (e < dimension)
+                    {
+                        for (unsigned s = 0 ; s < last - first ; ++s)
+                        {
+                            result.one_dimensional[e].add(values[s * dimension + e], weights[s]);
+                        }
+
+                        continue;
+                    }
+
+                    const unsigned i = pairs[e - dimension][0], j = pairs[e - dimension][1];
+                    for (unsigned s = 0 ; s < last - first ; ++s)
+                    {
+                        const double * row = values.data() + s * dimension;
+                        result.two_dimensional[e - dimension].add(std::array<double, 2>{{ row[i], row[j] }}, weights[s]);
+                    }
+                }
+            });
+        }
+
+        // smooth all estimates; the two-dimensional ones use the spreads of the one-dimensional ones
+        for_each_block(dimension, [&] (const unsigned & first_estimate, const unsigned & last_estimate)
+        {
+            for (unsigned i = first_estimate ; i < last_estimate ; ++i)
+            {
+                result.one_dimensional[i].density();
+            }
+        });
+
+        for_each_block(pairs.size(), [&] (const unsigned & first_estimate, const unsigned & last_estimate)
+        {
+            for (unsigned p = first_estimate ; p < last_estimate ; ++p)
+            {
+                result.two_dimensional[p].density();
+            }
+        });
+
+        return result;
+    }
+}
@@ -0,0 +1,306 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_KERNEL_DENSITY_ESTIMATE_HH
+#define EOS_GUARD_EOS_STATISTICS_KERNEL_DENSITY_ESTIMATE_HH 1
+
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <array>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Rules for the selection of the bandwidth of a kernel density estimate.
+     */
+    enum Bandwidth
+    {
+        bw_silverman,          ///< Silverman's rule of thumb, using a robust estimate of the spread
+        bw_scott,              ///< Scott's rule of thumb
+        bw_plug_in             ///< the two-stage direct plug-in rule of Sheather and Jones
+    };
+
+    template <std::size_t dimensions_> class KernelDensityEstimate;
+
+    /*!
+     * Estimate a one-dimensional probability density with a Gaussian kernel.
+     *
+     * Samples are linearly binned onto an equidistant grid as they are added,
+     * so that memory use and the cost of smoothing are independent of the number
+     * of samples. The binned counts are convolved with the kernel by means of
+     * the FFT, cf. Wand and Jones, "Kernel Smoothing" (1995), appendix D.
+     * The smoothed density is computed upon the first access after samples
+     * have been added.
+     */
+    template <> class KernelDensityEstimate<1> :
+        public PrivateImplementationPattern<KernelDensityEstimate<1>>
+    {
+        public:
+            struct Config;
+
+            friend class KernelDensityEstimate<2>;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param lower  Left-most point of the grid.
+             * @param upper  Right-most point of the grid.
+             * @param config The configuration options.
+             */
+            KernelDensityEstimate(const double & lower, const double & upper, const KernelDensityEstimate<1>::Config & config);
+
+            /// Destructor.
+            ~KernelDensityEstimate();
+            ///@}
+
+            ///@name Insertion
+            ///@{
+            /*!
+             * Add a weighted sample.
+             *
+             * Samples outside the grid contribute to the normalization, but not to the density.
+             *
+             * @param value  The value of the sample.
+             * @param weight The (non-negative) weight of the sample.
+             */
+            void add(const double & value, const double & weight = 1.0);
+
+            /// Multiply the weights of all samples added so far by a positive factor.
+            void scale_weights(const double & factor);
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Retrieve the number of samples added so far.
+            unsigned number_of_samples() const;
+
+            /// Retrieve the effective sample size (sum w)^2 / (sum w^2).
+            double effective_sample_size() const;
+
+            /// Retrieve the bandwidth of the kernel.
+            double bandwidth() const;
+
+            /// Retrieve the grid points.
+            std::vector<double> grid() const;
+
+            /// Retrieve the estimated density at the grid points.
+            const std::vector<double> & density() const;
+
+            /// Evaluate the estimated density by linear interpolation between the grid points.
+            double operator() (const double & value) const;
+            ///@}
+
+            ///@name Highest Posterior Density Regions
+            ///@{
+            /*!
+             * Retrieve the smallest density within the highest posterior density region.
+             *
+             * @param probability The probability content of the region.
+             */
+            double hpd_level(const double & probability) const;
+
+            /*!
+             * Retrieve the disjoint intervals that form the highest posterior density region.
+             *
+             * @param probability The probability content of the region.
+             */
+            std::vector<std::array<double, 2>> hpd_intervals(const double & probability) const;
+            ///@}
+    };
+
+    /*!
+     * Estimate a two-dimensional probability density with a Gaussian kernel.
+     *
+     * The kernel has a diagonal bandwidth matrix, and both the linear binning
+     * and the convolution are carried out as for KernelDensityEstimate<1>.
+     * The density is stored row by row, with the first coordinate indexing
+     * the rows.
+     */
+    template <> class KernelDensityEstimate<2> :
+        public PrivateImplementationPattern<KernelDensityEstimate<2>>
+    {
+        public:
+            struct Config;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param lower  Lower-left corner of the grid.
+             * @param upper  Upper-right corner of the grid.
+             * @param config The configuration options.
+             */
+            KernelDensityEstimate(const std::array<double, 2> & lower, const std::array<double, 2> & upper,
+                    const KernelDensityEstimate<2>::Config & config);
+
+            /*!
+             * Constructor on the grids of two one-dimensional estimates.
+             *
+             * The same samples must be added to the one-dimensional estimates and,
+             * as pairs, to this estimate. The spreads along both axes are then
+             * taken from the one-dimensional estimates instead of being accumulated
+             * a second time. The one-dimensional estimates must not be modified
+             * while this estimate is smoothed.
+             *
+             * @param axis0  The estimate of the marginal density along the first axis.
+             * @param axis1  The estimate of the marginal density along the second axis.
+             * @param config The configuration options.
+             */
+            KernelDensityEstimate(const KernelDensityEstimate<1> & axis0, const KernelDensityEstimate<1> & axis1,
+                    const KernelDensityEstimate<2>::Config & config);
+
+            /// Destructor.
+            ~KernelDensityEstimate();
+            ///@}
+
+            ///@name Insertion
+            ///@{
+            /*!
+             * Add a weighted sample.
+             *
+             * Samples outside the grid contribute to the normalization, but not to the density.
+             *
+             * @param value  The coordinates of the sample.
+             * @param weight The (non-negative) weight of the sample.
+             */
+            void add(const std::array<double, 2> & value, const double & weight = 1.0);
+
+            /// Multiply the weights of all samples added so far by a positive factor.
+            void scale_weights(const double & factor);
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Retrieve the number of samples added so far.
+            unsigned number_of_samples() const;
+
+            /// Retrieve the effective sample size (sum w)^2 / (sum w^2).
+            double effective_sample_size() const;
+
+            /// Retrieve the bandwidth of the kernel along each axis.
+            std::array<double, 2> bandwidth() const;
+
+            /*!
+             * Retrieve the grid points along one axis.
+             *
+             * @param axis The index of the axis, either 0 or 1.
+             */
+            std::vector<double> grid(const unsigned & axis) const;
+
+            /// Retrieve the estimated density at the grid points, row by row.
+            const std::vector<double> & density() const;
+
+            /// Evaluate the estimated density by bilinear interpolation between the grid points.
+            double operator() (const std::array<double, 2> & value) const;
+            ///@}
+
+            ///@name Highest Posterior Density Regions
+            ///@{
+            /*!
+             * Retrieve the smallest density within the highest posterior density region,
+             * i.e., the level of the region's contour.
+             *
+             * @param probability The probability content of the region.
+             */
+            double hpd_level(const double & probability) const;
+            ///@}
+    };
+
+    /*!
+     * Configuration options for one-dimensional kernel density estimates.
+     */
+    struct KernelDensityEstimate<1>::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            /// Constructor with the default settings.
+            static Config Default();
+
+            /// The rule by which the bandwidth is selected.
+            Bandwidth bandwidth;
+
+            /// A factor by which the selected bandwidth is multiplied.
+            double bandwidth_factor;
+
+            /// The number of grid points.
+            unsigned number_of_bins;
+    };
+
+    /*!
+     * Configuration options for two-dimensional kernel density estimates.
+     */
+    struct KernelDensityEstimate<2>::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            /// Constructor with the default settings.
+            static Config Default();
+
+            /// The rule by which the bandwidth is selected.
+            Bandwidth bandwidth;
+
+            /// A factor by which the selected bandwidths are multiplied.
+            double bandwidth_factor;
+
+            /// The number of grid points along each axis.
+            unsigned number_of_bins;
+    };
+
+    /*!
+     * The one- and two-dimensional marginal densities of a set of samples.
+     */
+    struct MarginalDensities
+    {
+        /// The marginal density of each parameter.
+        std::vector<KernelDensityEstimate<1>> one_dimensional;
+
+        /// The marginal densities of all pairs of parameters (i, j) with i < j, in the order (0, 1), (0, 2), ..., (1, 2), ...
+        std::vector<KernelDensityEstimate<2>> two_dimensional;
+    };
+
+    /*!
+     * Estimate all one- and two-dimensional marginal densities of the samples in a SampleStore.
+     *
+     * The samples are read once, chunk by chunk. The grids span the parameters' ranges
+     * as given by their descriptions. The two-dimensional estimates take their spreads
+     * from the one-dimensional ones. The estimates are distributed among the threads of
+     * the ThreadPool in contiguous blocks of similar size.
+     *
+     * @param samples     The samples, which may be weighted.
+     * @param config_1d   The configuration options for the one-dimensional estimates.
+     * @param config_2d   The configuration options for the two-dimensional estimates.
+     * @param parallelize Whether the work shall be distributed among several threads.
+     */
+    MarginalDensities estimate_marginal_densities(const SampleStore & samples,
+            const KernelDensityEstimate<1>::Config & config_1d, const KernelDensityEstimate<2>::Config & config_2d,
+            const bool & parallelize = true);
+}
+
+#endif
@@ -0,0 +1,246 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/analysis.hh>
+#include <eos/statistics/kernel-density-estimate.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/stringify.hh>
+
+#include <cmath>
+#include <random>
+
+using namespace test;
+using namespace eos;
+
+class KernelDensityEstimateTest :
+    public TestCase
+{
+    public:
+        KernelDensityEstimateTest() :
+            TestCase("kernel_density_estimate_test")
+        {
+        }
+
+        // standard normal variates from the Box-Muller transformation
+        static std::vector<double> normal_samples(const unsigned & n, std::mt19937 & rng)
+        {
+            std::vector<double> result;
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            while (result.size() < n)
+            {
+                const double u1 = 1.0 - uniform(rng), u2 = uniform(rng);
+                const double r = std::sqrt(-2.0 * std::log(u1));
+                result.push_back(r * std::cos(2.0 * M_PI * u2));
+                result.push_back(r * std::sin(2.0 * M_PI * u2));
+            }
+
+            return result;
+        }
+
+        virtual void run() const
+        {
+            static const unsigned n = 100000;
+            static const double phi0 = 1.0 / std::sqrt(2.0 * M_PI);
+
+            std::mt19937 rng(123456);
+            const std::vector<double> x = normal_samples(n, rng);
+            const std::vector<double> y = normal_samples(n, rng);
+
+            // one-dimensional, unweighted standard normal samples
+            for (Bandwidth rule : { bw_silverman, bw_scott, bw_plug_in })
+            {
+                KernelDensityEstimate<1>::Config config = KernelDensityEstimate<1>::Config::Default();
+                config.bandwidth = rule;
+
+                KernelDensityEstimate<1> kde(-6.0, +6.0, config);
+                for (const auto & v : x)
+                {
+                    kde.add(v);
+                }
+
+                TEST_CHECK_EQUAL(kde.number_of_samples(), n);
+                TEST_CHECK_RELATIVE_ERROR(kde.effective_sample_size(), double(n), 1e-10);
+
+                // all rules agree for normal samples, up to the factors 0.9 and 1.06 of the rules of thumb
+                TEST_CHECK_RELATIVE_ERROR(kde.bandwidth(), std::pow(n, -0.2), 0.2);
+
+                const auto grid = kde.grid();
+                const auto & density = kde.density();
+                TEST_CHECK_EQUAL(grid.size(), 1024u);
+                TEST_CHECK_EQUAL(density.size(), 1024u);
+
+                double integral = 0.0;
+                for (const auto & d : density)
+                {
+                    integral += d * (grid[1] - grid[0]);
+                }
+                TEST_CHECK_RELATIVE_ERROR(integral, 1.0, 1e-3);
+
+                TEST_CHECK_RELATIVE_ERROR(kde(0.0), phi0, 0.02);
+                TEST_CHECK_RELATIVE_ERROR(kde(1.0), phi0 * std::exp(-0.5), 0.02);
+                TEST_CHECK_EQUAL(kde(7.0), 0.0);
+
+                // the 68% HPD region is approximately [-1, +1]
+                const auto intervals = kde.hpd_intervals(0.6827);
+                TEST_CHECK_EQUAL(intervals.size(), 1u);
+                TEST_CHECK_NEARLY_EQUAL(intervals[0][0], -1.0, 0.05);
+                TEST_CHECK_NEARLY_EQUAL(intervals[0][1], +1.0, 0.05);
+                TEST_CHECK_RELATIVE_ERROR(kde.hpd_level(0.6827), phi0 * std::exp(-0.5), 0.03);
+            }
+
+            // one-dimensional, uniformly distributed samples weighted with a normal density
+            {
+                KernelDensityEstimate<1> kde(-4.0, +4.0, KernelDensityEstimate<1>::Config::Default());
+
+                std::uniform_real_distribution<double> uniform(-5.0, +5.0);
+                for (unsigned i = 0 ; i < n ; ++i)
+                {
+                    const double v = uniform(rng);
+                    kde.add(v, std::exp(-0.5 * v * v));
+                }
+
+                TEST_CHECK(kde.effective_sample_size() < 0.5 * n);
+                TEST_CHECK_RELATIVE_ERROR(kde(0.0), phi0, 0.03);
+
+                // rescaling all weights leaves the density unchanged
+                const double before = kde(0.5);
+                kde.scale_weights(1e-100);
+                TEST_CHECK_RELATIVE_ERROR(kde(0.5), before, 1e-10);
+            }
+
+            // two-dimensional, independent standard normal samples
+            {
+                KernelDensityEstimate<2> kde({{ -6.0, -6.0 }}, {{ +6.0, +6.0 }}, KernelDensityEstimate<2>::Config::Default());
+                for (unsigned i = 0 ; i < n ; ++i)
+                {
+                    kde.add({{ x[i], y[i] }});
+                }
+
+                const auto bandwidth = kde.bandwidth();
+                TEST_CHECK_RELATIVE_ERROR(bandwidth[0], std::pow(n, -1.0 / 6.0), 0.05);
+                TEST_CHECK_RELATIVE_ERROR(bandwidth[1], std::pow(n, -1.0 / 6.0), 0.05);
+
+                TEST_CHECK_EQUAL(kde.density().size(), 128u * 128u);
+
+                // compare with the normal density, smeared by the kernel
+                const double s2 = 1.0 + bandwidth[0] * bandwidth[0];
+                TEST_CHECK_RELATIVE_ERROR(kde({{ 0.0, 0.0 }}), phi0 * phi0 / s2, 0.04);
+                TEST_CHECK_RELATIVE_ERROR(kde({{ 1.0, 0.5 }}), phi0 * phi0 / s2 * std::exp(-0.625 / s2), 0.04);
+
+                // the HPD region with probability content p is bounded by the contour at density (1 - p) / (2 pi)
+                TEST_CHECK_RELATIVE_ERROR(kde.hpd_level(0.68), 0.32 / (2.0 * M_PI), 0.05);
+                TEST_CHECK_RELATIVE_ERROR(kde.hpd_level(0.95), 0.05 / (2.0 * M_PI), 0.08);
+            }
+
+            // two-dimensional estimates that take their spreads from one-dimensional ones agree with stand-alone estimates
+            for (Bandwidth rule : { bw_silverman, bw_scott, bw_plug_in })
+            {
+                KernelDensityEstimate<2>::Config config = KernelDensityEstimate<2>::Config::Default();
+                config.bandwidth = rule;
+                config.number_of_bins = 64;
+
+                KernelDensityEstimate<1> kde_x(-6.0, +6.0, KernelDensityEstimate<1>::Config::Default());
+                KernelDensityEstimate<1> kde_y(-5.0, +5.0, KernelDensityEstimate<1>::Config::Default());
+                KernelDensityEstimate<2> linked(kde_x, kde_y, config);
+                KernelDensityEstimate<2> standalone({{ -6.0, -5.0 }}, {{ +6.0, +5.0 }}, config);
+                for (unsigned i = 0 ; i < 10000 ; ++i)
+                {
+                    const double w = std::exp(-0.1 * x[i] * y[i] * y[i]);
+                    kde_x.add(x[i], w);
+                    kde_y.add(0.5 * y[i], w);
+                    linked.add({{ x[i], 0.5 * y[i] }}, w);
+                    standalone.add({{ x[i], 0.5 * y[i] }}, w);
+                }
+
+                TEST_CHECK_EQUAL(linked.number_of_samples(), 10000u);
+                TEST_CHECK_RELATIVE_ERROR(linked.effective_sample_size(), standalone.effective_sample_size(), 1e-12);
+                TEST_CHECK_RELATIVE_ERROR(linked.bandwidth()[0], standalone.bandwidth()[0], 1e-12);
+                TEST_CHECK_RELATIVE_ERROR(linked.bandwidth()[1], standalone.bandwidth()[1], 1e-12);
+                TEST_CHECK_EQUAL(linked.grid(1).front(), -5.0);
+                TEST_CHECK_RELATIVE_ERROR(linked({{ 0.3, -0.2 }}), standalone({{ 0.3, -0.2 }}), 1e-12);
+            }
+
+            // marginal densities of the samples in a store, with more pairs than threads
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/kernel-density-estimate_TEST.hdf5");
+                static const std::vector<std::string> names
+                {
+                    "mass::b(MSbar)", "mass::c", "mass::s(2GeV)", "mass::t(pole)", "mass::tau", "mass::mu"
+                };
+                static const unsigned dimension = names.size(), samples = 2000;
+
+                std::vector<double> z = normal_samples(dimension * samples, rng);
+                {
+                    auto file = hdf5::File::Create(file_name);
+
+                    auto descriptions = file.create_data_set("/descriptions/main run/chain #0/parameters", Analysis::Output::description_type());
+                    auto record = Analysis::Output::description_record();
+                    for (unsigned i = 0 ; i < dimension ; ++i)
+                    {
+                        std::get<0>(record) = names[i].c_str(); std::get<1>(record) = -6.0; std::get<2>(record) = 6.0 + i; std::get<3>(record) = 0; std::get<4>(record) = "flat";
+                        descriptions << record;
+                    }
+
+                    auto data_set = file.create_data_set("/main run/chain #0/samples", hdf5::Array<1, double>("samples", { dimension + 1 }));
+                    std::vector<double> row(dimension + 1, 0.0);
+                    for (unsigned s = 0 ; s < samples ; ++s)
+                    {
+                        std::copy(z.begin() + s * dimension, z.begin() + (s + 1) * dimension, row.begin());
+                        data_set << row;
+                    }
+                }
+
+                SampleStore store = SampleStore::MarkovChains(file_name, "/main run", SampleStore::Config::Default());
+
+                KernelDensityEstimate<1>::Config config_1d = KernelDensityEstimate<1>::Config::Default();
+                KernelDensityEstimate<2>::Config config_2d = KernelDensityEstimate<2>::Config::Default();
+                config_2d.number_of_bins = 32;
+
+                MarginalDensities serial = estimate_marginal_densities(store, config_1d, config_2d, false);
+                MarginalDensities parallel = estimate_marginal_densities(store, config_1d, config_2d, true);
+                TEST_CHECK_EQUAL(serial.one_dimensional.size(), dimension);
+                TEST_CHECK_EQUAL(serial.two_dimensional.size(), dimension * (dimension - 1) / 2);
+                TEST_CHECK_EQUAL(parallel.two_dimensional.size(), dimension * (dimension - 1) / 2);
+
+                // compare each pair (i, j) with a stand-alone estimate
+                unsigned p = 0;
+                for (unsigned i = 0 ; i < dimension ; ++i)
+                {
+                    TEST_CHECK_EQUAL(serial.one_dimensional[i].number_of_samples(), samples);
+                    TEST_CHECK_EQUAL(serial.one_dimensional[i].bandwidth(), parallel.one_dimensional[i].bandwidth());
+
+                    for (unsigned j = i + 1 ; j < dimension ; ++j, ++p)
+                    {
+                        KernelDensityEstimate<2> expected({{ -6.0, -6.0 }}, {{ 6.0 + i, 6.0 + j }}, config_2d);
+                        for (unsigned s = 0 ; s < samples ; ++s)
+                        {
+                            expected.add({{ z[s * dimension + i], z[s * dimension + j] }});
+                        }
+
+                        TEST_CHECK_EQUAL(serial.two_dimensional[p].grid(1).back(), 6.0 + j);
+                        TEST_CHECK_RELATIVE_ERROR(serial.two_dimensional[p].bandwidth()[0], expected.bandwidth()[0], 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(serial.two_dimensional[p].bandwidth()[1], expected.bandwidth()[1], 1e-12);
+                        TEST_CHECK_RELATIVE_ERROR(serial.two_dimensional[p]({{ 0.1, -0.3 }}), expected({{ 0.1, -0.3 }}), 1e-12);
+                        TEST_CHECK_EQUAL(serial.two_dimensional[p]({{ 0.1, -0.3 }}), parallel.two_dimensional[p]({{ 0.1, -0.3 }}));
+                    }
+                }
+            }
+        }
+} kernel_density_estimate_test;
@@ -0,0 +1,338 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/laplace-approximation.hh>
+#include <eos/utils/density.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <functional>
+
+#include <gsl/gsl_eigen.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+
+namespace eos
+{
+    LaplaceApproximation::Config::Config() :
+        parallelize(true),
+        number_of_workers(4),
+        initial_step_size(1e-3),
+        target_delta(0.1),
+        max_step_adjustments(5)
+    {
+    }
+
+    LaplaceApproximation::Config
+    LaplaceApproximation::Config::Default()
+    {
+        return Config();
+    }
+
+    template <>
+    struct Implementation<LaplaceApproximation>
+    {
+        // a displacement from the point of expansion, as pairs of parameter index and offset
+        typedef std::vector<std::pair<unsigned, double>> Shift;
+
+        LaplaceApproximation::Config config;
+
+        // independent copies of the density, one per worker
+        std::vector<DensityPtr> densities;
+
+        // the parameter descriptions of each copy
+        std::vector<std::vector<ParameterDescription>> descriptions;
+
+        Implementation(const DensityPtr & density, const LaplaceApproximation::Config & config) :
+            config(config)
+        {
+            if (! density)
+                throw InternalError("LaplaceApproximation: Missing valid density");
+
+            const unsigned number_of_workers = config.parallelize ? std::max(config.number_of_workers, 1u) : 1u;
+            for (unsigned w = 0 ; w < number_of_workers ; ++w)
+            {
+                densities.push_back(density->clone());
+                descriptions.push_back(std::vector<ParameterDescription>(densities.back()->begin(), densities.back()->end()));
+            }
+
+            if (descriptions.front().empty())
+                throw InternalError("LaplaceApproximation: Density has no parameters");
+        }
+
+        // evaluate the log density of one copy at the shifted points in [first, last)
+        // exceptions must not escape a pool job; keep them for the caller to rethrow
+        void evaluate_range(const unsigned & worker, const std::vector<double> & point,
+                const Shift * first, const Shift * last, double * result, std::exception_ptr * exception) const
+        {
+            const auto & defs = descriptions[worker];
+
+            try
+            {
+                for ( ; first != last ; ++first, ++result)
+                {
+                    for (unsigned i = 0 ; i < defs.size() ; ++i)
+                    {
+                        defs[i].parameter->set(point[i]);
+                    }
+
+                    for (const auto & s : *first)
+                    {
+                        defs[s.first].parameter->set(point[s.first] + s.second);
+                    }
+
+                    *result = densities[worker]->evaluate();
+                }
+            }
+            catch (...)
+            {
+                *exception = std::current_exception();
+            }
+        }
+
+        // evaluate the log density at all shifted points concurrently
+        std::vector<double> evaluate(const std::vector<double> & point, const std::vector<Shift> & shifts) const
+        {
+            std::vector<double> results(shifts.size());
+
+            const unsigned number_of_workers = densities.size();
+            const unsigned chunk_size = (shifts.size() + number_of_workers - 1) / number_of_workers;
+
+            std::vector<std::exception_ptr> exceptions(number_of_workers);
+            TicketList tickets;
+            for (unsigned w = 0 ; w < number_of_workers ; ++w)
+            {
+                const unsigned first = std::min<unsigned>(w * chunk_size, shifts.size());
+                const unsigned last  = std::min<unsigned>(first + chunk_size, shifts.size());
+
+                if (first == last)
+                    break;
+
+                std::function<void ()> f = std::bind(&Implementation<LaplaceApproximation>::evaluate_range, this, w, std::cref(point),
+                        shifts.data() + first, shifts.data() + last, results.data() + first, &exceptions[w]);
+
+                if (1 == number_of_workers)
+                {
+                    f();
+                }
+                else
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue(f));
+                }
+            }
+            tickets.wait();
+
+            for (const auto & e : exceptions)
+            {
+                if (e)
+                    std::rethrow_exception(e);
+            }
+
+            return results;
+        }
+
+        LaplaceApproximation::Result compute(const std::vector<double> & point) const
+        {
+            const auto & defs = descriptions.front();
+            const unsigned k = defs.size();
+
+            if (point.size() != k)
+                throw InternalError("LaplaceApproximation::compute: Dimension of the point (" + stringify(point.size())
+                        + ") does not match the number of parameters (" + stringify(k) + ")");
+
+            // the steps must not leave the allowed ranges of the parameters
+            std::vector<double> room(k), h(k);
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                room[i] = std::min(point[i] - defs[i].min, defs[i].max - point[i]);
+                if (! (room[i] > 0.0))
+                    throw InternalError("LaplaceApproximation::compute: Point does not lie within the allowed range of parameter '"
+                            + defs[i].parameter->name() + "'");
+
+                h[i] = std::min(config.initial_step_size * (defs[i].max - defs[i].min), room[i]);
+            }
+
+            // the point of expansion, and the steps along each parameter
+            std::vector<Shift> shifts(1 + 2 * k);
+            std::vector<double> values;
+            for (unsigned adjustment = 0 ; ; ++adjustment)
+            {
+                for (unsigned i = 0 ; i < k ; ++i)
+                {
+                    shifts[1 + 2 * i + 0] = Shift{ { i, +h[i] } };
+                    shifts[1 + 2 * i + 1] = Shift{ { i, -h[i] } };
+                }
+                values = evaluate(point, shifts);
+
+                if (adjustment == config.max_step_adjustments)
+                    break;
+
+                // for a quadratic log density, the decrease scales with the square of the step size
+                bool adjusted = false;
+                for (unsigned i = 0 ; i < k ; ++i)
+                {
+                    const double delta = values[0] - 0.5 * (values[1 + 2 * i] + values[2 + 2 * i]);
+                    if (! std::isfinite(delta) || (delta <= 0.0))
+                        continue;
+
+                    const double ratio = delta / config.target_delta;
+                    if ((0.25 <= ratio) && (ratio <= 4.0))
+                        continue;
+
+                    const double new_h = std::min(h[i] / std::sqrt(ratio), room[i]);
+                    if (new_h == h[i])
+                        continue;
+
+                    h[i] = new_h;
+                    adjusted = true;
+                }
+
+                if (! adjusted)
+                    break;
+
+                Log::instance()->message("laplace_approximation.compute", ll_debug)
+                    << "Adjusted step sizes to " << stringify_container(h, 4);
+            }
+
+            LaplaceApproximation::Result result;
+            result.point = point;
+            result.log_density = values[0];
+            result.step_sizes = h;
+            result.hessian.resize(k * k);
+
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                result.hessian[i * k + i] = (values[1 + 2 * i] - 2.0 * values[0] + values[2 + 2 * i]) / (h[i] * h[i]);
+            }
+
+            // the off-diagonal elements require four points each
+            std::vector<Shift> mixed_shifts;
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                for (unsigned j = i + 1 ; j < k ; ++j)
+                {
+                    mixed_shifts.push_back(Shift{ { i, +h[i] }, { j, +h[j] } });
+                    mixed_shifts.push_back(Shift{ { i, +h[i] }, { j, -h[j] } });
+                    mixed_shifts.push_back(Shift{ { i, -h[i] }, { j, +h[j] } });
+                    mixed_shifts.push_back(Shift{ { i, -h[i] }, { j, -h[j] } });
+                }
+            }
+            const std::vector<double> mixed_values = evaluate(point, mixed_shifts);
+
+            auto v = mixed_values.cbegin();
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                for (unsigned j = i + 1 ; j < k ; ++j, v += 4)
+                {
+                    const double value = (v[0] - v[1] - v[2] + v[3]) / (4.0 * h[i] * h[j]);
+                    result.hessian[i * k + j] = value;
+                    result.hessian[j * k + i] = value;
+                }
+            }
+
+            // diagonalize -H; its inverse shares the eigenvectors
+            gsl_matrix * negative_hessian = gsl_matrix_alloc(k, k);
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                for (unsigned j = 0 ; j < k ; ++j)
+                {
+                    gsl_matrix_set(negative_hessian, i, j, -result.hessian[i * k + j]);
+                }
+            }
+
+            gsl_vector * eigenvalues = gsl_vector_alloc(k);
+            gsl_matrix * eigenvectors = gsl_matrix_alloc(k, k);
+            gsl_eigen_symmv_workspace * workspace = gsl_eigen_symmv_alloc(k);
+            gsl_eigen_symmv(negative_hessian, eigenvalues, eigenvectors, workspace);
+            gsl_eigen_symmv_free(workspace);
+            gsl_matrix_free(negative_hessian);
+
+            for (unsigned m = 0 ; m < k ; ++m)
+            {
+                const double lambda = gsl_vector_get(eigenvalues, m);
+                if (! (lambda > 0.0))
+                {
+                    gsl_matrix_free(eigenvectors);
+                    gsl_vector_free(eigenvalues);
+
+                    throw InternalError("LaplaceApproximation::compute: Hessian is not negative definite at "
+                            + stringify_container(point, 4) + ", found eigenvalue " + stringify(-lambda));
+                }
+
+                gsl_vector_set(eigenvalues, m, 1.0 / lambda);
+            }
+            gsl_eigen_symmv_sort(eigenvalues, eigenvectors, GSL_EIGEN_SORT_VAL_ASC);
+
+            result.eigenvalues.resize(k);
+            result.eigenvectors.resize(k * k);
+            result.covariance.assign(k * k, 0.0);
+            result.log_evidence = result.log_density + 0.5 * k * std::log(2.0 * M_PI);
+            for (unsigned m = 0 ; m < k ; ++m)
+            {
+                const double sigma2 = gsl_vector_get(eigenvalues, m);
+                result.eigenvalues[m] = sigma2;
+                result.log_evidence += 0.5 * std::log(sigma2);
+
+                for (unsigned i = 0 ; i < k ; ++i)
+                {
+                    result.eigenvectors[i * k + m] = gsl_matrix_get(eigenvectors, i, m);
+
+                    for (unsigned j = 0 ; j < k ; ++j)
+                    {
+                        result.covariance[i * k + j] += gsl_matrix_get(eigenvectors, i, m) * sigma2 * gsl_matrix_get(eigenvectors, j, m);
+                    }
+                }
+            }
+            gsl_matrix_free(eigenvectors);
+            gsl_vector_free(eigenvalues);
+
+            for (unsigned i = 0 ; i < k ; ++i)
+            {
+                result.widths.push_back(std::sqrt(result.covariance[i * k + i]));
+            }
+
+            Log::instance()->message("laplace_approximation.compute", ll_informational)
+                << "Evaluated the density at " << (shifts.size() + mixed_shifts.size()) << " points, marginal widths = "
+                << stringify_container(result.widths, 4);
+
+            return result;
+        }
+    };
+
+    LaplaceApproximation::LaplaceApproximation(const DensityPtr & density, const Config & config) :
+        PrivateImplementationPattern<LaplaceApproximation>(new Implementation<LaplaceApproximation>(density, config))
+    {
+    }
+
+    LaplaceApproximation::~LaplaceApproximation()
+    {
+    }
+
+    LaplaceApproximation::Result
+    LaplaceApproximation::compute(const std::vector<double> & point) const
+    {
+        return _imp->compute(point);
+    }
+}
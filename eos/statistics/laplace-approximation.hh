@@ -0,0 +1,138 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_STATISTICS_LAPLACE_APPROXIMATION_HH
+#define EOS_GUARD_SRC_STATISTICS_LAPLACE_APPROXIMATION_HH 1
+
+#include <eos/utils/density-fwd.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Approximate a density by a multivariate Gaussian around a given point.
+     *
+     * The Hessian H of the log density is computed from central finite differences.
+     * The step size along each parameter is adapted until the log density drops by
+     * roughly Config::target_delta across one step. All points of the finite-difference
+     * stencil are evaluated concurrently, on independent copies of the density.
+     *
+     * At the mode of a posterior, the covariance -H^-1 yields the Laplace approximation
+     * of the posterior. At the fiducial point of a likelihood, it yields the Fisher forecast
+     * of the parameter uncertainties.
+     */
+    class LaplaceApproximation :
+        public PrivateImplementationPattern<LaplaceApproximation>
+    {
+        public:
+            struct Config;
+            struct Result;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param density The density on the log scale. It is cloned, and the original remains untouched.
+             * @param config  The configuration options.
+             */
+            LaplaceApproximation(const DensityPtr & density, const Config & config);
+
+            /// Destructor.
+            ~LaplaceApproximation();
+            ///@}
+
+            /*!
+             * Compute the Hessian of the log density and the Gaussian approximation derived from it.
+             *
+             * @param point The parameter values, in the order of the density's parameters.
+             *              It must lie strictly within the allowed range of each parameter.
+             */
+            Result compute(const std::vector<double> & point) const;
+    };
+
+    /*!
+     * Store configuration options
+     */
+    struct LaplaceApproximation::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            /// Constructor with the default settings.
+            static Config Default();
+
+            /*!
+             * If true, use as many threads as there are cores available.
+             * If false, use only one thread.
+             */
+            bool parallelize;
+
+            /// Number of workers among which the stencil points are distributed.
+            unsigned number_of_workers;
+
+            /// Initial step size, in units of each parameter's allowed range.
+            double initial_step_size;
+
+            /// Desired decrease of the log density across one step along each parameter.
+            double target_delta;
+
+            /// Maximal number of adjustments of the step sizes.
+            unsigned max_step_adjustments;
+    };
+
+    /*!
+     * The Gaussian approximation of a density. All matrices are stored in row major format.
+     */
+    struct LaplaceApproximation::Result
+    {
+        /// The point of expansion.
+        std::vector<double> point;
+
+        /// The log density at the point of expansion.
+        double log_density;
+
+        /// The final step sizes of the finite differences.
+        std::vector<double> step_sizes;
+
+        /// The Hessian of the log density.
+        std::vector<double> hessian;
+
+        /// The covariance matrix -H^-1.
+        std::vector<double> covariance;
+
+        /// The eigenvalues of the covariance matrix, in ascending order.
+        std::vector<double> eigenvalues;
+
+        /// The eigenvectors of the covariance matrix; column i belongs to eigenvalue i.
+        std::vector<double> eigenvectors;
+
+        /// The marginal standard deviations, i.e., the square roots of the diagonal of the covariance matrix.
+        std::vector<double> widths;
+
+        /// The logarithm of the integral of the Gaussian approximation to the density.
+        double log_evidence;
+    };
+}
+
+#endif
@@ -0,0 +1,142 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/density-wrapper.hh>
+#include <eos/statistics/laplace-approximation.hh>
+#include <eos/utils/exception.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+// correlated normal distribution around (1, -1) with sigma_x = 1, sigma_y = 2, and correlation rho = 0.9
+namespace
+{
+    const double rho = 0.9;
+
+    double correlated_normal(const std::vector<double> & x)
+    {
+        const double u = (x[0] - 1.0) / 1.0, v = (x[1] + 1.0) / 2.0;
+
+        return -0.5 * (u * u - 2.0 * rho * u * v + v * v) / (1.0 - rho * rho);
+    }
+
+    double saddle(const std::vector<double> & x)
+    {
+        return -0.5 * x[0] * x[0] + 0.5 * x[1] * x[1];
+    }
+
+    double failing(const std::vector<double> & x)
+    {
+        if (x[1] > 0.0)
+            throw InternalError("failing: Cannot evaluate for y > 0");
+
+        return -0.5 * (x[0] * x[0] + x[1] * x[1]);
+    }
+}
+
+class LaplaceApproximationTest :
+    public TestCase
+{
+    public:
+        LaplaceApproximationTest() :
+            TestCase("laplace_approximation_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // Gaussian density, at the mode
+            for (bool parallelize : { false, true })
+            {
+                static const double eps = 1e-7;
+
+                DensityPtr density(new DensityWrapper(&correlated_normal));
+                static_cast<DensityWrapper &>(*density).add_parameter("x", -10.0, +10.0);
+                static_cast<DensityWrapper &>(*density).add_parameter("y", -20.0, +20.0);
+
+                auto config = LaplaceApproximation::Config::Default();
+                config.parallelize = parallelize;
+
+                LaplaceApproximation laplace(density, config);
+                auto result = laplace.compute(std::vector<double>{ 1.0, -1.0 });
+
+                TEST_CHECK_EQUAL(2u, result.step_sizes.size());
+                TEST_CHECK_NEARLY_EQUAL(0.0, result.log_density, eps);
+
+                TEST_CHECK_EQUAL(4u, result.covariance.size());
+                TEST_CHECK_NEARLY_EQUAL(1.0, result.covariance[0], eps);
+                TEST_CHECK_NEARLY_EQUAL(1.8, result.covariance[1], eps);
+                TEST_CHECK_NEARLY_EQUAL(1.8, result.covariance[2], eps);
+                TEST_CHECK_NEARLY_EQUAL(4.0, result.covariance[3], eps);
+
+                TEST_CHECK_NEARLY_EQUAL(1.0, result.widths[0], eps);
+                TEST_CHECK_NEARLY_EQUAL(2.0, result.widths[1], eps);
+
+                // eigenvalues are (5 -+ sqrt(21.96)) / 2
+                TEST_CHECK_NEARLY_EQUAL(0.15692510, result.eigenvalues[0], eps);
+                TEST_CHECK_NEARLY_EQUAL(4.84307490, result.eigenvalues[1], eps);
+
+                // eigenvectors are normalized, and orthogonal
+                TEST_CHECK_NEARLY_EQUAL(1.0, std::hypot(result.eigenvectors[0], result.eigenvectors[2]), eps);
+                TEST_CHECK_NEARLY_EQUAL(0.0, result.eigenvectors[0] * result.eigenvectors[1] + result.eigenvectors[2] * result.eigenvectors[3], eps);
+
+                // integral of exp(-chi^2 / 2) is 2 pi sqrt(det(covariance))
+                TEST_CHECK_NEARLY_EQUAL(std::log(2.0 * M_PI) + 0.5 * std::log(0.76), result.log_evidence, eps);
+
+                // the density itself remains untouched
+                TEST_CHECK_EQUAL(0.0, (*density->begin()).parameter->evaluate());
+            }
+
+            // invalid inputs
+            {
+                DensityPtr density(new DensityWrapper(&saddle));
+                static_cast<DensityWrapper &>(*density).add_parameter("x", -1.0, +1.0);
+                static_cast<DensityWrapper &>(*density).add_parameter("y", -1.0, +1.0);
+
+                LaplaceApproximation laplace(density, LaplaceApproximation::Config::Default());
+
+                // not a maximum
+                TEST_CHECK_THROWS(InternalError, laplace.compute(std::vector<double>{ 0.0, 0.0 }));
+
+                // wrong dimension
+                TEST_CHECK_THROWS(InternalError, laplace.compute(std::vector<double>{ 0.0 }));
+
+                // on the boundary
+                TEST_CHECK_THROWS(InternalError, laplace.compute(std::vector<double>{ 1.0, 0.0 }));
+            }
+
+            // failing evaluations at the shifted points reach the caller
+            for (bool parallelize : { false, true })
+            {
+                DensityPtr density(new DensityWrapper(&failing));
+                static_cast<DensityWrapper &>(*density).add_parameter("x", -1.0, +1.0);
+                static_cast<DensityWrapper &>(*density).add_parameter("y", -1.0, +1.0);
+
+                auto config = LaplaceApproximation::Config::Default();
+                config.parallelize = parallelize;
+
+                LaplaceApproximation laplace(density, config);
+
+                TEST_CHECK_THROWS(InternalError, laplace.compute(std::vector<double>{ 0.0, 0.0 }));
+            }
+        }
+} laplace_approximation_test;
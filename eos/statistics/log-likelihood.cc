@@ -47,6 +47,22 @@ namespace eos
 {
     namespace implementation
     {
+        // evaluate a block for a single observable for each row of predictions
+        template <typename Block_>
+        void evaluate_univariate_batch(const Block_ & block, const char * name, const gsl_matrix * predictions, gsl_vector * results)
+        {
+            if (1 != predictions->size2)
+                throw InternalError("LogLikelihoodBlock::" + std::string(name) + "::evaluate_batch: predictions must have exactly one column");
+
+            if (predictions->size1 != results->size)
+                throw InternalError("LogLikelihoodBlock::" + std::string(name) + "::evaluate_batch: dimensions of predictions and results are not identical");
+
+            for (std::size_t i = 0 ; i < predictions->size1 ; ++i)
+            {
+                gsl_vector_set(results, i, block.evaluate(gsl_matrix_get(predictions, i, 0)));
+            }
+        }
+
         struct GaussianBlock :
             public LogLikelihoodBlock
         {
@@ -108,9 +124,8 @@ namespace eos
                 return result;
             }
 
-            virtual double evaluate() const
+            double evaluate(const double & value) const
             {
-                double value = cache[id];
                 double sigma = 0.0;
 
                 // allow for asymmetric Gaussian uncertainty
@@ -124,6 +139,16 @@ namespace eos
                 return norm - power_of<2>(chi) / 2.0;
             }
 
+            virtual double evaluate() const
+            {
+                return evaluate(cache[id]);
+            }
+
+            virtual void evaluate_batch(const gsl_matrix * predictions, gsl_vector * results) const
+            {
+                evaluate_univariate_batch(*this, "GaussianBlock", predictions, results);
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -203,9 +228,7 @@ namespace eos
 
             virtual LogLikelihoodBlockPtr clone(ObservableCache cache) const
             {
-                ObservablePtr observable = this->cache.observable(id)->clone(cache.parameters());
-
-                return LogLikelihoodBlockPtr(new GaussianBlock(cache, cache.add(observable), mode - sigma_lower, mode, mode + sigma_upper, _number_of_observations));
+                return LogLikelihoodBlockPtr(new GaussianBlock(cache, cache.add_clone(this->cache.observable(id)), mode - sigma_lower, mode, mode + sigma_upper, _number_of_observations));
             }
         };
 
@@ -409,13 +432,23 @@ namespace eos
                 return first + second;
             }
 
-            virtual double evaluate() const
+            double evaluate(const double & prediction) const
             {
-                double value = (cache[id] - nu) / lambda;
+                double value = (prediction - nu) / lambda;
 
                 return norm + alpha * value - std::exp(value);
             }
 
+            virtual double evaluate() const
+            {
+                return evaluate(cache[id]);
+            }
+
+            virtual void evaluate_batch(const gsl_matrix * predictions, gsl_vector * results) const
+            {
+                evaluate_univariate_batch(*this, "LogGammaBlock", predictions, results);
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -566,9 +599,7 @@ namespace eos
 
             virtual LogLikelihoodBlockPtr clone(ObservableCache cache) const
             {
-                ObservablePtr observable = this->cache.observable(id)->clone(cache.parameters());
-
-                return LogLikelihoodBlockPtr(new LogGammaBlock(cache, cache.add(observable),
+                return LogLikelihoodBlockPtr(new LogGammaBlock(cache, cache.add_clone(this->cache.observable(id)),
                     central - sigma_lower, central, central + sigma_upper, lambda, alpha, _number_of_observations));
             }
         };
@@ -644,14 +675,24 @@ namespace eos
                     return 1.0 - gsl_sf_gamma_inc_Q(alpha, w);
             }
 
-            virtual double evaluate() const
+            double evaluate(const double & prediction) const
             {
                 // standardized transform
-                const double z = (cache[id] - physical_limit) / theta;
+                const double z = (prediction - physical_limit) / theta;
 
                 return norm + (alpha * beta - 1) * std::log(z) - std::pow(z, beta);
             }
 
+            virtual double evaluate() const
+            {
+                return evaluate(cache[id]);
+            }
+
+            virtual void evaluate_batch(const gsl_matrix * predictions, gsl_vector * results) const
+            {
+                evaluate_univariate_batch(*this, "AmorosoBlock", predictions, results);
+            }
+
             inline double mode() const
             {
                 return physical_limit + theta * std::pow(alpha - 1 / beta, 1 / beta);
@@ -791,8 +832,7 @@ namespace eos
 
             virtual LogLikelihoodBlockPtr clone(ObservableCache cache) const
             {
-                ObservablePtr observable = this->cache.observable(id)->clone(cache.parameters());
-                return LogLikelihoodBlockPtr(new AmorosoBlock(cache, cache.add(observable), physical_limit, theta, alpha, beta, _number_of_observations));
+                return LogLikelihoodBlockPtr(new AmorosoBlock(cache, cache.add_clone(this->cache.observable(id)), physical_limit, theta, alpha, beta, _number_of_observations));
             }
         };
 
@@ -855,6 +895,38 @@ namespace eos
                 return ret_val;
             }
 
+            void evaluate_batch(const gsl_matrix * predictions, gsl_vector * results) const
+            {
+                const auto n = results->size;
+
+                std::vector<gsl_vector *> values;
+                for (auto c = components.cbegin() ; c != components.cend() ; ++c)
+                {
+                    values.push_back(gsl_vector_alloc(n));
+                    (**c).evaluate_batch(predictions, values.back());
+                }
+
+                // as in evaluate(), renormalize the exponents by the biggest element
+                for (std::size_t i = 0 ; i < n ; ++i)
+                {
+                    double max_val = -std::numeric_limits<double>::infinity();
+                    for (auto v = values.cbegin() ; v != values.cend() ; ++v)
+                        max_val = std::max(max_val, gsl_vector_get(*v, i));
+
+                    double ret_val = 0;
+                    auto v = values.cbegin();
+                    for (auto w = weights.cbegin(); w != weights.cend() ; ++w, ++v)
+                    {
+                        ret_val += *w * std::exp(gsl_vector_get(*v, i) - max_val);
+                    }
+
+                    gsl_vector_set(results, i, std::log(ret_val) + max_val);
+                }
+
+                for (auto v = values.begin() ; v != values.end() ; ++v)
+                    gsl_vector_free(*v);
+            }
+
             unsigned number_of_observations() const
             {
                 unsigned ret_val = 0;
@@ -888,34 +960,62 @@ namespace eos
 
             std::vector<ObservableCache::Id> _ids;
 
+            // owns the inputs and the matrices derived from them, which are shared among all clones
+            struct Data
+            {
+                gsl_vector * mean;
+                gsl_matrix * covariance;
+                gsl_matrix * chol;
+                gsl_matrix * covariance_inv;
+
+                Data(gsl_vector * mean, gsl_matrix * covariance) :
+                    mean(mean),
+                    covariance(covariance),
+                    chol(gsl_matrix_alloc(mean->size, mean->size)),
+                    covariance_inv(gsl_matrix_alloc(mean->size, mean->size))
+                {
+                }
+
+                ~Data()
+                {
+                    gsl_matrix_free(covariance_inv);
+                    gsl_matrix_free(chol);
+                    gsl_matrix_free(covariance);
+                    gsl_vector_free(mean);
+                }
+            };
+            std::shared_ptr<const Data> _data;
+
             // inputs
             gsl_vector * const _mean;
             gsl_matrix * const _covariance;
             const unsigned _number_of_observations;
 
-            // the normalization constant of the density
-            const double _norm;
+            // lower cholesky factor L of the covariance, with covariance = L L^T
+            gsl_matrix * const _chol;
 
-            // cholesky matrix of covariance, and inverse of covariance
-            gsl_matrix * _chol;
-            gsl_matrix * _covariance_inv;
+            // inverse of covariance, for display purposes only
+            gsl_matrix * const _covariance_inv;
 
-            // temporary storage for evaluation
-            gsl_vector * _observables;
-            gsl_vector * _observables_2;
+            // the normalization constant of the density
+            double _norm;
 
+            /*
+             * All evaluations only read from the members, and use per-call storage for
+             * intermediate results. Hence a block can be evaluated concurrently, as long
+             * as its cache is not updated at the same time.
+             */
             MultivariateGaussianBlock(const ObservableCache & cache, const std::vector<ObservableCache::Id> && ids,
                     gsl_vector * mean, gsl_matrix * covariance, const unsigned & number_of_observations) :
                 _cache(cache),
                 _ids(ids),
-                _mean(mean),
-                _covariance(covariance),
+                _data(new Data(mean, covariance)),
+                _mean(_data->mean),
+                _covariance(_data->covariance),
                 _number_of_observations(number_of_observations),
-                _norm(compute_norm()),
-                _chol(gsl_matrix_alloc(ids.size(), ids.size())),
-                _covariance_inv(gsl_matrix_alloc(ids.size(), ids.size())),
-                _observables(gsl_vector_alloc(ids.size())),
-                _observables_2(gsl_vector_alloc(ids.size()))
+                _chol(_data->chol),
+                _covariance_inv(_data->covariance_inv),
+                _norm(0.0)
             {
                 const auto k = ids.size();
 
@@ -941,17 +1041,27 @@ namespace eos
                         gsl_matrix_set(_chol, i, j, 0.0);
                     }
                 }
+
+                _norm = compute_norm();
             }
 
-            virtual ~MultivariateGaussianBlock()
+            // share the inputs and the decomposition of another block, which are never modified after construction
+            MultivariateGaussianBlock(const ObservableCache & cache, const std::vector<ObservableCache::Id> && ids,
+                    const MultivariateGaussianBlock & other) :
+                _cache(cache),
+                _ids(ids),
+                _data(other._data),
+                _mean(_data->mean),
+                _covariance(_data->covariance),
+                _number_of_observations(other._number_of_observations),
+                _chol(_data->chol),
+                _covariance_inv(_data->covariance_inv),
+                _norm(other._norm)
             {
-                gsl_matrix_free(_covariance_inv);
-                gsl_matrix_free(_chol);
-                gsl_matrix_free(_covariance);
+            }
 
-                gsl_vector_free(_observables_2);
-                gsl_vector_free(_observables);
-                gsl_vector_free(_mean);
+            virtual ~MultivariateGaussianBlock()
+            {
             }
 
             virtual std::string as_string() const
@@ -1020,60 +1130,45 @@ namespace eos
                 // add observables to cache
                 for (auto i = 0u ; i < k ; ++i)
                 {
-                    ids.push_back(cache.add(this->_cache.observable(this->_ids[i])->clone(cache.parameters())));
+                    ids.push_back(cache.add_clone(this->_cache.observable(this->_ids[i])));
                 }
 
-                gsl_vector * mean = gsl_vector_alloc(k);
-                gsl_vector_memcpy(mean, _mean);
-
-                gsl_matrix * covariance = gsl_matrix_alloc(k, k);
-                gsl_matrix_memcpy(covariance, _covariance);
-
-                return LogLikelihoodBlockPtr(new MultivariateGaussianBlock(cache, std::move(ids), mean, covariance, _number_of_observations));
+                return LogLikelihoodBlockPtr(new MultivariateGaussianBlock(cache, std::move(ids), *this));
             }
 
             // compute the normalization constant on log scale
-            // -k/2 * log 2 Pi - 1/2 log(abs(det(V^{-1})))
-            double compute_norm()
+            // -k/2 * log 2 Pi - 1/2 log(abs(det(V))), with log(det(V)) = 2 * sum_i log(L_ii)
+            double compute_norm() const
             {
                 // dimensionality of parameter space
                 const auto k = _mean->size;
 
-                // copy covariance matrix
-                gsl_matrix * M = gsl_matrix_alloc (k, k);
-                gsl_matrix_memcpy(M, _covariance);
-
-                // find LU decomposition
-                int signum = 0;
-                gsl_permutation * p = gsl_permutation_alloc(k);
-                gsl_linalg_LU_decomp(M, p, &signum);
-
-                // calculate determinant
-                const double log_det = gsl_linalg_LU_lndet(M);
-
-                gsl_permutation_free(p);
-                gsl_matrix_free(M);
+                double log_det = 0.0;
+                for (auto i = 0u ; i < k ; ++i)
+                {
+                    log_det += 2.0 * std::log(gsl_matrix_get(_chol, i, i));
+                }
 
                 return -0.5 * k * std::log(2 * M_PI) - 0.5 * log_det;
             }
 
             double chi_square() const
             {
+                const auto k = _mean->size;
+
                 // read observable values from cache, and subtract mean
-                for (auto i = 0u ; i < _mean->size ; ++i)
+                std::vector<double> residuals(k);
+                for (auto i = 0u ; i < k ; ++i)
                 {
-                    gsl_vector_set(_observables, i, _cache[_ids[i]]);
+                    residuals[i] = _cache[_ids[i]] - gsl_vector_get(_mean, i);
                 }
 
-                // center the gaussian:
-                //   observable <- observables - mean
-                gsl_vector_sub(_observables, _mean);
-
-                // observables_2 <- inv(covariance) * observables
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _covariance_inv, _observables, 0.0, _observables_2);
+                // whiten the residuals: residuals <- inv(L) * residuals
+                gsl_vector_view r = gsl_vector_view_array(residuals.data(), k);
+                gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, _chol, &r.vector);
 
                 double result;
-                gsl_blas_ddot(_observables, _observables_2, &result);
+                gsl_blas_ddot(&r.vector, &r.vector, &result);
 
                 return result;
             }
@@ -1083,6 +1178,42 @@ namespace eos
                 return _norm - 0.5 * chi_square();
             }
 
+            virtual void evaluate_batch(const gsl_matrix * predictions, gsl_vector * results) const
+            {
+                const auto k = _mean->size;
+                const auto n = predictions->size1;
+
+                if (k != predictions->size2)
+                    throw InternalError("LogLikelihoodBlock::MultivariateGaussianBlock::evaluate_batch: dimensions of predictions and mean are not identical");
+
+                if (n != results->size)
+                    throw InternalError("LogLikelihoodBlock::MultivariateGaussianBlock::evaluate_batch: dimensions of predictions and results are not identical");
+
+                // residuals <- predictions - mean, one row per set of predictions
+                gsl_matrix * residuals = gsl_matrix_alloc(n, k);
+                gsl_matrix_memcpy(residuals, predictions);
+                for (auto i = 0u ; i < n ; ++i)
+                {
+                    gsl_vector_view row = gsl_matrix_row(residuals, i);
+                    gsl_vector_sub(&row.vector, _mean);
+                }
+
+                // whiten all rows at once: residuals <- residuals * inv(L^T)
+                gsl_blas_dtrsm(CblasRight, CblasLower, CblasTrans, CblasNonUnit, 1.0, _chol, residuals);
+
+                for (auto i = 0u ; i < n ; ++i)
+                {
+                    gsl_vector_const_view row = gsl_matrix_const_row(residuals, i);
+
+                    double chi_square;
+                    gsl_blas_ddot(&row.vector, &row.vector, &chi_square);
+
+                    gsl_vector_set(results, i, _norm - 0.5 * chi_square);
+                }
+
+                gsl_matrix_free(residuals);
+            }
+
             virtual unsigned number_of_observations() const
             {
                 return _number_of_observations;
@@ -1092,22 +1223,15 @@ namespace eos
             {
                 const auto k = _mean->size;
 
-                // generate standard normals in observables
+                // To be consistent with the univariate Gaussian, we would center observables around theory,
+                // then compare to theory. Hence we can forget about theory, and stay centered on zero.
+                // For observables = L * u with standard normals u, the whitened residuals are just u,
+                // and chi^2 = u^T u.
+                double result = 0.0;
                 for (auto i = 0u ; i < k ; ++i)
                 {
-                    gsl_vector_set(_observables, i, gsl_ran_ugaussian(rng));
+                    result += power_of<2>(gsl_ran_ugaussian(rng));
                 }
-
-                // transform: observables2 <- _chol * observables
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _chol, _observables, 0.0, _observables_2);
-
-                // To be consistent with the univariate Gaussian, we would center observables around theory,
-                // then compare to theory. Hence we can forget about theory, and stay centered on zero.
-                // transform: observables <- inv(covariance) * observables2
-                gsl_blas_dgemv(CblasNoTrans, 1.0, _covariance_inv, _observables_2, 0.0, _observables);
-
-                double result;
-                gsl_blas_ddot(_observables, _observables_2, &result);
                 result *= -0.5;
                 result += _norm;
 
@@ -1569,6 +1693,12 @@ namespace eos
         return _imp->cache;
     }
 
+    unsigned
+    LogLikelihood::use_polynomials(const std::list<std::string> & coefficients, const std::set<Parameter::Id> & floating)
+    {
+        return _imp->cache.use_polynomials(coefficients, floating);
+    }
+
     double
     LogLikelihood::operator() () const
     {
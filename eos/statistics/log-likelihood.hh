@@ -61,6 +61,16 @@ namespace eos
             /// Compute the logarithm of the likelihood for this block.
             virtual double evaluate() const = 0;
 
+            /*!
+             * Compute the logarithm of the likelihood for this block for several sets of predictions at once.
+             * The block's observable cache is neither read nor modified.
+             *
+             * @param predictions The predictions, one row per set and one column per observable,
+             *                    in the order in which the observables were passed to the block's named constructor.
+             * @param results     The logarithms of the likelihood, one entry per row of predictions.
+             */
+            virtual void evaluate_batch(const gsl_matrix * predictions, gsl_vector * results) const = 0;
+
             /// The number of experimental observations (not observables!) used in this block.
             virtual unsigned number_of_observations() const = 0;
 
@@ -440,6 +450,18 @@ namespace eos
              */
             ObservableCache observable_cache() const;
 
+            /*!
+             * Predict observables by means of polynomials in the given coefficients, wherever possible.
+             *
+             * @param coefficients The names of the coefficients, typically Wilson coefficients.
+             * @param floating     The ids of all parameters that are expected to vary, including the coefficients.
+             *
+             * @return The number of observables that are predicted by means of a polynomial.
+             *
+             * @see ObservableCache::use_polynomials
+             */
+            unsigned use_polynomials(const std::list<std::string> & coefficients, const std::set<Parameter::Id> & floating);
+
             /*!
              * Evaluate the log likelihood, i.e., return @f[ \log \mathcal{L} = \log P(D | \vec{\theta}, M)=  - \frac{\chi^2}{2} + C@f].
              * @note: all observables are recalculated
@@ -21,14 +21,71 @@
 #include <test/test.hh>
 #include <eos/statistics/analysis_TEST.hh>
 #include <eos/statistics/log-likelihood.hh>
+#include <eos/utils/integrate.hh>
 #include <eos/utils/power_of.hh>
 #include <algorithm>
+#include <cmath>
+#include <list>
+#include <set>
 
 using namespace test;
 using namespace eos;
 
 namespace eos
 {
+    // not a polynomial in the mass
+    struct RatioTestObservable :
+        public TestObservable
+    {
+            RatioTestObservable(const Parameters & p, const Kinematics & k, const QualifiedName & mass_name) :
+                TestObservable(p, k, mass_name, QualifiedName("Test::ratio"))
+            {
+            }
+
+            virtual double evaluate() const
+            {
+                return power_of<2>(mass()) / (1.0 + power_of<2>(mass()));
+            }
+
+            virtual ObservablePtr clone() const
+            {
+                return ObservablePtr(new RatioTestObservable(p.clone(), k.clone(), mass_name));
+            }
+
+            virtual ObservablePtr clone(const Parameters & parameters) const
+            {
+                return ObservablePtr(new RatioTestObservable(parameters, k.clone(), mass_name));
+            }
+    };
+
+    // a quadratic polynomial in the mass, up to the accuracy of the numerical integration
+    struct IntegratedTestObservable :
+        public TestObservable
+    {
+            IntegratedTestObservable(const Parameters & p, const Kinematics & k, const QualifiedName & mass_name) :
+                TestObservable(p, k, mass_name, QualifiedName("Test::integrated"))
+            {
+            }
+
+            virtual double evaluate() const
+            {
+                const double m = mass();
+                std::function<double (const double &)> f = [m] (const double & t) { return power_of<2>(m + t) * std::exp(-5.0 * t); };
+
+                return integrate1D(f, 16, 0.0, 1.0);
+            }
+
+            virtual ObservablePtr clone() const
+            {
+                return ObservablePtr(new IntegratedTestObservable(p.clone(), k.clone(), mass_name));
+            }
+
+            virtual ObservablePtr clone(const Parameters & parameters) const
+            {
+                return ObservablePtr(new IntegratedTestObservable(parameters, k.clone(), mass_name));
+            }
+    };
+
     class LogLikelihoodTest :
         public TestCase
     {
@@ -101,6 +158,11 @@ namespace eos
                     LogLikelihood llh2 = llh1.clone();
                     TEST_CHECK_EQUAL(llh1(), llh2());
 
+                    // the clone holds its own copy of each observable, bound to its own parameters
+                    TEST_CHECK_EQUAL(llh1.observable_cache().size(), llh2.observable_cache().size());
+                    TEST_CHECK(llh1.observable_cache().observable(0) != llh2.observable_cache().observable(0));
+                    TEST_CHECK(! (llh2.observable_cache().observable(0)->parameters() != llh2.parameters()));
+
                     //change parameters of ll1, but not of llh2
                     p["mass::b(MSbar)"] = 4.30;
                     TEST_CHECK_NEARLY_EQUAL(llh1(), 1.383646559789377, eps);
@@ -111,6 +173,72 @@ namespace eos
                     TEST_CHECK_NEARLY_EQUAL(llh2(), -3.116353440210579, eps);
                 }
 
+                // polynomial surrogates
+                {
+                    p["mass::b(MSbar)"] = 4.25;
+                    p["mass::c"] = 1.3;
+
+                    LogLikelihood llh(p);
+                    llh.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)", k)), +4.1,  +4.2, +4.3);
+                    llh.add(ObservablePtr(new ObservableStub(p, "mass::c",        k)), +1.15, +1.2, +1.25);
+
+                    LogLikelihood reference = llh.clone();
+
+                    // mass::c floats, but is not a coefficient
+                    std::set<Parameter::Id> floating{ p["mass::b(MSbar)"].id(), p["mass::c"].id() };
+                    TEST_CHECK_EQUAL(1u, llh.use_polynomials(std::list<std::string>{ "mass::b(MSbar)" }, floating));
+                    TEST_CHECK(llh.observable_cache().uses_polynomial(0));
+                    TEST_CHECK(! llh.observable_cache().uses_polynomial(1));
+
+                    // constructing the polynomials leaves the parameters unchanged
+                    TEST_CHECK_EQUAL(4.25, p["mass::b(MSbar)"].evaluate());
+
+                    p["mass::b(MSbar)"] = 4.18;
+                    reference.parameters()["mass::b(MSbar)"] = 4.18;
+                    TEST_CHECK_NEARLY_EQUAL(reference(), llh(), 1e-12);
+
+                    // mass::c is fixed, so the second observable becomes a constant polynomial, which is rebuilt when mass::c changes
+                    TEST_CHECK_EQUAL(2u, llh.use_polynomials(std::list<std::string>{ "mass::b(MSbar)" }, std::set<Parameter::Id>{ p["mass::b(MSbar)"].id() }));
+
+                    p["mass::c"] = 1.22;
+                    reference.parameters()["mass::c"] = 1.22;
+                    TEST_CHECK_NEARLY_EQUAL(reference(), llh(), 1e-12);
+                    TEST_CHECK_EQUAL(1.22, llh.observable_cache()[1]);
+
+                    // clones inherit the polynomials
+                    LogLikelihood clone = llh.clone();
+                    TEST_CHECK(clone.observable_cache().uses_polynomial(0));
+                    TEST_CHECK(clone.observable_cache().uses_polynomial(1));
+
+                    clone.parameters()["mass::b(MSbar)"] = 4.31;
+                    reference.parameters()["mass::b(MSbar)"] = 4.31;
+                    TEST_CHECK_NEARLY_EQUAL(reference(), clone(), 1e-12);
+                    TEST_CHECK_EQUAL(4.18, llh.observable_cache()[0]);
+                }
+
+                // polynomial surrogates of ratios and integrated observables
+                {
+                    p["mass::b(MSbar)"] = 4.18;
+
+                    LogLikelihood llh(p);
+                    llh.add(ObservablePtr(new RatioTestObservable(p, k, "mass::b(MSbar)")),      +0.93, +0.94, +0.95);
+                    llh.add(ObservablePtr(new IntegratedTestObservable(p, k, "mass::b(MSbar)")), +3.7,  +3.8,  +3.9);
+
+                    LogLikelihood reference = llh.clone();
+
+                    // the ratio is evaluated directly, while the integration's inaccuracy does not prevent the use of a polynomial
+                    TEST_CHECK_EQUAL(1u, llh.use_polynomials(std::list<std::string>{ "mass::b(MSbar)" }, std::set<Parameter::Id>{ p["mass::b(MSbar)"].id() }));
+                    TEST_CHECK(! llh.observable_cache().uses_polynomial(0));
+                    TEST_CHECK(llh.observable_cache().uses_polynomial(1));
+
+                    p["mass::b(MSbar)"] = 4.25;
+                    reference.parameters()["mass::b(MSbar)"] = 4.25;
+                    llh();
+                    reference();
+                    TEST_CHECK_EQUAL(reference.observable_cache()[0], llh.observable_cache()[0]);
+                    TEST_CHECK_RELATIVE_ERROR(reference.observable_cache()[1], llh.observable_cache()[1], 1e-4);
+                }
+
                 // iteration
                 {
                     std::cout << "FOO" << std::endl;
@@ -670,12 +798,48 @@ namespace eos
 
                     double old_value = block->evaluate();
                     TEST_CHECK_RELATIVE_ERROR(old_value, block_clone->evaluate(), eps);
+                    TEST_CHECK_EQUAL(block->as_string(), block_clone->as_string());
 
                     // with updated parameters, results should differ
                     new_pars["mass::c"] = 1.232;
                     new_cache.update();
                     TEST_CHECK(block_clone->evaluate() != block->evaluate());
 
+                    /* batch evaluation */
+                    {
+                        gsl_matrix * predictions = gsl_matrix_alloc(3, 2);
+                        gsl_vector * results = gsl_vector_alloc(3);
+
+                        gsl_matrix_set(predictions, 0, 0, 4.35); gsl_matrix_set(predictions, 0, 1, 1.2);
+                        gsl_matrix_set(predictions, 1, 0, 4.6);  gsl_matrix_set(predictions, 1, 1, 1.3);
+                        gsl_matrix_set(predictions, 2, 0, 4.3);  gsl_matrix_set(predictions, 2, 1, 1.1);
+
+                        block->evaluate_batch(predictions, results);
+
+                        TEST_CHECK_NEARLY_EQUAL(gsl_vector_get(results, 0), 1.30077135,   1e-8);
+                        TEST_CHECK_NEARLY_EQUAL(gsl_vector_get(results, 1), -4.597666149, 1e-8);
+                        TEST_CHECK_NEARLY_EQUAL(gsl_vector_get(results, 2), -log(2 * M_PI) - 0.5 * log(1.6e-5), 1e-8);
+
+                        // the cache is left untouched
+                        TEST_CHECK_NEARLY_EQUAL(block->evaluate(), -4.597666149, 1e-8);
+
+                        // one-dimensional blocks agree with evaluate()
+                        gsl_matrix_view column = gsl_matrix_submatrix(predictions, 0, 1, 3, 1);
+                        block2->evaluate_batch(&column.matrix, results);
+                        for (unsigned i = 0 ; i < 3 ; ++i)
+                        {
+                            p["mass::c"] = gsl_matrix_get(predictions, i, 1);
+                            cache.update();
+                            TEST_CHECK_NEARLY_EQUAL(gsl_vector_get(results, i), block2->evaluate(), 1e-13);
+                        }
+
+                        // dimension mismatches are rejected
+                        TEST_CHECK_THROWS(InternalError, block->evaluate_batch(&column.matrix, results));
+
+                        gsl_vector_free(results);
+                        gsl_matrix_free(predictions);
+                    }
+
                     /* interface with correlation */
                     mean = std::array<double, 2> {{ -0.32, 0.2 }};
                     std::array<double, 2> variances{{ 0.1321, 0.0601 }};
@@ -25,6 +25,7 @@
 #include <eos/utils/stringify.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <numeric>
@@ -108,6 +109,11 @@ namespace eos
                     return _value;
                 }
 
+                virtual void evaluate(const double *, const unsigned & number, double * result) const
+                {
+                    std::fill(result, result + number, _value);
+                }
+
                 virtual LogPriorPtr clone(const Parameters & parameters) const
                 {
                     return LogPriorPtr(new priors::Flat(parameters, _name, _range));
@@ -118,6 +124,21 @@ namespace eos
                     return gsl_rng_uniform(rng) * (_range.max - _range.min) + _range.min;
                 }
 
+                virtual void sample(gsl_rng * rng, const unsigned & number, double * result) const
+                {
+                    const double width = _range.max - _range.min;
+
+                    for (unsigned i = 0 ; i < number ; ++i)
+                    {
+                        result[i] = gsl_rng_uniform(rng);
+                    }
+
+                    for (unsigned i = 0 ; i < number ; ++i)
+                    {
+                        result[i] = result[i] * width + _range.min;
+                    }
+                }
+
                 virtual double mean() const
                 {
                     return (_range.max - _range.min) / 2.0;
@@ -160,6 +181,24 @@ namespace eos
                 // PDF normalization factor precomputed for operator()
                 const double _norm_lower, _norm_upper;
 
+                double _log_pdf(const double & x) const
+                {
+                    if (x < _central)
+                        return _norm_lower - 0.5 * power_of<2>((x - _central) / _sigma_lower);
+
+                    return _norm_upper - 0.5 * power_of<2>((x - _central) / _sigma_upper);
+                }
+
+                // get a sample from lower or upper part using inverse transform method
+                // CDF = c \Phi(x - x_{central} / \sigma) + b
+                double _inverse_cdf(const double & u) const
+                {
+                    if (u < _prob_lower)
+                       return gsl_cdf_gaussian_Pinv((u - _prob_lower) / _c_b + 0.5, _sigma_lower) + _central;
+                    else
+                       return gsl_cdf_gaussian_Pinv((u - _prob_lower) / _c_a + 0.5,  _sigma_upper) + _central;
+                }
+
             public:
                 Gauss(const Parameters & parameters, const std::string & name, const ParameterRange & range,
                         const double & lower, const double & central, const double & upper) :
@@ -208,22 +247,16 @@ namespace eos
 
                 virtual double operator()() const
                 {
-                    double sigma = 0.0, norm = 0.0;
-
                     // read parameter's current value
-                    double x = _parameter_descriptions.front().parameter->evaluate();
+                    return _log_pdf(_parameter_descriptions.front().parameter->evaluate());
+                }
 
-                    if (x < _central)
-                    {
-                        sigma = _sigma_lower;
-                        norm = _norm_lower;
-                    }
-                    else
+                virtual void evaluate(const double * values, const unsigned & number, double * result) const
+                {
+                    for (unsigned i = 0 ; i < number ; ++i)
                     {
-                        sigma = _sigma_upper;
-                        norm = _norm_upper;
+                        result[i] = _log_pdf(values[i]);
                     }
-                    return norm - 0.5 * power_of<2>((x - _central) / sigma);
                 }
 
                 virtual LogPriorPtr clone(const Parameters & parameters) const
@@ -233,15 +266,20 @@ namespace eos
 
                 virtual double sample(gsl_rng * rng) const
                 {
-                    // find out if sample in upper or lower part
-                    const double u = gsl_rng_uniform(rng);
+                    return _inverse_cdf(gsl_rng_uniform(rng));
+                }
 
-                    // get a sample from lower or upper part using inverse transform method
-                    // CDF = c \Phi(x - x_{central} / \sigma) + b
-                    if (u < _prob_lower)
-                       return gsl_cdf_gaussian_Pinv((u - _prob_lower) / _c_b + 0.5, _sigma_lower) + _central;
-                    else
-                       return gsl_cdf_gaussian_Pinv((u - _prob_lower) / _c_a + 0.5,  _sigma_upper) + _central;
+                virtual void sample(gsl_rng * rng, const unsigned & number, double * result) const
+                {
+                    for (unsigned i = 0 ; i < number ; ++i)
+                    {
+                        result[i] = gsl_rng_uniform(rng);
+                    }
+
+                    for (unsigned i = 0 ; i < number ; ++i)
+                    {
+                        result[i] = _inverse_cdf(result[i]);
+                    }
                 }
 
                 virtual double mean() const
@@ -295,11 +333,44 @@ namespace eos
 
                 double _norm;
 
+                // the cumulative distribution at the boundaries of the range, used for sampling
+                double _cdf_min, _cdf_max;
+
                 LogGamma(const Parameters & parameters) :
                     LogPrior(parameters)
                 {
                 }
 
+                /*
+                 * For x = \nu + \lambda * log(y), with y ~ Gamma(\alpha, 1), the cumulative is
+                 * P(\alpha, exp((x - \nu) / \lambda)) for \lambda > 0, and
+                 * Q(\alpha, exp((x - \nu) / \lambda)) for \lambda < 0.
+                 */
+                double _cdf(const double & x) const
+                {
+                    const double y = std::exp((x - _nu) / _lambda);
+
+                    return (_lambda > 0.0) ? gsl_sf_gamma_inc_P(_alpha, y) : gsl_sf_gamma_inc_Q(_alpha, y);
+                }
+
+                // map u ~ U[0, 1) onto the truncated distribution by inversion of its cumulative
+                double _inverse_cdf(const double & u) const
+                {
+                    const double p = _cdf_min + u * (_cdf_max - _cdf_min);
+                    const double y = (_lambda > 0.0) ? gsl_cdf_gamma_Pinv(p, _alpha, 1.0) : gsl_cdf_gamma_Qinv(p, _alpha, 1.0);
+                    const double x = _nu + _lambda * std::log(y);
+
+                    // guard against round-off at the boundaries
+                    return std::min(std::max(x, _range.min), _range.max);
+                }
+
+                double _log_pdf(const double & x) const
+                {
+                    const double z = (x - _nu) / _lambda;
+
+                    return _norm + _alpha * z - std::exp(z);
+                }
+
             public:
                 LogGamma(const Parameters & parameters, const std::string & name, const ParameterRange & range,
                         const double & lower, const double & central, const double & upper) :
@@ -397,6 +468,9 @@ namespace eos
                     // calculate normalization factors that are independent of x
                     _norm += -1.0 * gsl_sf_lngamma(_alpha) - std::log(std::fabs(_lambda));
 
+                    _cdf_min = _cdf(_range.min);
+                    _cdf_max = _cdf(_range.max);
+
                     // restore default error handler
                     gsl_set_error_handler(default_gsl_error_handler);
                 }
@@ -456,8 +530,15 @@ namespace eos
 
                 virtual double operator()() const
                 {
-                    const double z = (_parameter_descriptions.front().parameter->evaluate() - _nu) / _lambda;
-                    return _norm + _alpha * z - std::exp(z);
+                    return _log_pdf(_parameter_descriptions.front().parameter->evaluate());
+                }
+
+                virtual void evaluate(const double * values, const unsigned & number, double * result) const
+                {
+                    for (unsigned i = 0 ; i < number ; ++i)
+                    {
+                        result[i] = _log_pdf(values[i]);
+                    }
                 }
 
                 // change private members by hand. Saves time on optimization
@@ -465,6 +546,8 @@ namespace eos
                 {
                     priors::LogGamma * log_gamma = new priors::LogGamma(parameters);
                     log_gamma->_alpha = _alpha;
+                    log_gamma->_cdf_max = _cdf_max;
+                    log_gamma->_cdf_min = _cdf_min;
                     log_gamma->_central = _central;
                     log_gamma->_lambda = _lambda;
                     log_gamma->_name = _name;
@@ -481,21 +564,27 @@ namespace eos
 
                 /*!
                  * Use the fact that if x' ~ StdLogGamma(\alpha), then
-                 * x = \nu + \lambda * x' ~ LogGamma(\nu, \lambda, \alpha)
+                 * x = \nu + \lambda * x' ~ LogGamma(\nu, \lambda, \alpha).
+                 *
+                 * The truncation to the range is accounted for exactly by inverting the
+                 * cumulative, rather than by rejecting samples outside the range.
                  */
                 virtual double sample(gsl_rng * rng) const
                 {
-                    double x = _range.min;
+                    return _inverse_cdf(gsl_rng_uniform(rng));
+                }
 
-                    while(true)
+                virtual void sample(gsl_rng * rng, const unsigned & number, double * result) const
+                {
+                    for (unsigned i = 0 ; i < number ; ++i)
                     {
-                        x = _lambda * std::log(gsl_ran_gamma(rng, _alpha, 1.0)) + _nu;
-
-                        if (_range.min < x && x < _range.max)
-                            break;
+                        result[i] = gsl_rng_uniform(rng);
                     }
 
-                    return x;
+                    for (unsigned i = 0 ; i < number ; ++i)
+                    {
+                        result[i] = _inverse_cdf(result[i]);
+                    }
                 }
 
                 virtual double mean() const
@@ -528,6 +617,42 @@ namespace eos
     {
     }
 
+    void
+    LogPrior::evaluate(const double * values, const unsigned & number, double * result) const
+    {
+        const unsigned dimension = _parameter_descriptions.size();
+
+        std::vector<double> old_values;
+        for (const auto & d : _parameter_descriptions)
+        {
+            old_values.push_back(d.parameter->evaluate());
+        }
+
+        for (unsigned i = 0 ; i < number ; ++i)
+        {
+            for (unsigned k = 0 ; k < dimension ; ++k)
+            {
+                _parameter_descriptions[k].parameter->set(values[i * dimension + k]);
+            }
+
+            result[i] = (*this)();
+        }
+
+        for (unsigned k = 0 ; k < dimension ; ++k)
+        {
+            _parameter_descriptions[k].parameter->set(old_values[k]);
+        }
+    }
+
+    void
+    LogPrior::sample(gsl_rng * rng, const unsigned & number, double * result) const
+    {
+        for (unsigned i = 0 ; i < number ; ++i)
+        {
+            result[i] = sample(rng);
+        }
+    }
+
     LogPrior::Iterator
     LogPrior::begin()
     {
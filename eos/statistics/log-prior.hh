@@ -90,12 +90,38 @@ namespace eos
              */
             virtual double operator() () const = 0;
 
+            /*!
+             * Evaluate the natural logarithm of the prior for a block of points.
+             *
+             * The values of the parameters are not changed by subclasses that override
+             * this method. The default implementation sets the parameters to each point in
+             * turn, and restores their values afterwards.
+             *
+             * @param values The points, stored one after another. Each point comprises one value
+             *               per parameter, in the order of the parameter descriptions.
+             * @param number The number of points.
+             * @param result Buffer receiving the log(prior) at each of the points.
+             */
+            virtual void evaluate(const double * values, const unsigned & number, double * result) const;
+
             /*!
              * @param rng the random number engine
              * @return a sample according to this prior distribution
              */
             virtual double sample(gsl_rng * rng) const = 0;
 
+            /*!
+             * Draw a block of samples according to this prior distribution.
+             *
+             * The samples are identical to those obtained from the same number of calls to
+             * sample(gsl_rng *).
+             *
+             * @param rng    The random number engine.
+             * @param number The number of samples.
+             * @param result Buffer receiving the samples, stored one after another.
+             */
+            virtual void sample(gsl_rng * rng, const unsigned & number, double * result) const;
+
             /*!
              * Return the mean of the distribution.
              */
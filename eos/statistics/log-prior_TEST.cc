@@ -22,6 +22,11 @@
 #include <eos/statistics/log-prior.hh>
 #include <eos/utils/power_of.hh>
 
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
 using namespace test;
 using namespace eos;
 
@@ -310,6 +315,153 @@ class LogPriorTest :
                 TEST_CHECK_RELATIVE_ERROR((*log_gamma)(), 1.139778733, low_eps);
             }
 
+            // truncated LogGamma sampling reproduces the truncated density, for both signs of lambda
+            {
+                struct Case { double lower, central, upper; ParameterRange range; double sign; };
+                const std::vector<Case> cases
+                {
+                    // long tail towards small values: lambda > 0
+                    { 0.34, 0.53, 0.63, ParameterRange{ 0.40, 0.60 }, +1.0 },
+                    // long tail towards large values: lambda < 0
+                    { 0.66, 1.20, 1.80, ParameterRange{ 0.80, 2.00 }, -1.0 },
+                };
+
+                for (const auto & c : cases)
+                {
+                    LogPriorPtr prior = LogPrior::LogGamma(parameters, "mass::b(MSbar)", c.range, c.lower, c.central, c.upper);
+
+                    const std::string description = prior->as_string();
+                    const auto pos = description.find("lambda: ") + 8;
+                    const double lambda = std::stod(description.substr(pos, description.find(',', pos) - pos));
+                    TEST_CHECK(lambda * c.sign > 0.0);
+
+                    // the cumulative of the truncated density, integrated numerically with the trapezoidal rule
+                    static const unsigned points = 20001;
+                    const double dx = (c.range.max - c.range.min) / (points - 1);
+                    std::vector<double> x(points), cdf(points, 0.0);
+                    for (unsigned i = 0 ; i < points ; ++i)
+                    {
+                        x[i] = c.range.min + i * dx;
+                    }
+
+                    std::vector<double> pdf(points);
+                    prior->evaluate(x.data(), points, pdf.data());
+                    double first_moment = 0.0;
+                    for (unsigned i = 0 ; i < points ; ++i)
+                    {
+                        pdf[i] = std::exp(pdf[i]);
+
+                        if (i > 0)
+                        {
+                            cdf[i] = cdf[i - 1] + 0.5 * dx * (pdf[i - 1] + pdf[i]);
+                            first_moment += 0.5 * dx * (x[i - 1] * pdf[i - 1] + x[i] * pdf[i]);
+                        }
+                    }
+
+                    const double norm = cdf.back();
+                    for (auto & f : cdf)
+                    {
+                        f /= norm;
+                    }
+                    const double expected_mean = first_moment / norm;
+
+                    auto analytic_cdf = [&] (const double & value) -> double
+                    {
+                        const unsigned i = std::min<unsigned>((value - c.range.min) / dx, points - 2);
+                        const double f = (value - x[i]) / dx;
+
+                        return cdf[i] * (1.0 - f) + cdf[i + 1] * f;
+                    };
+
+                    static const unsigned N = 100000;
+                    gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
+                    gsl_rng_set(rng, 1729);
+
+                    std::vector<double> samples(N);
+                    prior->sample(rng, N, samples.data());
+                    gsl_rng_free(rng);
+
+                    std::sort(samples.begin(), samples.end());
+                    TEST_CHECK(c.range.min <= samples.front());
+                    TEST_CHECK(samples.back() <= c.range.max);
+
+                    // the mean agrees within four standard errors
+                    double mean = 0.0, variance = 0.0;
+                    for (const auto & s : samples)
+                    {
+                        mean += s / N;
+                    }
+                    for (const auto & s : samples)
+                    {
+                        variance += power_of<2>(s - mean) / (N - 1);
+                    }
+                    TEST_CHECK_NEARLY_EQUAL(mean, expected_mean, 4.0 * std::sqrt(variance / N));
+
+                    // the sample quantiles agree with the cumulative within four standard errors
+                    for (double q : { 0.05, 0.25, 0.5, 0.75, 0.95 })
+                    {
+                        TEST_CHECK_NEARLY_EQUAL(analytic_cdf(samples[unsigned(q * N)]), q, 4.0 * std::sqrt(q * (1.0 - q) / N));
+                    }
+
+                    // Kolmogorov-Smirnov distance below its 99.9% critical value
+                    double distance = 0.0;
+                    for (unsigned i = 0 ; i < N ; ++i)
+                    {
+                        const double f = analytic_cdf(samples[i]);
+                        distance = std::max(distance, std::max(f - double(i) / N, double(i + 1) / N - f));
+                    }
+                    TEST_CHECK(distance < 1.95 / std::sqrt(double(N)));
+                }
+            }
+
+            // batch evaluation and sampling
+            {
+                Parameters p = Parameters::Defaults();
+                Parameter m_b = p["mass::b(MSbar)"];
+
+                std::vector<LogPriorPtr> priors
+                {
+                    LogPrior::Flat(p, "mass::b(MSbar)", ParameterRange{ 0.2, 0.7 }),
+                    LogPrior::Gauss(p, "mass::b(MSbar)", ParameterRange{ 0.2, 0.7 }, 0.34, 0.53, 0.63),
+                    LogPrior::LogGamma(p, "mass::b(MSbar)", ParameterRange{ 0.2, 0.7 }, 0.34, 0.53, 0.63),
+                };
+
+                for (const auto & prior : priors)
+                {
+                    m_b = 0.45;
+
+                    // evaluation agrees with the one-point interface, and leaves the parameter untouched
+                    const std::vector<double> values{ 0.21, 0.34, 0.5, 0.53, 0.57, 0.69 };
+                    std::vector<double> log_priors(values.size());
+                    prior->evaluate(values.data(), values.size(), log_priors.data());
+                    TEST_CHECK_EQUAL(0.45, m_b());
+
+                    for (unsigned i = 0 ; i < values.size() ; ++i)
+                    {
+                        m_b = values[i];
+                        TEST_CHECK_NEARLY_EQUAL((*prior)(), log_priors[i], eps);
+                    }
+
+                    // sampling agrees with the one-sample interface, and respects the range
+                    static const unsigned N = 1000;
+                    gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
+
+                    gsl_rng_set(rng, 2018);
+                    std::vector<double> samples(N);
+                    prior->sample(rng, N, samples.data());
+
+                    gsl_rng_set(rng, 2018);
+                    for (unsigned i = 0 ; i < N ; ++i)
+                    {
+                        TEST_CHECK_EQUAL(prior->sample(rng), samples[i]);
+                        TEST_CHECK(0.2 <= samples[i]);
+                        TEST_CHECK(samples[i] <= 0.7);
+                    }
+
+                    gsl_rng_free(rng);
+                }
+            }
+
             //Make
             {
                 Parameters p = Parameters::Defaults();
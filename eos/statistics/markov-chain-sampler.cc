@@ -22,6 +22,7 @@
 
 #include <eos/statistics/markov-chain-sampler.hh>
 #include <eos/statistics/analysis.hh>
+#include <eos/utils/background-writer.hh>
 #include <eos/utils/hdf5.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/power_of.hh>
@@ -33,15 +34,49 @@
 #include <Minuit2/MnPrint.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
 #include <map>
 #include <limits>
 #include <sys/stat.h>
 
+#include <gsl/gsl_rng.h>
+
 namespace eos
 {
     template<>
     struct Implementation<MarkovChainSampler>
     {
+        /*
+         * The replicas of one chain at decreasing inverse temperatures, for parallel tempering.
+         * The cold replica is identical to the chain itself.
+         */
+        struct Ladder
+        {
+            std::vector<MarkovChain> replicas;
+
+            // beta_{k + 1} = beta_k * exp(-exp(log_spacing[k]))
+            std::vector<double> log_spacing;
+
+            // swap statistics of neighbouring replicas (k, k + 1) since the last report
+            std::vector<unsigned> swaps_proposed;
+            std::vector<unsigned> swaps_accepted;
+
+            // number of swap rounds which contributed to the adaptation of the temperatures
+            unsigned adaptation_steps;
+
+            void update_inverse_temperatures()
+            {
+                double beta = 1.0;
+                for (unsigned k = 1 ; k < replicas.size() ; ++k)
+                {
+                    beta *= std::exp(-std::exp(log_spacing[k - 1]));
+                    replicas[k].inverse_temperature(std::max(beta, std::numeric_limits<double>::min()));
+                }
+            }
+        };
+
         // the target density to sample from
         DensityPtr density;
 
@@ -63,14 +98,56 @@ namespace eos
 
         ChainGroup::RValueFunction compute_rvalue;
 
+        // temperature ladders, one per chain; empty unless parallel tempering is used
+        std::vector<Ladder> ladders;
+
+        // decides on the swaps between replicas
+        gsl_rng * swap_rng;
+
+        // progress of the sampling beyond the prerun info, as stored in checkpoints
+        bool main_run_started;
+        unsigned chunks_completed;
+
+        // number of prerun updates or main-run chunks since the last checkpoint
+        unsigned steps_since_checkpoint;
+
+        // the complete state of the sampler, as stored in a checkpoint
+        struct Snapshot
+        {
+            // number of chains, number of temperatures, main run started, prerun iterations,
+            // prerun converged, iterations at convergence, chunks completed
+            std::vector<double> progress;
+
+            // the cold replica of each chain, followed by its hot replicas
+            std::vector<std::vector<MarkovChain::Checkpoint>> chains;
+
+            // the number of adaptation steps of each ladder, followed by its log spacings
+            std::vector<std::vector<double>> ladders;
+
+            std::vector<unsigned> swap_rng_state;
+        };
+
+        // stores samples and checkpoints while the chains move on
+        BackgroundWriter writer;
+
         Implementation(const DensityPtr & density, const MarkovChainSampler::Config & config) :
             density(density),
             config(config),
-            compute_rvalue(config.use_strict_rvalue_definition ? &RValue::gelman_rubin : &RValue::approximation)
+            compute_rvalue(config.use_strict_rvalue_definition ? &RValue::gelman_rubin : &RValue::approximation),
+            swap_rng(nullptr),
+            main_run_started(false),
+            chunks_completed(0),
+            steps_since_checkpoint(0)
         {
             initialize();
         }
 
+        ~Implementation()
+        {
+            if (swap_rng)
+                gsl_rng_free(swap_rng);
+        }
+
         /*
          * Checks efficiencies, adjusts if needed
          * return true if all efficiencies in ranges defined by MarkovChainConfig::min_efficiency, MarkovChainConfig::max_efficiency
@@ -84,29 +161,23 @@ namespace eos
             // loop over chains and proposal functions
             for (unsigned c = 0 ; c < chains.size() ; ++c)
             {
-                const MarkovChain::Stats & statistics = chains[c].statistics();
-                if (chains[c].history().states.empty())
-                {
-                    throw InternalError("MarkovChainSampler::adjust_scales: cannot adapt from empty history");
-                }
-
-                // rely on the fact that counters are reset in each chunk
-                double efficiency = 1.0 * statistics.iterations_accepted / (statistics.iterations_accepted + statistics.iterations_rejected);
-                if ((efficiency < config.min_efficiency) || (efficiency > config.max_efficiency))
+                if (! adjust_scale(chains[c], iterations, "chain " + stringify(c)))
                     efficiencies_ok = false;
+            }
 
-                // consider only the last chunk
-                MarkovChain::State::Iterator states_begin = chains[c].history().states.end() - iterations;
-                MarkovChain::State::Iterator states_end = chains[c].history().states.end();
-
-                chains[c].proposal_function()->adapt(states_begin, states_end, efficiency, config.min_efficiency, config.max_efficiency);
-
-                Log::instance()->message("markov_chain_sampler.efficiencies", ll_debug)
-                        << "Current efficiency for chain " << c << ": " << stringify(efficiency, 4);
+            // the hot replicas only need a reasonable efficiency, which does not enter the convergence criterion
+            for (unsigned c = 0 ; c < ladders.size() ; ++c)
+            {
+                for (unsigned k = 1 ; k < ladders[c].replicas.size() ; ++k)
+                {
+                    MarkovChain & replica = ladders[c].replicas[k];
+                    adjust_scale(replica, iterations, "chain " + stringify(c) + ", replica " + stringify(k));
 
-                Log::instance()->message("markov_chain_sampler.efficiencies", ll_debug)
-                        << "invalid/rejected proposals = " << stringify(1.0 * statistics.iterations_invalid / statistics.iterations_rejected, 4);
+                    // the history of a hot replica serves the adaptation only
+                    replica.clear();
+                }
             }
+
             if (efficiencies_ok)
                 Log::instance()->message("markov_chain_sampler.efficiencies", ll_informational)
                     << "All efficiencies OK";
@@ -114,6 +185,37 @@ namespace eos
             return efficiencies_ok;
         }
 
+        /*
+         * Adapts the proposal of a single chain from its last iterations.
+         *
+         * @return true if the chain's efficiency lies in the range defined by MarkovChainConfig::min_efficiency, MarkovChainConfig::max_efficiency
+         */
+        bool adjust_scale(MarkovChain & chain, const unsigned & iterations, const std::string & name)
+        {
+            const MarkovChain::Stats & statistics = chain.statistics();
+            if (chain.history().states.empty())
+            {
+                throw InternalError("MarkovChainSampler::adjust_scales: cannot adapt from empty history");
+            }
+
+            // rely on the fact that counters are reset in each chunk
+            double efficiency = 1.0 * statistics.iterations_accepted / (statistics.iterations_accepted + statistics.iterations_rejected);
+
+            // consider only the last chunk
+            MarkovChain::State::Iterator states_begin = chain.history().states.end() - iterations;
+            MarkovChain::State::Iterator states_end = chain.history().states.end();
+
+            chain.proposal_function()->adapt(states_begin, states_end, efficiency, config.min_efficiency, config.max_efficiency);
+
+            Log::instance()->message("markov_chain_sampler.efficiencies", ll_debug)
+                    << "Current efficiency for " << name << ": " << stringify(efficiency, 4);
+
+            Log::instance()->message("markov_chain_sampler.efficiencies", ll_debug)
+                    << "invalid/rejected proposals = " << stringify(1.0 * statistics.iterations_invalid / statistics.iterations_rejected, 4);
+
+            return ! ((efficiency < config.min_efficiency) || (efficiency > config.max_efficiency));
+        }
+
         bool check_convergence(const unsigned & iterations)
         {
             bool efficiencies_ok = adjust_scales(iterations);
@@ -273,6 +375,179 @@ namespace eos
          }
 
 
+        /*
+         * Run all chains, including their hot replicas, for the given number of iterations.
+         *
+         * With parallel tempering, the replicas run in segments of MarkovChainSampler::Config::swap_interval
+         * iterations, after each of which swaps between neighbouring replicas are proposed.
+         *
+         * @param iterations   The number of iterations.
+         * @param adapt_ladder If true, adapt the temperatures of the replicas to the target swap rate.
+         */
+        void run_chains(const unsigned & iterations, const bool & adapt_ladder)
+        {
+            std::vector<MarkovChain> replicas;
+            if (ladders.empty())
+            {
+                replicas = chains;
+            }
+            else
+            {
+                for (auto & l : ladders)
+                {
+                    replicas.insert(replicas.end(), l.replicas.begin(), l.replicas.end());
+                }
+            }
+
+            const unsigned segment_size = ladders.empty() ? iterations : unsigned(config.swap_interval);
+            for (unsigned done = 0 ; done < iterations ; )
+            {
+                const unsigned segment = std::min(segment_size, iterations - done);
+
+                // start with empty ticket queue
+                tickets.clear();
+
+                // the first segment starts a new run, which resets the counters of accepted and rejected proposals
+                for (auto & r : replicas)
+                {
+                    std::function<void (void)> f = (0 == done) ? std::bind(&MarkovChain::run, r, segment) : std::bind(&MarkovChain::resume, r, segment);
+
+                    if (config.parallelize)
+                    {
+                        tickets.push_back(ThreadPool::instance()->enqueue(f));
+                    }
+                    else
+                    {
+                        f();
+                    }
+                }
+
+                // wait for job completion
+                for (auto t = tickets.begin(), t_end = tickets.end(); t != t_end; ++t)
+                {
+                    t->wait();
+                }
+
+                // all tickets finished
+                tickets.clear();
+
+                done += segment;
+
+                for (auto & l : ladders)
+                {
+                    propose_swaps(l, adapt_ladder);
+                }
+            }
+        }
+
+        /*
+         * Propose to swap the states of all pairs of neighbouring replicas, beginning with the hottest pair.
+         */
+        void propose_swaps(Ladder & ladder, const bool & adapt)
+        {
+            // step size of the stochastic approximation of the target swap rate
+            const double gain = std::pow(1.0 + ladder.adaptation_steps, -0.6);
+
+            for (unsigned k = ladder.replicas.size() - 1 ; k > 0 ; --k)
+            {
+                MarkovChain & colder = ladder.replicas[k - 1];
+                MarkovChain & hotter = ladder.replicas[k];
+
+                // swap the states with probability min(1, [p(x_hot) / p(x_cold)]^(beta_cold - beta_hot))
+                const double log_r = (colder.inverse_temperature() - hotter.inverse_temperature())
+                    * (hotter.current_state().log_density - colder.current_state().log_density);
+                const double acceptance = std::isnan(log_r) ? 0.0 : std::min(1.0, std::exp(log_r));
+
+                ++ladder.swaps_proposed[k - 1];
+                if (gsl_rng_uniform(swap_rng) < acceptance)
+                {
+                    MarkovChain::State state = colder.current_state();
+                    colder.set_state(hotter.current_state());
+                    hotter.set_state(state);
+
+                    ++ladder.swaps_accepted[k - 1];
+                }
+
+                // spread the temperatures if swaps are accepted too often, and vice versa
+                if (adapt)
+                    ladder.log_spacing[k - 1] += gain * (acceptance - config.target_swap_rate);
+            }
+
+            if (adapt)
+            {
+                ++ladder.adaptation_steps;
+                ladder.update_inverse_temperatures();
+            }
+        }
+
+        /*
+         * Log the swap rates since the last report, and optionally store them together with
+         * the inverse temperatures to the HDF5 file.
+         *
+         * @param output_base The root directory name within the HDF5 file under which all samples are stored.
+         * @param store       Whether to store the swap statistics.
+         */
+        void report_swaps(const std::string & output_base, const bool & store)
+        {
+            if (ladders.empty())
+                return;
+
+            // (inverse temperature, proposed swaps, accepted swaps) of each replica and its hotter neighbour
+            std::shared_ptr<std::vector<std::vector<double>>> records(new std::vector<std::vector<double>>(ladders.size()));
+
+            for (unsigned c = 0 ; c < ladders.size() ; ++c)
+            {
+                Ladder & l = ladders[c];
+
+                std::string rates;
+                for (unsigned k = 0 ; k < l.replicas.size() ; ++k)
+                {
+                    rates += " (" + stringify(l.replicas[k].inverse_temperature(), 4);
+                    if (k + 1 < l.replicas.size())
+                    {
+                        rates += ", " + stringify(1.0 * l.swaps_accepted[k] / l.swaps_proposed[k], 4);
+                    }
+                    rates += ")";
+                }
+
+                Log::instance()->message("markov_chain_sampler.tempering", ll_informational)
+                    << "Chain " << c << ": (beta, swap rate) =" << rates;
+
+                for (unsigned k = 0 ; k < l.replicas.size() ; ++k)
+                {
+                    (*records)[c].push_back(l.replicas[k].inverse_temperature());
+                    (*records)[c].push_back((k + 1 < l.replicas.size()) ? l.swaps_proposed[k] : 0.0);
+                    (*records)[c].push_back((k + 1 < l.replicas.size()) ? l.swaps_accepted[k] : 0.0);
+                }
+
+                std::fill(l.swaps_proposed.begin(), l.swaps_proposed.end(), 0u);
+                std::fill(l.swaps_accepted.begin(), l.swaps_accepted.end(), 0u);
+            }
+
+            if (! store)
+                return;
+
+            const std::string output_file = config.output_file;
+            writer.enqueue([records, output_file, output_base] ()
+            {
+                const hdf5::Array<1, double> tempering_type
+                {
+                    "tempering",
+                    { 3 },
+                };
+
+                hdf5::File file = hdf5::File::Open(output_file, H5F_ACC_RDWR);
+                for (unsigned c = 0 ; c < records->size() ; ++c)
+                {
+                    auto data_set = file.create_or_open_data_set(output_base + "/chain #" + stringify(c) + "/tempering", tempering_type);
+                    for (auto r = (*records)[c].cbegin(), r_end = (*records)[c].cend() ; r != r_end ; r += 3)
+                    {
+                        data_set << std::vector<double>(r, r + 3);
+                    }
+                }
+            });
+        }
+
         /*
          * Dump MCMC samples and proposal density state to HDF5 file.
          *
@@ -280,17 +555,322 @@ namespace eos
          */
         void dump_hdf5(const std::string & output_base, const unsigned & last_iterations)
         {
-            hdf5::File file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
-
             Log::instance()->message("markov_chain_sampler.dump_hdf5", ll_debug)
                 << "Dumping all " << chains.size() <<" chains to HDF5 file " << config.output_file;
 
-            unsigned i = 0;
-            for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c, ++i)
+            // copy the samples, so that the chains can move on while the copies are stored
+            std::shared_ptr<std::vector<MarkovChain::Checkpoint>> snapshots(new std::vector<MarkovChain::Checkpoint>());
+            for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c)
             {
-                c->dump_history(file, output_base + "/chain #" + stringify(i), last_iterations);
-                c->dump_proposal(file, output_base + "/chain #" + stringify(i));
+                const std::vector<MarkovChain::State> & states = c->history().states;
+                if (states.size() < last_iterations)
+                    throw InternalError("MarkovChainSampler::dump_hdf5: Cannot store more samples (" + stringify(last_iterations)
+                        + ") than there are in history (" + stringify(states.size()) + ").");
+
+                MarkovChain::Checkpoint snapshot;
+                snapshot.history.assign(states.cend() - last_iterations, states.cend());
+                snapshot.stats = c->statistics();
+                snapshot.proposal = c->proposal_function()->clone();
+                snapshots->push_back(snapshot);
             }
+
+            const std::string output_file = config.output_file;
+            writer.enqueue([snapshots, output_file, output_base] ()
+            {
+                hdf5::File file = hdf5::File::Open(output_file, H5F_ACC_RDWR);
+                for (unsigned i = 0 ; i < snapshots->size() ; ++i)
+                {
+                    const MarkovChain::Checkpoint & snapshot = (*snapshots)[i];
+                    MarkovChain::dump_states(file, output_base + "/chain #" + stringify(i), snapshot.history, snapshot.stats);
+                    snapshot.proposal->dump_state(file, output_base + "/chain #" + stringify(i) + "/proposal");
+                }
+            });
+        }
+
+        /*
+         * Write the descriptions of the parameters of each chain to the HDF5 file.
+         *
+         * @param output_base Either "prerun" or "main run".
+         */
+        void dump_descriptions(const std::string & output_base)
+        {
+            const DensityPtr density = this->density;
+            const std::string output_file = config.output_file;
+            const unsigned number_of_chains = chains.size();
+            writer.enqueue([density, output_file, output_base, number_of_chains] ()
+            {
+                auto file = hdf5::File::Open(output_file, H5F_ACC_RDWR);
+                for (unsigned i = 0; i < number_of_chains; ++i)
+                {
+                    density->dump_descriptions(file, "/descriptions/" + output_base + "/chain #" + stringify(i));
+                }
+            });
+        }
+
+        /*
+         * Write the complete state of the sampler to the checkpoint file, if any.
+         */
+        void write_checkpoint()
+        {
+            steps_since_checkpoint = 0;
+
+            if (config.checkpoint_file.empty())
+                return;
+
+            std::shared_ptr<Snapshot> snapshot(new Snapshot);
+            snapshot->progress = std::vector<double>
+            {
+                double(chains.size()), double(config.number_of_temperatures), double(main_run_started),
+                double(pre_run_info.iterations), double(pre_run_info.converged), double(pre_run_info.iterations_at_convergence),
+                double(chunks_completed)
+            };
+
+            // the prerun history enters the R-values
+            for (unsigned c = 0 ; c < chains.size() ; ++c)
+            {
+                snapshot->chains.push_back(std::vector<MarkovChain::Checkpoint>{ chains[c].checkpoint(! main_run_started) });
+            }
+
+            for (unsigned c = 0 ; c < ladders.size() ; ++c)
+            {
+                for (auto r = ladders[c].replicas.cbegin() + 1, r_end = ladders[c].replicas.cend() ; r != r_end ; ++r)
+                {
+                    snapshot->chains[c].push_back(r->checkpoint(! main_run_started));
+                }
+
+                std::vector<double> ladder{ double(ladders[c].adaptation_steps) };
+                ladder.insert(ladder.end(), ladders[c].log_spacing.cbegin(), ladders[c].log_spacing.cend());
+                snapshot->ladders.push_back(ladder);
+            }
+
+            if (swap_rng)
+            {
+                snapshot->swap_rng_state.resize((gsl_rng_size(swap_rng) + sizeof(unsigned) - 1) / sizeof(unsigned), 0);
+                std::memcpy(snapshot->swap_rng_state.data(), gsl_rng_state(swap_rng), gsl_rng_size(swap_rng));
+            }
+
+            const std::string checkpoint_file = config.checkpoint_file;
+            const std::string output_file = config.output_file;
+            writer.enqueue([snapshot, checkpoint_file, output_file] ()
+            {
+                // all output enqueued before this checkpoint has been written by now; record how far each data set extends
+                std::vector<std::pair<std::string, unsigned>> output_records;
+                if (! output_file.empty())
+                {
+                    hdf5::File output = hdf5::File::Open(output_file, H5F_ACC_RDONLY);
+                    for (const auto & name : output.data_sets("/"))
+                    {
+                        output_records.push_back(std::make_pair(name, output.records(name)));
+                    }
+                }
+
+                // write to a temporary file first, so that an interruption never leaves an incomplete checkpoint behind
+                const std::string temporary_file = checkpoint_file + ".tmp";
+
+                {
+                    hdf5::File file = hdf5::File::Create(temporary_file);
+
+                    auto data_set_output = file.create_data_set("/output", output_records_type());
+                    for (const auto & r : output_records)
+                    {
+                        auto record = std::make_tuple(r.first.c_str(), r.second);
+                        data_set_output << record;
+                    }
+
+                    const hdf5::Array<1, double> progress_type
+                    {
+                        "progress",
+                        { unsigned(snapshot->progress.size()) },
+                    };
+                    auto data_set_progress = file.create_data_set("/progress", progress_type);
+                    data_set_progress << snapshot->progress;
+
+                    for (unsigned c = 0 ; c < snapshot->chains.size() ; ++c)
+                    {
+                        const std::string chain_base = "/chain #" + stringify(c);
+                        snapshot->chains[c].front().dump(file, chain_base);
+
+                        for (unsigned k = 1 ; k < snapshot->chains[c].size() ; ++k)
+                        {
+                            snapshot->chains[c][k].dump(file, chain_base + "/replica #" + stringify(k));
+                        }
+                    }
+
+                    for (unsigned c = 0 ; c < snapshot->ladders.size() ; ++c)
+                    {
+                        const hdf5::Array<1, double> ladder_type
+                        {
+                            "ladder",
+                            { unsigned(snapshot->ladders[c].size()) },
+                        };
+                        auto data_set_ladder = file.create_data_set("/chain #" + stringify(c) + "/ladder", ladder_type);
+                        data_set_ladder << snapshot->ladders[c];
+                    }
+
+                    if (! snapshot->swap_rng_state.empty())
+                    {
+                        const hdf5::Array<1, unsigned> rng_type
+                        {
+                            "rng",
+                            { unsigned(snapshot->swap_rng_state.size()) },
+                        };
+                        auto data_set_rng = file.create_data_set("/swap rng", rng_type);
+                        data_set_rng << snapshot->swap_rng_state;
+                    }
+                }
+
+                if (0 != std::rename(temporary_file.c_str(), checkpoint_file.c_str()))
+                    throw InternalError("MarkovChainSampler::write_checkpoint: Could not replace checkpoint file '" + checkpoint_file + "'");
+
+                Log::instance()->message("markov_chain_sampler.checkpoint", ll_debug)
+                    << "Wrote checkpoint to '" << checkpoint_file << "'";
+            });
+        }
+
+        // write a checkpoint after every MarkovChainSampler::Config::checkpoint_interval prerun updates or main-run chunks
+        void checkpoint_step()
+        {
+            if (++steps_since_checkpoint < config.checkpoint_interval)
+                return;
+
+            write_checkpoint();
+        }
+
+        /*
+         * Restore the complete state of the sampler from the checkpoint file.
+         */
+        void read_checkpoint()
+        {
+            if (config.checkpoint_file.empty())
+                throw InternalError("MarkovChainSampler::resume: No checkpoint file specified");
+
+            hdf5::File file = hdf5::File::Open(config.checkpoint_file);
+
+            std::vector<double> progress(7);
+            const hdf5::Array<1, double> progress_type
+            {
+                "progress",
+                { unsigned(progress.size()) },
+            };
+            auto data_set_progress = file.open_data_set("/progress", progress_type);
+            data_set_progress >> progress;
+
+            if ((chains.size() != unsigned(progress[0])) || (config.number_of_temperatures != unsigned(progress[1])))
+                throw InternalError("MarkovChainSampler::resume: Checkpoint '" + config.checkpoint_file + "' holds "
+                        + stringify(progress[0]) + " chains with " + stringify(progress[1]) + " temperatures, but "
+                        + stringify(chains.size()) + " chains with " + stringify(config.number_of_temperatures)
+                        + " temperatures are configured");
+
+            main_run_started = (0.0 != progress[2]);
+            pre_run_info.iterations = progress[3];
+            pre_run_info.converged = (0.0 != progress[4]);
+            pre_run_info.iterations_at_convergence = progress[5];
+            chunks_completed = progress[6];
+
+            for (unsigned c = 0 ; c < chains.size() ; ++c)
+            {
+                chains[c].restore(MarkovChain::Checkpoint::read(file, "/chain #" + stringify(c)));
+            }
+
+            for (unsigned c = 0 ; c < ladders.size() ; ++c)
+            {
+                Ladder & l = ladders[c];
+                for (unsigned k = 1 ; k < l.replicas.size() ; ++k)
+                {
+                    l.replicas[k].restore(MarkovChain::Checkpoint::read(file, "/chain #" + stringify(c) + "/replica #" + stringify(k)));
+                }
+
+                std::vector<double> ladder(l.replicas.size());
+                const hdf5::Array<1, double> ladder_type
+                {
+                    "ladder",
+                    { unsigned(ladder.size()) },
+                };
+                auto data_set_ladder = file.open_data_set("/chain #" + stringify(c) + "/ladder", ladder_type);
+                data_set_ladder >> ladder;
+
+                l.adaptation_steps = ladder.front();
+                l.log_spacing.assign(ladder.cbegin() + 1, ladder.cend());
+            }
+
+            if (swap_rng)
+            {
+                std::vector<unsigned> state((gsl_rng_size(swap_rng) + sizeof(unsigned) - 1) / sizeof(unsigned), 0);
+                const hdf5::Array<1, unsigned> rng_type
+                {
+                    "rng",
+                    { unsigned(state.size()) },
+                };
+                auto data_set_rng = file.open_data_set("/swap rng", rng_type);
+                data_set_rng >> state;
+
+                std::memcpy(gsl_rng_state(swap_rng), state.data(), gsl_rng_size(swap_rng));
+            }
+
+            if (! config.output_file.empty())
+            {
+                std::map<std::string, unsigned> output_records;
+                auto data_set_output = file.open_data_set("/output", output_records_type());
+                auto record = std::make_tuple("name", 0u);
+                for (unsigned i = 0 ; i < data_set_output.records() ; ++i)
+                {
+                    data_set_output >> record;
+                    output_records[std::get<0>(record)] = std::get<1>(record);
+                }
+
+                restore_output(output_records);
+            }
+
+            Log::instance()->message("markov_chain_sampler.resume", ll_informational)
+                << "Resuming from checkpoint '" << config.checkpoint_file << "' after " << pre_run_info.iterations
+                << " prerun iterations and " << chunks_completed << " main-run chunks";
+        }
+
+        /*
+         * Reset the output file to its state at the time of the checkpoint, so that resuming does not store any samples twice.
+         *
+         * @param output_records The number of records of each data set in the output file, as recorded in the checkpoint.
+         */
+        void restore_output(const std::map<std::string, unsigned> & output_records)
+        {
+            hdf5::File file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
+
+            for (const auto & name : file.data_sets("/"))
+            {
+                auto r = output_records.find(name);
+                if (output_records.end() == r)
+                {
+                    file.remove(name);
+                    continue;
+                }
+
+                const unsigned records = file.records(name);
+                if (records < r->second)
+                    throw InternalError("MarkovChainSampler::resume: Data set '" + name + "' in output file '" + config.output_file
+                            + "' holds " + stringify(records) + " records, but the checkpoint requires " + stringify(r->second));
+
+                if (records > r->second)
+                    file.truncate(name, r->second);
+            }
+
+            // remove groups that were created after the checkpoint, subgroups first
+            const std::vector<std::string> groups = file.groups("/");
+            for (auto g = groups.crbegin(), g_end = groups.crend() ; g != g_end ; ++g)
+            {
+                if (0 == file.number_of_objects(*g))
+                    file.remove(*g);
+            }
+        }
+
+        // type of the record counts of the output data sets, as stored in a checkpoint
+        static hdf5::Composite<hdf5::Scalar<const char *>, hdf5::Scalar<unsigned>> output_records_type()
+        {
+            return hdf5::Composite<hdf5::Scalar<const char *>, hdf5::Scalar<unsigned>>
+            {
+                "output",
+                hdf5::Scalar<const char *>("name"),
+                hdf5::Scalar<unsigned>("records"),
+            };
         }
 
         // common method to call from multiple constructors
@@ -326,45 +906,45 @@ namespace eos
             {
                 // todo draw initial point from prior
 
-                //todo use factory for proposal_function
-                std::shared_ptr<MarkovChain::ProposalFunction> prop;
-                if (config.proposal == "MultivariateGaussian")
-                {
-                    if (c == 0)
-                    {
-                        Log::instance()->message("markov_chain_sampler.initialize", ll_informational)
-                            << "Using proposal_functions::MultivariateGaussian";
-                    }
-                    prop.reset(new proposal_functions::MultivariateGaussian(number_of_parameters, config.proposal_initial_covariance,
-                                                                            config.scale_automatic));
-                }
-                if (config.proposal == "MultivariateStudentT")
-                {
-                    if (c == 0)
-                    {
-                        Log::instance()->message("markov_chain_sampler.initialize", ll_informational)
-                            << "Using proposal_functions::MultivariateStudentT";
-                    }
-                    prop.reset(new proposal_functions::MultivariateStudentT(number_of_parameters, config.proposal_initial_covariance,
-                                                                            config.student_t_degrees_of_freedom, config.scale_automatic));
-                }
-                // default behavior
-                if (! prop)
+                MarkovChain chain(density, config.seed + c, make_proposal(0 == c));
+                chains.push_back(chain);
+            }
+            gsl_rng_free(rng);
+
+            /* setup temperature ladders */
+
+            if (config.number_of_temperatures > 1)
+            {
+                Log::instance()->message("markov_chain_sampler.initialize", ll_informational)
+                    << "Using parallel tempering with " << config.number_of_temperatures << " temperatures up to "
+                    << config.max_temperature;
+
+                const unsigned number_of_temperatures = config.number_of_temperatures;
+
+                // geometric spacing of the temperatures
+                const double initial_log_spacing = std::log(std::log(double(config.max_temperature)) / (number_of_temperatures - 1));
+
+                for (unsigned c = 0 ; c < config.number_of_chains ; ++c)
                 {
-                    if (c == 0)
+                    Ladder ladder;
+                    ladder.replicas.push_back(chains[c]);
+                    for (unsigned k = 1 ; k < number_of_temperatures ; ++k)
                     {
-                        Log::instance()->message("markov_chain_sampler.initialize", ll_warning)
-                                        << "No proposal function of name '" << config.proposal << "' registered."
-                                        << "Falling back to MultivariateGaussian.";
+                        // avoid the seeds of the cold chains
+                        ladder.replicas.push_back(MarkovChain(density, config.seed + c + k * config.number_of_chains, make_proposal(false)));
                     }
-                    prop.reset(new proposal_functions::MultivariateGaussian(number_of_parameters, config.proposal_initial_covariance,
-                                                                            config.scale_automatic));
+                    ladder.log_spacing.assign(number_of_temperatures - 1, initial_log_spacing);
+                    ladder.swaps_proposed.assign(number_of_temperatures - 1, 0);
+                    ladder.swaps_accepted.assign(number_of_temperatures - 1, 0);
+                    ladder.adaptation_steps = 0;
+                    ladder.update_inverse_temperatures();
+
+                    ladders.push_back(ladder);
                 }
 
-                MarkovChain chain(density, config.seed + c, prop);
-                chains.push_back(chain);
+                swap_rng = gsl_rng_alloc(gsl_rng_mt19937);
+                gsl_rng_set(swap_rng, config.seed + number_of_temperatures * config.number_of_chains);
             }
-            gsl_rng_free(rng);
 
             // setup prerun info
             pre_run_info =
@@ -376,6 +956,47 @@ namespace eos
             };
         }
 
+        // create the proposal function for one chain
+        std::shared_ptr<MarkovChain::ProposalFunction> make_proposal(const bool & verbose)
+        {
+            //todo use factory for proposal_function
+            std::shared_ptr<MarkovChain::ProposalFunction> prop;
+            if (config.proposal == "MultivariateGaussian")
+            {
+                if (verbose)
+                {
+                    Log::instance()->message("markov_chain_sampler.initialize", ll_informational)
+                        << "Using proposal_functions::MultivariateGaussian";
+                }
+                prop.reset(new proposal_functions::MultivariateGaussian(number_of_parameters, config.proposal_initial_covariance,
+                                                                        config.scale_automatic));
+            }
+            if (config.proposal == "MultivariateStudentT")
+            {
+                if (verbose)
+                {
+                    Log::instance()->message("markov_chain_sampler.initialize", ll_informational)
+                        << "Using proposal_functions::MultivariateStudentT";
+                }
+                prop.reset(new proposal_functions::MultivariateStudentT(number_of_parameters, config.proposal_initial_covariance,
+                                                                        config.student_t_degrees_of_freedom, config.scale_automatic));
+            }
+            // default behavior
+            if (! prop)
+            {
+                if (verbose)
+                {
+                    Log::instance()->message("markov_chain_sampler.initialize", ll_warning)
+                                    << "No proposal function of name '" << config.proposal << "' registered."
+                                    << "Falling back to MultivariateGaussian.";
+                }
+                prop.reset(new proposal_functions::MultivariateGaussian(number_of_parameters, config.proposal_initial_covariance,
+                                                                        config.scale_automatic));
+            }
+
+            return prop;
+        }
+
         /*
          * Collect samples from posterior and check for convergence.
          */
@@ -386,19 +1007,6 @@ namespace eos
                 << config.prerun_iterations_max << ", " << config.prerun_iterations_update
                 << " (min, max, update) iterations.";
 
-            // write parameter descriptions
-            {
-                auto file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
-                for (unsigned i = 0; i < chains.size(); ++i)
-                {
-                    density->dump_descriptions(file, "/descriptions/prerun/chain #" + stringify(i));
-                }
-            }
-
-            // require:chains are initialized
-            pre_run_info.converged = false;
-            pre_run_info.iterations = 0;
-
             // set up chains
             for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c)
             {
@@ -406,50 +1014,38 @@ namespace eos
                 c->keep_history(true);
             }
 
+            // the hot replicas need their history for the adaptation of their proposals
+            for (auto & l : ladders)
+            {
+                for (auto & r : l.replicas)
+                {
+                    r.keep_history(true);
+                }
+            }
+
             // keep going till maxIter or  break when convergence estimated
 
-            unsigned number_of_updates = 0;
             while (pre_run_info.iterations < config.prerun_iterations_min || (!pre_run_info.converged && pre_run_info.iterations
                             < config.prerun_iterations_max))
             {
-                // start with empty ticket queue
-                tickets.clear();
-
-                // loop over chains
                 // run each chain for N iterations
-                for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c)
-                {
-                    if (config.parallelize)
-                    {
-                        tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&MarkovChain::run, *c, config.prerun_iterations_update)));
-                    }
-                    else
-                    {
-                        c->run(config.prerun_iterations_update);
-                    }
-                }
-
-                // wait for job completion
-                for (auto t = tickets.begin(), t_end = tickets.end(); t != t_end; ++t)
-                {
-                    t->wait();
-                }
-
-                // all tickets finished
-                tickets.clear();
+                run_chains(config.prerun_iterations_update, true);
 
                 pre_run_info.iterations += config.prerun_iterations_update;
-                number_of_updates++;
 
                 // store state before adjusting proposal!
                 if (config.store_prerun)
                     dump_hdf5("/prerun", config.prerun_iterations_update);
 
+                report_swaps("/prerun", config.store_prerun);
+
                 // check efficiency in last chunk and overall R-value: typically changes proposal
                 pre_run_info.converged = check_convergence(config.prerun_iterations_update);
 
                 Log::instance()->message("markov_chain_sampler.prerun_progress", ll_informational)
                     << "Pre-run has completed " << pre_run_info.iterations << " iterations";
+
+                checkpoint_step();
             }
 
             if (pre_run_info.converged)
@@ -483,43 +1079,24 @@ namespace eos
             Log::instance()->message("markov_chain_sampler.mainrun_start", ll_informational)
                 << "Commencing the main-run";
 
-            for (unsigned chunk = 0 ; chunk < config.chunks ; ++chunk)
+            for ( ; chunks_completed < config.chunks ; )
             {
 
-                // start with empty ticket queue
-                tickets.clear();
-
-                // loop over chains
                 // run each chain for N iterations
-                for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c)
-                {
-                    if (config.parallelize)
-                    {
-                        tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&MarkovChain::run, *c, config.chunk_size)));
-                    }
-                    else
-                    {
-                        c->run(config.chunk_size);
-                    }
-                }
+                run_chains(config.chunk_size, false);
 
-                // wait for job completion
-                for (auto t = tickets.begin(), t_end = tickets.end(); t != t_end; ++t)
-                {
-                    t->wait();
-                }
-
-                // all tickets finished
-                tickets.clear();
+                ++chunks_completed;
 
                 Log::instance()->message("markov_chain_sampler.mainrun_progress", ll_informational)
-                    << "Main-run has completed " << (chunk + 1) * config.chunk_size << " iterations";
+                    << "Main-run has completed " << chunks_completed * config.chunk_size << " iterations";
 
                 if (config.store)
                 {
                     dump_hdf5("/main run", config.chunk_size);
                 }
 
+                report_swaps("/main run", config.store);
+
                 check_rvalues_main();
 
                 for (auto c = chains.begin(), c_end = chains.end() ; c != c_end ; ++c)
@@ -538,6 +1115,7 @@ namespace eos
                     c->clear();
                 }
 
+                checkpoint_step();
             }
             Log::instance()->message("markov_chain_sampler.mainrun_end", ll_informational)
                 << "Finished the main-run";
@@ -548,8 +1126,18 @@ namespace eos
             // overwrite file only if sampling is requested
             setup_output();
 
+            main_run_started = false;
+            chunks_completed = 0;
+            steps_since_checkpoint = 0;
+
             if (config.need_prerun)
             {
+                // require:chains are initialized
+                pre_run_info.converged = false;
+                pre_run_info.iterations = 0;
+
+                dump_descriptions("prerun");
+
                 pre_run();
             }
 
@@ -558,8 +1146,48 @@ namespace eos
                 // set up chains
                 setup_main_run();
 
+                dump_descriptions("main run");
+
                 main_run();
             }
+
+            finish();
+        }
+
+        void resume()
+        {
+            read_checkpoint();
+
+            steps_since_checkpoint = 0;
+
+            if (config.need_prerun && ! main_run_started)
+            {
+                pre_run();
+            }
+
+            if (config.need_main_run)
+            {
+                const bool resuming_main_run = main_run_started;
+
+                setup_main_run();
+
+                // otherwise, the descriptions have been written before the checkpoint
+                if (! resuming_main_run)
+                    dump_descriptions("main run");
+
+                main_run();
+            }
+
+            finish();
+        }
+
+        // make sure that all output has been written
+        void finish()
+        {
+            if (steps_since_checkpoint > 0)
+                write_checkpoint();
+
+            writer.flush();
         }
 
         /*
@@ -576,14 +1204,17 @@ namespace eos
                 c->keep_history(config.store);
             }
 
-            // write parameter descriptions
+            // only the cold replicas are stored
+            for (auto & l : ladders)
             {
-                auto file = hdf5::File::Open(config.output_file, H5F_ACC_RDWR);
-                for (unsigned i = 0; i < chains.size(); ++i)
+                for (auto r = l.replicas.begin() + 1, r_end = l.replicas.end() ; r != r_end ; ++r)
                 {
-                    density->dump_descriptions(file, "/descriptions/main run/chain #" + stringify(i));
+                    r->clear();
+                    r->keep_history(false);
                 }
             }
+
+            main_run_started = true;
         }
 
         void setup_output()
@@ -609,7 +1240,7 @@ namespace eos
     }
 
     std::vector<HistoryPtr>
-    MarkovChainSampler::read_chains(const std::vector<std::shared_ptr<hdf5::File>> & input_files)
+    MarkovChainSampler::read_chains(const std::vector<std::shared_ptr<hdf5::File>> & input_files, const std::string & base)
     {
         std::vector<HistoryPtr> result;
 
@@ -622,7 +1253,7 @@ namespace eos
             unsigned c = 0;
             while (true)
             {
-                group_name = "/prerun/chain #" + stringify(c);
+                group_name = base + "/chain #" + stringify(c);
                 if (! (*f)->group_exists(group_name))
                     break;
 
@@ -662,6 +1293,12 @@ namespace eos
         _imp->run();
     }
 
+    void
+    MarkovChainSampler::resume()
+    {
+        _imp->resume();
+    }
+
     const MarkovChainSampler::Config &
     MarkovChainSampler::config()
     {
@@ -693,7 +1330,12 @@ namespace eos
         chunk_size(1000),
         need_main_run(true),
         skip_initial(0, 1, 0.1),
-        store(true)
+        store(true),
+        number_of_temperatures(1, std::numeric_limits<unsigned>::max(), 1),
+        max_temperature(1, std::numeric_limits<double>::max(), 10),
+        swap_interval(1, std::numeric_limits<unsigned>::max(), 100),
+        target_swap_rate(0, 1, 0.23),
+        checkpoint_interval(1, std::numeric_limits<unsigned>::max(), 1)
     {
     }
 
@@ -731,7 +1373,12 @@ namespace eos
                << ", prerun min iterations = " << c.prerun_iterations_min << std::endl
                << ", prerun max iterations = " << c.prerun_iterations_max
                << ", prerun update iterations = " << c.prerun_iterations_update
-               << ", skip initial = " << c.skip_initial;
+               << ", skip initial = " << c.skip_initial << std::endl
+               << "Parallel tempering settings:" << std::endl
+               << "ntemperatures = " << c.number_of_temperatures
+               << ", max temperature = " << c.max_temperature
+               << ", swap interval = " << c.swap_interval
+               << ", target swap rate = " << c.target_swap_rate;
         return stream;
     }
 }
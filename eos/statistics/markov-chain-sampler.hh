@@ -51,8 +51,12 @@ namespace eos
 
             /*!
              * Read the history of Markov chains stored in the input files.
+             *
+             * @param input_files The files from which the chains are read.
+             * @param base        The group in which the chains are stored, either "/prerun" or "/main run".
              */
-            static std::vector<HistoryPtr> read_chains(const std::vector<std::shared_ptr<hdf5::File>> & input_files);
+            static std::vector<HistoryPtr> read_chains(const std::vector<std::shared_ptr<hdf5::File>> & input_files,
+                    const std::string & base = "/prerun");
             ///@}
 
             ///@name Sampling
@@ -64,6 +68,16 @@ namespace eos
             /// Start the Markov chain sampling.
             void run();
 
+            /*!
+             * Continue the Markov chain sampling from the last checkpoint written to
+             * MarkovChainSampler::Config::checkpoint_file, e.g. after the program was interrupted.
+             * The sampler must be configured as the interrupted one, and the samples are
+             * appended to the existing output file.
+             *
+             * @note Samples that were stored after the last checkpoint are stored a second time.
+             */
+            void resume();
+
             /// Retrieve the configuration from which this sampler was constructed.
             const MarkovChainSampler::Config & config();
             ///@}
@@ -198,12 +212,43 @@ namespace eos
             bool store;
             ///@}
 
+            ///@name Parallel tempering options
+            ///@{
+            /*!
+             * Number of replicas per chain, each sampling from the density raised to the power of
+             * its inverse temperature. Neighbouring replicas periodically propose to swap their states,
+             * so that the cold replica (at temperature one) can cross between well separated modes.
+             * Only the cold replicas are stored. A value of one turns parallel tempering off.
+             */
+            VerifiedRange<unsigned> number_of_temperatures;
+
+            /// Temperature of the hottest replica in the initial, geometrically spaced ladder.
+            VerifiedRange<double> max_temperature;
+
+            /// Number of iterations between two rounds of swap proposals.
+            VerifiedRange<unsigned> swap_interval;
+
+            /// During the prerun, the temperatures are adapted such that the swap acceptance rate between neighbouring replicas approaches this value.
+            VerifiedRange<double> target_swap_rate;
+            ///@}
+
             ///@name Output options
             ///@{
             /*!
              * The HDF5 output file to store the markov chains.
              */
             std::string output_file;
+
+            /*!
+             * The HDF5 file to which the complete state of the sampler is written periodically,
+             * such that the sampling can be continued with resume(). The file is replaced
+             * atomically, so that it always holds a complete checkpoint. If empty, no checkpoints
+             * are written.
+             */
+            std::string checkpoint_file;
+
+            /// Number of prerun updates or main-run chunks between two checkpoints.
+            VerifiedRange<unsigned> checkpoint_interval;
             ///@}
     };
 
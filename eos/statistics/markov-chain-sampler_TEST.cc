@@ -27,6 +27,8 @@
 #include <eos/utils/hdf5.hh>
 #include <eos/utils/power_of.hh>
 
+#include <fstream>
+
 using namespace test;
 using namespace eos;
 
@@ -48,6 +50,21 @@ void bin_data_set(hdf5::DataSet<T_ > & data_set, Histogram<1> & hist, const unsi
     }
 }
 
+// two well separated normal distributions at x = -3 and x = +3 with equal weights
+double bimodal(const std::vector<double> & x)
+{
+    const double sigma = 0.3;
+
+    return std::log(0.5 * std::exp(-0.5 * power_of<2>((x[0] + 3.0) / sigma)) + 0.5 * std::exp(-0.5 * power_of<2>((x[0] - 3.0) / sigma)));
+}
+
+void copy_file(const std::string & source, const std::string & destination)
+{
+    std::ifstream in(source, std::ios::binary);
+    std::ofstream out(destination, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+}
+
 class MarkovChainSamplerTest :
     public TestCase
 {
@@ -250,5 +267,218 @@ class MarkovChainSamplerTest :
                     }
                 }
             }
+
+            // parallel tempering lets the cold chain cross between both modes
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_tempering.hdf5");
+
+                DensityWrapper density(&bimodal);
+                density.add_parameter("x", -5.0, +5.0);
+
+                MarkovChainSampler::Config config = MarkovChainSampler::Config::Default();
+                config.chunk_size = 1000;
+                config.chunks = 10;
+                config.number_of_chains = 1;
+                config.number_of_temperatures = 5;
+                config.max_temperature = 100.0;
+                config.swap_interval = 20;
+                config.output_file = file_name;
+                config.parallelize = true;
+                config.prerun_iterations_update = 500;
+                config.prerun_iterations_min = 2000;
+                config.prerun_iterations_max = 10000;
+                config.seed = 1729;
+                MarkovChainSampler sampler(density.clone(), config);
+                sampler.run();
+
+                auto f = hdf5::File::Open(file_name);
+
+                // only the cold replica is stored
+                hdf5::Array<1, double> sample_type
+                {
+                    "samples",
+                    { 1 + 1 },
+                };
+                auto data_set = f.open_data_set("/main run/chain #0/samples", sample_type);
+                TEST_CHECK_EQUAL(data_set.records(), 10000);
+
+                unsigned positive = 0;
+                std::vector<double> record(2);
+                for (unsigned i = 0 ; i < data_set.records() ; ++i)
+                {
+                    data_set >> record;
+                    if (record[0] > 0.0)
+                        ++positive;
+                }
+                TEST_CHECK(positive > 1000);
+                TEST_CHECK(positive < 9000);
+
+                // one record per replica and chunk
+                hdf5::Array<1, double> tempering_type
+                {
+                    "tempering",
+                    { 3 },
+                };
+                auto data_set_tempering = f.open_data_set("/main run/chain #0/tempering", tempering_type);
+                TEST_CHECK_EQUAL(data_set_tempering.records(), 10 * 5);
+
+                std::vector<double> tempering_record(3);
+                double beta = 2.0;
+                for (unsigned k = 0 ; k < 5 ; ++k)
+                {
+                    data_set_tempering >> tempering_record;
+                    TEST_CHECK(tempering_record[0] < beta);
+                    beta = tempering_record[0];
+
+                    // 1000 iterations, swapped every 20 iterations
+                    TEST_CHECK_EQUAL(tempering_record[1], (k < 4) ? 50.0 : 0.0);
+                    TEST_CHECK(tempering_record[2] <= tempering_record[1]);
+                }
+            }
+
+            // a resumed run continues exactly where the interrupted run stopped
+            {
+                static const std::string file_name_full(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_full.hdf5");
+                static const std::string file_name_resumed(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_resumed.hdf5");
+                static const std::string file_name_checkpoint(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_checkpoint.hdf5");
+                std::remove(file_name_checkpoint.c_str());
+
+                DensityWrapper density(&bimodal);
+                density.add_parameter("x", -5.0, +5.0);
+
+                MarkovChainSampler::Config config = MarkovChainSampler::Config::Default();
+                config.chunk_size = 500;
+                config.chunks = 6;
+                config.number_of_chains = 2;
+                config.number_of_temperatures = 2;
+                config.swap_interval = 50;
+                config.parallelize = true;
+                config.prerun_iterations_update = 500;
+                config.prerun_iterations_min = 1000;
+                config.prerun_iterations_max = 2000;
+                config.seed = 4711;
+
+                // uninterrupted run
+                {
+                    config.output_file = file_name_full;
+                    MarkovChainSampler sampler(density.clone(), config);
+                    sampler.run();
+                }
+
+                // run that stops after half the chunks, and is resumed from its checkpoint
+                {
+                    config.output_file = file_name_resumed;
+                    config.checkpoint_file = file_name_checkpoint;
+                    config.chunks = 3;
+                    MarkovChainSampler sampler(density.clone(), config);
+                    sampler.run();
+                }
+                TEST_CHECK(hdf5::File::Exists(file_name_checkpoint));
+                TEST_CHECK(! hdf5::File::Exists(file_name_checkpoint + ".tmp"));
+
+                {
+                    config.chunks = 6;
+                    MarkovChainSampler sampler(density.clone(), config);
+                    sampler.resume();
+                }
+
+                auto f_full = hdf5::File::Open(file_name_full);
+                auto f_resumed = hdf5::File::Open(file_name_resumed);
+
+                hdf5::Array<1, double> sample_type
+                {
+                    "samples",
+                    { 1 + 1 },
+                };
+                for (unsigned c = 0 ; c < 2 ; ++c)
+                {
+                    auto data_set_full = f_full.open_data_set("/main run/chain #" + stringify(c) + "/samples", sample_type);
+                    auto data_set_resumed = f_resumed.open_data_set("/main run/chain #" + stringify(c) + "/samples", sample_type);
+                    TEST_CHECK_EQUAL(data_set_full.records(), 6 * 500);
+                    TEST_CHECK_EQUAL(data_set_resumed.records(), 6 * 500);
+
+                    std::vector<double> record_full(2), record_resumed(2);
+                    for (unsigned i = 0 ; i < data_set_full.records() ; ++i)
+                    {
+                        data_set_full >> record_full;
+                        data_set_resumed >> record_resumed;
+                        TEST_CHECK_EQUAL(record_full[0], record_resumed[0]);
+                        TEST_CHECK_EQUAL(record_full[1], record_resumed[1]);
+                    }
+                }
+
+                // the descriptions are written only once
+                TEST_CHECK(f_resumed.group_exists("/descriptions/main run/chain #1"));
+
+                // a run interrupted between two checkpoints discards the samples stored after the last checkpoint
+                {
+                    static const std::string file_name_interrupted(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_interrupted.hdf5");
+                    static const std::string file_name_saved(EOS_BUILDDIR "/eos/statistics/markov-chain-sampler_TEST_checkpoint_saved.hdf5");
+                    std::remove(file_name_checkpoint.c_str());
+
+                    config.output_file = file_name_interrupted;
+                    config.checkpoint_interval = 2;
+
+                    // the checkpoint after two chunks is the last one before the interruption
+                    {
+                        config.chunks = 2;
+                        MarkovChainSampler sampler(density.clone(), config);
+                        sampler.run();
+                    }
+                    copy_file(file_name_checkpoint, file_name_saved);
+
+                    // the third chunk reaches the output file, but the next checkpoint is never written
+                    {
+                        config.chunks = 3;
+                        MarkovChainSampler sampler(density.clone(), config);
+                        sampler.resume();
+                    }
+                    copy_file(file_name_saved, file_name_checkpoint);
+
+                    {
+                        auto f_interrupted = hdf5::File::Open(file_name_interrupted);
+                        TEST_CHECK_EQUAL(f_interrupted.records("/main run/chain #0/samples"), 3 * 500);
+                    }
+
+                    {
+                        config.chunks = 6;
+                        MarkovChainSampler sampler(density.clone(), config);
+                        sampler.resume();
+                    }
+
+                    auto f_interrupted = hdf5::File::Open(file_name_interrupted);
+                    for (unsigned c = 0 ; c < 2 ; ++c)
+                    {
+                        auto data_set_full = f_full.open_data_set("/main run/chain #" + stringify(c) + "/samples", sample_type);
+                        auto data_set_interrupted = f_interrupted.open_data_set("/main run/chain #" + stringify(c) + "/samples", sample_type);
+                        TEST_CHECK_EQUAL(data_set_interrupted.records(), 6 * 500);
+
+                        std::vector<double> record_full(2), record_interrupted(2);
+                        for (unsigned i = 0 ; i < data_set_full.records() ; ++i)
+                        {
+                            data_set_full >> record_full;
+                            data_set_interrupted >> record_interrupted;
+                            TEST_CHECK_EQUAL(record_full[0], record_interrupted[0]);
+                            TEST_CHECK_EQUAL(record_full[1], record_interrupted[1]);
+                        }
+                    }
+
+                    // every data set of the uninterrupted run is recreated with the same number of records
+                    TEST_CHECK(f_full.data_sets("/") == f_interrupted.data_sets("/"));
+                    for (const auto & name : f_full.data_sets("/"))
+                    {
+                        TEST_CHECK_EQUAL(f_full.records(name), f_interrupted.records(name));
+                    }
+
+                    std::remove(file_name_saved.c_str());
+                }
+
+                // resuming requires the configuration of the interrupted run
+                {
+                    config.number_of_chains = 3;
+                    MarkovChainSampler sampler(density.clone(), config);
+                    TEST_CHECK_THROWS(InternalError, sampler.resume());
+                }
+            }
         }
 } markov_chain_sampler_test;
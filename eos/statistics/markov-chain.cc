@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <cstring>
 #include <map>
 #include <numeric>
 
@@ -74,6 +75,9 @@ namespace eos
         // overall statistics
         MarkovChain::Stats stats;
 
+        // the chain samples from density^inverse_temperature
+        double inverse_temperature;
+
         // sample variance of param values (Welford's method)
         std::vector<double> welford_data_parameters;
 
@@ -86,6 +90,7 @@ namespace eos
 
         Implementation(const DensityPtr & density, unsigned long seed, const std::shared_ptr<MarkovChain::ProposalFunction> & proposal_function) :
             density(density->clone()),
+            inverse_temperature(1.0),
             sample_type
             {
                 "samples",
@@ -118,21 +123,32 @@ namespace eos
 
         void dump_history(hdf5::File & file, const std::string & data_set_base_name, const unsigned & last_iterations) const
         {
-
-            /* store samples */
-
             if (history.states.size() < last_iterations)
                 throw InternalError("MarkovChain::dump_history: Cannot store more samples (" + stringify(last_iterations)
                     + ") than there are in history (" + stringify(history.states.size()) + ").");
 
-            unsigned sample_record_length = parameter_descriptions.size() + 1;
+            dump_states(file, data_set_base_name, history.states.cend() - last_iterations, history.states.cend(), stats);
+        }
+
+        static void dump_states(hdf5::File & file, const std::string & data_set_base_name,
+                                const MarkovChain::State::Iterator & begin, const MarkovChain::State::Iterator & end,
+                                const MarkovChain::Stats & stats)
+        {
+            const unsigned sample_record_length = stats.parameters_at_mode.size() + 1;
+            const SampleType sample_type
+            {
+                "samples",
+                { sample_record_length },
+            };
+
+            /* store samples */
 
             // we could get into trouble if we attempt to create a data set a 2nd time
             auto data_set = file.create_or_open_data_set(data_set_base_name + "/samples", sample_type);
 
             // parameter values + density
             std::vector<double> record(sample_record_length);
-            for (auto s = history.states.cend() - last_iterations, s_end = history.states.cend() ; s != s_end ; ++s)
+            for (auto s = begin ; s != end ; ++s)
             {
                 std::copy(s->point.cbegin(), s->point.cend(), record.begin());
                 record.back() = s->log_density;
@@ -153,6 +169,55 @@ namespace eos
             proposal_function->dump_state(file, data_set_base_name + "/proposal");
         }
 
+        MarkovChain::Checkpoint checkpoint(bool with_history) const
+        {
+            MarkovChain::Checkpoint result;
+            result.current = current;
+            result.stats = stats;
+            result.welford_data_parameters = welford_data_parameters;
+            result.welford_data_density = welford_data_density;
+            result.inverse_temperature = inverse_temperature;
+            result.proposal = proposal_function->clone();
+
+            // copy the raw state of the RNG
+            result.rng_state.resize((gsl_rng_size(rng) + sizeof(unsigned) - 1) / sizeof(unsigned), 0);
+            std::memcpy(result.rng_state.data(), gsl_rng_state(rng), gsl_rng_size(rng));
+
+            if (with_history)
+                result.history = history.states;
+
+            return result;
+        }
+
+        void restore(const MarkovChain::Checkpoint & checkpoint)
+        {
+            if (parameter_descriptions.size() != checkpoint.current.point.size())
+                throw InternalError("MarkovChain::restore: Dimension of the parameter space of the analysis "
+                                    "doesn't match the dimension of the checkpoint.");
+
+            if (checkpoint.rng_state.size() * sizeof(unsigned) < gsl_rng_size(rng))
+                throw InternalError("MarkovChain::restore: State of the random number generator is incomplete");
+
+            if (! checkpoint.proposal)
+                throw InternalError("MarkovChain::restore: Checkpoint lacks a proposal function");
+
+            std::memcpy(gsl_rng_state(rng), checkpoint.rng_state.data(), gsl_rng_size(rng));
+
+            proposal_function = checkpoint.proposal->clone();
+            stats = checkpoint.stats;
+            welford_data_parameters = checkpoint.welford_data_parameters;
+            welford_data_density = checkpoint.welford_data_density;
+            inverse_temperature = checkpoint.inverse_temperature;
+            history.states = checkpoint.history;
+
+            current = checkpoint.current;
+            proposal = checkpoint.current;
+            revert();
+
+            Log::instance()->message("markov_chain.restore", ll_debug)
+                << "Continuing chain at: " << current;
+        }
+
         // calculate density etc at the proposal point
         void evaluate_proposal()
         {
@@ -259,7 +324,7 @@ namespace eos
 
             // compute the Metropolis-Hastings factor
             double log_u = std::log(uniform_random_number());
-            double log_r_post = proposal.log_density - current.log_density;
+            double log_r_post = inverse_temperature * (proposal.log_density - current.log_density);
             double log_r_prop = proposal_function->evaluate(current, proposal) - proposal_function->evaluate(proposal, current);
             double log_r = log_r_post + log_r_prop;
 
@@ -391,6 +456,24 @@ namespace eos
 
             reset();
 
+            iterate(iterations);
+
+            run_iterations = iterations;
+        }
+
+        // continue the previous run without resetting the counters
+        void resume(unsigned iterations)
+        {
+            Log::instance()->message("markov_chain.resume", ll_debug)
+                << "Resuming for " << iterations << " iterations";
+
+            iterate(iterations);
+
+            run_iterations += iterations;
+        }
+
+        void iterate(unsigned iterations)
+        {
             // make sure everything is fine __before__ we start
             self_check();
 
@@ -418,7 +501,6 @@ namespace eos
 
             // we are done. store how many iterations we had in total
             stats.iterations_total += iterations;
-            run_iterations = iterations;
         }
 
         // check consistency of configuration, throw exception
@@ -493,6 +575,23 @@ namespace eos
                 << current;
         }
 
+        void set_state(const MarkovChain::State & state)
+        {
+            if (parameter_descriptions.size() != state.point.size())
+                throw InternalError("markov_chain::set_state: Dimension of the parameter space of the analysis "
+                                    "doesn't match the dimension of the state given.");
+
+            current = state;
+            proposal = state;
+            revert();
+
+            if (current.log_density > stats.mode)
+            {
+                stats.mode = current.log_density;
+                stats.parameters_at_mode = current.point;
+            }
+        }
+
         // save points, update statistics
         void update()
         {
@@ -574,6 +673,12 @@ namespace eos
     {
     }
 
+    MarkovChain::Checkpoint
+    MarkovChain::checkpoint(bool with_history) const
+    {
+        return _imp->checkpoint(with_history);
+    }
+
     void
     MarkovChain::clear()
     {
@@ -592,12 +697,25 @@ namespace eos
         _imp->dump_proposal(file, data_set);
     }
 
+    void
+    MarkovChain::dump_states(hdf5::File & file, const std::string & data_set_base_name,
+                             const std::vector<MarkovChain::State> & states, const MarkovChain::Stats & stats)
+    {
+        Implementation<MarkovChain>::dump_states(file, data_set_base_name, states.cbegin(), states.cend(), stats);
+    }
+
     void
     MarkovChain::set_point(const std::vector<double> & point)
     {
         _imp->set_point(point);
     }
 
+    void
+    MarkovChain::set_state(const MarkovChain::State & state)
+    {
+        _imp->set_state(state);
+    }
+
     const MarkovChain::State &
     MarkovChain::current_state() const
     {
@@ -616,6 +734,21 @@ namespace eos
         return _imp->run_iterations;
     }
 
+    const double &
+    MarkovChain::inverse_temperature() const
+    {
+        return _imp->inverse_temperature;
+    }
+
+    void
+    MarkovChain::inverse_temperature(const double & beta)
+    {
+        if ((beta <= 0.0) || (beta > 1.0))
+            throw InternalError("MarkovChain::inverse_temperature: inverse temperature " + stringify(beta) + " not in (0, 1]");
+
+        _imp->inverse_temperature = beta;
+    }
+
     void
     MarkovChain::keep_history(bool keep)
     {
@@ -669,12 +802,24 @@ namespace eos
         _imp->reset(hard);
     }
 
+    void
+    MarkovChain::restore(const MarkovChain::Checkpoint & checkpoint)
+    {
+        _imp->restore(checkpoint);
+    }
+
     void
     MarkovChain::run(const unsigned & iterations)
     {
         _imp->run(iterations);
     }
 
+    void
+    MarkovChain::resume(const unsigned & iterations)
+    {
+        _imp->resume(iterations);
+    }
+
     void
     MarkovChain::set_mode(hdf5::File & file, const std::string & data_base_name,
                           const std::vector<double> & point, const double & density)
@@ -789,6 +934,156 @@ namespace eos
         }
     }
 
+    void
+    MarkovChain::Checkpoint::dump(hdf5::File & file, const std::string & data_set_base_name) const
+    {
+        const unsigned dimension = current.point.size();
+
+        const hdf5::Array<1, double> state_type
+        {
+            "state",
+            { dimension + 1 },
+        };
+        const hdf5::Array<1, double> moments_type
+        {
+            "moments",
+            { dimension },
+        };
+        // iterations (total, accepted, rejected, invalid), moments of the log(density), Welford's data for
+        // the log(density), inverse temperature
+        const hdf5::Array<1, double> scalars_type
+        {
+            "scalars",
+            { 8 },
+        };
+        const hdf5::Array<1, unsigned> rng_type
+        {
+            "rng",
+            { unsigned(rng_state.size()) },
+        };
+
+        std::vector<double> record(dimension + 1);
+
+        // current state, then the mode
+        auto data_set_state = file.create_data_set(data_set_base_name + "/state", state_type);
+        std::copy(current.point.cbegin(), current.point.cend(), record.begin());
+        record.back() = current.log_density;
+        data_set_state << record;
+        std::copy(stats.parameters_at_mode.cbegin(), stats.parameters_at_mode.cend(), record.begin());
+        record.back() = stats.mode;
+        data_set_state << record;
+
+        auto data_set_moments = file.create_data_set(data_set_base_name + "/moments", moments_type);
+        data_set_moments << stats.mean_of_parameters << stats.variance_of_parameters << welford_data_parameters;
+
+        auto data_set_scalars = file.create_data_set(data_set_base_name + "/scalars", scalars_type);
+        data_set_scalars << std::vector<double>
+        {
+            double(stats.iterations_total), double(stats.iterations_accepted),
+            double(stats.iterations_rejected), double(stats.iterations_invalid),
+            stats.mean_of_log_density, stats.variance_of_log_density, welford_data_density,
+            inverse_temperature
+        };
+
+        auto data_set_rng = file.create_data_set(data_set_base_name + "/rng", rng_type);
+        data_set_rng << rng_state;
+
+        auto data_set_history = file.create_data_set(data_set_base_name + "/history", state_type);
+        for (auto s = history.cbegin(), s_end = history.cend() ; s != s_end ; ++s)
+        {
+            std::copy(s->point.cbegin(), s->point.cend(), record.begin());
+            record.back() = s->log_density;
+            data_set_history << record;
+        }
+
+        proposal->dump_state(file, data_set_base_name + "/proposal");
+    }
+
+    MarkovChain::Checkpoint
+    MarkovChain::Checkpoint::read(hdf5::File & file, const std::string & data_set_base_name)
+    {
+        MarkovChain::Checkpoint result;
+
+        // extract meta information from the proposal
+        auto meta_record = proposal_functions::meta_record();
+        auto meta_data_set = file.open_data_set(data_set_base_name + "/proposal/meta", proposal_functions::meta_type());
+        meta_data_set >> meta_record;
+        const std::string proposal_type = std::get<0>(meta_record);
+        const unsigned dimension = std::get<1>(meta_record);
+
+        result.proposal = proposal_functions::Factory::make(file, data_set_base_name + "/proposal", proposal_type, dimension);
+
+        const hdf5::Array<1, double> state_type
+        {
+            "state",
+            { dimension + 1 },
+        };
+        const hdf5::Array<1, double> moments_type
+        {
+            "moments",
+            { dimension },
+        };
+        const hdf5::Array<1, double> scalars_type
+        {
+            "scalars",
+            { 8 },
+        };
+
+        std::vector<double> record(dimension + 1);
+
+        auto data_set_state = file.open_data_set(data_set_base_name + "/state", state_type);
+        data_set_state >> record;
+        result.current.point.assign(record.cbegin(), record.cend() - 1);
+        result.current.log_density = record.back();
+        data_set_state >> record;
+        result.stats.parameters_at_mode.assign(record.cbegin(), record.cend() - 1);
+        result.stats.mode = record.back();
+
+        result.stats.mean_of_parameters.resize(dimension);
+        result.stats.variance_of_parameters.resize(dimension);
+        result.welford_data_parameters.resize(dimension);
+        auto data_set_moments = file.open_data_set(data_set_base_name + "/moments", moments_type);
+        data_set_moments >> result.stats.mean_of_parameters >> result.stats.variance_of_parameters >> result.welford_data_parameters;
+
+        std::vector<double> scalars(8);
+        auto data_set_scalars = file.open_data_set(data_set_base_name + "/scalars", scalars_type);
+        data_set_scalars >> scalars;
+        result.stats.iterations_total = scalars[0];
+        result.stats.iterations_accepted = scalars[1];
+        result.stats.iterations_rejected = scalars[2];
+        result.stats.iterations_invalid = scalars[3];
+        result.stats.mean_of_log_density = scalars[4];
+        result.stats.variance_of_log_density = scalars[5];
+        result.welford_data_density = scalars[6];
+        result.inverse_temperature = scalars[7];
+
+        // all chains use the Mersenne-Twister RNG
+        gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
+        result.rng_state.resize((gsl_rng_size(rng) + sizeof(unsigned) - 1) / sizeof(unsigned), 0);
+        gsl_rng_free(rng);
+
+        const hdf5::Array<1, unsigned> rng_type
+        {
+            "rng",
+            { unsigned(result.rng_state.size()) },
+        };
+        auto data_set_rng = file.open_data_set(data_set_base_name + "/rng", rng_type);
+        data_set_rng >> result.rng_state;
+
+        auto data_set_history = file.open_data_set(data_set_base_name + "/history", state_type);
+        MarkovChain::State state;
+        for (unsigned i = 0 ; i < data_set_history.records() ; ++i)
+        {
+            data_set_history >> record;
+
+            state.point.assign(record.cbegin(), record.cend() - 1);
+            state.log_density = record.back();
+            result.history.push_back(state);
+        }
+
+        return result;
+    }
+
     std::ostream &
     operator<< (std::ostream & lhs, const MarkovChain::State & rhs)
     {
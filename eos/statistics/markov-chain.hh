@@ -38,6 +38,7 @@ namespace eos
         public PrivateImplementationPattern<MarkovChain>
     {
         public:
+            struct Checkpoint;
             struct History;
             struct ProposalFunction;
             struct State;
@@ -58,6 +59,14 @@ namespace eos
             ~MarkovChain();
             ///@}
 
+            /*!
+             * Take a snapshot of the complete state of this chain, from which its random walk
+             * can be continued exactly, e.g. after a restart of the program.
+             *
+             * @param with_history If true, the snapshot includes the chain's history.
+             */
+            Checkpoint checkpoint(bool with_history) const;
+
             /// Remove existing history of this chain.
             void clear();
 
@@ -76,12 +85,35 @@ namespace eos
 
             void dump_proposal(hdf5::File & file, const std::string & data_set_name) const;
 
+            /*!
+             * Dump states in the HDF5 file, in the same format as dump_history().
+             * This allows to store copies of a chain's history while the chain itself moves on.
+             *
+             * @param file
+             * @param data_set_name All output is stored below this directory.
+             * @param states The states to dump.
+             * @param stats The chain's statistics, from which the mode is stored.
+             */
+            static void dump_states(hdf5::File & file, const std::string & data_set_name,
+                                    const std::vector<MarkovChain::State> & states, const MarkovChain::Stats & stats);
+
             /// Retrieve the number of iterations used in the last run
             const unsigned & iterations_last_run() const;
 
             /// Retrieve the chain's detailed history.
             const History & history() const;
 
+            /// Retrieve the inverse temperature at which the chain samples.
+            const double & inverse_temperature() const;
+
+            /*!
+             * Set the inverse temperature beta, such that the chain samples from the
+             * density raised to the power beta. The default value is one.
+             *
+             * @param beta The inverse temperature, 0 < beta <= 1.
+             */
+            void inverse_temperature(const double & beta);
+
             /*!
              * Set whether the chain stores samples in runs to come.
              *
@@ -128,6 +160,14 @@ namespace eos
                                   std::string & proposal_type,
                                   MarkovChain::Stats & stats);
 
+            /*!
+             * Continue the random walk from a snapshot, which may have been taken from another chain
+             * for the same density.
+             *
+             * @param checkpoint The snapshot, as obtained from checkpoint() or Checkpoint::read().
+             */
+            void restore(const Checkpoint & checkpoint);
+
             /*!
              * Perform a number of iterations.
              *
@@ -135,6 +175,14 @@ namespace eos
              */
             void run(const unsigned & iterations);
 
+            /*!
+             * Perform a number of iterations as a continuation of the previous run, i.e.,
+             * without resetting the counters of accepted and rejected proposals.
+             *
+             * @param iterations The number of iterations that shall be performed.
+             */
+            void resume(const unsigned & iterations);
+
             /*! Set the stats at mode to a point found outside of the chain.
              * Triggers writing to the HDF5 file as another row in the stats section.
              *
@@ -153,6 +201,14 @@ namespace eos
              */
             void set_point(const std::vector<double> & point);
 
+            /*!
+             * Set the chain to continue its walk from the given state. As opposed to set_point(),
+             * the density is not evaluated, and the state's log(density) is used as is.
+             *
+             * @param state The state, comprising the point in parameter space and the log(density) there.
+             */
+            void set_state(const State & state);
+
             /// Retrieve statistical data that summarizes the evolution of the chain up to the current point.
             const Stats & statistics() const;
     };
@@ -183,6 +239,8 @@ namespace eos
             point.resize(other.point.size());
             std::copy(other.point.cbegin(), other.point.cend(), point.begin());
         }
+
+        State & operator= (const State &) = default;
     };
 
     /*!
@@ -308,6 +366,50 @@ namespace eos
         virtual void propose(MarkovChain::State & x, const MarkovChain::State & y, gsl_rng * rng) const = 0;
     };
 
+    /*!
+     * Holds the complete state of a MarkovChain, from which its random walk can be continued.
+     */
+    struct MarkovChain::Checkpoint
+    {
+        /// The current state of the chain.
+        MarkovChain::State current;
+
+        /// The chain's statistics.
+        MarkovChain::Stats stats;
+
+        /// The intermediate results of Welford's method for the variances of the parameters and of the log(density).
+        std::vector<double> welford_data_parameters;
+        double welford_data_density;
+
+        /// The inverse temperature at which the chain samples.
+        double inverse_temperature;
+
+        /// The raw state of the chain's random number generator.
+        std::vector<unsigned> rng_state;
+
+        /// An independent copy of the chain's proposal function.
+        ProposalFunctionPtr proposal;
+
+        /// The chain's history, if requested.
+        std::vector<MarkovChain::State> history;
+
+        /*!
+         * Store the checkpoint in the HDF5 file under the given group name.
+         *
+         * @param file
+         * @param data_set_base_name All output is stored below this directory.
+         */
+        void dump(hdf5::File & file, const std::string & data_set_base_name) const;
+
+        /*!
+         * Read a checkpoint from the HDF5 file.
+         *
+         * @param file
+         * @param data_set_base_name The directory in the file under which the checkpoint was stored by dump().
+         */
+        static Checkpoint read(hdf5::File & file, const std::string & data_set_base_name);
+    };
+
     std::ostream & operator<< (std::ostream & lhs, const MarkovChain::State & rhs);
 }
 
@@ -1273,9 +1273,19 @@ namespace eos
         static void read_samples(const std::string & sample_file, const std::string & base,
                                  const unsigned & min, const unsigned & max,
                                  std::vector<std::vector<double>> & samples)
+        {
+            std::vector<double> log_weights;
+            read_samples(sample_file, base, min, max, samples, log_weights);
+        }
+
+        static void read_samples(const std::string & sample_file, const std::string & base,
+                                 const unsigned & min, const unsigned & max,
+                                 std::vector<std::vector<double>> & samples,
+                                 std::vector<double> & log_weights)
         {
             const unsigned n_dim = samples.front().size();
             samples.clear();
+            log_weights.clear();
 
             auto file = hdf5::File::Open(sample_file, H5F_ACC_RDONLY);
 
@@ -1286,6 +1296,7 @@ namespace eos
             {
                 data_set >> record;
                 samples.push_back(std::vector<double>(record.begin(), record.end() - 3));
+                log_weights.push_back(record.back());
             }
         }
 
@@ -1594,6 +1605,15 @@ namespace eos
         Implementation<PopulationMonteCarloSampler>::read_samples(sample_file, base, min, max, samples);
     }
 
+    void
+    PopulationMonteCarloSampler::read_samples(const std::string & sample_file, const std::string & base,
+                                              const unsigned & min, const unsigned & max,
+                                              std::vector<std::vector<double>> & samples,
+                                              std::vector<double> & log_weights)
+    {
+        Implementation<PopulationMonteCarloSampler>::read_samples(sample_file, base, min, max, samples, log_weights);
+    }
+
     const PopulationMonteCarloSampler::Status &
     PopulationMonteCarloSampler::status() const
     {
@@ -92,6 +92,21 @@ namespace eos
                                      const unsigned & min, const unsigned & max,
                                      std::vector<std::vector<double>> & samples);
 
+            /*!
+             * Read in a slice of samples and their importance weights from a previous PMC dump.
+             *
+             * @param sample_file Name of HDF5 file containing the samples.
+             * @param base Directory name within HDF5 file.
+             * @param min First element to parse.
+             * @param max Index of one-past last element to parse.
+             * @param samples Upon return, contains all samples stored. When passing in, there must be at least one sample in there to convey the parameter dimension
+             * @param log_weights Upon return, contains the logarithm of the unnormalized importance weight of each sample.
+             */
+            static void read_samples(const std::string & sample_file, const std::string & base,
+                                     const unsigned & min, const unsigned & max,
+                                     std::vector<std::vector<double>> & samples,
+                                     std::vector<double> & log_weights);
+
             /// Start the Markov chain sampling.
             void run();
 
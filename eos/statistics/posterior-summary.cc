@@ -0,0 +1,495 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/posterior-summary.hh>
+#include <eos/statistics/t-digest.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace eos
+{
+    PosteriorSummary::Config::Config() :
+        parallelize(true),
+        exact_quantiles(false),
+        compression(200.0),
+        probabilities{ 0.025, 0.16, 0.5, 0.84, 0.975 },
+        chunk_size(10000)
+    {
+    }
+
+    PosteriorSummary::Config
+    PosteriorSummary::Config::Default()
+    {
+        return Config();
+    }
+
+    template <>
+    struct Implementation<PosteriorSummary>
+    {
+        // weighted mean and central moments of one column, multiplied by the sum of weights
+        struct Moments
+        {
+            double mean = 0.0, m2 = 0.0, m3 = 0.0, m4 = 0.0;
+
+            double min = std::numeric_limits<double>::infinity();
+
+            double max = -std::numeric_limits<double>::infinity();
+        };
+
+        PosteriorSummary::Config config;
+
+        std::vector<std::string> names;
+
+        unsigned dimension;
+
+        unsigned number_of_samples;
+
+        // all weights are stored relative to exp(log_reference)
+        double log_reference;
+
+        double sum_of_weights, sum_of_squared_weights;
+
+        std::vector<Moments> moments;
+
+        // co-moments of all pairs of columns, row by row; only the upper triangle is used
+        std::vector<double> comoments;
+
+        std::vector<TDigest> digests;
+
+        // pairs of value and weight, if exact quantiles are requested
+        std::vector<std::vector<std::pair<double, double>>> values;
+
+        Implementation(const std::vector<std::string> & names, const PosteriorSummary::Config & config) :
+            config(config),
+            names(names),
+            dimension(names.size()),
+            number_of_samples(0),
+            log_reference(0.0),
+            sum_of_weights(0.0),
+            sum_of_squared_weights(0.0),
+            moments(dimension),
+            comoments(dimension * dimension, 0.0)
+        {
+            if (0 == dimension)
+                throw InternalError("PosteriorSummary: need at least one column");
+
+            for (const auto & p : config.probabilities)
+            {
+                if ((p < 0.0) || (p > 1.0))
+                    throw InternalError("PosteriorSummary: probability '" + stringify(p) + "' is outside [0, 1]");
+            }
+
+            if (config.exact_quantiles)
+            {
+                values.resize(dimension);
+            }
+            else
+            {
+                digests.resize(dimension, TDigest(config.compression));
+            }
+        }
+
+        // run the task once for each column
+        void for_each_column(const std::function<void (const unsigned &)> & task)
+        {
+            std::vector<Ticket> tickets;
+            for (unsigned j = 0 ; j < dimension ; ++j)
+            {
+                if (config.parallelize)
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue(std::bind(task, j)));
+                }
+                else
+                {
+                    task(j);
+                }
+            }
+
+            for (auto & t : tickets)
+            {
+                t.wait();
+            }
+        }
+
+        // move the reference point of all weights, scaling all accumulated weighted sums accordingly
+        void rescale(const double & log_new_reference)
+        {
+            const double factor = std::exp(log_reference - log_new_reference);
+
+            sum_of_weights *= factor;
+            sum_of_squared_weights *= factor * factor;
+
+            for (auto & m : moments)
+            {
+                m.m2 *= factor;
+                m.m3 *= factor;
+                m.m4 *= factor;
+            }
+
+            for (auto & c : comoments)
+            {
+                c *= factor;
+            }
+
+            for (auto & d : digests)
+            {
+                d.scale(factor);
+            }
+
+            for (auto & v : values)
+            {
+                for (auto & p : v)
+                {
+                    p.second *= factor;
+                }
+            }
+
+            log_reference = log_new_reference;
+        }
+
+        void add(const double * samples, const unsigned & count, const double * log_weights)
+        {
+            if (0 == count)
+                return;
+
+            // determine the weights relative to the largest weight seen so far
+            double log_max = 0.0;
+            if (log_weights)
+            {
+                log_max = *std::max_element(log_weights, log_weights + count);
+
+                if (std::isnan(log_max))
+                    throw InternalError("PosteriorSummary: encountered NaN as log weight");
+
+                // all samples in this chunk have zero weight
+                if (log_max == -std::numeric_limits<double>::infinity())
+                {
+                    number_of_samples += count;
+                    return;
+                }
+            }
+
+            if (0.0 == sum_of_weights)
+            {
+                log_reference = log_max;
+            }
+            else if (log_max > log_reference)
+            {
+                rescale(log_max);
+            }
+
+            std::vector<double> weights(count, 1.0);
+            double chunk_weight = 0.0, chunk_squared_weight = 0.0;
+            for (unsigned i = 0 ; i < count ; ++i)
+            {
+                weights[i] = std::exp((log_weights ? log_weights[i] : 0.0) - log_reference);
+                chunk_weight += weights[i];
+                chunk_squared_weight += weights[i] * weights[i];
+            }
+
+            // first pass: the moments of each column within this chunk
+            std::vector<Moments> chunk_moments(dimension);
+            for_each_column([&] (const unsigned & j)
+            {
+                Moments & m = chunk_moments[j];
+
+                double sum = 0.0;
+                for (unsigned i = 0 ; i < count ; ++i)
+                {
+                    const double & x = samples[i * dimension + j];
+
+                    sum += weights[i] * x;
+
+                    // samples without weight do not belong to the support of the posterior
+                    if (0.0 == weights[i])
+                        continue;
+
+                    m.min = std::min(m.min, x);
+                    m.max = std::max(m.max, x);
+                }
+                m.mean = sum / chunk_weight;
+
+                for (unsigned i = 0 ; i < count ; ++i)
+                {
+                    const double d = samples[i * dimension + j] - m.mean;
+                    const double wd2 = weights[i] * d * d;
+
+                    m.m2 += wd2;
+                    m.m3 += wd2 * d;
+                    m.m4 += wd2 * d * d;
+                }
+
+                if (config.exact_quantiles)
+                {
+                    for (unsigned i = 0 ; i < count ; ++i)
+                    {
+                        values[j].push_back(std::make_pair(samples[i * dimension + j], weights[i]));
+                    }
+                }
+                else
+                {
+                    for (unsigned i = 0 ; i < count ; ++i)
+                    {
+                        digests[j].add(samples[i * dimension + j], weights[i]);
+                    }
+                }
+            });
+
+            std::vector<double> delta(dimension);
+            for (unsigned j = 0 ; j < dimension ; ++j)
+            {
+                delta[j] = chunk_moments[j].mean - moments[j].mean;
+            }
+
+            // second pass: the co-moments within this chunk, and the merge with the running totals
+            const double wa = sum_of_weights, wb = chunk_weight, w = wa + wb;
+            for_each_column([&] (const unsigned & j)
+            {
+                const Moments & b = chunk_moments[j];
+
+                for (unsigned k = j + 1 ; k < dimension ; ++k)
+                {
+                    double c = 0.0;
+                    for (unsigned i = 0 ; i < count ; ++i)
+                    {
+                        c += weights[i] * (samples[i * dimension + j] - b.mean) * (samples[i * dimension + k] - chunk_moments[k].mean);
+                    }
+
+                    comoments[j * dimension + k] += c + delta[j] * delta[k] * wa * wb / w;
+                }
+
+                Moments & a = moments[j];
+                const double d = delta[j], d2 = d * d;
+
+                a.m4 += b.m4 + d2 * d2 * wa * wb * (wa * wa - wa * wb + wb * wb) / (w * w * w)
+                    + 6.0 * d2 * (wa * wa * b.m2 + wb * wb * a.m2) / (w * w)
+                    + 4.0 * d * (wa * b.m3 - wb * a.m3) / w;
+                a.m3 += b.m3 + d2 * d * wa * wb * (wa - wb) / (w * w)
+                    + 3.0 * d * (wa * b.m2 - wb * a.m2) / w;
+                a.m2 += b.m2 + d2 * wa * wb / w;
+                a.mean += d * wb / w;
+                a.min = std::min(a.min, b.min);
+                a.max = std::max(a.max, b.max);
+            });
+
+            number_of_samples += count;
+            sum_of_weights = w;
+            sum_of_squared_weights += chunk_squared_weight;
+        }
+
+        void add(const SampleStore & store)
+        {
+            if (store.dimension() != dimension)
+                throw InternalError("PosteriorSummary: store has " + stringify(store.dimension()) + " parameters, but expected "
+                        + stringify(dimension));
+
+            const unsigned chunk_size = std::max(config.chunk_size, 1u);
+            std::vector<double> samples;
+            std::vector<double> log_weights;
+            samples.reserve(chunk_size * dimension);
+            log_weights.reserve(chunk_size);
+            for (unsigned first = 0 ; first < store.size() ; first += chunk_size)
+            {
+                const unsigned last = std::min(first + chunk_size, store.size());
+
+                samples.clear();
+                log_weights.clear();
+                for (unsigned i = first ; i < last ; ++i)
+                {
+                    SampleStore::Row row = store[i];
+                    samples.insert(samples.end(), row.begin(), row.end());
+                    log_weights.push_back(row.log_weight());
+                }
+
+                add(samples.data(), last - first, store.weighted() ? log_weights.data() : nullptr);
+            }
+        }
+
+        // the denominator of the unbiased weighted variance
+        double normalization() const
+        {
+            if (0.0 == sum_of_weights)
+                return 0.0;
+
+            return sum_of_weights - sum_of_squared_weights / sum_of_weights;
+        }
+
+        double exact_quantile(const std::vector<std::pair<double, double>> & sorted, const double & p) const
+        {
+            const double target = p * sum_of_weights;
+
+            double weight_so_far = 0.0;
+            for (const auto & v : sorted)
+            {
+                weight_so_far += v.second;
+                if (weight_so_far >= target)
+                    return v.first;
+            }
+
+            return sorted.back().first;
+        }
+
+        std::vector<PosteriorSummary::Column> columns()
+        {
+            std::vector<PosteriorSummary::Column> result(dimension);
+            const double n = normalization();
+
+            for_each_column([&] (const unsigned & j)
+            {
+                const Moments & m = moments[j];
+                PosteriorSummary::Column & c = result[j];
+
+                c.name = names[j];
+                c.mean = m.mean;
+                // the standard deviation is consistent with covariance(), while the shape parameters
+                // are ratios of the population moments; see the documentation of PosteriorSummary::Column
+                c.std_deviation = (n > 0.0) ? std::sqrt(m.m2 / n) : 0.0;
+                c.skewness = (m.m2 > 0.0) ? std::sqrt(sum_of_weights) * m.m3 / std::pow(m.m2, 1.5) : 0.0;
+                c.kurtosis = (m.m2 > 0.0) ? sum_of_weights * m.m4 / (m.m2 * m.m2) : 0.0;
+                c.min = m.min;
+                c.max = m.max;
+
+                if (0.0 == sum_of_weights)
+                {
+                    c.quantiles.assign(config.probabilities.size(), std::numeric_limits<double>::quiet_NaN());
+                }
+                else if (config.exact_quantiles)
+                {
+                    std::sort(values[j].begin(), values[j].end());
+
+                    for (const auto & p : config.probabilities)
+                    {
+                        c.quantiles.push_back(exact_quantile(values[j], p));
+                    }
+                }
+                else
+                {
+                    for (const auto & p : config.probabilities)
+                    {
+                        c.quantiles.push_back(digests[j].quantile(p));
+                    }
+                }
+            });
+
+            return result;
+        }
+
+        std::vector<std::vector<double>> covariance() const
+        {
+            std::vector<std::vector<double>> result(dimension, std::vector<double>(dimension, 0.0));
+            const double n = normalization();
+            if (n <= 0.0)
+                return result;
+
+            for (unsigned j = 0 ; j < dimension ; ++j)
+            {
+                result[j][j] = moments[j].m2 / n;
+
+                for (unsigned k = j + 1 ; k < dimension ; ++k)
+                {
+                    result[j][k] = result[k][j] = comoments[j * dimension + k] / n;
+                }
+            }
+
+            return result;
+        }
+    };
+
+    PosteriorSummary::PosteriorSummary(const std::vector<std::string> & names, const PosteriorSummary::Config & config) :
+        PrivateImplementationPattern<PosteriorSummary>(new Implementation<PosteriorSummary>(names, config))
+    {
+    }
+
+    PosteriorSummary::~PosteriorSummary()
+    {
+    }
+
+    void
+    PosteriorSummary::add(const double * samples, const unsigned & count, const double * log_weights)
+    {
+        _imp->add(samples, count, log_weights);
+    }
+
+    void
+    PosteriorSummary::add(const SampleStore & store)
+    {
+        _imp->add(store);
+    }
+
+    unsigned
+    PosteriorSummary::number_of_samples() const
+    {
+        return _imp->number_of_samples;
+    }
+
+    double
+    PosteriorSummary::effective_sample_size() const
+    {
+        if (0.0 == _imp->sum_of_squared_weights)
+            return 0.0;
+
+        return _imp->sum_of_weights * _imp->sum_of_weights / _imp->sum_of_squared_weights;
+    }
+
+    const std::vector<double> &
+    PosteriorSummary::probabilities() const
+    {
+        return _imp->config.probabilities;
+    }
+
+    std::vector<PosteriorSummary::Column>
+    PosteriorSummary::columns() const
+    {
+        return _imp->columns();
+    }
+
+    std::vector<std::vector<double>>
+    PosteriorSummary::covariance() const
+    {
+        return _imp->covariance();
+    }
+
+    std::vector<std::vector<double>>
+    PosteriorSummary::correlation() const
+    {
+        std::vector<std::vector<double>> result = _imp->covariance();
+
+        std::vector<double> sigma(_imp->dimension);
+        for (unsigned j = 0 ; j < _imp->dimension ; ++j)
+        {
+            sigma[j] = std::sqrt(result[j][j]);
+        }
+
+        for (unsigned j = 0 ; j < _imp->dimension ; ++j)
+        {
+            for (unsigned k = 0 ; k < _imp->dimension ; ++k)
+            {
+                result[j][k] = (sigma[j] > 0.0 && sigma[k] > 0.0) ? result[j][k] / (sigma[j] * sigma[k]) : 0.0;
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,168 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_POSTERIOR_SUMMARY_HH
+#define EOS_GUARD_EOS_STATISTICS_POSTERIOR_SUMMARY_HH 1
+
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Summarise a stream of (weighted) posterior samples in a single pass.
+     *
+     * The samples are consumed in chunks. For each chunk, the weighted central
+     * moments up to fourth order and the co-moments of all pairs of columns are
+     * computed, and merged into the running totals using the pairwise update
+     * formulas of Chan et al. and Pebay. Quantiles are estimated with one TDigest
+     * per column, or computed exactly if requested.
+     *
+     * Sample weights are passed as logarithms. The running totals are rescaled
+     * whenever a larger log weight is encountered, so that the weights never overflow.
+     */
+    class PosteriorSummary :
+        public PrivateImplementationPattern<PosteriorSummary>
+    {
+        public:
+            struct Config;
+            struct Column;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param names  The names of the columns, in the order in which they appear in each sample.
+             * @param config The configuration options.
+             */
+            PosteriorSummary(const std::vector<std::string> & names, const PosteriorSummary::Config & config);
+
+            /// Destructor.
+            ~PosteriorSummary();
+            ///@}
+
+            ///@name Accumulation
+            ///@{
+            /*!
+             * Add a chunk of samples.
+             *
+             * @param samples     The samples, stored row by row with one entry per column.
+             * @param count       The number of samples.
+             * @param log_weights The logarithm of the samples' weights. If null, all samples are weighted equally.
+             */
+            void add(const double * samples, const unsigned & count, const double * log_weights = nullptr);
+
+            /*!
+             * Add all samples from a SampleStore, chunk by chunk.
+             *
+             * @param store The samples, with one parameter per column.
+             */
+            void add(const SampleStore & store);
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Retrieve the number of samples added so far.
+            unsigned number_of_samples() const;
+
+            /// Retrieve the effective sample size (sum w)^2 / (sum w^2).
+            double effective_sample_size() const;
+
+            /// Retrieve the probabilities at which the quantiles are evaluated.
+            const std::vector<double> & probabilities() const;
+
+            /// Retrieve the summary of each column.
+            std::vector<PosteriorSummary::Column> columns() const;
+
+            /// Retrieve the weighted covariance matrix, row by row.
+            std::vector<std::vector<double>> covariance() const;
+
+            /// Retrieve the weighted correlation matrix, row by row.
+            std::vector<std::vector<double>> correlation() const;
+            ///@}
+    };
+
+    /*!
+     * Summary configuration options.
+     */
+    struct PosteriorSummary::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            /// Constructor with the default settings.
+            static Config Default();
+
+            /// Process the columns of each chunk in parallel.
+            bool parallelize;
+
+            /// Store all samples and compute exact quantiles, instead of estimating them.
+            bool exact_quantiles;
+
+            /// The compression parameter of the quantile estimates.
+            double compression;
+
+            /// The probabilities at which the quantiles are evaluated.
+            std::vector<double> probabilities;
+
+            /// The number of samples that are read from a SampleStore at once.
+            unsigned chunk_size;
+    };
+
+    /*!
+     * The summary of the marginal distribution of a single column.
+     */
+    struct PosteriorSummary::Column
+    {
+        std::string name;
+
+        double mean;
+
+        /*!
+         * The standard deviation, from the unbiased weighted variance
+         * m_2 * W / (W - sum w^2 / W) with W = sum w. For equal weights this
+         * reduces to the usual n / (n - 1) correction, and it agrees with the
+         * diagonal of covariance().
+         */
+        double std_deviation;
+
+        /*!
+         * The skewness m_3 / m_2^(3/2), using the population central moments
+         * m_k = sum w (x - mean)^k / W without any small-sample correction.
+         */
+        double skewness;
+
+        /// The kurtosis m_4 / m_2^2 of the population central moments, which is 3 for a normal distribution.
+        double kurtosis;
+
+        /// The smallest and largest values among the samples with non-zero weight.
+        double min, max;
+
+        /// The quantiles at the probabilities given in the configuration.
+        std::vector<double> quantiles;
+    };
+}
+
+#endif
@@ -0,0 +1,187 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/posterior-summary.hh>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class PosteriorSummaryTest :
+    public TestCase
+{
+    public:
+        PosteriorSummaryTest() :
+            TestCase("posterior_summary_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1e-12;
+
+            // weighted samples, compared with a direct two-pass evaluation
+            {
+                const std::vector<double> samples
+                {
+                     1.23, -0.50,
+                     4.13,  0.25,
+                     2.13,  1.50,
+                    -0.70,  0.75,
+                     3.30, -1.25,
+                     0.45,  2.00,
+                     2.80,  0.10
+                };
+                const std::vector<double> log_weights { 0.0, -0.5, -1.0, 0.3, -2.0, 0.1, -0.2 };
+
+                for (bool parallelize : { false, true })
+                {
+                    // results must be independent of the chunking and of a common offset of the log weights
+                    for (unsigned chunk_size : { 7u, 3u, 1u })
+                    {
+                        for (double offset : { 0.0, 800.0 })
+                        {
+                            PosteriorSummary::Config config = PosteriorSummary::Config::Default();
+                            config.parallelize = parallelize;
+                            config.exact_quantiles = true;
+
+                            PosteriorSummary summary({ "x", "y" }, config);
+
+                            std::vector<double> shifted_log_weights(log_weights);
+                            for (auto & lw : shifted_log_weights)
+                            {
+                                lw += offset;
+                            }
+
+                            for (unsigned first = 0 ; first < 7 ; first += chunk_size)
+                            {
+                                const unsigned count = std::min(chunk_size, 7u - first);
+                                summary.add(samples.data() + 2 * first, count, shifted_log_weights.data() + first);
+                            }
+
+                            TEST_CHECK_EQUAL(summary.number_of_samples(), 7u);
+                            TEST_CHECK_RELATIVE_ERROR(summary.effective_sample_size(), 5.5358311793579285, eps);
+
+                            auto columns = summary.columns();
+                            TEST_CHECK_EQUAL(columns.size(), 2u);
+
+                            TEST_CHECK_EQUAL(columns[0].name, "x");
+                            TEST_CHECK_RELATIVE_ERROR(columns[0].mean,          1.2649810920485849,  eps);
+                            TEST_CHECK_RELATIVE_ERROR(columns[0].std_deviation, 1.7617508151234671,  eps);
+                            TEST_CHECK_RELATIVE_ERROR(columns[0].skewness,      0.35561112150270868, eps);
+                            TEST_CHECK_RELATIVE_ERROR(columns[0].kurtosis,      1.9688845736766043,  eps);
+                            TEST_CHECK_EQUAL(columns[0].min, -0.70);
+                            TEST_CHECK_EQUAL(columns[0].max,  4.13);
+
+                            TEST_CHECK_EQUAL(columns[1].name, "y");
+                            TEST_CHECK_RELATIVE_ERROR(columns[1].mean,          0.62020769083231952, eps);
+                            TEST_CHECK_RELATIVE_ERROR(columns[1].std_deviation, 1.0037829411811161,  eps);
+                            TEST_CHECK_RELATIVE_ERROR(columns[1].skewness,      0.17819723884138317, eps);
+                            TEST_CHECK_RELATIVE_ERROR(columns[1].kurtosis,      2.0517334051348888,  eps);
+
+                            // quantiles at 2.5%, 16%, 50%, 84% and 97.5%
+                            TEST_CHECK_EQUAL(columns[0].quantiles.size(), 5u);
+                            TEST_CHECK_EQUAL(columns[0].quantiles[0], -0.70);
+                            TEST_CHECK_EQUAL(columns[0].quantiles[1], -0.70);
+                            TEST_CHECK_EQUAL(columns[0].quantiles[2],  1.23);
+                            TEST_CHECK_EQUAL(columns[0].quantiles[3],  2.80);
+                            TEST_CHECK_EQUAL(columns[0].quantiles[4],  4.13);
+
+                            auto covariance = summary.covariance();
+                            TEST_CHECK_RELATIVE_ERROR(covariance[0][1], -0.69826280614642511, eps);
+                            TEST_CHECK_RELATIVE_ERROR(covariance[1][0], -0.69826280614642511, eps);
+                            TEST_CHECK_RELATIVE_ERROR(covariance[0][0], 1.7617508151234671 * 1.7617508151234671, eps);
+
+                            auto correlation = summary.correlation();
+                            TEST_CHECK_RELATIVE_ERROR(correlation[0][1], -0.394852250376035, eps);
+                            TEST_CHECK_RELATIVE_ERROR(correlation[1][1], 1.0, eps);
+                        }
+                    }
+                }
+            }
+
+            // samples with zero weight affect neither the moments nor the range
+            {
+                static const double inf = std::numeric_limits<double>::infinity();
+
+                const std::vector<double> samples { -10.0, 1.0, 2.0, 3.0, 10.0 };
+                const std::vector<double> log_weights { -inf, 0.0, 0.0, 0.0, -inf };
+
+                for (unsigned chunk_size : { 5u, 1u })
+                {
+                    PosteriorSummary::Config config = PosteriorSummary::Config::Default();
+                    config.parallelize = false;
+                    config.exact_quantiles = true;
+
+                    PosteriorSummary summary({ "x" }, config);
+                    for (unsigned first = 0 ; first < 5 ; first += chunk_size)
+                    {
+                        summary.add(samples.data() + first, std::min(chunk_size, 5u - first), log_weights.data() + first);
+                    }
+
+                    TEST_CHECK_EQUAL(summary.number_of_samples(), 5u);
+                    TEST_CHECK_RELATIVE_ERROR(summary.effective_sample_size(), 3.0, eps);
+
+                    auto columns = summary.columns();
+                    TEST_CHECK_RELATIVE_ERROR(columns[0].mean,          2.0, eps);
+                    TEST_CHECK_RELATIVE_ERROR(columns[0].std_deviation, 1.0, eps);
+                    TEST_CHECK_NEARLY_EQUAL(columns[0].skewness,        0.0, eps);
+                    TEST_CHECK_RELATIVE_ERROR(columns[0].kurtosis,      1.5, eps);
+                    TEST_CHECK_EQUAL(columns[0].min, 1.0);
+                    TEST_CHECK_EQUAL(columns[0].max, 3.0);
+                }
+            }
+
+            // unweighted samples, with estimated quantiles
+            {
+                static const unsigned n = 100000;
+
+                PosteriorSummary::Config config = PosteriorSummary::Config::Default();
+                config.probabilities = { 0.05, 0.5, 0.95 };
+                PosteriorSummary summary({ "u" }, config);
+
+                std::vector<double> samples(1000);
+                for (unsigned first = 0 ; first < n ; first += samples.size())
+                {
+                    for (unsigned i = 0 ; i < samples.size() ; ++i)
+                    {
+                        samples[i] = (((first + i) * 7919u) % n + 0.5) / n;
+                    }
+
+                    summary.add(samples.data(), samples.size());
+                }
+
+                TEST_CHECK_EQUAL(summary.number_of_samples(), n);
+                TEST_CHECK_RELATIVE_ERROR(summary.effective_sample_size(), double(n), eps);
+
+                auto columns = summary.columns();
+                TEST_CHECK_RELATIVE_ERROR(columns[0].mean, 0.5, eps);
+                TEST_CHECK_RELATIVE_ERROR(columns[0].std_deviation, std::sqrt((1.0 - 1.0 / n / n) / 12.0 * n / (n - 1.0)), 1e-10);
+                TEST_CHECK_NEARLY_EQUAL(columns[0].skewness, 0.0, 1e-10);
+                TEST_CHECK_RELATIVE_ERROR(columns[0].kurtosis, 1.8, 1e-6);
+                TEST_CHECK_NEARLY_EQUAL(columns[0].quantiles[0], 0.05, 1e-3);
+                TEST_CHECK_NEARLY_EQUAL(columns[0].quantiles[1], 0.50, 1e-3);
+                TEST_CHECK_NEARLY_EQUAL(columns[0].quantiles[2], 0.95, 1e-3);
+            }
+        }
+} posterior_summary_test;
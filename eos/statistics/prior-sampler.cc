@@ -19,14 +19,20 @@
 
 #include <eos/statistics/log-prior.hh>
 #include <eos/statistics/prior-sampler.hh>
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/background-writer.hh>
 #include <eos/utils/hdf5.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/memoise.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/thread_pool.hh>
 
 #include <gsl/gsl_randist.h>
 
+#include <algorithm>
+
 namespace eos
 {
     namespace
@@ -39,6 +45,8 @@ namespace eos
     {
         typedef std::function<void (void)> Function;
 
+        typedef hdf5::DataSet<hdf5::Array<1, double>> DataSetType;
+
         struct Worker
         {
             ObservableSet observables;
@@ -52,20 +60,47 @@ namespace eos
             // Random number generator seed
             unsigned seed;
 
-            // the sampling output, one vector for each iteration
-            SamplesList observable_samples;
-            SamplesList parameter_samples;
+            // Serializes all accesses to the output file
+            BackgroundWriter * writer;
+
+            // Serializes the reads of parameter samples with the writes to the output file, as the HDF5 library is not thread safe
+            Mutex * hdf5_mutex;
+
+            // the output data sets; parameter_data_set is empty unless parameters are stored
+            std::shared_ptr<DataSetType> observable_data_set;
+            std::shared_ptr<DataSetType> parameter_data_set;
+
+            // index of the next output record of this worker
+            unsigned offset;
 
-            hdf5::Array<1, double> observable_type;
-            hdf5::Array<1, double> parameter_type;
+            // number of samples kept in memory before they are handed over to the writer
+            unsigned block_size;
+
+            // the current block of sampling output, one row after the other
+            std::shared_ptr<std::vector<double>> observable_block;
+            std::shared_ptr<std::vector<double>> parameter_block;
+            unsigned rows;
 
             Worker(const ObservableSet & observables,
                    const std::vector<LogPriorPtr> & priors,
                    const std::vector<ParameterDescription> & parameter_descriptions,
-                   unsigned seed) :
+                   unsigned seed,
+                   BackgroundWriter * writer,
+                   Mutex * hdf5_mutex,
+                   const std::shared_ptr<DataSetType> & observable_data_set,
+                   const std::shared_ptr<DataSetType> & parameter_data_set,
+                   unsigned offset,
+                   unsigned block_size) :
                        seed(seed),
-                       observable_type("observables", { observables.size() }),
-                       parameter_type("parameters", { parameter_descriptions.size() })
+                       writer(writer),
+                       hdf5_mutex(hdf5_mutex),
+                       observable_data_set(observable_data_set),
+                       parameter_data_set(parameter_data_set),
+                       offset(offset),
+                       block_size(std::max(block_size, 1u)),
+                       observable_block(new std::vector<double>),
+                       parameter_block(new std::vector<double>),
+                       rows(0)
             {
                 // need to clone, so parameters that are fixed by hand have correct value
                 // cast away const-ness
@@ -90,26 +125,43 @@ namespace eos
                     this->parameter_descriptions.push_back(
                         ParameterDescription{ p[i->parameter->name()].clone(), i->min, i->max, i->nuisance });
                 }
+
+                observable_block->reserve(this->block_size * this->observables.size());
             }
 
-            void dump_history(const std::shared_ptr<hdf5::File> & file, const bool & store_parameters)
+            /*!
+             * Hand the current block over to the writer, which stores it in this worker's
+             * range of the output data sets.
+             */
+            void flush_block()
             {
-                // write observables
-                auto observable_data_set = file->create_or_open_data_set("/data/observables", observable_type);
-                for (auto o = observable_samples.cbegin(), o_end = observable_samples.cend() ; o != o_end ; ++o)
-                {
-                    observable_data_set << *o;
-                }
-
-                // write parameters
-                if ( ! store_parameters)
+                if (0 == rows)
                     return;
 
-                auto parameter_data_set = file->create_or_open_data_set("/data/parameters", parameter_type);
-                for (auto p = parameter_samples.cbegin(), p_end = parameter_samples.cend() ; p != p_end ; ++p)
+                auto observable_data_set = this->observable_data_set;
+                auto observable_block = this->observable_block;
+                auto parameter_data_set = this->parameter_data_set;
+                auto parameter_block = this->parameter_block;
+                const unsigned first = offset, rows = this->rows;
+                Mutex * hdf5_mutex = this->hdf5_mutex;
+
+                writer->enqueue([observable_data_set, observable_block, parameter_data_set, parameter_block, first, rows, hdf5_mutex] ()
                 {
-                    parameter_data_set << *p;
-                }
+                    Lock l(*hdf5_mutex);
+
+                    observable_data_set->write(first, rows, observable_block->data());
+
+                    if (parameter_data_set)
+                        parameter_data_set->write(first, rows, parameter_block->data());
+                });
+
+                offset += rows;
+                this->rows = 0;
+
+                // the writer owns the previous blocks from now on
+                this->observable_block.reset(new std::vector<double>);
+                this->observable_block->reserve(block_size * observables.size());
+                this->parameter_block.reset(new std::vector<double>);
             }
 
             /*!
@@ -129,33 +181,100 @@ namespace eos
                 // loop over samples
                 for (; first != last; ++first)
                 {
-                    // read and update parameter values, one at a time
-                    auto def = parameter_descriptions.begin();
-                    for (auto p = first->cbegin() ; p != first->cend() ; ++p, ++def)
+                    compute_observables(first->cbegin(), first->cend(), rng);
+                }
+                flush_block();
+
+                // free RN generator
+                gsl_rng_free(rng);
+            }
+
+            /*!
+             * Compute observables for every sample in the store
+             */
+            void compute_observables(const SampleStore & samples)
+            {
+                Log::instance()->message("prior_sampler.run", ll_informational)
+                            << "Computing " << observables.size() << " observables for "
+                            << samples.size() << " parameter samples";
+
+                // setup random number generator
+                gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
+                gsl_rng_set(rng, seed);
+
+                // read one block of samples at a time, while the writer is kept out of the HDF5 library
+                std::vector<SampleStore::Row> block;
+                for (unsigned first = 0 ; first < samples.size() ; first += block_size)
+                {
+                    const unsigned last = std::min(samples.size(), first + block_size);
+
+                    block.clear();
                     {
-                        def->parameter->set(*p);
+                        Lock l(*hdf5_mutex);
+
+                        for (unsigned i = first ; i < last ; ++i)
+                        {
+                            block.push_back(samples[i]);
+                        }
                     }
 
-                    auto p = priors.cbegin();
-                    std::advance(p, std::distance(first->cbegin(), first->cend()));
-                    for (auto p_end = priors.cend() ; p != p_end ; ++p, ++def)
+                    for (auto row = block.cbegin(), row_end = block.cend() ; row != row_end ; ++row)
                     {
-                        def->parameter->set((*p)->sample(rng));
+                        compute_observables(row->begin(), row->end(), rng);
                     }
-
-                    // calculate all observables
-                    std::vector<double> observable_sample;
-                    for (auto & o : observables)
-                        observable_sample.push_back(o->evaluate());
-                    observable_samples.push_back(observable_sample);
                 }
+                flush_block();
 
                 // free RN generator
                 gsl_rng_free(rng);
             }
 
             /*!
-             * Draw random vector from the priors.
+             * Compute observables for a single sample; parameters beyond the sample's
+             * dimension are drawn from their priors.
+             */
+            template <typename Iterator_>
+            void compute_observables(Iterator_ begin, Iterator_ end, gsl_rng * rng)
+            {
+                // read and update parameter values, one at a time
+                auto def = parameter_descriptions.begin();
+                for (auto p = begin ; p != end ; ++p, ++def)
+                {
+                    def->parameter->set(*p);
+                }
+
+                auto p = priors.cbegin();
+                std::advance(p, std::distance(begin, end));
+                for (auto p_end = priors.cend() ; p != p_end ; ++p, ++def)
+                {
+                    def->parameter->set((*p)->sample(rng));
+                }
+
+                // calculate all observables
+                for (auto & o : observables)
+                    observable_block->push_back(o->evaluate());
+
+                if (parameter_data_set)
+                {
+                    for (auto & d : parameter_descriptions)
+                        parameter_block->push_back(d.parameter->evaluate());
+                }
+
+                if (++rows == block_size)
+                    flush_block();
+            }
+
+            // derive a seed that differs from the seeds of all workers, which are consecutive
+            static unsigned observables_seed(const unsigned & seed)
+            {
+                // Knuth's multiplicative hash
+                return seed * 2654435761u + 1u;
+            }
+
+            /*!
+             * Draw random vectors from the priors, and compute observables for each of them.
+             *
+             * The samples are drawn in blocks, so that only one block is kept in memory at any time.
              *
              * @param iterations The number of samples.
              */
@@ -164,29 +283,46 @@ namespace eos
                 Log::instance()->message("prior_sampler.run", ll_informational)
                             << "Drawing " << iterations << " parameter samples";
 
-                // setup random number generator
+                // setup random number generators
                 gsl_rng * rng = gsl_rng_alloc(gsl_rng_mt19937);
                 gsl_rng_set(rng, seed);
 
-                for (unsigned i = 0 ; i < iterations ; ++i)
+                // the observables must not reuse the random numbers of the parameter samples
+                gsl_rng * rng_observables = gsl_rng_alloc(gsl_rng_mt19937);
+                gsl_rng_set(rng_observables, observables_seed(seed));
+
+                std::vector<double> column(std::min(iterations, block_size));
+                SamplesList parameter_samples;
+
+                for (unsigned done = 0 ; done < iterations ; )
                 {
-                    std::vector<double> parameter_sample;
+                    const unsigned count = std::min(iterations - done, block_size);
+
+                    // draw all samples of one prior at once, then transpose into rows
+                    parameter_samples.assign(count, std::vector<double>(priors.size()));
 
-                    // draw a sample
                     unsigned index = 0;
                     for (auto prior = priors.begin(), i_end = priors.end() ; prior != i_end ; ++prior, ++index)
                     {
-                        double p = (**prior).sample(rng);
-//TODO: Fred, please check rebase starting here
-                        parameter_descriptions[index].parameter->set(p);
-                        parameter_sample.push_back(p);
+                        (**prior).sample(rng, count, column.data());
+
+                        for (unsigned i = 0 ; i < count ; ++i)
+                        {
+                            parameter_samples[i][index] = column[i];
+                        }
+                    }
+
+                    for (auto s = parameter_samples.cbegin(), s_end = parameter_samples.cend() ; s != s_end ; ++s)
+                    {
+                        compute_observables(s->cbegin(), s->cend(), rng_observables);
                     }
 
-//TODO: Fred, to here
-                    parameter_samples.push_back(parameter_sample);
+                    done += count;
                 }
+                flush_block();
 
-                // free RN generator
+                // free RN generators
+                gsl_rng_free(rng_observables);
                 gsl_rng_free(rng);
             }
         };
@@ -215,6 +351,9 @@ namespace eos
         // tickets for parallel computations
         std::vector<Ticket> tickets;
 
+        // Serializes the workers' and the writer's accesses to the HDF5 library
+        Mutex hdf5_mutex;
+
         Implementation(const ObservableSet & observables, const PriorSampler::Config & config) :
             config(config),
             observables(observables),
@@ -265,20 +404,81 @@ namespace eos
             return observables.add(observable).second;
         }
 
-        void run(const SamplesList & samples, const std::vector<ParameterDescription> & defs)
+        /*
+         * Parameters with given samples precede those drawn from the priors.
+         */
+        void prepend(const std::vector<ParameterDescription> & defs)
         {
             this->parameter_descriptions.insert(this->parameter_descriptions.begin(), defs.begin(), defs.end());
 
+            std::vector<LogPriorPtr> priors;
+            for (auto d = defs.cbegin(), d_end = defs.cend() ; d != d_end ; ++d)
+            {
+                priors.push_back(LogPrior::Flat(Parameters::Defaults(), d->parameter->name(), ParameterRange{ d->min, d->max }));
+            }
+
+            this->priors.insert(this->priors.begin(), priors.begin(), priors.end());
+        }
+
+        void run(const SampleStore & samples)
+        {
+            prepend(samples.descriptions());
+
+            // setup the scan file
+            setup_output();
+
+            // start with empty ticket queue
+            tickets.clear();
+
+            config.n_samples = samples.size();
+            config.store_parameters = false;
+
+            // hold back the workers if they produce blocks faster than these can be written
+            BackgroundWriter writer(2 * config.n_workers);
+            std::shared_ptr<DataSetType> observable_data_set, parameter_data_set;
+            const unsigned offset = open_data_sets(observable_data_set, parameter_data_set);
+
+            // create one Worker per chunk, each with its own view of the samples
+            std::vector<std::shared_ptr<Worker>> workers;
+            const unsigned average_samples_per_worker = config.n_samples / config.n_workers;
+            const unsigned remainder = config.n_samples % config.n_workers;
+
+            for (unsigned chunk = 0 ; chunk < config.n_workers; ++chunk)
             {
-                std::vector<LogPriorPtr> priors;
-                for (auto d = defs.cbegin(), d_end = defs.cend() ; d != d_end ; ++d)
+                const unsigned first = chunk * average_samples_per_worker;
+
+                workers.push_back(std::make_shared<Worker>(observables, this->priors, this->parameter_descriptions,
+                        config.seed + chunk, &writer, &hdf5_mutex, observable_data_set, parameter_data_set,
+                        offset + first, config.block_size));
+
+                unsigned samples_per_worker = average_samples_per_worker;
+
+                // last worker gets the remainder
+                if (chunk == config.n_workers - 1)
+                    samples_per_worker += remainder;
+
+                SampleStore slice = samples.slice(first, first + samples_per_worker);
+
+                Function f = std::bind(static_cast<void (Worker::*)(const SampleStore &)>(&Worker::compute_observables),
+                        workers.back().get(), slice);
+
+                if (config.parallelize)
                 {
-                    priors.push_back(LogPrior::Flat(Parameters::Defaults(), d->parameter->name(), ParameterRange{ d->min, d->max }));
+                    tickets.push_back(ThreadPool::instance()->enqueue(f));
+                }
+                else
+                {
+                    f();
                 }
-
-                this->priors.insert(this->priors.begin(), priors.begin(), priors.end());
             }
 
+            finish(writer);
+        }
+
+        void run(const SamplesList & samples, const std::vector<ParameterDescription> & defs)
+        {
+            prepend(defs);
+
             // setup the scan file
             setup_output();
 
@@ -293,6 +493,11 @@ namespace eos
                 config.store_parameters = false;
             }
 
+            // hold back the workers if they produce blocks faster than these can be written
+            BackgroundWriter writer(2 * config.n_workers);
+            std::shared_ptr<DataSetType> observable_data_set, parameter_data_set;
+            const unsigned offset = open_data_sets(observable_data_set, parameter_data_set);
+
             // create one Worker per chunk
             std::vector<std::shared_ptr<Worker>> workers;
             const unsigned average_samples_per_worker = config.n_samples / config.n_workers;
@@ -301,7 +506,8 @@ namespace eos
             for (unsigned chunk = 0 ; chunk < config.n_workers; ++chunk)
             {
                 workers.push_back(std::make_shared<Worker>(observables, this->priors, this->parameter_descriptions,
-                        config.seed + chunk));
+                        config.seed + chunk, &writer, &hdf5_mutex, observable_data_set, parameter_data_set,
+                        offset + chunk * average_samples_per_worker, config.block_size));
 
                 unsigned samples_per_worker = average_samples_per_worker;
 
@@ -309,16 +515,19 @@ namespace eos
                 if (chunk == config.n_workers - 1)
                     samples_per_worker += remainder;
 
-                auto first = samples.cbegin() + chunk * average_samples_per_worker;
-                auto last  = first + samples_per_worker;
+                Function f;
                 if (draw)
                 {
-                    workers.back()->draw_samples(samples_per_worker);
-                    first = workers.back()->parameter_samples.cbegin();
-                    last  = workers.back()->parameter_samples.cend();
+                    f = std::bind(&Worker::draw_samples, workers.back().get(), samples_per_worker);
                 }
+                else
+                {
+                    auto first = samples.cbegin() + chunk * average_samples_per_worker;
+                    auto last  = first + samples_per_worker;
 
-                Function f = std::bind(&Worker::compute_observables, workers.back().get(), first, last);
+                    f = std::bind(static_cast<void (Worker::*)(SamplesList::const_iterator &, const SamplesList::const_iterator &)>(&Worker::compute_observables),
+                            workers.back().get(), first, last);
+                }
 
                 if (config.parallelize)
                 {
@@ -332,21 +541,47 @@ namespace eos
                 }
             }
 
-            // wait for job completion
-            for (auto t = tickets.begin(), t_end = tickets.end() ; t != t_end ; ++t)
+            finish(writer);
+        }
+
+        /*
+         * Open the output data sets. Each worker writes to its own range of records,
+         * starting after any records already present.
+         *
+         * @return The index of the first new record.
+         */
+        unsigned open_data_sets(std::shared_ptr<DataSetType> & observable_data_set, std::shared_ptr<DataSetType> & parameter_data_set)
+        {
+            observable_data_set = std::make_shared<DataSetType>(config.output_file->create_or_open_data_set("/data/observables",
+                    PriorSampler::observables_type(observables.size())));
+
+            const unsigned offset = observable_data_set->records();
+
+            if (config.store_parameters)
             {
-                t->wait();
+                parameter_data_set = std::make_shared<DataSetType>(config.output_file->create_or_open_data_set("/data/parameters",
+                        hdf5::Array<1, double>("parameters", { unsigned(parameter_descriptions.size()) })));
+
+                if (offset != parameter_data_set->records())
+                    throw InternalError("PriorSampler::run: Existing parameter and observable data sets differ in length");
             }
 
-            // retrieve data and delete workers
-            for (auto w = workers.begin(), w_end = workers.end() ; w != w_end ; ++w)
+            return offset;
+        }
+
+        // wait for the workers, and for all of their output to be written
+        void finish(BackgroundWriter & writer)
+        {
+            for (auto t = tickets.begin(), t_end = tickets.end() ; t != t_end ; ++t)
             {
-                (**w).dump_history(config.output_file, config.store_parameters);
+                t->wait();
             }
 
             // all tickets finished
             tickets.clear();
 
+            writer.flush();
+
             Log::instance()->message("prior_sampler.run", ll_informational)
                         << "Observable computations completed.";
         }
@@ -444,9 +679,16 @@ namespace eos
         _imp->run(samples, defs);
     }
 
+    void
+    PriorSampler::run(const SampleStore & samples)
+    {
+        _imp->run(samples);
+    }
+
     PriorSampler::Config::Config() :
         n_samples(100000),
         n_workers(4),
+        block_size(1000),
         parallelize(true),
         seed(1234623),
         store_parameters(false)
@@ -21,6 +21,7 @@
 #define EOS_GUARD_SRC_STATISTICS_PRIOR_SAMPLER_HH 1
 
 #include <eos/statistics/log-prior-fwd.hh>
+#include <eos/statistics/sample-store.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/private_implementation_pattern.hh>
 #include <eos/utils/hdf5-fwd.hh>
@@ -33,7 +34,9 @@ namespace eos
      * Perform simple uncertainty propagation by defining parameters to be varied,
      * and the observables whose variation one is interested in.
      * Parameter values are sampled directly from 1D priors.
-     * All observable values are stored to disk.
+     * All observable values are stored to disk, in blocks of fixed size
+     * as the sampling goes on. Each worker writes to its own range of rows
+     * within the common data sets, so that the rows follow the order of the samples.
      */
     class PriorSampler :
         public PrivateImplementationPattern<PriorSampler>
@@ -83,6 +86,14 @@ namespace eos
              * @note No new samples are drawn from the priors.
              */
             void run(const SamplesList & samples, const std::vector<ParameterDescription> & );
+
+            /*!
+             * Calculate observables at the samples of a SampleStore.
+             *
+             * The samples are read in chunks, and each worker only accesses its own range of samples.
+             * @note No new samples are drawn from the priors for the parameters in the store.
+             */
+            void run(const SampleStore & samples);
     };
 
     /*!
@@ -105,6 +116,12 @@ namespace eos
             /// Number of worker threads
             unsigned n_workers;
 
+            /*!
+             * Number of samples that each worker keeps in memory. Once a block is complete,
+             * it is written to the output file in the background.
+             */
+            unsigned block_size;
+
             /// The file where the observables are stored.
             std::shared_ptr<hdf5::File> output_file;
 
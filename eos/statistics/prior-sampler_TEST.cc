@@ -20,6 +20,7 @@
 #include <eos/statistics/analysis_TEST.hh>
 #include <eos/statistics/log-prior.hh>
 #include <eos/statistics/prior-sampler.hh>
+#include <eos/statistics/sample-store.hh>
 #include <eos/utils/hdf5.hh>
 #include <test/test.hh>
 
@@ -98,5 +99,107 @@ class PriorSamplerTest :
                 TEST_CHECK_EQUAL(std::get<0>(par_record), 3.5);
                 TEST_CHECK_EQUAL(std::get<1>(par_record), 4.5);
             }
+
+            // blocks smaller than the number of samples per worker
+            static const std::string block_file_name(EOS_BUILDDIR "/eos/statistics/prior-sampler_TEST-blocks.hdf5");
+            config.n_samples = 23;
+            config.block_size = 2;
+            config.output_file.reset(new hdf5::File(hdf5::File::Create(block_file_name)));
+            {
+                Parameters p = Parameters::Defaults();
+
+                ObservableSet o;
+                o.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)")));
+                o.add(ObservablePtr(new ObservableStub(p, "mass::c")));
+
+                PriorSampler sampler(o, config);
+
+                sampler.add(LogPrior::Gauss(p, "mass::b(MSbar)", ParameterRange{3.5, 4.5}, 4.1, 4.2, 4.3));
+                sampler.add(LogPrior::Flat(p, "mass::c", ParameterRange{1, 2}));
+
+                sampler.run();
+            }
+            config.output_file.reset();
+
+            {
+                auto file = hdf5::File::Open(block_file_name);
+
+                auto data_obs = file.open_data_set("/data/observables", PriorSampler::observables_type(2));
+                auto data_par = file.open_data_set("/data/parameters", PriorSampler::observables_type(2));
+
+                TEST_CHECK_EQUAL(data_obs.records(), 23);
+                TEST_CHECK_EQUAL(data_par.records(), 23);
+
+                // parameters == observables, row by row
+                std::vector<double> obs_record(2), par_record(2);
+                for (unsigned i = 0 ; i < 23 ; ++i)
+                {
+                    data_obs >> obs_record;
+                    data_par >> par_record;
+
+                    TEST_CHECK_EQUAL(obs_record[0], par_record[0]);
+                    TEST_CHECK_EQUAL(obs_record[1], par_record[1]);
+                    TEST_CHECK(1.0 <= obs_record[1] && obs_record[1] <= 2.0);
+                }
+            }
+
+            // samples from a store, in blocks smaller than the slice of each worker
+            static const std::string store_file_name(EOS_BUILDDIR "/eos/statistics/prior-sampler_TEST-store.hdf5");
+            static const std::string store_output_file_name(EOS_BUILDDIR "/eos/statistics/prior-sampler_TEST-store-output.hdf5");
+            {
+                auto file = hdf5::File::Create(store_file_name);
+
+                auto descriptions = file.create_data_set("/descriptions/main run/chain #0/parameters", Analysis::Output::description_type());
+                auto record = Analysis::Output::description_record();
+                std::get<0>(record) = "mass::b(MSbar)"; std::get<1>(record) = 4.0; std::get<2>(record) = 5.0; std::get<3>(record) = 0; std::get<4>(record) = "flat";
+                descriptions << record;
+
+                // row i holds (4 + i / 100, log(posterior))
+                auto samples = file.create_data_set("/main run/chain #0/samples", hdf5::Array<1, double>("samples", { 2 }));
+                for (unsigned i = 0 ; i < 23 ; ++i)
+                {
+                    samples << std::vector<double>{ 4.0 + i / 100.0, -1.0 * i };
+                }
+            }
+
+            config.n_workers = 4;
+            config.block_size = 3;
+            config.output_file.reset(new hdf5::File(hdf5::File::Create(store_output_file_name)));
+            {
+                SampleStore::Config store_config = SampleStore::Config::Default();
+                store_config.chunk_size = 2;
+                store_config.cached_chunks = 1;
+                SampleStore store = SampleStore::MarkovChains(store_file_name, "/main run", store_config);
+
+                Parameters p = Parameters::Defaults();
+
+                ObservableSet o;
+                o.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)")));
+                o.add(ObservablePtr(new ObservableStub(p, "mass::c")));
+
+                PriorSampler sampler(o, config);
+
+                // mass::c is not part of the samples, and is drawn from its prior
+                sampler.add(LogPrior::Flat(p, "mass::c", ParameterRange{1, 2}));
+
+                sampler.run(store);
+            }
+            config.output_file.reset();
+
+            {
+                auto file = hdf5::File::Open(store_output_file_name);
+
+                auto data_obs = file.open_data_set("/data/observables", PriorSampler::observables_type(2));
+                TEST_CHECK_EQUAL(data_obs.records(), 23);
+
+                std::vector<double> obs_record(2);
+                for (unsigned i = 0 ; i < 23 ; ++i)
+                {
+                    data_obs >> obs_record;
+
+                    TEST_CHECK_EQUAL(obs_record[0], 4.0 + i / 100.0);
+                    TEST_CHECK(1.0 <= obs_record[1] && obs_record[1] <= 2.0);
+                }
+            }
         }
 } prior_sampler_test;
@@ -0,0 +1,366 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/analysis.hh>
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+
+#include <algorithm>
+#include <list>
+
+namespace eos
+{
+    SampleStore::Config::Config() :
+        chunk_size(10000),
+        cached_chunks(4)
+    {
+    }
+
+    SampleStore::Config
+    SampleStore::Config::Default()
+    {
+        return Config();
+    }
+
+    namespace
+    {
+        /*
+         * The file and its data sets, shared among all copies and slices of a SampleStore.
+         */
+        struct Source
+        {
+            hdf5::File file;
+
+            std::vector<hdf5::DataSet<hdf5::Array<1, double>>> data_sets;
+
+            // index of the first record of each data set within the concatenation
+            std::vector<unsigned> offsets;
+
+            unsigned size;
+
+            unsigned record_dimension;
+
+            int log_weight;
+
+            std::vector<ParameterDescription> descriptions;
+
+            // guards all accesses to the HDF5 library
+            Mutex mutex;
+
+            Source(const std::string & file_name, const std::vector<std::string> & data_set_names,
+                    const std::vector<ParameterDescription> & descriptions, const unsigned & record_dimension,
+                    const int & log_weight) :
+                file(hdf5::File::Open(file_name, H5F_ACC_RDONLY)),
+                size(0),
+                record_dimension(record_dimension),
+                log_weight(log_weight),
+                descriptions(descriptions)
+            {
+                if (descriptions.size() > record_dimension)
+                    throw InternalError("SampleStore: More parameters (" + stringify(descriptions.size())
+                            + ") than entries per record (" + stringify(record_dimension) + ")");
+
+                if (log_weight >= int(record_dimension))
+                    throw InternalError("SampleStore: Index of the log weight is out of range");
+
+                const hdf5::Array<1, double> type("samples", { record_dimension });
+                for (const auto & name : data_set_names)
+                {
+                    data_sets.push_back(file.open_data_set(name, type));
+                    offsets.push_back(size);
+                    size += data_sets.back().records();
+                }
+            }
+
+            /*
+             * Read the records [first, first + count) of the concatenation into buffer.
+             */
+            void read(unsigned first, unsigned count, double * buffer)
+            {
+                Lock l(mutex);
+
+                // find the data set which contains the first record
+                unsigned i = std::upper_bound(offsets.cbegin(), offsets.cend(), first) - offsets.cbegin() - 1;
+                while (count > 0)
+                {
+                    const unsigned local_first = first - offsets[i];
+                    const unsigned local_count = std::min(count, data_sets[i].records() - local_first);
+
+                    data_sets[i].read(local_first, local_count, buffer);
+
+                    buffer += local_count * record_dimension;
+                    first += local_count;
+                    count -= local_count;
+                    ++i;
+                }
+            }
+        };
+    }
+
+    template <>
+    struct Implementation<SampleStore>
+    {
+        std::shared_ptr<Source> source;
+
+        SampleStore::Config config;
+
+        // range of records within the source
+        unsigned first, last;
+
+        // selected entries of each record, and their descriptions
+        std::vector<unsigned> columns;
+
+        std::vector<ParameterDescription> descriptions;
+
+        // most recently used chunks first; chunks are identified by their index within the source
+        std::list<std::pair<unsigned, std::shared_ptr<const std::vector<double>>>> cache;
+
+        Mutex cache_mutex;
+
+        Implementation(const std::shared_ptr<Source> & source, const SampleStore::Config & config) :
+            Implementation(source, config, 0, source->size, identity(source->descriptions.size()))
+        {
+        }
+
+        Implementation(const std::shared_ptr<Source> & source, const SampleStore::Config & config,
+                const unsigned & first, const unsigned & last,
+                const std::vector<unsigned> & columns) :
+            source(source),
+            config(config),
+            first(first),
+            last(last),
+            columns(columns)
+        {
+            if (0 == config.chunk_size)
+                throw InternalError("SampleStore: chunk size must be positive");
+
+            if (0 == config.cached_chunks)
+                throw InternalError("SampleStore: need to cache at least one chunk");
+
+            if ((first > last) || (last > source->size))
+                throw InternalError("SampleStore: Invalid range [" + stringify(first) + ", " + stringify(last)
+                        + ") for " + stringify(source->size) + " samples");
+
+            for (const auto & c : columns)
+            {
+                descriptions.push_back(source->descriptions[c]);
+            }
+        }
+
+        static std::vector<unsigned> identity(const unsigned & size)
+        {
+            std::vector<unsigned> result(size);
+            for (unsigned i = 0 ; i < size ; ++i)
+            {
+                result[i] = i;
+            }
+
+            return result;
+        }
+
+        // number of cached values per row: the selected columns and the log weight
+        unsigned stride() const
+        {
+            return columns.size() + 1;
+        }
+
+        std::shared_ptr<const std::vector<double>> load(const unsigned & chunk)
+        {
+            const unsigned chunk_first = chunk * config.chunk_size;
+            const unsigned chunk_count = std::min(config.chunk_size, source->size - chunk_first);
+
+            Log::instance()->message("sample_store.load", ll_debug)
+                << "Loading samples [" << chunk_first << ", " << chunk_first + chunk_count << ")";
+
+            std::vector<double> records(chunk_count * source->record_dimension);
+            source->read(chunk_first, chunk_count, records.data());
+
+            // keep only the selected columns
+            std::shared_ptr<std::vector<double>> result = std::make_shared<std::vector<double>>(chunk_count * stride());
+            auto out = result->begin();
+            for (auto r = records.cbegin(), r_end = records.cend() ; r != r_end ; r += source->record_dimension)
+            {
+                for (const auto & c : columns)
+                {
+                    *out = *(r + c);
+                    ++out;
+                }
+
+                *out = (source->log_weight < 0) ? 0.0 : *(r + source->log_weight);
+                ++out;
+            }
+
+            return result;
+        }
+
+        SampleStore::Row row(const unsigned & index)
+        {
+            if (index >= last - first)
+                throw InternalError("SampleStore: Index " + stringify(index) + " out of range [0, " + stringify(last - first) + ")");
+
+            const unsigned global = first + index;
+            const unsigned chunk = global / config.chunk_size;
+
+            std::shared_ptr<const std::vector<double>> data;
+            {
+                Lock l(cache_mutex);
+
+                auto c = std::find_if(cache.begin(), cache.end(),
+                        [chunk] (const std::pair<unsigned, std::shared_ptr<const std::vector<double>>> & e) { return e.first == chunk; });
+                if (cache.end() != c)
+                {
+                    // move to front
+                    cache.splice(cache.begin(), cache, c);
+                }
+                else
+                {
+                    cache.push_front(std::make_pair(chunk, load(chunk)));
+                    if (cache.size() > config.cached_chunks)
+                        cache.pop_back();
+                }
+
+                data = cache.front().second;
+            }
+
+            const double * row_data = data->data() + (global - chunk * config.chunk_size) * stride();
+
+            return SampleStore::Row(data, row_data, columns.size(), row_data[columns.size()]);
+        }
+    };
+
+    SampleStore::SampleStore(const std::string & file_name, const std::vector<std::string> & data_sets,
+            const std::vector<ParameterDescription> & descriptions, const unsigned & record_dimension,
+            const int & log_weight, const SampleStore::Config & config) :
+        PrivateImplementationPattern<SampleStore>(new Implementation<SampleStore>(
+                    std::make_shared<Source>(file_name, data_sets, descriptions, record_dimension, log_weight), config))
+    {
+    }
+
+    SampleStore::~SampleStore()
+    {
+    }
+
+    SampleStore
+    SampleStore::MarkovChains(const std::string & file_name, const std::string & base, const SampleStore::Config & config)
+    {
+        std::vector<std::string> data_sets;
+        std::vector<ParameterDescription> descriptions;
+        {
+            auto file = hdf5::File::Open(file_name, H5F_ACC_RDONLY);
+            descriptions = Analysis::read_descriptions(file, "/descriptions" + base + "/chain #0");
+
+            for (unsigned c = 0 ; file.group_exists(base + "/chain #" + stringify(c)) ; ++c)
+            {
+                data_sets.push_back(base + "/chain #" + stringify(c) + "/samples");
+            }
+        }
+
+        if (data_sets.empty())
+            throw InternalError("SampleStore::MarkovChains: Did not find any chains in '" + base + "' of file '" + file_name + "'");
+
+        // parameters and log(posterior)
+        return SampleStore(file_name, data_sets, descriptions, descriptions.size() + 1, -1, config);
+    }
+
+    SampleStore
+    SampleStore::PopulationMonteCarlo(const std::string & file_name, const std::string & base, const SampleStore::Config & config)
+    {
+        std::vector<ParameterDescription> descriptions;
+        {
+            auto file = hdf5::File::Open(file_name, H5F_ACC_RDONLY);
+            descriptions = Analysis::read_descriptions(file);
+        }
+
+        // parameters, component index, posterior and log(weight)
+        const unsigned record_dimension = descriptions.size() + 3;
+
+        return SampleStore(file_name, { base + "/samples" }, descriptions, record_dimension, record_dimension - 1, config);
+    }
+
+    unsigned
+    SampleStore::size() const
+    {
+        return _imp->last - _imp->first;
+    }
+
+    unsigned
+    SampleStore::dimension() const
+    {
+        return _imp->columns.size();
+    }
+
+    const std::vector<ParameterDescription> &
+    SampleStore::descriptions() const
+    {
+        return _imp->descriptions;
+    }
+
+    bool
+    SampleStore::weighted() const
+    {
+        return _imp->source->log_weight >= 0;
+    }
+
+    SampleStore::Row
+    SampleStore::operator[] (const unsigned & index) const
+    {
+        return _imp->row(index);
+    }
+
+    SampleStore
+    SampleStore::slice(const unsigned & first, const unsigned & last) const
+    {
+        if ((first > last) || (last > size()))
+            throw InternalError("SampleStore::slice: Invalid range [" + stringify(first) + ", " + stringify(last)
+                    + ") for " + stringify(size()) + " samples");
+
+        SampleStore result(*this);
+        result._imp.reset(new Implementation<SampleStore>(_imp->source, _imp->config,
+                    _imp->first + first, _imp->first + last, _imp->columns));
+
+        return result;
+    }
+
+    SampleStore
+    SampleStore::select(const std::vector<std::string> & names) const
+    {
+        std::vector<unsigned> columns;
+        for (const auto & name : names)
+        {
+            auto d = std::find_if(_imp->descriptions.cbegin(), _imp->descriptions.cend(),
+                    [&name] (const ParameterDescription & d) { return d.parameter->name() == name; });
+            if (_imp->descriptions.cend() == d)
+                throw InternalError("SampleStore::select: Unknown parameter '" + name + "'");
+
+            columns.push_back(_imp->columns[d - _imp->descriptions.cbegin()]);
+        }
+
+        SampleStore result(*this);
+        result._imp.reset(new Implementation<SampleStore>(_imp->source, _imp->config,
+                    _imp->first, _imp->last, columns));
+
+        return result;
+    }
+}
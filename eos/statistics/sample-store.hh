@@ -0,0 +1,213 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_STATISTICS_SAMPLE_STORE_HH
+#define EOS_GUARD_SRC_STATISTICS_SAMPLE_STORE_HH 1
+
+#include <eos/utils/parameters.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Read-only random access to parameter samples stored in an HDF5 file.
+     *
+     * Samples are read in chunks of contiguous rows, and only a small number of
+     * chunks is kept in memory at any time. Rows are handed out as views into
+     * the cached chunks, without copying. Copies of a SampleStore, as well as
+     * slices obtained through slice() and select(), share the underlying file,
+     * and may be used from several threads concurrently.
+     */
+    class SampleStore :
+        public PrivateImplementationPattern<SampleStore>
+    {
+        public:
+            struct Config;
+            class Row;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param file_name        Name of the HDF5 file.
+             * @param data_sets        Names of the data sets which are concatenated to form the store.
+             * @param descriptions     The descriptions of the parameters, in the order in which they appear in each record.
+             * @param record_dimension The number of entries of each record, including non-parameter entries.
+             * @param log_weight       Index of the record entry that holds the log weight; -1 if all samples are equally weighted.
+             * @param config           The configuration options.
+             */
+            SampleStore(const std::string & file_name, const std::vector<std::string> & data_sets,
+                    const std::vector<ParameterDescription> & descriptions, const unsigned & record_dimension,
+                    const int & log_weight, const SampleStore::Config & config);
+
+            /// Destructor.
+            ~SampleStore();
+
+            /*!
+             * Named constructor for samples produced by MarkovChainSampler.
+             *
+             * All chains found in the given group are concatenated.
+             *
+             * @param file_name Name of the HDF5 file.
+             * @param base      The group in which the chains are stored, either "/prerun" or "/main run".
+             * @param config    The configuration options.
+             */
+            static SampleStore MarkovChains(const std::string & file_name, const std::string & base,
+                    const SampleStore::Config & config);
+
+            /*!
+             * Named constructor for samples produced by PopulationMonteCarloSampler.
+             *
+             * @param file_name Name of the HDF5 file.
+             * @param base      The group in which the data set 'samples' is stored.
+             * @param config    The configuration options.
+             */
+            static SampleStore PopulationMonteCarlo(const std::string & file_name, const std::string & base,
+                    const SampleStore::Config & config);
+            ///@}
+
+            ///@name Access
+            ///@{
+            /// Retrieve the number of samples.
+            unsigned size() const;
+
+            /// Retrieve the number of parameters per sample.
+            unsigned dimension() const;
+
+            /// Retrieve the descriptions of the parameters per sample.
+            const std::vector<ParameterDescription> & descriptions() const;
+
+            /// Return true if the samples carry individual weights.
+            bool weighted() const;
+
+            /*!
+             * Retrieve a sample by index.
+             *
+             * @param index The index of the sample, within [0, size()).
+             */
+            Row operator[] (const unsigned & index) const;
+            ///@}
+
+            ///@name Slicing
+            ///@{
+            /*!
+             * Create a view of a contiguous range of samples.
+             *
+             * @param first Index of the first sample.
+             * @param last  Index of one-past the last sample.
+             */
+            SampleStore slice(const unsigned & first, const unsigned & last) const;
+
+            /*!
+             * Create a view of a subset of the parameters.
+             *
+             * @param names The names of the parameters, in the order in which they shall appear in each row.
+             */
+            SampleStore select(const std::vector<std::string> & names) const;
+            ///@}
+    };
+
+    /*!
+     * Store configuration options.
+     */
+    struct SampleStore::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            /// Constructor with the default settings.
+            static Config Default();
+
+            /// The number of samples that are read from the file at once.
+            unsigned chunk_size;
+
+            /// The maximal number of chunks that are kept in memory.
+            unsigned cached_chunks;
+    };
+
+    /*!
+     * A view of one of the samples in a SampleStore.
+     *
+     * The view keeps the underlying chunk alive, and remains valid after
+     * the chunk has been evicted from the cache.
+     */
+    class SampleStore::Row
+    {
+        private:
+            std::shared_ptr<const std::vector<double>> _chunk;
+
+            const double * _data;
+
+            unsigned _size;
+
+            double _log_weight;
+
+        public:
+            friend struct Implementation<SampleStore>;
+
+            Row(const std::shared_ptr<const std::vector<double>> & chunk, const double * data, const unsigned & size,
+                    const double & log_weight) :
+                _chunk(chunk),
+                _data(data),
+                _size(size),
+                _log_weight(log_weight)
+            {
+            }
+
+            /// Retrieve the number of parameters.
+            unsigned size() const
+            {
+                return _size;
+            }
+
+            /// Retrieve the value of the i-th parameter.
+            const double & operator[] (const unsigned & i) const
+            {
+                return _data[i];
+            }
+
+            /// Retrieve the logarithm of the sample's weight, or 0 for unweighted samples.
+            double log_weight() const
+            {
+                return _log_weight;
+            }
+
+            ///@name Iteration
+            ///@{
+            const double * begin() const
+            {
+                return _data;
+            }
+
+            const double * end() const
+            {
+                return _data + _size;
+            }
+            ///@}
+    };
+}
+
+#endif
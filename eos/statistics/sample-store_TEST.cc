@@ -0,0 +1,117 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/analysis.hh>
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/stringify.hh>
+
+using namespace test;
+using namespace eos;
+
+class SampleStoreTest :
+    public TestCase
+{
+    public:
+        SampleStoreTest() :
+            TestCase("sample_store_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const std::string file_name(EOS_BUILDDIR "/eos/statistics/sample-store_TEST.hdf5");
+
+            // create a file in the layout of MarkovChainSampler, with two chains of 7 and 5 samples
+            {
+                auto file = hdf5::File::Create(file_name);
+
+                auto descriptions = file.create_data_set("/descriptions/main run/chain #0/parameters", Analysis::Output::description_type());
+                auto record = Analysis::Output::description_record();
+                std::get<0>(record) = "mass::b(MSbar)"; std::get<1>(record) = 4.0; std::get<2>(record) = 5.0; std::get<3>(record) = 0; std::get<4>(record) = "flat";
+                descriptions << record;
+                std::get<0>(record) = "mass::c"; std::get<1>(record) = 1.0; std::get<2>(record) = 2.0; std::get<3>(record) = 1; std::get<4>(record) = "flat";
+                descriptions << record;
+
+                // row i holds (i, 100 + i, log(posterior))
+                unsigned i = 0;
+                for (unsigned c = 0, n = 7 ; c < 2 ; ++c, n -= 2)
+                {
+                    auto samples = file.create_data_set("/main run/chain #" + stringify(c) + "/samples", hdf5::Array<1, double>("samples", { 3 }));
+                    for (unsigned j = 0 ; j < n ; ++j, ++i)
+                    {
+                        samples << std::vector<double>{ double(i), 100.0 + i, -1.0 * i };
+                    }
+                }
+            }
+
+            // read back in small chunks, crossing chain boundaries
+            {
+                SampleStore::Config config = SampleStore::Config::Default();
+                config.chunk_size = 3;
+                config.cached_chunks = 2;
+
+                SampleStore store = SampleStore::MarkovChains(file_name, "/main run", config);
+                TEST_CHECK_EQUAL(12u, store.size());
+                TEST_CHECK_EQUAL(2u,  store.dimension());
+                TEST_CHECK(! store.weighted());
+                TEST_CHECK_EQUAL("mass::b(MSbar)", store.descriptions()[0].parameter->name());
+                TEST_CHECK_EQUAL("mass::c",        store.descriptions()[1].parameter->name());
+                TEST_CHECK(store.descriptions()[1].nuisance);
+
+                for (unsigned i = 0 ; i < store.size() ; ++i)
+                {
+                    auto row = store[i];
+                    TEST_CHECK_EQUAL(2u, row.size());
+                    TEST_CHECK_EQUAL(double(i),     row[0]);
+                    TEST_CHECK_EQUAL(100.0 + i,     row[1]);
+                    TEST_CHECK_EQUAL(0.0,           row.log_weight());
+                }
+
+                // rows remain valid after their chunk has been evicted
+                auto first = store[0];
+                store[6]; store[9];
+                TEST_CHECK_EQUAL(100.0, first[1]);
+
+                // random access in reverse order
+                for (unsigned i = store.size() ; i > 0 ; --i)
+                {
+                    TEST_CHECK_EQUAL(double(i - 1), store[i - 1][0]);
+                }
+
+                TEST_CHECK_THROWS(InternalError, store[12]);
+
+                // slicing by index range
+                SampleStore slice = store.slice(5, 9);
+                TEST_CHECK_EQUAL(4u, slice.size());
+                TEST_CHECK_EQUAL(5.0,   slice[0][0]);
+                TEST_CHECK_EQUAL(108.0, slice[3][1]);
+                TEST_CHECK_THROWS(InternalError, store.slice(5, 13));
+
+                // slicing by parameter subset
+                SampleStore subset = slice.select({ "mass::c" });
+                TEST_CHECK_EQUAL(4u, subset.size());
+                TEST_CHECK_EQUAL(1u, subset.dimension());
+                TEST_CHECK_EQUAL("mass::c", subset.descriptions()[0].parameter->name());
+                TEST_CHECK_EQUAL(106.0, subset[1][0]);
+                TEST_CHECK_THROWS(InternalError, slice.select({ "mass::t(pole)" }));
+            }
+        }
+} sample_store_test;
@@ -0,0 +1,217 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/t-digest.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/stringify.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace eos
+{
+    namespace
+    {
+        // the scale function k_1, which maps quantiles to the centroid index space
+        inline double k(const double & q, const double & compression)
+        {
+            return compression / (2.0 * M_PI) * std::asin(2.0 * q - 1.0);
+        }
+
+        // the inverse of the scale function k_1
+        inline double k_inverse(const double & k, const double & compression)
+        {
+            if (k >= compression / 4.0)
+                return 1.0;
+
+            return (std::sin(2.0 * M_PI * k / compression) + 1.0) / 2.0;
+        }
+    }
+
+    TDigest::TDigest(const double & compression) :
+        _compression(compression),
+        _total_weight(0.0),
+        _min(std::numeric_limits<double>::infinity()),
+        _max(-std::numeric_limits<double>::infinity())
+    {
+        if (compression < 1.0)
+            throw InternalError("TDigest: compression must be at least 1, but is " + stringify(compression));
+
+        _buffer.reserve(5 * unsigned(compression));
+    }
+
+    void
+    TDigest::_compress() const
+    {
+        if (_buffer.empty())
+            return;
+
+        std::vector<Centroid> centroids;
+        centroids.reserve(_centroids.size() + _buffer.size());
+        centroids.insert(centroids.end(), _centroids.begin(), _centroids.end());
+        centroids.insert(centroids.end(), _buffer.begin(), _buffer.end());
+        _buffer.clear();
+        std::sort(centroids.begin(), centroids.end());
+
+        _centroids.clear();
+
+        // merge neighbouring centroids as long as the merged centroid spans less than one unit in k space
+        double weight_so_far = 0.0;
+        double q_limit = k_inverse(k(0.0, _compression) + 1.0, _compression);
+        Centroid current = centroids.front();
+        for (auto c = centroids.cbegin() + 1, c_end = centroids.cend() ; c != c_end ; ++c)
+        {
+            double q = (weight_so_far + current.weight + c->weight) / _total_weight;
+            if (q <= q_limit)
+            {
+                current.weight += c->weight;
+                current.mean += (c->mean - current.mean) * c->weight / current.weight;
+            }
+            else
+            {
+                _centroids.push_back(current);
+                weight_so_far += current.weight;
+                q_limit = k_inverse(k(weight_so_far / _total_weight, _compression) + 1.0, _compression);
+                current = *c;
+            }
+        }
+        _centroids.push_back(current);
+    }
+
+    void
+    TDigest::add(const double & value, const double & weight)
+    {
+        if (weight <= 0.0)
+            return;
+
+        _buffer.push_back(Centroid{ value, weight });
+        _total_weight += weight;
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+
+        if (_buffer.size() >= 5 * _compression)
+            _compress();
+    }
+
+    void
+    TDigest::merge(const TDigest & other)
+    {
+        // the centroids and the buffer of other are modified while being read
+        if (&other == this)
+        {
+            const TDigest copy(other);
+            merge(copy);
+
+            return;
+        }
+
+        _buffer.insert(_buffer.end(), other._centroids.begin(), other._centroids.end());
+        _buffer.insert(_buffer.end(), other._buffer.begin(), other._buffer.end());
+        _total_weight += other._total_weight;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+
+        if (_buffer.size() >= 5 * _compression)
+            _compress();
+    }
+
+    void
+    TDigest::scale(const double & factor)
+    {
+        if (factor < 0.0)
+            throw InternalError("TDigest: scaling factor must not be negative, but is " + stringify(factor));
+
+        // all weights underflow
+        if (factor == 0.0)
+        {
+            _centroids.clear();
+            _buffer.clear();
+            _total_weight = 0.0;
+
+            return;
+        }
+
+        for (auto & c : _centroids)
+        {
+            c.weight *= factor;
+        }
+
+        for (auto & c : _buffer)
+        {
+            c.weight *= factor;
+        }
+
+        _total_weight *= factor;
+    }
+
+    double
+    TDigest::quantile(const double & q) const
+    {
+        if ((q < 0.0) || (q > 1.0))
+            throw InternalError("TDigest: quantile requested for probability '" + stringify(q) + "' outside [0, 1]");
+
+        _compress();
+
+        if (_centroids.empty())
+            return std::numeric_limits<double>::quiet_NaN();
+
+        if (_centroids.size() == 1)
+            return _centroids.front().mean;
+
+        const double target = q * _total_weight;
+
+        // the left tail, between the minimum and the center of the first centroid
+        const Centroid & first = _centroids.front();
+        if (target < first.weight / 2.0)
+            return _min + (first.mean - _min) * target / (first.weight / 2.0);
+
+        // the right tail, between the center of the last centroid and the maximum
+        const Centroid & last = _centroids.back();
+        if (target > _total_weight - last.weight / 2.0)
+            return _max - (_max - last.mean) * (_total_weight - target) / (last.weight / 2.0);
+
+        // interpolate linearly between the centers of adjacent centroids
+        double weight_so_far = first.weight / 2.0;
+        for (auto c = _centroids.cbegin(), c_end = _centroids.cend() - 1 ; c != c_end ; ++c)
+        {
+            const double step = (c->weight + (c + 1)->weight) / 2.0;
+            if (weight_so_far + step >= target)
+                return c->mean + ((c + 1)->mean - c->mean) * (target - weight_so_far) / step;
+
+            weight_so_far += step;
+        }
+
+        return last.mean;
+    }
+
+    unsigned
+    TDigest::number_of_centroids() const
+    {
+        _compress();
+
+        return _centroids.size();
+    }
+
+    double
+    TDigest::total_weight() const
+    {
+        return _total_weight;
+    }
+}
@@ -0,0 +1,100 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_STATISTICS_T_DIGEST_HH
+#define EOS_GUARD_EOS_STATISTICS_T_DIGEST_HH 1
+
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Approximate the quantiles of a stream of weighted values in bounded memory,
+     * using the merging t-digest of Dunning and Ertl, cf. arXiv:1902.04023.
+     *
+     * The values are clustered into centroids, whose maximal size shrinks towards
+     * the tails of the distribution. Digests of disjoint parts of a stream can be
+     * merged.
+     */
+    class TDigest
+    {
+        private:
+            struct Centroid
+            {
+                double mean;
+
+                double weight;
+
+                bool operator< (const Centroid & other) const
+                {
+                    return mean < other.mean;
+                }
+            };
+
+            double _compression;
+
+            mutable std::vector<Centroid> _centroids;
+
+            mutable std::vector<Centroid> _buffer;
+
+            double _total_weight;
+
+            double _min, _max;
+
+            // merge the buffered values into the centroids
+            void _compress() const;
+
+        public:
+            /*!
+             * Constructor.
+             *
+             * @param compression The compression parameter delta. The number of centroids is bounded by approximately delta.
+             */
+            TDigest(const double & compression = 100.0);
+
+            /*!
+             * Add a weighted value.
+             *
+             * @param value  The value.
+             * @param weight The (non-negative) weight of the value.
+             */
+            void add(const double & value, const double & weight = 1.0);
+
+            /// Merge the contents of another digest into this one.
+            void merge(const TDigest & other);
+
+            /// Multiply all weights by a non-negative factor.
+            void scale(const double & factor);
+
+            /*!
+             * Estimate a quantile.
+             *
+             * @param q The cumulative probability, within [0, 1].
+             */
+            double quantile(const double & q) const;
+
+            /// Retrieve the number of centroids.
+            unsigned number_of_centroids() const;
+
+            /// Retrieve the sum of all weights.
+            double total_weight() const;
+    };
+}
+
+#endif
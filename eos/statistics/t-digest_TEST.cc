@@ -0,0 +1,123 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/statistics/t-digest.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+class TDigestTest :
+    public TestCase
+{
+    public:
+        TDigestTest() :
+            TestCase("t_digest_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // uniformly spaced values in [0, 1), added in a scrambled order
+            static const unsigned n = 100000;
+            auto value = [] (const unsigned & i) { return ((i * 7919u) % n + 0.5) / n; };
+
+            // quantiles of a uniform distribution
+            {
+                TDigest d(100.0);
+                for (unsigned i = 0 ; i < n ; ++i)
+                {
+                    d.add(value(i));
+                }
+
+                TEST_CHECK_NEARLY_EQUAL(d.total_weight(), double(n), 1e-8);
+                TEST_CHECK(d.number_of_centroids() <= 100u);
+
+                for (double q : { 0.001, 0.025, 0.16, 0.5, 0.84, 0.975, 0.999 })
+                {
+                    TEST_CHECK_NEARLY_EQUAL(d.quantile(q), q, 1e-3);
+                }
+
+                TEST_CHECK_NEARLY_EQUAL(d.quantile(0.0), 0.5 / n,       1e-14);
+                TEST_CHECK_NEARLY_EQUAL(d.quantile(1.0), 1.0 - 0.5 / n, 1e-14);
+            }
+
+            // merging digests of disjoint parts of the stream
+            {
+                TDigest d1(100.0), d2(100.0);
+                for (unsigned i = 0 ; i < n ; ++i)
+                {
+                    (i % 3 == 0 ? d1 : d2).add(value(i));
+                }
+                d1.merge(d2);
+
+                TEST_CHECK_NEARLY_EQUAL(d1.total_weight(), double(n), 1e-8);
+                for (double q : { 0.025, 0.16, 0.5, 0.84, 0.975 })
+                {
+                    TEST_CHECK_NEARLY_EQUAL(d1.quantile(q), q, 1e-3);
+                }
+            }
+
+            // merging a digest with itself doubles all weights, but leaves the quantiles unchanged
+            {
+                TDigest d(100.0);
+                for (unsigned i = 0 ; i < n ; ++i)
+                {
+                    d.add(value(i));
+                }
+                d.merge(d);
+
+                TEST_CHECK_NEARLY_EQUAL(d.total_weight(), 2.0 * n, 1e-8);
+                for (double q : { 0.025, 0.16, 0.5, 0.84, 0.975 })
+                {
+                    TEST_CHECK_NEARLY_EQUAL(d.quantile(q), q, 1e-3);
+                }
+            }
+
+            // weighted values: a density proportional to x on [0, 1], with quantiles sqrt(q)
+            {
+                TDigest d(200.0);
+                for (unsigned i = 0 ; i < n ; ++i)
+                {
+                    d.add(value(i), value(i));
+                }
+
+                for (double q : { 0.025, 0.16, 0.5, 0.84, 0.975 })
+                {
+                    TEST_CHECK_NEARLY_EQUAL(d.quantile(q), std::sqrt(q), 2e-3);
+                }
+
+                // rescaling all weights leaves the quantiles unchanged
+                const double median = d.quantile(0.5);
+                d.scale(1e-3);
+                TEST_CHECK_NEARLY_EQUAL(d.total_weight(), n / 2.0 * 1e-3, 1e-8);
+                TEST_CHECK_NEARLY_EQUAL(d.quantile(0.5), median, 1e-12);
+            }
+
+            // a single value
+            {
+                TDigest d;
+                d.add(3.0);
+                TEST_CHECK_EQUAL(d.quantile(0.5), 3.0);
+                TEST_CHECK_THROWS(InternalError, d.quantile(1.5));
+            }
+        }
+} t_digest_test;
@@ -0,0 +1,198 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/utils/background-writer.hh>
+#include <eos/utils/condition_variable.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/thread.hh>
+
+#include <algorithm>
+#include <exception>
+#include <list>
+
+namespace eos
+{
+    template <>
+    struct Implementation<BackgroundWriter>
+    {
+        Mutex mutex;
+
+        // signalled when a task is submitted, or when the thread shall terminate
+        ConditionVariable task_arrival;
+
+        // signalled when a task has been executed
+        ConditionVariable task_completion;
+
+        // signalled when a task has been taken from the queue
+        ConditionVariable task_departure;
+
+        std::list<BackgroundWriter::Task> queue;
+
+        // the maximal number of tasks in the queue
+        unsigned capacity;
+
+        // is a task currently being executed?
+        bool busy;
+
+        bool terminate;
+
+        // the first failure since the last flush
+        std::exception_ptr failure;
+
+        Thread * thread;
+
+        void thread_function()
+        {
+            do
+            {
+                BackgroundWriter::Task task;
+
+                {
+                    Lock l(mutex);
+
+                    while (queue.empty() && ! terminate)
+                        task_arrival.wait(mutex);
+
+                    // only terminate once all pending tasks have been executed
+                    if (queue.empty())
+                        break;
+
+                    task = queue.front();
+                    queue.pop_front();
+                    busy = true;
+                    task_departure.signal();
+                }
+
+                std::exception_ptr task_failure;
+                try
+                {
+                    task();
+                }
+                catch (...)
+                {
+                    task_failure = std::current_exception();
+                }
+
+                {
+                    Lock l(mutex);
+
+                    if (task_failure && ! failure)
+                        failure = task_failure;
+
+                    busy = false;
+                    task_completion.broadcast();
+                }
+            }
+            while (true);
+        }
+
+        Implementation(const unsigned & capacity) :
+            capacity(std::max(capacity, 1u)),
+            busy(false),
+            terminate(false),
+            thread(nullptr)
+        {
+            thread = new Thread(std::bind(&Implementation<BackgroundWriter>::thread_function, this));
+        }
+
+        ~Implementation()
+        {
+            {
+                Lock l(mutex);
+                terminate = true;
+                task_arrival.broadcast();
+            }
+
+            // joins the thread after all pending tasks have been executed
+            delete thread;
+
+            if (! failure)
+                return;
+
+            try
+            {
+                std::rethrow_exception(failure);
+            }
+            catch (std::exception & e)
+            {
+                Log::instance()->message("background_writer.dtor", ll_error)
+                    << "Output task failed: " << e.what();
+            }
+            catch (...)
+            {
+                Log::instance()->message("background_writer.dtor", ll_error)
+                    << "Output task failed with an unknown exception";
+            }
+        }
+
+        void enqueue(const BackgroundWriter::Task & task)
+        {
+            Lock l(mutex);
+
+            // hold back the caller until the writer catches up
+            while (queue.size() >= capacity)
+                task_departure.wait(mutex);
+
+            queue.push_back(task);
+            task_arrival.signal();
+        }
+
+        void flush()
+        {
+            std::exception_ptr result;
+
+            {
+                Lock l(mutex);
+
+                while (busy || ! queue.empty())
+                    task_completion.wait(mutex);
+
+                std::swap(result, failure);
+            }
+
+            if (result)
+                std::rethrow_exception(result);
+        }
+    };
+
+    BackgroundWriter::BackgroundWriter(const unsigned & capacity) :
+        PrivateImplementationPattern<BackgroundWriter>(new Implementation<BackgroundWriter>(capacity))
+    {
+    }
+
+    BackgroundWriter::~BackgroundWriter()
+    {
+    }
+
+    void
+    BackgroundWriter::enqueue(const Task & task)
+    {
+        _imp->enqueue(task);
+    }
+
+    void
+    BackgroundWriter::flush()
+    {
+        _imp->flush();
+    }
+}
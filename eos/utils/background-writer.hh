@@ -0,0 +1,85 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_UTILS_BACKGROUND_WRITER_HH
+#define EOS_GUARD_SRC_UTILS_BACKGROUND_WRITER_HH 1
+
+#include <eos/utils/instantiation_policy.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <functional>
+
+namespace eos
+{
+    /**
+     * BackgroundWriter executes output tasks, e.g. writing to an HDF5 file,
+     * in a dedicated thread, so that the caller can carry on with its computations.
+     *
+     * The tasks are executed one after another in the order of their submission.
+     * Since they run concurrently with the caller, a task must not refer to
+     * any data that the caller might modify in the meantime, but rather work on copies.
+     * The number of pending tasks is bounded, so that callers which produce output
+     * faster than it can be written are held back.
+     */
+    class BackgroundWriter :
+        public InstantiationPolicy<BackgroundWriter, NonCopyable>,
+        public PrivateImplementationPattern<BackgroundWriter>
+    {
+        public:
+            /// Our task type.
+            typedef std::function<void ()> Task;
+
+            /// \name Constructor and destructor
+            /// \{
+
+            /**
+             * Constructor.
+             *
+             * \param capacity The maximal number of tasks that are pending at any time.
+             */
+            BackgroundWriter(const unsigned & capacity = 16);
+
+            /**
+             * Destructor.
+             *
+             * Waits for all pending tasks. Failures of these tasks are logged, but not rethrown.
+             */
+            ~BackgroundWriter();
+
+            /// \}
+
+            /**
+             * Submit a task for execution after all previously submitted tasks.
+             *
+             * Blocks while the maximal number of tasks is pending. Must not be called from within a task.
+             *
+             * \param task The task.
+             */
+            void enqueue(const Task & task);
+
+            /**
+             * Wait until all submitted tasks have been executed.
+             *
+             * Rethrows the exception of the first task that failed since the last call to flush().
+             */
+            void flush();
+    };
+}
+
+#endif
@@ -0,0 +1,144 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/background-writer.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/thread.hh>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace test;
+using namespace eos;
+
+class BackgroundWriterTest :
+    public TestCase
+{
+    public:
+        BackgroundWriterTest() :
+            TestCase("background_writer_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            // tasks are executed in the order of their submission
+            {
+                std::vector<unsigned> results;
+
+                BackgroundWriter writer;
+                for (unsigned i = 0 ; i < 1000 ; ++i)
+                {
+                    writer.enqueue([&results, i] () { results.push_back(i); });
+                }
+                writer.flush();
+
+                TEST_CHECK_EQUAL(1000u, results.size());
+                for (unsigned i = 0 ; i < results.size() ; ++i)
+                {
+                    TEST_CHECK_EQUAL(i, results[i]);
+                }
+
+                // the writer remains usable after a flush
+                writer.enqueue([&results] () { results.push_back(1000); });
+                writer.flush();
+                TEST_CHECK_EQUAL(1001u, results.size());
+            }
+
+            // the destructor waits for all pending tasks
+            {
+                std::vector<unsigned> results;
+
+                {
+                    BackgroundWriter writer;
+                    for (unsigned i = 0 ; i < 100 ; ++i)
+                    {
+                        writer.enqueue([&results, i] () { results.push_back(i); });
+                    }
+                }
+
+                TEST_CHECK_EQUAL(100u, results.size());
+            }
+
+            // failures are rethrown by the next flush, and do not affect later tasks
+            {
+                unsigned count = 0;
+
+                BackgroundWriter writer;
+                writer.enqueue([&count] () { ++count; });
+                writer.enqueue([] () { throw InternalError("first failure"); });
+                writer.enqueue([] () { throw InternalError("second failure"); });
+                writer.enqueue([&count] () { ++count; });
+
+                try
+                {
+                    writer.flush();
+                    TEST_CHECK_FAILED("flush() did not rethrow the failure");
+                }
+                catch (InternalError & e)
+                {
+                    TEST_CHECK_EQUAL(std::string("Internal Error: first failure"), std::string(e.what()));
+                }
+                TEST_CHECK_EQUAL(2u, count);
+
+                writer.flush();
+            }
+
+            // submission blocks while the maximal number of tasks is pending
+            {
+                std::vector<unsigned> results;
+                std::atomic<bool> released(false), submitted(false);
+
+                BackgroundWriter writer(2);
+                writer.enqueue([&results, &released] ()
+                {
+                    while (! released)
+                        std::this_thread::yield();
+
+                    results.push_back(0);
+                });
+                writer.enqueue([&results] () { results.push_back(1); });
+                writer.enqueue([&results] () { results.push_back(2); });
+
+                {
+                    Thread producer([&writer, &results, &submitted] ()
+                    {
+                        writer.enqueue([&results] () { results.push_back(3); });
+                        submitted = true;
+                    });
+
+                    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                    TEST_CHECK(! submitted);
+
+                    released = true;
+                }
+                TEST_CHECK(submitted);
+
+                writer.flush();
+                TEST_CHECK_EQUAL(4u, results.size());
+                for (unsigned i = 0 ; i < results.size() ; ++i)
+                {
+                    TEST_CHECK_EQUAL(i, results[i]);
+                }
+            }
+        }
+} background_writer_test;
@@ -23,14 +23,101 @@
 #include <eos/observable.hh>
 #include <eos/utils/apply.hh>
 #include <eos/utils/join.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/tuple-maker.hh>
 
 #include <array>
 #include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 namespace eos
 {
+    namespace impl
+    {
+        /*
+         * A decay depends only on the Parameters and Options it is constructed from. All observables
+         * of one decay that use the same Parameters object and identical Options share a single
+         * instance of the decay. This keeps the creation and cloning of many observables cheap.
+         */
+        template <typename Decay_>
+        class SharedDecays
+        {
+            private:
+                struct Entry
+                {
+                    Parameters parameters;
+
+                    Options options;
+
+                    const Decay_ * decay;
+
+                    std::weak_ptr<const Decay_> handle;
+                };
+
+                Mutex _mutex;
+
+                // <hash of options, entry>
+                std::unordered_multimap<std::size_t, Entry> _entries;
+
+                static SharedDecays & instance()
+                {
+                    // never destroyed, since decays might outlive any static object
+                    static SharedDecays * result = new SharedDecays;
+
+                    return *result;
+                }
+
+                void release(const std::size_t & hash, const Decay_ * decay)
+                {
+                    {
+                        Lock l(_mutex);
+
+                        auto range = _entries.equal_range(hash);
+                        for (auto e = range.first ; e != range.second ; ++e)
+                        {
+                            if (e->second.decay != decay)
+                                continue;
+
+                            _entries.erase(e);
+                            break;
+                        }
+                    }
+
+                    delete decay;
+                }
+
+            public:
+                static std::shared_ptr<const Decay_> get(const Parameters & parameters, const Options & options)
+                {
+                    SharedDecays & self = instance();
+                    const std::size_t hash = options.hash();
+
+                    Lock l(self._mutex);
+
+                    auto range = self._entries.equal_range(hash);
+                    for (auto e = range.first ; e != range.second ; ++e)
+                    {
+                        if ((e->second.parameters != parameters) || ! (e->second.options == options))
+                            continue;
+
+                        // the entry might be expired, but not yet released
+                        std::shared_ptr<const Decay_> result = e->second.handle.lock();
+                        if (result)
+                            return result;
+                    }
+
+                    const Decay_ * decay = new Decay_(parameters, options);
+                    std::shared_ptr<const Decay_> result(decay, [hash] (const Decay_ * d) { instance().release(hash, d); });
+                    self._entries.insert(std::make_pair(hash, Entry{ parameters, options, decay, result }));
+
+                    return result;
+                }
+        };
+    }
+
     template <typename Decay_, typename ... Args_>
     class ConcreteObservable :
         public Observable
@@ -46,7 +133,7 @@ namespace eos
 
             Options _options;
 
-            Decay_ _decay;
+            std::shared_ptr<const Decay_> _decay;
 
             std::function<double (const Decay_ *, const Args_ & ...)> _function;
 
@@ -65,12 +152,12 @@ namespace eos
                 _parameters(parameters),
                 _kinematics(kinematics),
                 _options(options),
-                _decay(parameters, options),
+                _decay(impl::SharedDecays<Decay_>::get(parameters, options)),
                 _function(function),
                 _kinematics_names(kinematics_names),
-                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, &_decay))
+                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, _decay.get()))
             {
-                uses(_decay);
+                uses(*_decay);
             }
 
             virtual const QualifiedName & name() const
@@ -183,7 +270,7 @@ namespace eos
 
             Options _options;
 
-            Decay_ _decay;
+            std::shared_ptr<const Decay_> _decay;
 
             std::function<double (const Decay_ *, const Args_ & ...)> _numerator, _denominator;
 
@@ -203,13 +290,13 @@ namespace eos
                 _parameters(parameters),
                 _kinematics(kinematics),
                 _options(options),
-                _decay(parameters, options),
+                _decay(impl::SharedDecays<Decay_>::get(parameters, options)),
                 _numerator(numerator),
                 _denominator(denominator),
                 _kinematics_names(kinematics_names),
-                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, &_decay))
+                _argument_tuple(impl::TupleMaker<sizeof...(Args_)>::make(_kinematics, _kinematics_names, _decay.get()))
             {
-                uses(_decay);
+                uses(*_decay);
             }
 
             ~ConcreteObservableRatio() = default;
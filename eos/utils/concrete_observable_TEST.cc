@@ -0,0 +1,126 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/concrete_observable.hh>
+#include <eos/utils/kinematic.hh>
+
+#include <memory>
+
+using namespace test;
+using namespace eos;
+
+namespace
+{
+    // counts its live instances
+    struct CountingDecay :
+        public ParameterUser
+    {
+        static int instances;
+
+        UsedParameter m_c;
+
+        CountingDecay(const Parameters & p, const Options &) :
+            m_c(p["mass::c"], *this)
+        {
+            ++instances;
+        }
+
+        ~CountingDecay()
+        {
+            --instances;
+        }
+
+        double linear(const double & q2) const
+        {
+            return m_c * q2;
+        }
+    };
+
+    int CountingDecay::instances = 0;
+}
+
+class ConcreteObservableTest :
+    public TestCase
+{
+    public:
+        ConcreteObservableTest() :
+            TestCase("concrete_observable_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            std::unique_ptr<ObservableEntry> entry(make_concrete_observable_entry<CountingDecay>(QualifiedName("Test::linear"),
+                    &CountingDecay::linear, std::make_tuple("q2")));
+
+            Parameters p = Parameters::Defaults();
+            p["mass::c"] = 1.5;
+
+            Kinematics k1{ { "q2", 1.0 } }, k2{ { "q2", 2.0 } };
+
+            {
+                // observables on the same Parameters and with identical Options share one decay
+                ObservablePtr o1 = entry->make(p, k1, Options());
+                ObservablePtr o2 = entry->make(p, k2, Options());
+                TEST_CHECK_EQUAL(1, CountingDecay::instances);
+                TEST_CHECK_EQUAL(1.5, o1->evaluate());
+                TEST_CHECK_EQUAL(3.0, o2->evaluate());
+
+                // different Options require a separate decay
+                ObservablePtr o3 = entry->make(p, k2, Options{ { "model", "SM" } });
+                TEST_CHECK_EQUAL(2, CountingDecay::instances);
+                TEST_CHECK_EQUAL(3.0, o3->evaluate());
+
+                // clones on cloned Parameters share one separate decay
+                Parameters q = p.clone();
+                ObservablePtr c1 = o1->clone(q);
+                ObservablePtr c2 = o2->clone(q);
+                TEST_CHECK_EQUAL(3, CountingDecay::instances);
+
+                // ... and follow their own parameters only
+                q["mass::c"] = 2.0;
+                TEST_CHECK_EQUAL(2.0, c1->evaluate());
+                TEST_CHECK_EQUAL(4.0, c2->evaluate());
+                TEST_CHECK_EQUAL(1.5, o1->evaluate());
+                TEST_CHECK_EQUAL(3.0, o2->evaluate());
+
+                p["mass::c"] = 1.0;
+                TEST_CHECK_EQUAL(2.0, o2->evaluate());
+                TEST_CHECK_EQUAL(2.0, o3->evaluate());
+                TEST_CHECK_EQUAL(4.0, c2->evaluate());
+
+                // a decay lives as long as any of its observables
+                o1.reset();
+                TEST_CHECK_EQUAL(3, CountingDecay::instances);
+                TEST_CHECK_EQUAL(2.0, o2->evaluate());
+
+                o2.reset();
+                TEST_CHECK_EQUAL(2, CountingDecay::instances);
+
+                // a new observable on the same Parameters gets a new decay
+                ObservablePtr o4 = entry->make(p, k1, Options());
+                TEST_CHECK_EQUAL(3, CountingDecay::instances);
+                TEST_CHECK_EQUAL(1.0, o4->evaluate());
+            }
+
+            // all decays are freed together with their last observable
+            TEST_CHECK_EQUAL(0, CountingDecay::instances);
+        }
+} concrete_observable_test;
@@ -30,6 +30,12 @@ namespace eos
     {
     }
 
+    bool
+    Density::gradient(std::vector<double> &) const
+    {
+        return false;
+    }
+
     void
     Density::dump_descriptions(hdf5::File & file, const std::string & data_set_base) const
     {
@@ -27,6 +27,8 @@
 #include <eos/utils/parameters.hh> // todo move ParameterDescription elsewhere and remove include
 #include <eos/utils/wrapped_forward_iterator.hh>
 
+#include <vector>
+
 namespace eos
 {
     /*!
@@ -46,6 +48,16 @@ namespace eos
             /// Create an independent copy of this density function.
             virtual DensityPtr clone() const = 0;
 
+            /*!
+             * Compute the gradient of the density function on the _log_ scale
+             * at the current parameter point, if known analytically.
+             *
+             * @param gradient The derivatives with respect to the parameters, in the order of iteration.
+             *
+             * @return false if the density function does not provide an analytic gradient.
+             */
+            virtual bool gradient(std::vector<double> & gradient) const;
+
             /// Iterate over the parameters relevant to this density function.
             ///@{
             struct IteratorTag;
@@ -0,0 +1,43 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_UTILS_HASH_HH
+#define EOS_GUARD_EOS_UTILS_HASH_HH 1
+
+#include <cstddef>
+#include <functional>
+
+namespace eos
+{
+    /*!
+     * Combine a hash value with the hash of a further value.
+     *
+     * The result depends on the order in which the values are combined.
+     *
+     * @param seed  The hash value so far.
+     * @param value The value whose hash shall be combined with the seed.
+     */
+    template <typename T_>
+    std::size_t hash_combine(const std::size_t & seed, const T_ & value)
+    {
+        return seed ^ (std::hash<T_>()(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+    }
+}
+
+#endif
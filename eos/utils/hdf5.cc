@@ -24,6 +24,8 @@
 #include <eos/utils/log.hh>
 #include <eos/utils/stringify.hh>
 
+#include <algorithm>
+
 #include <hdf5.h>
 
 namespace eos
@@ -33,6 +35,51 @@ namespace eos
     {
     }
 
+    namespace
+    {
+        struct ObjectList
+        {
+            std::string base;
+
+            H5I_type_t type;
+
+            std::vector<std::string> names;
+        };
+
+        herr_t list_object(hid_t group_id, const char * name, const H5L_info_t *, void * data)
+        {
+            ObjectList & list = *static_cast<ObjectList *>(data);
+
+            hid_t object_id = H5Oopen(group_id, name, H5P_DEFAULT);
+            if (H5I_INVALID_HID == object_id)
+                return -1;
+
+            if (list.type == H5Iget_type(object_id))
+                list.names.push_back(list.base + name);
+
+            H5Oclose(object_id);
+
+            return 0;
+        }
+
+        // list all objects of the given type below a group, with parents preceding their members
+        std::vector<std::string> list_objects(const hid_t & file_id, const std::string & name, const H5I_type_t & type)
+        {
+            hid_t group_id = H5Gopen2(file_id, name.c_str(), H5P_DEFAULT);
+            if (H5I_INVALID_HID == group_id)
+                throw HDF5Error("H5Gopen2 failed to open '" + name + "' and returned " + stringify(group_id));
+
+            ObjectList list{ ('/' == name.back()) ? name : name + "/", type, std::vector<std::string>() };
+            herr_t ret = H5Lvisit(group_id, H5_INDEX_NAME, H5_ITER_INC, &list_object, &list);
+            H5Gclose(group_id);
+
+            if (0 > ret)
+                throw HDF5Error("H5Lvisit failed for '" + name + "' and returned " + stringify(ret));
+
+            return list.names;
+        }
+    }
+
     template <> struct Implementation<hdf5::FileHandle>
     {
         const hid_t file_id;
@@ -296,6 +343,48 @@ namespace eos
             H5Dread(_imp->data_set_id, _imp->type_id, _imp->space_id_memory_element, _imp->space_id_file, H5P_DEFAULT, buffer);
         }
 
+        void
+        DataSetHandle::read_many(hsize_t count, void * buffer)
+        {
+            hid_t space_id_memory = H5Screate_simple(1, &count, 0);
+            herr_t ret = H5Dread(_imp->data_set_id, _imp->type_id, space_id_memory, _imp->space_id_file, H5P_DEFAULT, buffer);
+            H5Sclose(space_id_memory);
+
+            if (0 > ret)
+                throw HDF5Error("H5Dread failed and returned " + stringify(ret));
+        }
+
+        void
+        DataSetHandle::write_many(hsize_t start, hsize_t count, const void * buffer)
+        {
+            if (start + count >= _imp->capacity)
+            {
+                hsize_t new_capacity = start + count + 1000;
+                hsize_t max_capacity = H5S_UNLIMITED;
+
+                herr_t ret = H5Sset_extent_simple(_imp->space_id_file, 1, &new_capacity, &max_capacity);
+                if (0 > ret)
+                    throw HDF5Error("H5Sset_extent_simple failed and returned " + stringify(ret));
+
+                ret = H5Dset_extent(_imp->data_set_id, &new_capacity);
+                if (0 > ret)
+                    throw HDF5Error("H5Dset_extent failed and returned " + stringify(ret));
+
+                _imp->capacity = new_capacity;
+            }
+
+            select(start, count);
+
+            hid_t space_id_memory = H5Screate_simple(1, &count, 0);
+            herr_t ret = H5Dwrite(_imp->data_set_id, _imp->type_id, space_id_memory, _imp->space_id_file, H5P_DEFAULT, buffer);
+            H5Sclose(space_id_memory);
+
+            if (0 > ret)
+                throw HDF5Error("H5Dwrite failed and returned " + stringify(ret));
+
+            _imp->size = std::max(_imp->size, start + count);
+        }
+
         AttributeHandle
         DataSetHandle::create_attribute(const std::string & name, const hid_t & type_id)
         {
@@ -524,5 +613,66 @@ namespace eos
 
             return info.nlinks;
         }
+
+        std::vector<std::string>
+        File::groups(const std::string & name)
+        {
+            return list_objects(_handle.id(), name, H5I_GROUP);
+        }
+
+        std::vector<std::string>
+        File::data_sets(const std::string & name)
+        {
+            return list_objects(_handle.id(), name, H5I_DATASET);
+        }
+
+        void
+        File::remove(const std::string & name)
+        {
+            herr_t ret = H5Ldelete(_handle.id(), name.c_str(), H5P_DEFAULT);
+            if (0 > ret)
+                throw HDF5Error("H5Ldelete failed to remove '" + name + "' and returned " + stringify(ret));
+        }
+
+        unsigned
+        File::records(const std::string & name)
+        {
+            hid_t set_id = H5Dopen2(_handle.id(), name.c_str(), H5P_DEFAULT);
+            if (H5I_INVALID_HID == set_id)
+                throw HDF5Error("H5Dopen2 failed to open '" + name + "' and returned " + stringify(set_id));
+
+            hid_t space_id = H5Dget_space(set_id);
+            hsize_t size = 0;
+            const bool valid = (H5I_INVALID_HID != space_id) && (1 == H5Sget_simple_extent_ndims(space_id))
+                && (0 < H5Sget_simple_extent_dims(space_id, &size, 0));
+
+            if (H5I_INVALID_HID != space_id)
+                H5Sclose(space_id);
+            H5Dclose(set_id);
+
+            if (! valid)
+                throw HDF5Error("Cannot determine the number of records in data set '" + name + "'");
+
+            return size;
+        }
+
+        void
+        File::truncate(const std::string & name, const unsigned & records)
+        {
+            if (records > this->records(name))
+                throw HDF5Error("Cannot truncate data set '" + name + "' to " + stringify(records) + " records, since it holds only "
+                        + stringify(this->records(name)));
+
+            hid_t set_id = H5Dopen2(_handle.id(), name.c_str(), H5P_DEFAULT);
+            if (H5I_INVALID_HID == set_id)
+                throw HDF5Error("H5Dopen2 failed to open '" + name + "' and returned " + stringify(set_id));
+
+            hsize_t size = records;
+            herr_t ret = H5Dset_extent(set_id, &size);
+            H5Dclose(set_id);
+
+            if (0 > ret)
+                throw HDF5Error("H5Dset_extent failed for '" + name + "' and returned " + stringify(ret));
+        }
     }
 }
@@ -384,6 +384,10 @@ namespace eos
 
                 void read_one(void * buffer);
 
+                void read_many(hsize_t count, void * buffer);
+
+                void write_many(hsize_t start, hsize_t count, const void * buffer);
+
                 AttributeHandle create_attribute(const std::string & name, const hid_t & type_id);
 
                 AttributeHandle open_attribute(const std::string & name, const hid_t & type_id);
@@ -534,6 +538,46 @@ namespace eos
 
                 /// List how many objects, i.e. groups or data sets, are in a subdirectory.
                 unsigned number_of_objects(const std::string & name);
+
+                /*!
+                 * List the absolute names of all groups below a group, recursively.
+                 * Each group precedes its subgroups.
+                 *
+                 * @param name Name of the group whose subgroups shall be listed.
+                 */
+                std::vector<std::string> groups(const std::string & name);
+
+                /*!
+                 * List the absolute names of all data sets below a group, recursively.
+                 *
+                 * @param name Name of the group whose data sets shall be listed.
+                 */
+                std::vector<std::string> data_sets(const std::string & name);
+
+                /*!
+                 * Remove a group or a data set. All objects below a removed group are removed as well.
+                 *
+                 * @param name Name of the object that shall be removed.
+                 */
+                void remove(const std::string & name);
+                ///@}
+
+                ///@name Type-independent Data Set Operations
+                ///@{
+                /*!
+                 * Retrieve the number of records in a data set, regardless of its type.
+                 *
+                 * @param name Name of the data set.
+                 */
+                unsigned records(const std::string & name);
+
+                /*!
+                 * Discard all records of a data set beyond a given number.
+                 *
+                 * @param name    Name of the data set.
+                 * @param records Number of records that shall be kept.
+                 */
+                void truncate(const std::string & name, const unsigned & records);
                 ///@}
         };
 
@@ -625,6 +669,44 @@ namespace eos
                     _index = index;
                 }
 
+                /// Size of one record in its HDF5 representation, in bytes.
+                unsigned record_size() const
+                {
+                    return _type->size();
+                }
+
+                /*!
+                 * Retrieve a contiguous range of records in their HDF5 representation.
+                 *
+                 * No conversion takes place. This is only useful for types whose HDF5
+                 * representation coincides with the in-memory one, e.g. Array<1, double>.
+                 *
+                 * @param first  Index of the first record that shall be retrieved.
+                 * @param count  Number of records that shall be retrieved.
+                 * @param buffer Memory of at least count * record_size() bytes.
+                 */
+                void read(const unsigned & first, const unsigned & count, void * buffer)
+                {
+                    _handle.select(first, count);
+                    _handle.read_many(count, buffer);
+                }
+
+                /*!
+                 * Store a contiguous range of records in their HDF5 representation.
+                 *
+                 * As for read(), no conversion takes place. Writing beyond the last record
+                 * extends the data set; any records skipped in the process are expected to
+                 * be written later on.
+                 *
+                 * @param first  Index of the first record that shall be stored.
+                 * @param count  Number of records that shall be stored.
+                 * @param buffer Memory of at least count * record_size() bytes.
+                 */
+                void write(const unsigned & first, const unsigned & count, const void * buffer)
+                {
+                    _handle.write_many(first, count, buffer);
+                }
+
                 ///@}
 
                 ///@name Attribute Access
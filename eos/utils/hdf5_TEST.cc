@@ -128,6 +128,71 @@ class HDF5FileTest :
                 data_set >> record;
                 TEST_CHECK_EQUAL(-17.0, std::get<0>(record));
             }
+
+            // store ranges of records out of order
+            {
+                hdf5::File file = hdf5::File::Open(filename, H5F_ACC_RDWR);
+
+                const hdf5::Array<1, double> array_type("array", { 2 });
+                {
+                    auto data_set = file.create_data_set("/data/2/arrays", array_type);
+
+                    const std::vector<double> second{ 4.0, 5.0, 6.0, 7.0 };
+                    data_set.write(2, 2, second.data());
+                    TEST_CHECK_EQUAL(data_set.records(), 4);
+
+                    const std::vector<double> first{ 0.0, 1.0, 2.0, 3.0 };
+                    data_set.write(0, 2, first.data());
+                    TEST_CHECK_EQUAL(data_set.records(), 4);
+                }
+                {
+                    auto data_set = file.open_data_set("/data/2/arrays", array_type);
+                    TEST_CHECK_EQUAL(data_set.records(), 4);
+
+                    std::vector<double> values(8);
+                    data_set.read(0, 4, values.data());
+                    for (unsigned i = 0 ; i < 8 ; ++i)
+                    {
+                        TEST_CHECK_EQUAL(double(i), values[i]);
+                    }
+                }
+            }
+
+            // list, truncate and remove objects regardless of their type
+            {
+                hdf5::File file = hdf5::File::Open(filename, H5F_ACC_RDWR);
+
+                TEST_CHECK(file.groups("/") == (std::vector<std::string>{ "/data", "/data/1", "/data/2" }));
+                TEST_CHECK(file.data_sets("/") == (std::vector<std::string>{ "/data/1/components", "/data/2/arrays" }));
+                TEST_CHECK(file.data_sets("/data/2") == (std::vector<std::string>{ "/data/2/arrays" }));
+
+                TEST_CHECK_EQUAL(file.records("/data/1/components"), 2);
+                TEST_CHECK_EQUAL(file.records("/data/2/arrays"), 4);
+
+                file.truncate("/data/2/arrays", 3);
+                TEST_CHECK_EQUAL(file.records("/data/2/arrays"), 3);
+                TEST_CHECK_THROWS(HDF5Error, file.truncate("/data/2/arrays", 4));
+
+                // appending continues after the last remaining record
+                {
+                    auto data_set = file.open_data_set("/data/2/arrays", hdf5::Array<1, double>("array", { 2 }));
+                    data_set << std::vector<double>{ 8.0, 9.0 };
+                }
+                {
+                    auto data_set = file.open_data_set("/data/2/arrays", hdf5::Array<1, double>("array", { 2 }));
+                    TEST_CHECK_EQUAL(data_set.records(), 4);
+
+                    std::vector<double> values(2);
+                    data_set.set_index(3);
+                    data_set >> values;
+                    TEST_CHECK_EQUAL(8.0, values[0]);
+                }
+
+                file.remove("/data/2");
+                TEST_CHECK(! file.group_exists("/data/2"));
+                TEST_CHECK(file.data_sets("/") == (std::vector<std::string>{ "/data/1/components" }));
+                TEST_CHECK_THROWS(HDF5Error, file.remove("/data/2"));
+            }
         }
 } hdf5_file_test;
 
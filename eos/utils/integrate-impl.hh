@@ -137,6 +137,35 @@ namespace eos
             return 0;
         }
 
+        template <size_t fdim_>
+        int vector_integrand(unsigned ndim, const double *x, void *data,
+                      unsigned fdim, double *fval)
+        {
+            assert(ndim == 1);
+            assert(fdim == fdim_);
+
+            auto& f = *static_cast<const std::function<std::array<double, fdim_>(const double &)> *>(data);
+            std::array<double, fdim_> values = f(x[0]);
+            std::copy(values.cbegin(), values.cend(), fval);
+
+            return 0;
+        }
+
+        template <size_t dim_, size_t fdim_>
+        int multi_vector_integrand(unsigned ndim, const double *x, void *data,
+                      unsigned fdim, double *fval)
+        {
+            assert(ndim == dim_);
+            assert(fdim == fdim_);
+
+            auto& f = *static_cast<const std::function<std::array<double, fdim_>(const std::array<double, dim_> &)> *>(data);
+            std::array<double, dim_> args;
+            std::copy(x, x + dim_, args.data());
+            std::array<double, fdim_> values = f(args);
+            std::copy(values.cbegin(), values.cend(), fval);
+
+            return 0;
+        }
     }
 
     template <size_t dim_>
@@ -159,6 +188,42 @@ namespace eos
         return res;
     }
 
+    template <size_t fdim_>
+    std::array<double, fdim_> integrate(const std::function<std::array<double, fdim_>(const double &)> & f,
+                                        const double &a, const double &b,
+                                        const cubature::Config &config)
+    {
+        std::array<double, fdim_> res;
+        std::array<double, fdim_> err;
+        // in one dimension, hcubature uses the 7-15 point Gauss-Kronrod rule
+        if (hcubature(fdim_, &cubature::vector_integrand<fdim_>,
+                      const_cast<void *>(static_cast<const void *>(&f)), 1, &a, &b,
+                      config.maxeval(), config.epsabs(), config.epsrel(), ERROR_L2, res.data(), err.data()))
+        {
+            throw IntegrationError("hcubature failed");
+        }
+
+        return res;
+    }
+
+    template <size_t dim_, size_t fdim_>
+    std::array<double, fdim_> integrate(const std::function<std::array<double, fdim_>(const std::array<double, dim_> &)> & f,
+                                        const std::array<double, dim_> &a,
+                                        const std::array<double, dim_> &b,
+                                        const cubature::Config &config)
+    {
+        std::array<double, fdim_> res;
+        std::array<double, fdim_> err;
+        if (hcubature(fdim_, &cubature::multi_vector_integrand<dim_, fdim_>,
+                      const_cast<void *>(static_cast<const void *>(&f)), dim_, a.data(), b.data(),
+                      config.maxeval(), config.epsabs(), config.epsrel(), ERROR_L2, res.data(), err.data()))
+        {
+            throw IntegrationError("hcubature failed");
+        }
+
+        return res;
+    }
+
 }
 
 #endif
@@ -158,6 +158,34 @@ namespace cubature
                      const std::array<double, dim_> &b,
                      const cubature::Config &config = cubature::Config());
 
+    /*!
+     * Numerically integrate vector-valued functions of one real-valued parameter.
+     *
+     * Uses the adaptive 7-15 point Gauss-Kronrod rule of the cubature methods.
+     * All components share the same nodes. The error is estimated jointly, as the
+     * L2 norm of the components' errors relative to the L2 norm of the integrals,
+     * such that a component which is nearly zero (e.g. a CP asymmetry) does not
+     * drive the refinement on its own. Use this to obtain numerator and
+     * denominator of a ratio observable from a single sweep over the integrand.
+     */
+    template <size_t fdim_>
+    std::array<double, fdim_> integrate(const std::function<std::array<double, fdim_>(const double &)> & f,
+                                        const double &a, const double &b,
+                                        const cubature::Config &config = cubature::Config());
+
+    /*!
+     * Numerically integrate vector-valued functions of one or more than one
+     * variable with cubature methods.
+     *
+     * All components share the same nodes, and integration stops once the L2 norm
+     * of the components' errors satisfies the requested tolerances.
+     */
+    template <size_t dim_, size_t fdim_>
+    std::array<double, fdim_> integrate(const std::function<std::array<double, fdim_>(const std::array<double, dim_> &)> & f,
+                                        const std::array<double, dim_> &a,
+                                        const std::array<double, dim_> &b,
+                                        const cubature::Config &config = cubature::Config());
+
     class IntegrationError :
         public Exception
     {
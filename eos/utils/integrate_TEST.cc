@@ -111,5 +111,34 @@ class IntegrateTest :
             };
             auto q5 = integrate(cubature::fdd<dim>(f5lam), a_5, b_5, config_cubature);
             TEST_CHECK_RELATIVE_ERROR(q5, 1.0, eps);
+
+            // vector-valued integrands share their nodes
+            unsigned evaluations = 0;
+            auto f6lam = [&evaluations](const double & x) -> std::array<double, 3> {
+                ++evaluations;
+                return std::array<double, 3>{{ f1(x), f3(x), f4(1.0 + x) }};
+            };
+            auto q6 = integrate(std::function<std::array<double, 3> (const double &)>(f6lam), 0.0, 1.0, cubature::Config().epsrel(1e-8));
+            TEST_CHECK_RELATIVE_ERROR(q6[0], 1.0,                       1e-8);
+            TEST_CHECK_RELATIVE_ERROR(q6[1], 1.0 - std::exp(-1.0),      1e-8);
+            TEST_CHECK_RELATIVE_ERROR(q6[2], 2.0 * std::log(2.0) - 1.0, 1e-8);
+            TEST_CHECK(evaluations % 15 == 0);
+
+            // a nearly vanishing component does not drive the refinement on its own
+            unsigned evaluations_single = 0, evaluations_pair = 0;
+            auto f7lam = [&evaluations_single](const double & x) -> std::array<double, 1> {
+                ++evaluations_single;
+                return std::array<double, 1>{{ f1(x) }};
+            };
+            auto f8lam = [&evaluations_pair](const double & x) -> std::array<double, 2> {
+                ++evaluations_pair;
+                return std::array<double, 2>{{ f1(x), 1.0e-12 * std::sin(50.0 * x) }};
+            };
+            auto q7 = integrate(std::function<std::array<double, 1> (const double &)>(f7lam), 0.0, 1.0, cubature::Config().epsrel(1e-8));
+            auto q8 = integrate(std::function<std::array<double, 2> (const double &)>(f8lam), 0.0, 1.0, cubature::Config().epsrel(1e-8));
+            TEST_CHECK_RELATIVE_ERROR(q7[0], 1.0, 1e-8);
+            TEST_CHECK_RELATIVE_ERROR(q8[0], 1.0, 1e-8);
+            TEST_CHECK_NEARLY_EQUAL(q8[1], 0.0, 1e-12);
+            TEST_CHECK_EQUAL(evaluations_single, evaluations_pair);
         }
 } model_test;
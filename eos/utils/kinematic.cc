@@ -17,11 +17,12 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <eos/utils/hash.hh>
 #include <eos/utils/kinematic.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/stringify.hh>
 
-#include <map>
+#include <algorithm>
 #include <vector>
 
 namespace eos
@@ -29,11 +30,59 @@ namespace eos
     template <>
     struct Implementation<Kinematics>
     {
+        typedef std::vector<std::pair<std::string, unsigned>> Index;
+
         std::vector<double> variables_data;
 
-        std::map<std::string, unsigned> variables_map;
+        // <name, index into variables_data>, sorted by name
+        Index variables_map;
 
         std::vector<std::string> variables_names;
+
+        // hash of all names, in the order of variables_map
+        std::size_t names_hash;
+
+        Implementation() :
+            names_hash(0)
+        {
+        }
+
+        Index::const_iterator find(const std::string & name) const
+        {
+            auto i = std::lower_bound(variables_map.cbegin(), variables_map.cend(), name,
+                    [] (const Index::value_type & lhs, const std::string & rhs) { return lhs.first < rhs; });
+
+            if ((variables_map.cend() != i) && (name == i->first))
+                return i;
+
+            return variables_map.cend();
+        }
+
+        unsigned declare(const std::string & name, const double & value)
+        {
+            auto i = std::lower_bound(variables_map.begin(), variables_map.end(), name,
+                    [] (const Index::value_type & lhs, const std::string & rhs) { return lhs.first < rhs; });
+
+            if ((variables_map.end() != i) && (name == i->first))
+            {
+                variables_data[i->second] = value;
+
+                return i->second;
+            }
+
+            unsigned index = variables_data.size();
+            variables_map.insert(i, std::make_pair(name, index));
+            variables_data.push_back(value);
+            variables_names.push_back(name);
+
+            names_hash = 0;
+            for (auto v = variables_map.cbegin(), v_end = variables_map.cend() ; v != v_end ; ++v)
+            {
+                names_hash = hash_combine(names_hash, v->first);
+            }
+
+            return index;
+        }
     };
 
     Kinematics::Kinematics() :
@@ -46,21 +95,7 @@ namespace eos
     {
         for (auto v = variables.begin(), v_end = variables.end() ; v != v_end ; ++v)
         {
-            auto i(_imp->variables_map.find(v->first));
-
-            if (_imp->variables_map.end() == i)
-            {
-                int index = _imp->variables_data.size();
-                _imp->variables_map[v->first] = index;
-                _imp->variables_data.push_back(v->second);
-                _imp->variables_names.push_back(v->first);
-
-            }
-            else
-            {
-                _imp->variables_data[i->second] = v->second;
-                _imp->variables_names[i->second] = v->first;
-            }
+            _imp->declare(v->first, v->second);
         }
     }
 
@@ -81,6 +116,9 @@ namespace eos
     bool
     Kinematics::operator== (const Kinematics & rhs) const
     {
+        if (_imp->names_hash != rhs._imp->names_hash)
+            return false;
+
         if (_imp->variables_map.size() != rhs._imp->variables_map.size())
             return false;
 
@@ -103,12 +141,24 @@ namespace eos
     }
 
 
+    std::size_t
+    Kinematics::hash() const
+    {
+        std::size_t result = _imp->names_hash;
+        for (auto v = _imp->variables_map.cbegin(), v_end = _imp->variables_map.cend() ; v != v_end ; ++v)
+        {
+            result = hash_combine(result, _imp->variables_data[v->second]);
+        }
+
+        return result;
+    }
+
     KinematicVariable
     Kinematics::operator[] (const std::string & name) const
     {
-        auto i(_imp->variables_map.find(name));
+        auto i(_imp->find(name));
 
-        if (_imp->variables_map.end() == i)
+        if (_imp->variables_map.cend() == i)
             throw UnknownKinematicVariableError(name);
 
         return KinematicVariable(_imp, i->second);
@@ -137,29 +187,15 @@ namespace eos
     KinematicVariable
     Kinematics::declare(const std::string & name, const double & value)
     {
-        auto i(_imp->variables_map.find(name));
-
-        if (_imp->variables_map.end() == i)
-        {
-            int index = _imp->variables_data.size();
-            _imp->variables_map[name] = index;
-            _imp->variables_data.push_back(value);
-            _imp->variables_names.push_back(name);
-
-            return KinematicVariable(_imp, index);
-        }
-
-        _imp->variables_data[i->second] = value;
-
-        return KinematicVariable(_imp, i->second);
+        return KinematicVariable(_imp, _imp->declare(name, value));
     }
 
     void
     Kinematics::set(const std::string & name, const double & value)
     {
-        auto i(_imp->variables_map.find(name));
+        auto i(_imp->find(name));
 
-        if (_imp->variables_map.end() == i)
+        if (_imp->variables_map.cend() == i)
             throw UnknownKinematicVariableError(name);
 
         _imp->variables_data[i->second] = value;
@@ -84,6 +84,9 @@ namespace eos
 
             /// Inequality comparison operator.
             bool operator!= (const Kinematics & rhs) const;
+
+            /// Hash of the variables' names and values, consistent with the equality comparison.
+            std::size_t hash() const;
             ///@}
 
             ///@name Variable access
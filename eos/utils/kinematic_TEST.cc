@@ -88,5 +88,34 @@ class KinematicsTest :
                 TEST_CHECK(a == c);
                 TEST_CHECK(b == c);
             }
+
+            // Independence of the order of declaration, and hashing
+            {
+                Kinematics a, b;
+                a.declare("s_min", 1.0);
+                a.declare("s_max", 6.0);
+                b.declare("s_max", 6.0);
+                b.declare("s_min", 1.0);
+
+                TEST_CHECK(a == b);
+                TEST_CHECK_EQUAL(a.hash(), b.hash());
+                TEST_CHECK_EQUAL(a.as_string(), b.as_string());
+                TEST_CHECK_EQUAL("s_max=6, s_min=1", a.as_string());
+
+                // variables can still be accessed after further declarations
+                KinematicVariable s_min = a["s_min"];
+                a.declare("q2", 3.0);
+                TEST_CHECK_EQUAL(1.0, s_min.evaluate());
+                TEST_CHECK_EQUAL(3.0, a["q2"]);
+                TEST_CHECK(a != b);
+
+                b.declare("q2", 3.0);
+                TEST_CHECK(a == b);
+                TEST_CHECK_EQUAL(a.hash(), b.hash());
+
+                b.set("q2", 4.0);
+                TEST_CHECK(a != b);
+                TEST_CHECK(a.hash() != b.hash());
+            }
         }
 } kinematics_test;
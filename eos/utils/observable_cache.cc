@@ -18,18 +18,66 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <eos/utils/integrate.hh>
+#include <eos/utils/log.hh>
 #include <eos/utils/observable_cache.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/wilson-polynomial.hh>
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <map>
+#include <memory>
 #include <tuple>
 #include <vector>
 
 namespace eos
 {
+    namespace
+    {
+        // Replaces the evaluation of an observable by the evaluation of its polynomial
+        struct PolynomialSurrogate
+        {
+            // the polynomial in the coefficients that the observable uses
+            WilsonPolynomial polynomial;
+
+            // the names of the coefficients that the observable uses
+            std::list<std::string> coefficients;
+
+            // all other parameters that the observable uses, and their values at construction of the polynomial
+            std::vector<std::pair<Parameter, double>> dependencies;
+
+            PolynomialSurrogate(const WilsonPolynomial & polynomial, const std::list<std::string> & coefficients,
+                    const std::vector<std::pair<Parameter, double>> & dependencies) :
+                polynomial(polynomial),
+                coefficients(coefficients),
+                dependencies(dependencies)
+            {
+            }
+
+            void record()
+            {
+                for (auto d = dependencies.begin(), d_end = dependencies.end() ; d != d_end ; ++d)
+                {
+                    d->second = d->first.evaluate();
+                }
+            }
+
+            bool stale() const
+            {
+                for (auto d = dependencies.cbegin(), d_end = dependencies.cend() ; d != d_end ; ++d)
+                {
+                    if (d->first.evaluate() != d->second)
+                        return true;
+                }
+
+                return false;
+            }
+        };
+    }
+
     template <> struct
     Implementation<ObservableCache>
     {
@@ -42,8 +90,21 @@ namespace eos
         // Store values of observables
         std::vector<double> predictions;
 
+        // Polynomial surrogates of the observables, if any
+        std::vector<std::shared_ptr<PolynomialSurrogate>> surrogates;
+
+        // Are polynomial surrogates in use?
+        bool use_polynomials;
+
+        // The coefficients of the polynomial surrogates
+        std::list<std::string> coefficients;
+
+        // The ids of the parameters that are expected to vary
+        std::set<Parameter::Id> floating;
+
         Implementation(const Parameters & parameters) :
-            parameters(parameters)
+            parameters(parameters),
+            use_polynomials(false)
         {
         }
 
@@ -59,10 +120,122 @@ namespace eos
             if (result.second)
             {
                 predictions.push_back(std::numeric_limits<double>::quiet_NaN());
+                surrogates.push_back(use_polynomials ? make_surrogate(observable) : nullptr);
             }
 
             return result.first;
         }
+
+        // (Re)build the polynomial of an observable, and check it for consistency with the observable
+        WilsonPolynomial build_polynomial(const ObservablePtr & observable, const std::list<std::string> & coefficients, bool & consistent)
+        {
+            // relative deviation between polynomial and observable that is considered consistent;
+            // integrated observables are polynomials only up to the accuracy of their numerical integration
+            static const double tolerance = 10.0 * GSL::QNG::Config().epsrel();
+
+            // make_polynomial() resets the coefficients to their central values, so keep track of the current values
+            std::vector<std::pair<Parameter, double>> values;
+            for (auto c = coefficients.cbegin(), c_end = coefficients.cend() ; c != c_end ; ++c)
+            {
+                Parameter p = parameters[*c];
+                values.push_back(std::make_pair(p, p.evaluate()));
+            }
+
+            WilsonPolynomial result = make_polynomial(observable, coefficients);
+
+            // check at the current point, and at a point that does not coincide with any of the construction's points
+            WilsonPolynomialEvaluator evaluator;
+            consistent = true;
+            for (double shift : { 0.0, 0.5 })
+            {
+                for (auto v = values.begin(), v_end = values.end() ; v != v_end ; ++v)
+                {
+                    v->first = v->second + shift;
+                }
+
+                double value = observable->evaluate(), approximation = result.accept_returning<double>(evaluator);
+                if (! (std::abs(value - approximation) <= tolerance * std::max(std::abs(value), std::abs(approximation))))
+                {
+                    consistent = false;
+                    break;
+                }
+            }
+
+            for (auto v = values.begin(), v_end = values.end() ; v != v_end ; ++v)
+            {
+                v->first = v->second;
+            }
+
+            if (! consistent)
+            {
+                Log::instance()->message("observable_cache.build_polynomial", ll_informational)
+                    << "Observable '" << observable->name() << "' is not a polynomial in its coefficients and will be evaluated directly";
+            }
+
+            return result;
+        }
+
+        std::shared_ptr<PolynomialSurrogate> make_surrogate(const ObservablePtr & observable)
+        {
+            // without information on its parameters, we cannot tell if the observable qualifies
+            if (observable->begin() == observable->end())
+                return nullptr;
+
+            std::set<Parameter::Id> coefficient_ids;
+            for (auto c = coefficients.cbegin(), c_end = coefficients.cend() ; c != c_end ; ++c)
+            {
+                coefficient_ids.insert(parameters[*c].id());
+            }
+
+            // only use those coefficients on which the observable depends
+            std::list<std::string> used_coefficients;
+            std::vector<std::pair<Parameter, double>> dependencies;
+            for (auto i = observable->begin(), i_end = observable->end() ; i != i_end ; ++i)
+            {
+                Parameter p = parameters[*i];
+
+                if (coefficient_ids.end() != coefficient_ids.find(*i))
+                {
+                    used_coefficients.push_back(p.name());
+                }
+                else if (floating.end() != floating.find(*i))
+                {
+                    return nullptr;
+                }
+                else
+                {
+                    dependencies.push_back(std::make_pair(p, p.evaluate()));
+                }
+            }
+
+            bool consistent;
+            WilsonPolynomial polynomial = build_polynomial(observable, used_coefficients, consistent);
+            if (! consistent)
+                return nullptr;
+
+            return std::shared_ptr<PolynomialSurrogate>(new PolynomialSurrogate(polynomial, used_coefficients, dependencies));
+        }
+
+        unsigned use(const std::list<std::string> & coefficients, const std::set<Parameter::Id> & floating)
+        {
+            this->use_polynomials = true;
+            this->coefficients = coefficients;
+            this->floating = floating;
+
+            unsigned result = 0;
+            for (unsigned i = 0 ; i < observables.size() ; ++i)
+            {
+                surrogates[i] = make_surrogate(observables[i]);
+
+                if (surrogates[i])
+                    ++result;
+            }
+
+            Log::instance()->message("observable_cache.use_polynomials", ll_informational)
+                << "Using polynomials for " << result << " out of " << observables.size() << " observables";
+
+            return result;
+        }
     };
 
     ObservableCache::ObservableCache(const Parameters & parameters) :
@@ -80,15 +253,44 @@ namespace eos
         return _imp->add(observable);
     }
 
+    ObservableCache::Id
+    ObservableCache::add_clone(const ObservablePtr & observable)
+    {
+        auto existing = _imp->observables.find(observable);
+        if (existing.second)
+            return existing.first;
+
+        return _imp->add(observable->clone(_imp->parameters));
+    }
+
     void
     ObservableCache::update()
     {
         // evaluate all observables
         auto p = _imp->predictions.begin();
+        auto s = _imp->surrogates.begin();
 
-        for (auto o = _imp->observables.begin(), o_end = _imp->observables.end() ; o != o_end ; ++o, ++p)
+        WilsonPolynomialEvaluator evaluator;
+        for (auto o = _imp->observables.begin(), o_end = _imp->observables.end() ; o != o_end ; ++o, ++p, ++s)
         {
-            *p = (*o)->evaluate();
+            if ((*s) && (*s)->stale())
+            {
+                bool consistent;
+                (*s)->polynomial = _imp->build_polynomial(*o, (*s)->coefficients, consistent);
+                (*s)->record();
+
+                if (! consistent)
+                    s->reset();
+            }
+
+            if (*s)
+            {
+                *p = (*s)->polynomial.accept_returning<double>(evaluator);
+            }
+            else
+            {
+                *p = (*o)->evaluate();
+            }
         }
     }
 
@@ -126,8 +328,41 @@ namespace eos
             result._imp->add((*o)->clone(parameters));
         }
 
+        // rebind the polynomials rather than rebuilding them
+        result._imp->use_polynomials = _imp->use_polynomials;
+        result._imp->coefficients = _imp->coefficients;
+        result._imp->floating = _imp->floating;
+
+        WilsonPolynomialCloner cloner(parameters);
+        for (unsigned i = 0 ; i < _imp->surrogates.size() ; ++i)
+        {
+            const std::shared_ptr<PolynomialSurrogate> & s = _imp->surrogates[i];
+            if (! s)
+                continue;
+
+            std::vector<std::pair<Parameter, double>> dependencies;
+            for (auto d = s->dependencies.cbegin(), d_end = s->dependencies.cend() ; d != d_end ; ++d)
+            {
+                dependencies.push_back(std::make_pair(parameters[d->first.name()], d->second));
+            }
+
+            result._imp->surrogates[i].reset(new PolynomialSurrogate(s->polynomial.accept_returning<WilsonPolynomial>(cloner), s->coefficients, dependencies));
+        }
+
         result.update();
 
         return result;
     }
+
+    unsigned
+    ObservableCache::use_polynomials(const std::list<std::string> & coefficients, const std::set<Parameter::Id> & floating)
+    {
+        return _imp->use(coefficients, floating);
+    }
+
+    bool
+    ObservableCache::uses_polynomial(const ObservableCache::Id & id) const
+    {
+        return bool(_imp->surrogates[id]);
+    }
 }
@@ -25,6 +25,10 @@
 #include <eos/utils/parameters.hh>
 #include <eos/utils/private_implementation_pattern.hh>
 
+#include <list>
+#include <set>
+#include <string>
+
 namespace eos
 {
     class ObservableCache :
@@ -55,6 +59,16 @@ namespace eos
              */
             Id add(const ObservablePtr & observable);
 
+            /*!
+             * Add a clone of a given observable to the cache and return its unique Id.
+             *
+             * The observable is only cloned onto the cache's Parameters object if the
+             * cache does not yet hold an identical observable.
+             *
+             * @param observable The observable, which may use a different Parameters object.
+             */
+            Id add_clone(const ObservablePtr & observable);
+
             /// Update the predictions for all observables.
             void update();
 
@@ -80,6 +94,34 @@ namespace eos
 
             /// Clone this cache whilst keeping the observables in the given order, i.e. all ids remain valid.
             ObservableCache clone(const Parameters & parameters) const;
+            ///@}
+
+            ///@name Polynomial Surrogates
+            ///@{
+            /*!
+             * Predict observables by means of a WilsonPolynomial in the given coefficients, wherever possible.
+             *
+             * An observable qualifies if none of the floating parameters it uses, as reported through its
+             * ParameterUser interface, is outside of the set of coefficients, and if its polynomial reproduces
+             * the observable away from the points used in the polynomial's construction, within ten times the
+             * default relative accuracy of the numerical integration routines. A polynomial is rebuilt
+             * whenever any of the other parameters used by its observable changes its value. Observables that
+             * are added later on are checked as well.
+             *
+             * @param coefficients The names of the coefficients, typically Wilson coefficients.
+             * @param floating     The ids of all parameters that are expected to vary, including the coefficients.
+             *
+             * @return The number of observables that are predicted by means of a polynomial.
+             */
+            unsigned use_polynomials(const std::list<std::string> & coefficients, const std::set<Parameter::Id> & floating);
+
+            /*!
+             * Return whether a given observable is predicted by means of a polynomial.
+             *
+             * @param id The unique ObservableCache::Id of the observable.
+             */
+            bool uses_polynomial(const ObservableCache::Id & id) const;
+            ///@}
     };
 }
 
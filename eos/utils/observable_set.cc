@@ -17,11 +17,12 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <eos/utils/hash.hh>
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/wrapped_forward_iterator-impl.hh>
 
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace eos
@@ -32,30 +33,48 @@ namespace eos
         // The list of observables
         std::vector<ObservablePtr> observables;
 
-        // <observable name, index>
-        std::map<QualifiedName, unsigned> observable_names;
+        // <hash of name and options, index>
+        std::unordered_multimap<std::size_t, unsigned> index;
 
         Implementation()
         {
         }
 
+        // Kinematics are shared and can change after insertion, hence they do not enter the hash
+        static std::size_t hash(const ObservablePtr & observable)
+        {
+            return hash_combine(observable->name().hash(), observable->options().hash());
+        }
+
+        std::pair<unsigned, bool> find(const ObservablePtr & observable, const std::size_t & hash) const
+        {
+            // only compare against observables with the same hash for options and name
+            auto range = index.equal_range(hash);
+            for (auto i = range.first ; i != range.second ; ++i)
+            {
+                if (identical_observables(observables[i->second], observable))
+                    return std::make_pair(i->second, true);
+            }
+
+            return std::make_pair(observables.size(), false);
+        }
+
         std::pair<unsigned, bool> add(const ObservablePtr & observable)
         {
             if (! observables.empty() && (observable->parameters() != observables.front()->parameters()))
                 throw InternalError("ObservableSet::add(): Mismatch of Parameters between different observables detected.");
 
-            // compare each observable for options, kinematics and name
-            unsigned index = 0;
-            for (auto i = observables.begin(), i_end = observables.end() ; i != i_end ; ++i, ++index)
-            {
-                if (identical_observables(*i, observable))
-                    return std::make_pair(index, false);
-            }
+            const std::size_t h = hash(observable);
+            auto existing = find(observable, h);
+            if (existing.second)
+                return std::make_pair(existing.first, false);
 
             // new observable
+            unsigned result = observables.size();
             observables.push_back(observable);
+            index.insert(std::make_pair(h, result));
 
-            return std::make_pair(index, true);
+            return std::make_pair(result, true);
         }
 
         static bool identical_observables(const ObservablePtr & lhs, const ObservablePtr & rhs)
@@ -97,6 +116,12 @@ namespace eos
         return _imp->add(observable);
     }
 
+    std::pair<unsigned, bool>
+    ObservableSet::find(const ObservablePtr & observable) const
+    {
+        return _imp->find(observable, Implementation<ObservableSet>::hash(observable));
+    }
+
     template <>
     struct WrappedForwardIteratorTraits<ObservableSet::IteratorTag>
     {
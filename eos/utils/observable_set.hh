@@ -65,6 +65,9 @@ namespace eos
             /*!
              * Add an observable to the vector.
              *
+             * Observables are looked up by a hash of their name and options, and
+             * compared in full, including their current kinematics.
+             *
              * @param observable The observable to be added.
              *
              * @return If observable is found to be an existing observable,
@@ -74,6 +77,16 @@ namespace eos
              */
             std::pair<unsigned, bool> add(const ObservablePtr & observable);
 
+            /*!
+             * Look up an observable that is identical to a given one, i.e., that
+             * coincides in name, kinematics and options.
+             *
+             * @param observable The observable to be looked up. It may use a different Parameters object.
+             *
+             * @return If an identical observable is found, its index and true. Otherwise, the second value is false.
+             */
+            std::pair<unsigned, bool> find(const ObservablePtr & observable) const;
+
             /// Access to the underlying Parameters object.
             Parameters parameters();
 
@@ -21,6 +21,7 @@
 #include <eos/utils/observable_set.hh>
 #include <eos/utils/observable_stub.hh>
 
+#include <iterator>
 #include <vector>
 
 using namespace test;
@@ -94,6 +95,32 @@ class ObservableSetTest :
 
                 // try the same again
                 TEST_CHECK(! o.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)"))).second);
+
+                // look up identical observables, also across Parameters objects
+                Parameters q = p.clone();
+                TEST_CHECK(o.find(ObservablePtr(new ObservableStub(q, "mass::b(MSbar);opt=har"))).second);
+                TEST_CHECK_EQUAL(o.find(ObservablePtr(new ObservableStub(q, "mass::b(MSbar);opt=har"))).first, 1);
+                TEST_CHECK(! o.find(ObservablePtr(new ObservableStub(q, "mass::c"))).second);
+            }
+
+            // kinematics changed after the addition of an observable
+            {
+                ObservableSet o;
+                Parameters p = Parameters::Defaults();
+
+                Kinematics kin;
+                kin.declare("s", 1.0);
+
+                TEST_CHECK(o.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)", kin))).second);
+
+                kin.set("s", 2.0);
+
+                Kinematics other;
+                other.declare("s", 2.0);
+
+                TEST_CHECK(o.find(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)", other))).second);
+                TEST_CHECK(! o.add(ObservablePtr(new ObservableStub(p, "mass::b(MSbar)", other))).second);
+                TEST_CHECK_EQUAL(1, std::distance(o.begin(), o.end()));
             }
         }
 } observable_set_test;
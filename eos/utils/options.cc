@@ -17,27 +17,78 @@
  * Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <eos/utils/hash.hh>
 #include <eos/utils/options.hh>
 #include <eos/utils/private_implementation_pattern-impl.hh>
 
-#include <map>
+#include <algorithm>
+#include <vector>
 
 namespace eos
 {
     template <>
     struct Implementation<Options>
     {
-        std::map<std::string, std::string> options;
+        typedef std::vector<std::pair<std::string, std::string>> Storage;
 
-        Implementation()
+        // <key, value>, sorted by key
+        Storage options;
+
+        // hash of all keys and values, in the order of options
+        std::size_t hash;
+
+        Implementation() :
+            hash(0)
         {
         }
 
-        Implementation(const std::initializer_list<std::pair<std::string, std::string>> & _options)
+        Implementation(const std::initializer_list<std::pair<std::string, std::string>> & _options) :
+            hash(0)
         {
             for (auto o = _options.begin(), o_end = _options.end() ; o != o_end ; ++o)
             {
-                options.insert(*o);
+                insert(o->first, o->second, false);
+            }
+        }
+
+        Storage::iterator lower_bound(const std::string & key)
+        {
+            return std::lower_bound(options.begin(), options.end(), key,
+                    [] (const Storage::value_type & lhs, const std::string & rhs) { return lhs.first < rhs; });
+        }
+
+        Storage::const_iterator find(const std::string & key) const
+        {
+            auto i = std::lower_bound(options.cbegin(), options.cend(), key,
+                    [] (const Storage::value_type & lhs, const std::string & rhs) { return lhs.first < rhs; });
+
+            if ((options.cend() != i) && (key == i->first))
+                return i;
+
+            return options.cend();
+        }
+
+        // insert a new option, or replace the value of an existing option if requested
+        void insert(const std::string & key, const std::string & value, bool replace)
+        {
+            auto i = lower_bound(key);
+
+            if ((options.end() != i) && (key == i->first))
+            {
+                if (! replace)
+                    return;
+
+                i->second = value;
+            }
+            else
+            {
+                options.insert(i, std::make_pair(key, value));
+            }
+
+            hash = 0;
+            for (auto o = options.cbegin(), o_end = options.cend() ; o != o_end ; ++o)
+            {
+                hash = hash_combine(hash_combine(hash, o->first), o->second);
             }
         }
     };
@@ -59,6 +110,9 @@ namespace eos
     bool
     Options::operator== (const Options & rhs) const
     {
+        if (_imp->hash != rhs._imp->hash)
+            return false;
+
         if (_imp->options.size() != rhs._imp->options.size())
             return false;
 
@@ -77,11 +131,17 @@ namespace eos
         return ! (*this == rhs);
     }
 
+    std::size_t
+    Options::hash() const
+    {
+        return _imp->hash;
+    }
+
     const std::string &
     Options::operator[] (const std::string & key) const
     {
-        auto i(_imp->options.find(key));
-        if (_imp->options.end() == i)
+        auto i(_imp->find(key));
+        if (_imp->options.cend() == i)
             throw UnknownOptionError(key);
 
         return i->second;
@@ -90,29 +150,21 @@ namespace eos
     bool
     Options::has(const std::string & key) const
     {
-        return _imp->options.end() != _imp->options.find(key);
+        return _imp->options.cend() != _imp->find(key);
     }
 
     void
     Options::set(const std::string & key, const std::string & value)
     {
-        auto i(_imp->options.find(key));
-        if (_imp->options.end() != i)
-        {
-            i->second = value;
-        }
-        else
-        {
-            _imp->options[key] = value;
-        }
+        _imp->insert(key, value, true);
     }
 
     std::string
     Options::get(const std::string & key, const std::string & default_value) const
     {
-        auto i(_imp->options.find(key));
+        auto i(_imp->find(key));
 
-        if (_imp->options.end() == i)
+        if (_imp->options.cend() == i)
             return default_value;
 
         return i->second;
@@ -165,7 +217,8 @@ namespace eos
     {
         Options result;
 
-        result._imp->options.insert(lhs._imp->options.cbegin(), lhs._imp->options.cend());
+        result._imp->options = lhs._imp->options;
+        result._imp->hash = lhs._imp->hash;
 
         /*
          * merge all options from rhs into result. Make sure to overwrite
@@ -173,12 +226,7 @@ namespace eos
          */
         for (auto o : rhs._imp->options)
         {
-            auto retval = result._imp->options.insert(o);
-
-            if (! retval.second)
-            {
-                retval.first->second = o.second;
-            }
+            result._imp->insert(o.first, o.second, true);
         }
 
         return result;
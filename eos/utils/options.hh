@@ -88,6 +88,9 @@ namespace eos
 
             /// Inequality comparison operator.
             bool operator!= (const Options & rhs) const;
+
+            /// Hash of the keys and values, consistent with the equality comparison.
+            std::size_t hash() const;
             ///@}
 
             ///@name Access
@@ -125,6 +125,26 @@ class OptionsTest :
                 TEST_CHECK(a == c);
                 TEST_CHECK(b == c);
             }
+
+            // Independence of the order of insertion, and hashing
+            {
+                Options a{ { "model", "SM" }, { "form-factors", "BZ2004" } };
+                Options b;
+                b.set("form-factors", "BZ2004");
+                b.set("model", "SM");
+
+                TEST_CHECK(a == b);
+                TEST_CHECK_EQUAL(a.hash(), b.hash());
+                TEST_CHECK_EQUAL("form-factors=BZ2004,model=SM", a.as_string());
+
+                b.set("model", "WilsonScan");
+                TEST_CHECK(a != b);
+                TEST_CHECK(a.hash() != b.hash());
+
+                Options c = a + Options{ { "model", "WilsonScan" } };
+                TEST_CHECK(c == b);
+                TEST_CHECK_EQUAL(c.hash(), b.hash());
+            }
         }
 } options_test;
 
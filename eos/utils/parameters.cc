@@ -81,6 +81,14 @@ namespace eos
     struct Parameters::Data
     {
         std::vector<Parameter::Data> data;
+
+        // incremented whenever any parameter's value changes
+        unsigned long version;
+
+        Data() :
+            version(0)
+        {
+        }
     };
 
     template <>
@@ -182,6 +190,7 @@ namespace eos
                             << "Overriding existing parameter '" << name << "' with central value '" << central << "'";
 
                         parameters_data->data[i->second].value = central;
+                        ++parameters_data->version;
                         parameters_data->data[i->second].min = min;
                         parameters_data->data[i->second].max = max;
                     }
@@ -374,6 +383,13 @@ namespace eos
             throw UnknownParameterError(name);
 
         _imp->parameters_data->data[i->second].value = value;
+        ++_imp->parameters_data->version;
+    }
+
+    unsigned long
+    Parameters::version() const
+    {
+        return _imp->parameters_data->version;
     }
 
     Parameters::Iterator
@@ -452,6 +468,7 @@ namespace eos
     Parameter::operator= (const double & value)
     {
         _parameters_data->data[_index].value = value;
+        ++_parameters_data->version;
 
         return *this;
     }
@@ -460,6 +477,7 @@ namespace eos
     Parameter::set(const double & value)
     {
         _parameters_data->data[_index].value = value;
+        ++_parameters_data->version;
     }
 
     const double &
@@ -170,6 +170,15 @@ namespace eos
             void override_from_file(const std::string & file);
             ///@}
 
+            /*!
+             * Retrieve the version of the parameters' values.
+             *
+             * The version changes whenever the value of any of the parameters
+             * is changed, and can be used to detect when cached results that
+             * depend on the parameters become stale.
+             */
+            unsigned long version() const;
+
             /*!
              * Compare two instances of Parameters on inequality of their
              * underlying implementations.
@@ -71,5 +71,27 @@ class ParametersTest :
                 TEST_CHECK_EQUAL(m_c_original(), 0.0);
                 TEST_CHECK_EQUAL(m_c_clone(), m_c_clone.central());
             }
+
+            // Versioning
+            {
+                Parameters original = Parameters::Defaults();
+                Parameter m_c = original["mass::c"];
+
+                const unsigned long v0 = original.version();
+
+                m_c = 0.0;
+                TEST_CHECK(original.version() != v0);
+
+                const unsigned long v1 = original.version();
+                original.set("mass::b(MSbar)", 4.0);
+                TEST_CHECK(original.version() != v1);
+
+                const unsigned long v2 = original.version();
+                Parameters clone = original.clone();
+                TEST_CHECK_EQUAL(original.version(), v2);
+
+                clone["mass::c"] = 1.0;
+                TEST_CHECK_EQUAL(original.version(), v2);
+            }
         }
 } parameters_test;
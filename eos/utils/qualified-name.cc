@@ -20,6 +20,8 @@
 
 #include <eos/utils/qualified-name.hh>
 
+#include <functional>
+
 namespace eos
 {
     namespace qnp
@@ -136,6 +138,7 @@ namespace eos
 
     QualifiedName::QualifiedName(const std::string & input) :
         _full(input),
+        _hash(0),
         _prefix("null"),
         _name("empty"),
         _suffix(""),
@@ -210,6 +213,8 @@ namespace eos
 
             pos_option_start = pos_next_comma;
         }
+
+        _hash = std::hash<std::string>()(_str);
     }
 
     QualifiedName::QualifiedName(const char * input) :
@@ -220,6 +225,7 @@ namespace eos
     QualifiedName::QualifiedName(const QualifiedName & other) :
         _str(other._str),
         _full(other._full),
+        _hash(other._hash),
         _prefix(other._prefix),
         _name(other._name),
         _suffix(other._suffix),
@@ -122,6 +122,7 @@ namespace eos
         private:
             std::string  _str;     // short hand name, excluding possible options
             std::string  _full;    // full name, including all given options
+            std::size_t  _hash;    // hash of the short hand name
             qnp::Prefix  _prefix;
             qnp::Name    _name;
             qnp::Suffix  _suffix;
@@ -139,6 +140,7 @@ namespace eos
             inline const qnp::Name & name_part() const { return _name; };
             inline const qnp::Suffix & suffix_part() const { return _suffix; };
             inline const Options & options() const { return _options; };
+            inline std::size_t hash() const { return _hash; };
 
             /*
              * Two qualified names are compared based on their short names only.
@@ -146,8 +148,8 @@ namespace eos
              * full names aren't.
              */
             inline bool operator<  (const QualifiedName & rhs) const { return this->_str <  rhs._str; };
-            inline bool operator== (const QualifiedName & rhs) const { return this->_str == rhs._str; };
-            inline bool operator!= (const QualifiedName & rhs) const { return this->_str != rhs._str; };
+            inline bool operator== (const QualifiedName & rhs) const { return (this->_hash == rhs._hash) && (this->_str == rhs._str); };
+            inline bool operator!= (const QualifiedName & rhs) const { return ! (*this == rhs); };
     };
 
     class QualifiedNameSyntaxError :
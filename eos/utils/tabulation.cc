@@ -0,0 +1,192 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/utils/exception.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/stringify.hh>
+#include <eos/utils/tabulation.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <gsl/gsl_spline.h>
+
+namespace eos
+{
+    namespace
+    {
+        /*
+         * One build of the interpolant. Evaluation with a NULL accelerator
+         * does not modify the spline, and is therefore safe from several threads.
+         */
+        struct Table
+        {
+            std::vector<double> x, y;
+
+            gsl_spline * spline;
+
+            Table(const std::vector<double> & x, const std::vector<double> & y) :
+                x(x),
+                y(y),
+                spline(gsl_spline_alloc(gsl_interp_cspline, x.size()))
+            {
+                gsl_spline_init(spline, this->x.data(), this->y.data(), this->x.size());
+            }
+
+            Table(const Table &) = delete;
+
+            ~Table()
+            {
+                gsl_spline_free(spline);
+            }
+
+            double operator() (const double & x) const
+            {
+                return gsl_spline_eval(spline, x, NULL);
+            }
+        };
+    }
+
+    template <>
+    struct Implementation<Tabulation>
+    {
+        std::string name;
+
+        Parameters parameters;
+
+        std::function<double (const double &)> f;
+
+        double x_min, x_max;
+
+        unsigned points;
+
+        bool check;
+
+        // the current table and the parameter version it was built for
+        std::shared_ptr<const Table> table;
+
+        unsigned long version;
+
+        Mutex mutex;
+
+        Implementation(const std::string & name, const Parameters & parameters,
+                const std::function<double (const double &)> & f,
+                const double & x_min, const double & x_max, const unsigned & points,
+                const bool & check) :
+            name(name),
+            parameters(parameters),
+            f(f),
+            x_min(x_min),
+            x_max(x_max),
+            points(points),
+            check(check),
+            version(0)
+        {
+            if (points < 3)
+                throw InternalError("Tabulation: Need at least 3 grid points, got " + stringify(points));
+
+            if (x_min >= x_max)
+                throw InternalError("Tabulation: Invalid range [" + stringify(x_min) + ", " + stringify(x_max) + "]");
+        }
+
+        std::shared_ptr<const Table> current()
+        {
+            Lock l(mutex);
+
+            const unsigned long v = parameters.version();
+            if ((! table) || (v != version))
+            {
+                std::vector<double> x(points), y(points);
+                const double dx = (x_max - x_min) / (points - 1);
+                for (unsigned i = 0 ; i < points ; ++i)
+                {
+                    x[i] = x_min + i * dx;
+                    y[i] = f(x[i]);
+                }
+                x.back() = x_max;
+
+                table.reset(new Table(x, y));
+                version = v;
+
+                if (check)
+                {
+                    const double error = max_relative_error(*table);
+
+                    Log::instance()->message("tabulation.check", (error > 1.0e-3) ? ll_warning : ll_debug)
+                        << "Largest relative error of the tabulation of '" << name << "' is " << error;
+                }
+            }
+
+            return table;
+        }
+
+        double max_relative_error(const Table & t) const
+        {
+            double result = 0.0;
+            for (unsigned i = 0 ; i < points - 1 ; ++i)
+            {
+                const double x = (t.x[i] + t.x[i + 1]) / 2.0;
+                const double exact = f(x);
+                const double error = std::abs((t(x) - exact) / exact);
+
+                result = std::max(result, error);
+            }
+
+            return result;
+        }
+    };
+
+    Tabulation::Tabulation(const std::string & name, const Parameters & parameters,
+            const std::function<double (const double &)> & f,
+            const double & x_min, const double & x_max, const unsigned & points,
+            const bool & check) :
+        PrivateImplementationPattern<Tabulation>(new Implementation<Tabulation>(name, parameters, f, x_min, x_max, points, check))
+    {
+    }
+
+    Tabulation::~Tabulation()
+    {
+    }
+
+    double
+    Tabulation::operator() (const double & x) const
+    {
+        if ((x < _imp->x_min) || (x > _imp->x_max))
+            return _imp->f(x);
+
+        return (*_imp->current())(x);
+    }
+
+    double
+    Tabulation::exact(const double & x) const
+    {
+        return _imp->f(x);
+    }
+
+    double
+    Tabulation::max_relative_error() const
+    {
+        return _imp->max_relative_error(*_imp->current());
+    }
+}
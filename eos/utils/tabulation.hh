@@ -0,0 +1,78 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_SRC_UTILS_TABULATION_HH
+#define EOS_GUARD_SRC_UTILS_TABULATION_HH 1
+
+#include <eos/utils/parameters.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <functional>
+#include <string>
+
+namespace eos
+{
+    /*!
+     * Cubic-spline interpolation of an expensive function of one variable on a uniform grid.
+     *
+     * The table is built on first use, and rebuilt whenever the version of the
+     * associated Parameters object has changed since the last build. Arguments
+     * outside the tabulated range are evaluated exactly.
+     */
+    class Tabulation :
+        public PrivateImplementationPattern<Tabulation>
+    {
+        public:
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param name       Name of the tabulated function, used for log messages.
+             * @param parameters The parameters upon which the function depends.
+             * @param f          The function to be tabulated.
+             * @param x_min      Lower end of the tabulated range.
+             * @param x_max      Upper end of the tabulated range.
+             * @param points     Number of grid points, at least 3.
+             * @param check      If true, compare against exact evaluation after each build and log the error.
+             */
+            Tabulation(const std::string & name, const Parameters & parameters,
+                    const std::function<double (const double &)> & f,
+                    const double & x_min, const double & x_max, const unsigned & points,
+                    const bool & check = false);
+
+            /// Destructor.
+            ~Tabulation();
+            ///@}
+
+            /// Evaluate the interpolant at x, rebuilding the table if necessary.
+            double operator() (const double & x) const;
+
+            /// Evaluate the tabulated function exactly at x.
+            double exact(const double & x) const;
+
+            /*!
+             * Retrieve the largest relative deviation between interpolant and
+             * exact evaluation at the midpoints between neighbouring grid points.
+             */
+            double max_relative_error() const;
+    };
+}
+
+#endif
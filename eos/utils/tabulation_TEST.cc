@@ -0,0 +1,92 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/tabulation.hh>
+
+#include <cmath>
+
+using namespace test;
+using namespace eos;
+
+class TabulationTest :
+    public TestCase
+{
+    public:
+        TabulationTest() :
+            TestCase("tabulation_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const double eps = 1e-4;
+
+            Parameters p = Parameters::Defaults();
+            Parameter m_b = p["mass::b(MSbar)"];
+
+            unsigned evaluations = 0;
+            std::function<double (const double &)> f = [&] (const double & x) -> double
+            {
+                ++evaluations;
+                return m_b() * std::exp(-x / 4.0);
+            };
+
+            Tabulation t("f", p, f, 0.0, 10.0, 41, true);
+            TEST_CHECK_EQUAL(0u, evaluations);
+
+            // the table is built on first use
+            TEST_CHECK_RELATIVE_ERROR(m_b() * std::exp(-0.3 / 4.0), t(0.3), eps);
+            TEST_CHECK_EQUAL(41u + 40u, evaluations);
+
+            // no rebuild for unchanged parameters
+            TEST_CHECK_RELATIVE_ERROR(m_b() * std::exp(-7.7 / 4.0), t(7.7), eps);
+            TEST_CHECK_EQUAL(81u, evaluations);
+            TEST_CHECK(t.max_relative_error() < eps);
+
+            // exact evaluation outside the tabulated range, and on demand
+            evaluations = 0;
+            TEST_CHECK_EQUAL(m_b() * std::exp(-12.0 / 4.0), t(12.0));
+            TEST_CHECK_EQUAL(m_b() * std::exp(-2.0 / 4.0),  t.exact(2.0));
+            TEST_CHECK_EQUAL(2u, evaluations);
+
+            // rebuild after a parameter has changed
+            m_b = 2.0 * m_b();
+            evaluations = 0;
+            TEST_CHECK_RELATIVE_ERROR(m_b() * std::exp(-5.1 / 4.0), t(5.1), eps);
+            TEST_CHECK_EQUAL(81u, evaluations);
+
+            // copies of the parameters share their version
+            Parameters q = p;
+            q["mass::c"] = 1.3;
+            evaluations = 0;
+            t(5.1);
+            TEST_CHECK_EQUAL(81u, evaluations);
+
+            // clones do not
+            Parameters r = p.clone();
+            r["mass::c"] = 1.4;
+            evaluations = 0;
+            t(5.1);
+            TEST_CHECK_EQUAL(0u, evaluations);
+
+            TEST_CHECK_THROWS(InternalError, Tabulation("g", p, f, 0.0, 1.0, 2));
+            TEST_CHECK_THROWS(InternalError, Tabulation("g", p, f, 1.0, 0.0, 3));
+        }
+} tabulation_test;
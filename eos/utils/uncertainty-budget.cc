@@ -0,0 +1,289 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/utils/uncertainty-budget.hh>
+#include <eos/utils/kinematic.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
+#include <eos/utils/thread_pool.hh>
+
+#include <algorithm>
+#include <exception>
+#include <map>
+
+namespace eos
+{
+    UncertaintyBudget::Config::Config() :
+        parallelize(true)
+    {
+    }
+
+    UncertaintyBudget::Config
+    UncertaintyBudget::Config::Default()
+    {
+        return Config();
+    }
+
+    template <>
+    struct Implementation<UncertaintyBudget>
+    {
+        struct Point
+        {
+            ObservablePtr observable;
+
+            std::vector<std::pair<std::string, double>> kinematics;
+        };
+
+        /*
+         * A single evaluation: the observable at one point, with at most one parameter varied.
+         */
+        struct Task
+        {
+            unsigned point;
+
+            // the index of the varied parameter, or -1 for the central value
+            int variation;
+
+            // the varied parameter takes its maximal value if true, its minimal value otherwise
+            bool upper;
+
+            double * result;
+        };
+
+        /*
+         * The state shared by all workers of one call to evaluate().
+         */
+        struct Queue
+        {
+            const std::vector<Point> & points;
+
+            const std::vector<Task> & tasks;
+
+            Mutex mutex;
+
+            unsigned next;
+
+            std::exception_ptr exception;
+
+            Queue(const std::vector<Point> & points, const std::vector<Task> & tasks) :
+                points(points),
+                tasks(tasks),
+                next(0)
+            {
+            }
+
+            // retrieve the next pending task, or nullptr once all tasks are done or one has failed
+            const Task * pop()
+            {
+                Lock l(mutex);
+
+                if ((next == tasks.size()) || exception)
+                    return nullptr;
+
+                return &tasks[next++];
+            }
+
+            void fail(const std::exception_ptr & e)
+            {
+                Lock l(mutex);
+
+                if (! exception)
+                    exception = e;
+            }
+        };
+
+        /*
+         * A worker owns its clones of the parameters and of all observables it has encountered so far.
+         */
+        struct Worker
+        {
+            Parameters parameters;
+
+            std::vector<Parameter> variations;
+
+            std::vector<double> central_values;
+
+            std::map<const Observable *, ObservablePtr> observables;
+
+            Worker(const Parameters & p, const std::vector<std::string> & names) :
+                parameters(p.clone())
+            {
+                for (const auto & n : names)
+                {
+                    variations.push_back(parameters[n]);
+                    central_values.push_back(variations.back().evaluate());
+                }
+            }
+
+            ObservablePtr observable(const ObservablePtr & original, Mutex & mutex)
+            {
+                auto o = observables.find(original.get());
+                if (observables.end() != o)
+                    return o->second;
+
+                // the construction of observables is not guaranteed to be thread safe
+                Lock l(mutex);
+                ObservablePtr result = original->clone(parameters);
+                observables[original.get()] = result;
+
+                return result;
+            }
+
+            void run(Queue & queue, Mutex & clone_mutex)
+            {
+                try
+                {
+                    while (const Task * t = queue.pop())
+                    {
+                        const Point & point = queue.points[t->point];
+                        ObservablePtr o = observable(point.observable, clone_mutex);
+
+                        Kinematics k = o->kinematics();
+                        for (const auto & v : point.kinematics)
+                        {
+                            k.set(v.first, v.second);
+                        }
+
+                        if (t->variation < 0)
+                        {
+                            *t->result = o->evaluate();
+                            continue;
+                        }
+
+                        Parameter & p = variations[t->variation];
+                        p = (t->upper ? p.max() : p.min());
+                        *t->result = o->evaluate();
+                        p = central_values[t->variation];
+                    }
+                }
+                catch (...)
+                {
+                    queue.fail(std::current_exception());
+                }
+            }
+        };
+
+        Parameters parameters;
+
+        std::vector<std::string> variations;
+
+        UncertaintyBudget::Config config;
+
+        std::vector<Point> points;
+
+        Mutex clone_mutex;
+
+        Implementation(const Parameters & parameters, const std::vector<Parameter> & variations, const UncertaintyBudget::Config & config) :
+            parameters(parameters),
+            config(config)
+        {
+            for (const auto & v : variations)
+            {
+                this->variations.push_back(v.name());
+            }
+        }
+
+        std::vector<UncertaintyBudget::Result> evaluate()
+        {
+            std::vector<UncertaintyBudget::Result> results(points.size());
+            std::vector<Task> tasks;
+            tasks.reserve(points.size() * (1 + 2 * variations.size()));
+            for (unsigned i = 0 ; i < points.size() ; ++i)
+            {
+                results[i].at_min.resize(variations.size());
+                results[i].at_max.resize(variations.size());
+
+                tasks.push_back(Task{ i, -1, false, &results[i].central });
+                for (unsigned j = 0 ; j < variations.size() ; ++j)
+                {
+                    tasks.push_back(Task{ i, int(j), false, &results[i].at_min[j] });
+                    tasks.push_back(Task{ i, int(j), true,  &results[i].at_max[j] });
+                }
+            }
+
+            const unsigned number_of_workers = config.parallelize
+                ? std::max(1u, std::min<unsigned>(ThreadPool::instance()->number_of_threads(), tasks.size()))
+                : 1u;
+
+            Log::instance()->message("uncertainty_budget.evaluate", ll_debug)
+                << "Evaluating " << tasks.size() << " tasks for " << points.size() << " points using "
+                << number_of_workers << " workers";
+
+            Queue queue(points, tasks);
+            std::vector<std::shared_ptr<Worker>> workers;
+            std::vector<Ticket> tickets;
+            for (unsigned w = 0 ; w < number_of_workers ; ++w)
+            {
+                workers.push_back(std::make_shared<Worker>(parameters, variations));
+
+                std::function<void (void)> f = std::bind(&Worker::run, workers.back().get(), std::ref(queue), std::ref(clone_mutex));
+
+                if (config.parallelize)
+                {
+                    tickets.push_back(ThreadPool::instance()->enqueue(f));
+                }
+                else
+                {
+                    f();
+                }
+            }
+
+            for (auto & t : tickets)
+            {
+                t.wait();
+            }
+
+            if (queue.exception)
+                std::rethrow_exception(queue.exception);
+
+            return results;
+        }
+    };
+
+    UncertaintyBudget::UncertaintyBudget(const Parameters & parameters, const std::vector<Parameter> & variations, const UncertaintyBudget::Config & config) :
+        PrivateImplementationPattern<UncertaintyBudget>(new Implementation<UncertaintyBudget>(parameters, variations, config))
+    {
+    }
+
+    UncertaintyBudget::~UncertaintyBudget()
+    {
+    }
+
+    unsigned
+    UncertaintyBudget::add(const ObservablePtr & observable, const std::vector<std::pair<std::string, double>> & kinematics)
+    {
+        _imp->points.push_back(Implementation<UncertaintyBudget>::Point{ observable, kinematics });
+
+        return _imp->points.size() - 1;
+    }
+
+    unsigned
+    UncertaintyBudget::number_of_points() const
+    {
+        return _imp->points.size();
+    }
+
+    std::vector<UncertaintyBudget::Result>
+    UncertaintyBudget::evaluate() const
+    {
+        return _imp->evaluate();
+    }
+}
@@ -0,0 +1,123 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EOS_GUARD_EOS_UTILS_UNCERTAINTY_BUDGET_HH
+#define EOS_GUARD_EOS_UTILS_UNCERTAINTY_BUDGET_HH 1
+
+#include <eos/observable.hh>
+#include <eos/utils/parameters.hh>
+#include <eos/utils/private_implementation_pattern.hh>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace eos
+{
+    /*!
+     * Evaluate observables at the central values of the parameters, and with
+     * each of a list of parameters varied to its minimal and maximal value.
+     *
+     * Every evaluation is an independent task. The tasks are distributed among
+     * the threads of the ThreadPool, each of which evaluates clones of the
+     * observables that use its own clone of the parameters. The central value
+     * of an observable at a given point is evaluated only once, and the results
+     * are returned in the order in which the points have been added, regardless
+     * of the order in which the tasks have finished.
+     */
+    class UncertaintyBudget :
+        public PrivateImplementationPattern<UncertaintyBudget>
+    {
+        public:
+            struct Config;
+            struct Result;
+
+            ///@name Basic Functions
+            ///@{
+            /*!
+             * Constructor.
+             *
+             * @param parameters The parameters which the observables use. They are cloned
+             *                   for each thread, and are never modified.
+             * @param variations The parameters which are varied one at a time.
+             * @param config     The configuration options.
+             */
+            UncertaintyBudget(const Parameters & parameters, const std::vector<Parameter> & variations, const UncertaintyBudget::Config & config);
+
+            /// Destructor.
+            ~UncertaintyBudget();
+            ///@}
+
+            /*!
+             * Add a point at which an observable shall be evaluated.
+             *
+             * @param observable The observable, which must use the parameters passed to the constructor.
+             * @param kinematics Values for (some of) the observable's kinematic variables.
+             *
+             * @return The index of the point within the results.
+             */
+            unsigned add(const ObservablePtr & observable, const std::vector<std::pair<std::string, double>> & kinematics = { });
+
+            /// Retrieve the number of points added so far.
+            unsigned number_of_points() const;
+
+            /*!
+             * Evaluate all observables at all points.
+             *
+             * Exceptions raised by an observable are rethrown once all threads have finished.
+             *
+             * @return One result for each point, in the order in which they have been added.
+             */
+            std::vector<UncertaintyBudget::Result> evaluate() const;
+    };
+
+    /*!
+     * Configuration options for UncertaintyBudget.
+     */
+    struct UncertaintyBudget::Config
+    {
+        private:
+            /// Constructor.
+            Config();
+
+        public:
+            /// Constructor with the default settings.
+            static Config Default();
+
+            /// Whether the evaluations shall be distributed among the threads of the ThreadPool.
+            bool parallelize;
+    };
+
+    /*!
+     * The values of an observable at one point.
+     */
+    struct UncertaintyBudget::Result
+    {
+        /// The value at the central values of the parameters.
+        double central;
+
+        /// The values with one of the parameters set to its minimal value, in the order of the variations.
+        std::vector<double> at_min;
+
+        /// The values with one of the parameters set to its maximal value, in the order of the variations.
+        std::vector<double> at_max;
+    };
+}
+
+#endif
@@ -0,0 +1,90 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <test/test.hh>
+#include <eos/utils/observable_stub.hh>
+#include <eos/utils/uncertainty-budget.hh>
+
+using namespace test;
+using namespace eos;
+
+class UncertaintyBudgetTest :
+    public TestCase
+{
+    public:
+        UncertaintyBudgetTest() :
+            TestCase("uncertainty_budget_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            for (bool parallelize : { false, true })
+            {
+                Parameters parameters = Parameters::Defaults();
+                Parameter m_b = parameters["mass::b(MSbar)"];
+                Parameter m_c = parameters["mass::c"];
+
+                UncertaintyBudget::Config config = UncertaintyBudget::Config::Default();
+                config.parallelize = parallelize;
+
+                UncertaintyBudget budget(parameters, std::vector<Parameter>{ m_b, m_c }, config);
+
+                // add each observable several times, so that the tasks outnumber the threads
+                for (unsigned i = 0 ; i < 20 ; ++i)
+                {
+                    TEST_CHECK_EQUAL(2 * i + 0, budget.add(ObservablePtr(new ObservableStub(parameters, "mass::b(MSbar)"))));
+                    TEST_CHECK_EQUAL(2 * i + 1, budget.add(ObservablePtr(new ObservableStub(parameters, "mass::c"))));
+                }
+                TEST_CHECK_EQUAL(40u, budget.number_of_points());
+
+                const double m_b_central = m_b(), m_c_central = m_c();
+
+                const auto results = budget.evaluate();
+                TEST_CHECK_EQUAL(40u, results.size());
+
+                for (unsigned i = 0 ; i < 40 ; i += 2)
+                {
+                    // m_b
+                    TEST_CHECK_EQUAL(m_b_central, results[i].central);
+                    TEST_CHECK_EQUAL(2u,          results[i].at_min.size());
+                    TEST_CHECK_EQUAL(2u,          results[i].at_max.size());
+                    TEST_CHECK_EQUAL(m_b.min(),   results[i].at_min[0]);
+                    TEST_CHECK_EQUAL(m_b.max(),   results[i].at_max[0]);
+                    TEST_CHECK_EQUAL(m_b_central, results[i].at_min[1]);
+                    TEST_CHECK_EQUAL(m_b_central, results[i].at_max[1]);
+
+                    // m_c
+                    TEST_CHECK_EQUAL(m_c_central, results[i + 1].central);
+                    TEST_CHECK_EQUAL(m_c_central, results[i + 1].at_min[0]);
+                    TEST_CHECK_EQUAL(m_c_central, results[i + 1].at_max[0]);
+                    TEST_CHECK_EQUAL(m_c.min(),   results[i + 1].at_min[1]);
+                    TEST_CHECK_EQUAL(m_c.max(),   results[i + 1].at_max[1]);
+                }
+
+                // the original parameters remain untouched
+                TEST_CHECK_EQUAL(m_b_central, m_b());
+                TEST_CHECK_EQUAL(m_c_central, m_c());
+
+                // changes to the original parameters are picked up by the next evaluation
+                m_b = m_b.max();
+                TEST_CHECK_EQUAL(m_b.max(), budget.evaluate()[0].central);
+            }
+        }
+} uncertainty_budget_test;
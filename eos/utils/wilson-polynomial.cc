@@ -18,10 +18,24 @@
  */
 
 #include <eos/observable.hh>
+#include <eos/utils/exception.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
+#include <eos/utils/private_implementation_pattern-impl.hh>
 #include <eos/utils/stringify.hh>
 #include <eos/utils/wilson-polynomial.hh>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
 
 namespace eos
 {
@@ -186,6 +200,328 @@ namespace eos
         return result;
     }
 
+    /* Binary serialization of WilsonPolynomial objects */
+    namespace
+    {
+        // tags of the individual elements, in prefix order
+        enum class ElementTag : std::uint8_t
+        {
+            constant = 1,
+            sum = 2,
+            product = 3,
+            sine = 4,
+            cosine = 5,
+            parameter = 6
+        };
+
+        template <typename T_> void write_value(std::ostream & stream, const T_ & value)
+        {
+            stream.write(reinterpret_cast<const char *>(&value), sizeof(T_));
+        }
+
+        template <typename T_> T_ read_value(std::istream & stream)
+        {
+            T_ result;
+            if (! stream.read(reinterpret_cast<char *>(&result), sizeof(T_)))
+                throw InternalError("read_polynomial: Unexpected end of input");
+
+            return result;
+        }
+
+        void write_string(std::ostream & stream, const std::string & value)
+        {
+            write_value(stream, std::uint32_t(value.size()));
+            stream.write(value.data(), value.size());
+        }
+
+        std::string read_string(std::istream & stream)
+        {
+            std::string result(read_value<std::uint32_t>(stream), '\0');
+            if (! stream.read(&result[0], result.size()))
+                throw InternalError("read_polynomial: Unexpected end of input");
+
+            return result;
+        }
+
+        class WilsonPolynomialWriter
+        {
+            private:
+                std::ostream & _stream;
+
+            public:
+                WilsonPolynomialWriter(std::ostream & stream) :
+                    _stream(stream)
+                {
+                }
+
+                void visit(const Constant & c)
+                {
+                    write_value(_stream, ElementTag::constant);
+                    write_value(_stream, c.value);
+                }
+
+                void visit(const Sum & s)
+                {
+                    write_value(_stream, ElementTag::sum);
+                    write_value(_stream, std::uint32_t(s.summands.size()));
+                    for (auto i = s.summands.cbegin(), i_end = s.summands.cend() ; i != i_end ; ++i)
+                    {
+                        i->accept(*this);
+                    }
+                }
+
+                void visit(const Product & p)
+                {
+                    write_value(_stream, ElementTag::product);
+                    p.x.accept(*this);
+                    p.y.accept(*this);
+                }
+
+                void visit(const Sine & s)
+                {
+                    write_value(_stream, ElementTag::sine);
+                    s.phi.accept(*this);
+                }
+
+                void visit(const Cosine & c)
+                {
+                    write_value(_stream, ElementTag::cosine);
+                    c.phi.accept(*this);
+                }
+
+                void visit(const Parameter & p)
+                {
+                    write_value(_stream, ElementTag::parameter);
+                    write_string(_stream, p.name());
+                }
+        };
+    }
+
+    void
+    write_polynomial(std::ostream & stream, const WilsonPolynomial & polynomial)
+    {
+        WilsonPolynomialWriter writer(stream);
+        polynomial.accept(writer);
+    }
+
+    WilsonPolynomial
+    read_polynomial(std::istream & stream, const Parameters & parameters)
+    {
+        switch (read_value<ElementTag>(stream))
+        {
+            case ElementTag::constant:
+                return Constant(read_value<double>(stream));
+
+            case ElementTag::sum:
+                {
+                    Sum result;
+                    for (std::uint32_t i = 0, i_end = read_value<std::uint32_t>(stream) ; i != i_end ; ++i)
+                    {
+                        result.add(read_polynomial(stream, parameters));
+                    }
+
+                    return result;
+                }
+
+            case ElementTag::product:
+                {
+                    // enforce the order of evaluation
+                    WilsonPolynomial x = read_polynomial(stream, parameters);
+                    WilsonPolynomial y = read_polynomial(stream, parameters);
+
+                    return Product(x, y);
+                }
+
+            case ElementTag::sine:
+                return Sine(read_polynomial(stream, parameters));
+
+            case ElementTag::cosine:
+                return Cosine(read_polynomial(stream, parameters));
+
+            case ElementTag::parameter:
+                return parameters[read_string(stream)];
+        }
+
+        throw InternalError("read_polynomial: Unknown element tag");
+    }
+
+    /* WilsonPolynomialStore */
+    template <>
+    struct Implementation<WilsonPolynomialStore>
+    {
+        // identifies the file format, including its version
+        static const char magic[8];
+
+        std::string file_name;
+
+        // the serialized polynomials, by key
+        std::map<std::string, std::string> polynomials;
+
+        Mutex mutex;
+
+        Implementation(const std::string & file_name) :
+            file_name(file_name)
+        {
+            std::ifstream file(file_name, std::ios::binary);
+            if (! file)
+                return;
+
+            char file_magic[sizeof(magic)];
+            if ((! file.read(file_magic, sizeof(magic))) || (0 != std::memcmp(file_magic, magic, sizeof(magic))))
+                throw InternalError("WilsonPolynomialStore: '" + file_name + "' is not a polynomial store, or has an unsupported format");
+
+            for (std::uint32_t i = 0, i_end = read_value<std::uint32_t>(file) ; i != i_end ; ++i)
+            {
+                std::string key = read_string(file);
+                polynomials[key] = read_string(file);
+            }
+
+            Log::instance()->message("wilson_polynomial_store.ctor", ll_informational)
+                << "Read " << polynomials.size() << " polynomials from '" << file_name << "'";
+        }
+
+        static std::string key(const ObservablePtr & observable, const std::list<std::string> & coefficients)
+        {
+            std::string result = observable->name().full()
+                + '[' + observable->kinematics().as_string() + ']'
+                + '(' + observable->options().as_string() + ')';
+
+            result += '{';
+            for (auto c = coefficients.cbegin(), c_end = coefficients.cend() ; c != c_end ; ++c)
+            {
+                if (c != coefficients.cbegin())
+                    result += ',';
+
+                result += *c;
+            }
+            result += '}';
+
+            // FNV-1a hash of the names and values of all other parameters
+            std::uint64_t hash = 14695981039346656037ull;
+            auto hash_bytes = [&hash] (const char * bytes, const std::size_t & size)
+            {
+                for (std::size_t i = 0 ; i < size ; ++i)
+                {
+                    hash ^= std::uint8_t(bytes[i]);
+                    hash *= 1099511628211ull;
+                }
+            };
+
+            Parameters parameters = observable->parameters();
+            for (auto p = parameters.begin(), p_end = parameters.end() ; p != p_end ; ++p)
+            {
+                if (coefficients.cend() != std::find(coefficients.cbegin(), coefficients.cend(), p->name()))
+                    continue;
+
+                const double value = p->evaluate();
+                hash_bytes(p->name().data(), p->name().size());
+                hash_bytes(reinterpret_cast<const char *>(&value), sizeof(double));
+            }
+
+            std::ostringstream stream;
+            stream << '#' << std::hex << std::setw(16) << std::setfill('0') << hash;
+
+            return result + stream.str();
+        }
+
+        bool has(const std::string & key)
+        {
+            Lock l(mutex);
+
+            return polynomials.end() != polynomials.find(key);
+        }
+
+        WilsonPolynomial polynomial(const ObservablePtr & observable, const std::list<std::string> & coefficients)
+        {
+            const std::string key = this->key(observable, coefficients);
+
+            {
+                Lock l(mutex);
+
+                auto i = polynomials.find(key);
+                if (polynomials.end() != i)
+                {
+                    std::istringstream stream(i->second);
+
+                    return read_polynomial(stream, observable->parameters());
+                }
+            }
+
+            // construct the polynomial without holding the lock
+            WilsonPolynomial result = make_polynomial(observable, coefficients);
+
+            std::ostringstream stream;
+            write_polynomial(stream, result);
+
+            {
+                Lock l(mutex);
+
+                polynomials[key] = stream.str();
+            }
+
+            return result;
+        }
+
+        void write()
+        {
+            Lock l(mutex);
+
+            // write to a temporary file first, so that an existing store is never left incomplete
+            const std::string temporary_file = file_name + ".tmp";
+            {
+                std::ofstream file(temporary_file, std::ios::binary | std::ios::trunc);
+                file.write(magic, sizeof(magic));
+                write_value(file, std::uint32_t(polynomials.size()));
+                for (auto p = polynomials.cbegin(), p_end = polynomials.cend() ; p != p_end ; ++p)
+                {
+                    write_string(file, p->first);
+                    write_string(file, p->second);
+                }
+
+                if (! file)
+                    throw InternalError("WilsonPolynomialStore::write: Could not write to '" + temporary_file + "'");
+            }
+
+            if (0 != std::rename(temporary_file.c_str(), file_name.c_str()))
+                throw InternalError("WilsonPolynomialStore::write: Could not replace store file '" + file_name + "'");
+        }
+    };
+
+    const char Implementation<WilsonPolynomialStore>::magic[8] = { 'E', 'O', 'S', '-', 'W', 'P', 'S', '1' };
+
+    WilsonPolynomialStore::WilsonPolynomialStore(const std::string & file_name) :
+        PrivateImplementationPattern<WilsonPolynomialStore>(new Implementation<WilsonPolynomialStore>(file_name))
+    {
+    }
+
+    WilsonPolynomialStore::~WilsonPolynomialStore()
+    {
+    }
+
+    std::string
+    WilsonPolynomialStore::key(const ObservablePtr & observable, const std::list<std::string> & coefficients)
+    {
+        return Implementation<WilsonPolynomialStore>::key(observable, coefficients);
+    }
+
+    bool
+    WilsonPolynomialStore::has(const ObservablePtr & observable, const std::list<std::string> & coefficients) const
+    {
+        return _imp->has(key(observable, coefficients));
+    }
+
+    WilsonPolynomial
+    WilsonPolynomialStore::polynomial(const ObservablePtr & observable, const std::list<std::string> & coefficients)
+    {
+        return _imp->polynomial(observable, coefficients);
+    }
+
+    void
+    WilsonPolynomialStore::write() const
+    {
+        _imp->write();
+    }
+
     class WilsonPolynomialRatio :
         public Observable
     {
@@ -21,8 +21,11 @@
 #define EOS_GUARD_SRC_UTILS_WILSON_POLYNOMIAL_HH 1
 
 #include <eos/observable.hh>
+#include <eos/utils/instantiation_policy.hh>
 #include <eos/utils/one-of.hh>
+#include <eos/utils/private_implementation_pattern.hh>
 
+#include <iosfwd>
 #include <list>
 #include <string>
 
@@ -42,6 +45,75 @@ namespace eos
 
     WilsonPolynomial make_polynomial(const ObservablePtr &, const std::list<std::string> &);
 
+    /*!
+     * Write a WilsonPolynomial to a binary stream.
+     *
+     * Parameters are stored by name. Numbers are stored in the native byte order.
+     *
+     * @param stream      The stream to which the polynomial shall be written.
+     * @param polynomial  The polynomial that shall be written.
+     */
+    void write_polynomial(std::ostream & stream, const WilsonPolynomial & polynomial);
+
+    /*!
+     * Read a WilsonPolynomial from a binary stream, as written by write_polynomial().
+     *
+     * @param stream      The stream from which the polynomial shall be read.
+     * @param parameters  The Parameters object to which the polynomial's parameters shall be bound.
+     */
+    WilsonPolynomial read_polynomial(std::istream & stream, const Parameters & parameters);
+
+    /*!
+     * Persistent store of WilsonPolynomial objects.
+     *
+     * Each polynomial is stored under a key that identifies the observable by its name,
+     * kinematics and options, the set of coefficients, and a hash of the values of
+     * all other parameters. Polynomials that are not found in the store are
+     * constructed with make_polynomial() and added to the store.
+     *
+     * All methods can be called concurrently.
+     */
+    class WilsonPolynomialStore :
+        public InstantiationPolicy<WilsonPolynomialStore, NonCopyable>,
+        public PrivateImplementationPattern<WilsonPolynomialStore>
+    {
+        public:
+            /*!
+             * Constructor.
+             *
+             * @param file_name  The name of the store's file. If the file exists, all of its polynomials are read.
+             */
+            WilsonPolynomialStore(const std::string & file_name);
+
+            /// Destructor.
+            ~WilsonPolynomialStore();
+
+            /*!
+             * Return the key under which the polynomial of an observable is stored.
+             *
+             * @param observable    The observable.
+             * @param coefficients  The names of the coefficients.
+             */
+            static std::string key(const ObservablePtr & observable, const std::list<std::string> & coefficients);
+
+            /// Return whether the polynomial of an observable is already stored.
+            bool has(const ObservablePtr & observable, const std::list<std::string> & coefficients) const;
+
+            /*!
+             * Retrieve the polynomial of an observable, and construct it if it is not yet stored.
+             *
+             * The polynomial's parameters are bound to the observable's Parameters object. Constructing
+             * the polynomial temporarily changes the coefficients' values in that object.
+             *
+             * @param observable    The observable.
+             * @param coefficients  The names of the coefficients.
+             */
+            WilsonPolynomial polynomial(const ObservablePtr & observable, const std::list<std::string> & coefficients);
+
+            /// Write all polynomials to the store's file.
+            void write() const;
+    };
+
     /*!
      * Return an Observable that wraps a WilsonPolynomial object.
      *
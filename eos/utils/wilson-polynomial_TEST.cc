@@ -23,6 +23,8 @@
 
 #include <array>
 #include <cmath>
+#include <cstdio>
+#include <sstream>
 #include <vector>
 
 #include <iostream>
@@ -180,3 +182,79 @@ class WilsonPolynomialClonerTest :
             TEST_CHECK_EQUAL(p.accept_returning<double>(evaluator), c.accept_returning<double>(evaluator));
         }
 } wilson_polynomial_cloner_test;
+
+class WilsonPolynomialStoreTest :
+    public TestCase
+{
+    public:
+        WilsonPolynomialStoreTest() :
+            TestCase("wilson_polynomial_store_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            static const std::list<std::string> coefficients{ "b->s::Re{c7}", "b->smumu::Re{c9}", "b->smumu::Re{c10}" };
+
+            Parameters parameters = Parameters::Defaults();
+            Kinematics kinematics;
+
+            ObservablePtr o = ObservablePtr(new WilsonPolynomialTestObservable(parameters, kinematics, Options()));
+            WilsonPolynomialPrinter printer;
+            WilsonPolynomialEvaluator evaluator;
+
+            // round trip through the binary format
+            {
+                WilsonPolynomial p = make_polynomial(o, coefficients);
+
+                std::stringstream stream;
+                write_polynomial(stream, p);
+
+                Parameters read_parameters = Parameters::Defaults();
+                WilsonPolynomial r = read_polynomial(stream, read_parameters);
+
+                TEST_CHECK_EQUAL(p.accept_returning<std::string>(printer), r.accept_returning<std::string>(printer));
+                TEST_CHECK_EQUAL(p.accept_returning<double>(evaluator), r.accept_returning<double>(evaluator));
+
+                // the read polynomial is bound to the parameters that were passed
+                read_parameters["b->smumu::Re{c9}"] = 3.0;
+                parameters["b->smumu::Re{c9}"] = 3.0;
+                TEST_CHECK_EQUAL(o->evaluate(), r.accept_returning<double>(evaluator));
+                parameters["b->smumu::Re{c9}"] = read_parameters["b->smumu::Re{c9}"].central();
+            }
+
+            // storing and reloading
+            {
+                static const std::string file_name(EOS_BUILDDIR "/eos/utils/wilson-polynomial_TEST.store");
+
+                std::remove(file_name.c_str());
+
+                double value;
+                {
+                    WilsonPolynomialStore store(file_name);
+                    TEST_CHECK(! store.has(o, coefficients));
+
+                    WilsonPolynomial p = store.polynomial(o, coefficients);
+                    TEST_CHECK(store.has(o, coefficients));
+                    value = p.accept_returning<double>(evaluator);
+
+                    store.write();
+                }
+
+                WilsonPolynomialStore store(file_name);
+                TEST_CHECK(store.has(o, coefficients));
+                TEST_CHECK_EQUAL(value, store.polynomial(o, coefficients).accept_returning<double>(evaluator));
+
+                // changing a Wilson coefficient keeps the key intact
+                parameters["b->s::Re{c7}"] = 0.5;
+                TEST_CHECK(store.has(o, coefficients));
+                TEST_CHECK_NEARLY_EQUAL(o->evaluate(), store.polynomial(o, coefficients).accept_returning<double>(evaluator), 1e-10);
+
+                // changing any other parameter invalidates the key
+                parameters["b->s::c1"] = 0.5;
+                TEST_CHECK(! store.has(o, coefficients));
+
+                std::remove(file_name.c_str());
+            }
+        }
+} wilson_polynomial_store_test;
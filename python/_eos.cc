@@ -25,6 +25,7 @@
 #include "eos/utils/parameters.hh"
 #include "eos/utils/options.hh"
 #include "eos/utils/qualified-name.hh"
+#include "eos/statistics/kernel-density-estimate.hh"
 #include "eos/statistics/log-likelihood.hh"
 
 #include <boost/python.hpp>
@@ -76,6 +77,120 @@ namespace impl
 
         return object();
     }
+
+    // convert a std::vector to a python list
+    list
+    to_list(const std::vector<double> & values)
+    {
+        list result;
+        for (const auto & v : values)
+        {
+            result.append(v);
+        }
+
+        return result;
+    }
+
+    // add samples from python sequences to a KernelDensityEstimate<1>
+    void
+    KernelDensityEstimate1D_add_samples(KernelDensityEstimate<1> & kde, object values, object weights)
+    {
+        const unsigned size = len(values);
+        const bool weighted = ! weights.is_none();
+        if (weighted && (len(weights) != size))
+            throw InternalError("KernelDensityEstimate1D.add_samples: number of values and weights differ");
+
+        for (unsigned i = 0 ; i < size ; ++i)
+        {
+            kde.add(extract<double>(values[i]), weighted ? extract<double>(weights[i]) : 1.0);
+        }
+    }
+
+    list
+    KernelDensityEstimate1D_grid(const KernelDensityEstimate<1> & kde)
+    {
+        return to_list(kde.grid());
+    }
+
+    list
+    KernelDensityEstimate1D_density(const KernelDensityEstimate<1> & kde)
+    {
+        return to_list(kde.density());
+    }
+
+    list
+    KernelDensityEstimate1D_hpd_intervals(const KernelDensityEstimate<1> & kde, const double & probability)
+    {
+        list result;
+        for (const auto & i : kde.hpd_intervals(probability))
+        {
+            result.append(make_tuple(i[0], i[1]));
+        }
+
+        return result;
+    }
+
+    // constructor for class KernelDensityEstimate<2>, from python sequences of the lower and upper corners
+    KernelDensityEstimate<2> *
+    KernelDensityEstimate2D_ctor(object lower, object upper, const KernelDensityEstimate<2>::Config & config)
+    {
+        return new KernelDensityEstimate<2>(
+                std::array<double, 2>{{ extract<double>(lower[0]), extract<double>(lower[1]) }},
+                std::array<double, 2>{{ extract<double>(upper[0]), extract<double>(upper[1]) }},
+                config);
+    }
+
+    // add samples from python sequences to a KernelDensityEstimate<2>
+    void
+    KernelDensityEstimate2D_add_samples(KernelDensityEstimate<2> & kde, object x, object y, object weights)
+    {
+        const unsigned size = len(x);
+        const bool weighted = ! weights.is_none();
+        if ((len(y) != size) || (weighted && (len(weights) != size)))
+            throw InternalError("KernelDensityEstimate2D.add_samples: number of coordinates and weights differ");
+
+        for (unsigned i = 0 ; i < size ; ++i)
+        {
+            kde.add(std::array<double, 2>{{ extract<double>(x[i]), extract<double>(y[i]) }},
+                    weighted ? extract<double>(weights[i]) : 1.0);
+        }
+    }
+
+    tuple
+    KernelDensityEstimate2D_bandwidth(const KernelDensityEstimate<2> & kde)
+    {
+        auto bandwidth = kde.bandwidth();
+
+        return make_tuple(bandwidth[0], bandwidth[1]);
+    }
+
+    list
+    KernelDensityEstimate2D_grid(const KernelDensityEstimate<2> & kde, const unsigned & axis)
+    {
+        return to_list(kde.grid(axis));
+    }
+
+    // the density as a list of rows
+    list
+    KernelDensityEstimate2D_density(const KernelDensityEstimate<2> & kde)
+    {
+        const auto & density = kde.density();
+        const unsigned size = kde.grid(0).size();
+
+        list result;
+        for (unsigned i = 0 ; i < size ; ++i)
+        {
+            result.append(to_list(std::vector<double>(density.begin() + i * size, density.begin() + (i + 1) * size)));
+        }
+
+        return result;
+    }
+
+    double
+    KernelDensityEstimate2D_call(const KernelDensityEstimate<2> & kde, const double & x, const double & y)
+    {
+        return kde(std::array<double, 2>{{ x, y }});
+    }
 }
 
 BOOST_PYTHON_MODULE(_eos)
@@ -198,4 +313,54 @@ BOOST_PYTHON_MODULE(_eos)
         .def("m_s_msbar",  &Model::m_s_msbar)
         .def("m_ud_msbar", &Model::m_ud_msbar)
         ;
+
+    // Bandwidth
+    enum_<Bandwidth>("Bandwidth")
+        .value("silverman", bw_silverman)
+        .value("scott",     bw_scott)
+        .value("plug_in",   bw_plug_in)
+        ;
+
+    // KernelDensityEstimate<1>
+    class_<KernelDensityEstimate<1>::Config>("KernelDensityEstimate1DConfig", no_init)
+        .def("Default", &KernelDensityEstimate<1>::Config::Default)
+        .staticmethod("Default")
+        .def_readwrite("bandwidth", &KernelDensityEstimate<1>::Config::bandwidth)
+        .def_readwrite("bandwidth_factor", &KernelDensityEstimate<1>::Config::bandwidth_factor)
+        .def_readwrite("number_of_bins", &KernelDensityEstimate<1>::Config::number_of_bins)
+        ;
+
+    class_<KernelDensityEstimate<1>>("KernelDensityEstimate1D", init<double, double, KernelDensityEstimate<1>::Config>())
+        .def("add", &KernelDensityEstimate<1>::add)
+        .def("add_samples", &impl::KernelDensityEstimate1D_add_samples, (arg("self"), arg("values"), arg("weights") = object()))
+        .def("number_of_samples", &KernelDensityEstimate<1>::number_of_samples)
+        .def("effective_sample_size", &KernelDensityEstimate<1>::effective_sample_size)
+        .def("bandwidth", &KernelDensityEstimate<1>::bandwidth)
+        .def("grid", &impl::KernelDensityEstimate1D_grid)
+        .def("density", &impl::KernelDensityEstimate1D_density)
+        .def("__call__", &KernelDensityEstimate<1>::operator())
+        .def("hpd_level", &KernelDensityEstimate<1>::hpd_level)
+        .def("hpd_intervals", &impl::KernelDensityEstimate1D_hpd_intervals)
+        ;
+
+    // KernelDensityEstimate<2>
+    class_<KernelDensityEstimate<2>::Config>("KernelDensityEstimate2DConfig", no_init)
+        .def("Default", &KernelDensityEstimate<2>::Config::Default)
+        .staticmethod("Default")
+        .def_readwrite("bandwidth", &KernelDensityEstimate<2>::Config::bandwidth)
+        .def_readwrite("bandwidth_factor", &KernelDensityEstimate<2>::Config::bandwidth_factor)
+        .def_readwrite("number_of_bins", &KernelDensityEstimate<2>::Config::number_of_bins)
+        ;
+
+    class_<KernelDensityEstimate<2>>("KernelDensityEstimate2D", no_init)
+        .def("__init__", make_constructor(&impl::KernelDensityEstimate2D_ctor))
+        .def("add_samples", &impl::KernelDensityEstimate2D_add_samples, (arg("self"), arg("x"), arg("y"), arg("weights") = object()))
+        .def("number_of_samples", &KernelDensityEstimate<2>::number_of_samples)
+        .def("effective_sample_size", &KernelDensityEstimate<2>::effective_sample_size)
+        .def("bandwidth", &impl::KernelDensityEstimate2D_bandwidth)
+        .def("grid", &impl::KernelDensityEstimate2D_grid)
+        .def("density", &impl::KernelDensityEstimate2D_density)
+        .def("__call__", &impl::KernelDensityEstimate2D_call)
+        .def("hpd_level", &KernelDensityEstimate<2>::hpd_level)
+        ;
 }
@@ -29,6 +29,49 @@ class FileFormatError(Exception):
         return 'Expected file format %s, found %s instead' % (self.expected, self.found)
 
 
+def _columns(parameters, names):
+    """Map parameter names onto the columns of the samples"""
+    if names is None:
+        return None
+
+    known = [p[0].decode() if isinstance(p[0], bytes) else p[0] for p in parameters]
+    result = []
+    for name in names:
+        if name not in known:
+            raise KeyError('unknown parameter \'%s\'' % name)
+        result.append(known.index(name))
+
+    return result
+
+
+def _read(datasets, first, last, columns):
+    """Read the rows [first, last) of the concatenation of several datasets, keeping only the requested columns"""
+    result = []
+    offset = 0
+    for dset in datasets:
+        size = len(dset)
+        lo = max(first - offset, 0) if first is not None else 0
+        hi = min(last - offset, size) if last is not None else size
+        offset += size
+
+        if lo >= hi:
+            continue
+
+        # only the selected rows are read from disk
+        chunk = numpy.array(dset[lo:hi])
+        if columns is not None:
+            chunk = chunk[:, columns]
+        result.append(chunk)
+
+    if not result:
+        # no rows selected, keep the shape of the samples
+        width = len(columns) if columns is not None else (datasets[0].shape[1] if datasets else 0)
+        dtype = datasets[0].dtype if datasets else numpy.float64
+        return numpy.empty((0, width), dtype=dtype)
+
+    return numpy.concatenate(result, axis=0)
+
+
 class PMCDataFile:
     def __init__(self, file):
         # open the input file for reading
@@ -50,8 +93,11 @@ class PMCDataFile:
     def __del__(self):
         self.file.close()
 
-    """Retrieve data"""
-    def data(self):
+    """Retrieve data
+
+    Optionally, only the samples [first, last) and only the named parameters are retrieved.
+    """
+    def data(self, first=None, last=None, parameters=None):
         step = 'final'
 
         if '/data/%s/samples' % step not in self.file:
@@ -59,7 +105,7 @@ class PMCDataFile:
 
         dataset = self.file['/data/%s/samples' % step]
 
-        return numpy.array(dataset[:])
+        return _read([dataset], first, last, _columns(self.parameters, parameters))
 
 
 class MCMCDataFile:
@@ -85,8 +131,12 @@ class MCMCDataFile:
     def __del__(self):
         self.file.close()
 
-    """Retrieve data"""
-    def data(self):
+    """Retrieve data
+
+    The chains are concatenated. Optionally, only the samples [first, last) of
+    the concatenation and only the named parameters are retrieved.
+    """
+    def data(self, first=None, last=None, parameters=None):
         groupname = 'main run'
 
         if 'main run' not in self.file:
@@ -95,20 +145,9 @@ class MCMCDataFile:
 
         group = self.file[groupname]
 
-        # start with no data
-        data = None
-
-        # append each dataset to data
-        for chainname in group:
-            chain = group[chainname]
-            dset = chain['samples']
+        datasets = [group[chainname]['samples'] for chainname in group]
 
-            if data == None:
-                data = numpy.array(dset[:])
-            else:
-                data = numpy.append(data, dset[:], axis=0)
-
-        return data
+        return _read(datasets, first, last, _columns(self.parameters, parameters))
 
 
 class UncertaintyDataFile:
@@ -240,11 +240,12 @@ class Plotter1D:
         # plot
         plt.hist(data, bins=100, normed=1, alpha=.3)
         if options['kde']:
-            kde = gaussian_kde(data)
-            kde.set_bandwidth(bw_method='silverman')
-            kde.set_bandwidth(bw_method=kde.factor * options['kde_bandwidth'])
-            x = numpy.linspace(xmin, xmax, 1000)
-            plot.plot(x, kde(x), 'r')
+            config = eos.KernelDensityEstimate1DConfig.Default()
+            config.bandwidth = eos.Bandwidth.silverman
+            config.bandwidth_factor = options['kde_bandwidth']
+            kde = eos.KernelDensityEstimate1D(xmin, xmax, config)
+            kde.add_samples(data)
+            plt.plot(kde.grid(), kde.density(), 'r')
 
         plt.tight_layout()
 
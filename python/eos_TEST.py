@@ -161,6 +161,27 @@ class PythonTests:
         except:
             raise TestFailedError('cannot determine running b quark mass')
 
+    def check_009_KernelDensityEstimate(self):
+        """Check if a one-dimensional kernel density estimate can be created and evaluated."""
+        from eos import Bandwidth, KernelDensityEstimate1D, KernelDensityEstimate1DConfig
+
+        try:
+            config = KernelDensityEstimate1DConfig.Default()
+            config.bandwidth = Bandwidth.scott
+            kde = KernelDensityEstimate1D(-1.0, +1.0, config)
+            kde.add_samples([-0.5, 0.0, 0.0, 0.5], [1.0, 2.0, 2.0, 1.0])
+        except:
+            raise TestFailedError('cannot create KernelDensityEstimate1D')
+
+        if not kde.number_of_samples() == 4:
+            raise TestFailedError('wrong number of samples')
+
+        if not len(kde.density()) == config.number_of_bins:
+            raise TestFailedError('wrong number of grid points')
+
+        if not kde(0.0) > kde(0.5):
+            raise TestFailedError('density is not peaked at the mode')
+
 # Run all test cases.
 tests = PythonTests()
 for (name, testcase) in inspect.getmembers(tests, predicate=inspect.ismethod):
@@ -23,6 +23,7 @@
 #include <eos/utils/instantiation_policy-impl.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/power_of.hh>
+#include <eos/utils/uncertainty-budget.hh>
 
 #include <cmath>
 #include <cstdlib>
@@ -76,12 +77,15 @@ class CommandLine :
 
         bool use_budget;
 
+        bool parallelize;
+
         int precision;
 
         CommandLine() :
             parameters(Parameters::Defaults()),
             budgets{std::make_tuple(std::string("delta"), std::vector<Parameter>())},
             use_budget(false),
+            parallelize(true),
             precision(-1)
         {
         }
@@ -103,6 +107,13 @@ class CommandLine :
                 	continue;
                 }
 
+                if ("--parallel" == argument)
+                {
+                    parallelize = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
                 if ("--kinematics" == argument)
                 {
                     std::string name = std::string(*(++a));
@@ -208,7 +219,34 @@ class CommandLine :
         }
 };
 
-void evaluate_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluation_input)
+// Add all kinematic points of one input to the budget.
+void add_points(UncertaintyBudget & budget, const std::shared_ptr<EvaluationInput> evaluation_input)
+{
+    // check if the kinematical ranges are empty
+    if (evaluation_input->ranges.size() == 0)
+    {
+        budget.add(evaluation_input->observable);
+
+        return;
+    }
+
+    // iterate over all kinematical ranges
+    for (auto r = evaluation_input->ranges.begin() ; r != evaluation_input->ranges.end() ; ++r)
+    {
+        // set the kinematics for every dimension
+        std::vector<std::pair<std::string, double>> kinematics;
+        for (std::size_t i = 0 ; i < (*r).size() ; ++i)
+        {
+            kinematics.push_back(std::make_pair(evaluation_input->kinematic_names[i], (*r)[i]));
+        }
+
+        budget.add(evaluation_input->observable, kinematics);
+    }
+}
+
+// Print the results for all kinematic points of one input, starting with the point at index 'first'.
+unsigned print_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluation_input,
+        const std::vector<UncertaintyBudget::Result> & results, unsigned first)
 {
     // print headlines
     std::cout << "# " << evaluation_input->observable->name()
@@ -231,78 +269,48 @@ void evaluate_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluat
     if (precision != -1)
         std::cout.precision(precision);
 
-    bool ranges_empty = false;
-    // check if the kinematical ranges are empty
-    if (evaluation_input->ranges.size() == 0)
-    {
-        ranges_empty = true;
+    // a dummy point is evaluated if the kinematical ranges are empty
+    const bool ranges_empty = (evaluation_input->ranges.size() == 0);
+    const unsigned last = first + (ranges_empty ? 1 : evaluation_input->ranges.size());
 
-        // create a vector with a single entry
-        std::vector<double> range(1, 1.0);
-        // insert a dummy value for the for-loop
-        evaluation_input->ranges.over(range);
-    }
-
-    // iterate over all kinematical ranges
-    for (auto r = evaluation_input->ranges.begin() ; r != evaluation_input->ranges.end() ; ++r)
+    auto r = evaluation_input->ranges.begin();
+    for (unsigned i = first ; i < last ; ++i)
     {
-        if (!ranges_empty)
+        if (! ranges_empty)
         {
-            // set the kinematics
-            // for every dimension
-            for (std::size_t i = 0 ; i < (*r).size() ; ++i)
+            for (std::size_t j = 0 ; j < (*r).size() ; ++j)
             {
-                evaluation_input->kinematics->set(evaluation_input->kinematic_names[i], (*r)[i]);
-                std::cout << (*r)[i] << '\t';
+                std::cout << (*r)[j] << '\t';
             }
+            ++r;
         }
 
-        double central = evaluation_input->observable->evaluate();
+        const UncertaintyBudget::Result & result = results[i];
+        const double central = result.central;
 
         std::cout << central;
 
-        // do the variations
+        // collect the variations, which are ordered by budget
         double delta_max = 0.0, delta_min = 0.0;
+        unsigned v = 0;
         for (auto b = CommandLine::instance()->budgets.begin() ; b != CommandLine::instance()->budgets.end() ; ++b)
         {
             double budget_min = 0.0;
             double budget_max = 0.0;
 
-            std::vector<Parameter> variations = std::get<1>(*b);
-
-            for (auto v = variations.begin(), v_end = variations.end() ; v != v_end ; ++v)
+            for (std::size_t j = 0 ; j < std::get<1>(*b).size() ; ++j, ++v)
             {
-                double old_v = *v;
-
-                // raise value
-                *v = v->max();
-
-                double value = evaluation_input->observable->evaluate();
-
-                if (value > central)
-                {
-                    budget_max += power_of<2>(value - central);
-                }
-                else if (value < central)
-                {
-                    budget_min += power_of<2>(value - central);
-                }
-
-                // lower value
-                *v = v->min();
-
-                value = evaluation_input->observable->evaluate();
-
-                if (value > central)
+                for (double value : { result.at_max[v], result.at_min[v] })
                 {
-                    budget_max += power_of<2>(value - central);
-                }
-                else if (value < central)
-                {
-                    budget_min += power_of<2>(value - central);
+                    if (value > central)
+                    {
+                        budget_max += power_of<2>(value - central);
+                    }
+                    else if (value < central)
+                    {
+                        budget_min += power_of<2>(value - central);
+                    }
                 }
-
-                *v = old_v;
             }
 
             delta_min += budget_min;
@@ -316,6 +324,8 @@ void evaluate_with_sum_of_squares(const std::shared_ptr<EvaluationInput> evaluat
             << "   (-" << std::abs(std::sqrt(delta_min) / central) * 100 << "% / +" << std::abs(std::sqrt(delta_max) / central) * 100 << "%)"
             << std::endl;
     }
+
+    return last;
 }
 
 
@@ -329,9 +339,28 @@ main(int argc, char * argv[])
         if (CommandLine::instance()->evaluation_inputs.empty())
             throw DoUsage("No input specified");
 
+        // all budgets are evaluated in one go, so that all evaluations can be distributed among the threads
+        std::vector<Parameter> variations;
+        for (const auto & b : CommandLine::instance()->budgets)
+        {
+            variations.insert(variations.end(), std::get<1>(b).begin(), std::get<1>(b).end());
+        }
+
+        UncertaintyBudget::Config config = UncertaintyBudget::Config::Default();
+        config.parallelize = CommandLine::instance()->parallelize;
+
+        UncertaintyBudget budget(CommandLine::instance()->parameters, variations, config);
+        for (auto i = CommandLine::instance()->evaluation_inputs.cbegin(), i_end = CommandLine::instance()->evaluation_inputs.cend() ; i != i_end ; ++i)
+        {
+            add_points(budget, *i);
+        }
+
+        const std::vector<UncertaintyBudget::Result> results = budget.evaluate();
+
+        unsigned first = 0;
         for (auto i = CommandLine::instance()->evaluation_inputs.cbegin(), i_end = CommandLine::instance()->evaluation_inputs.cend() ; i != i_end ; ++i)
         {
-            evaluate_with_sum_of_squares(*i);
+            first = print_with_sum_of_squares(*i, results, first);
         }
     }
     catch(DoUsage & e)
@@ -339,6 +368,7 @@ main(int argc, char * argv[])
         std::cout << e.what() << std::endl;
         std::cout << "Usage: eos-evaluate" << std::endl;
         std::cout << "  [--precision PRECISION]" << std::endl;
+        std::cout << "  [--parallel [0|1]]" << std::endl;
         std::cout << "  [--vary PARAMETER]*" << std::endl;
         std::cout << "  [{--budget BUDGET[--parameter PARAMETER]*}*|{--parameter PARAMETER}*]" << std::endl;
         std::cout << "  [[--kinematics NAME VALUE|--range NAME MIN MAX POINTS]* --observable OBSERVABLE]*" << std::endl;
@@ -24,6 +24,7 @@
 #include <eos/observable.hh>
 #include <eos/optimize/optimizer-gsl.hh>
 #include <eos/statistics/analysis.hh>
+#include <eos/statistics/laplace-approximation.hh>
 #include <eos/utils/destringify.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
 #include <eos/utils/log.hh>
@@ -116,12 +117,20 @@ class CommandLine :
 
         double target_precision;
 
+        // expand around the mode found
+        bool laplace;
+
+        // expand around the starting point, without optimization
+        bool fisher;
+
         CommandLine() :
             parameters(Parameters::Defaults()),
             likelihood(parameters),
             analysis(likelihood),
             max_iterations(500),
-            target_precision(1e-8)
+            target_precision(1e-8),
+            laplace(false),
+            fisher(false)
         {
         }
 
@@ -386,6 +395,20 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--laplace" == argument)
+                {
+                    laplace = true;
+
+                    continue;
+                }
+
+                if ("--fisher" == argument)
+                {
+                    fisher = true;
+
+                    continue;
+                }
+
                 if ("--print-args" == argument)
                 {
                     // print arguments and quit
@@ -413,6 +436,32 @@ class CommandLine :
         }
 };
 
+void print_laplace_approximation(const Analysis & analysis, const LaplaceApproximation::Result & result)
+{
+    const unsigned k = result.point.size();
+
+    std::cout << "# Gaussian approximation at " << stringify_container(result.point, 6) << std::endl;
+    std::cout << "#   log(density)  = " << result.log_density << std::endl;
+    std::cout << "#   log(evidence) = " << result.log_evidence << std::endl;
+    std::cout << "# Marginal widths:" << std::endl;
+    for (unsigned i = 0 ; i < k ; ++i)
+    {
+        std::cout << "#   " << analysis.parameter_descriptions()[i].parameter->name()
+            << " = " << result.point[i] << " +/- " << result.widths[i] << std::endl;
+    }
+    std::cout << "# Covariance matrix:" << std::endl;
+    for (unsigned i = 0 ; i < k ; ++i)
+    {
+        std::cout << "#  ";
+        for (unsigned j = 0 ; j < k ; ++j)
+        {
+            std::cout << ' ' << result.covariance[i * k + j];
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "# Eigenvalues of the covariance matrix: " << stringify_container(result.eigenvalues, 6) << std::endl;
+}
+
 int main(int argc, char * argv[])
 {
     try
@@ -484,6 +533,9 @@ int main(int argc, char * argv[])
             }
         }
 
+        if (inst->fisher && inst->starting_point.empty())
+            throw DoUsage("The Fisher forecast requires a starting point");
+
         // run optimization. Use starting point if given, else sample a point from the prior.
         if (inst->starting_point.empty())
         {
@@ -502,6 +554,15 @@ int main(int argc, char * argv[])
                           + " doesn't match with analysis size of " + stringify(inst->analysis.parameter_descriptions().size()));
         }
 
+        if (inst->fisher)
+        {
+            // Fisher forecast: expand around the starting point, without optimization
+            LaplaceApproximation laplace(inst->analysis.clone(), LaplaceApproximation::Config::Default());
+            print_laplace_approximation(inst->analysis, laplace.compute(inst->starting_point));
+
+            return EXIT_SUCCESS;
+        }
+
         std::cout << std::endl;
         std::cout << "# Starting optimization at " << stringify_container(inst->starting_point, 4) << std::endl;
         std::cout << std::endl;
@@ -520,6 +581,18 @@ int main(int argc, char * argv[])
             }
             std::cout << " )" << std::endl;
             std::cout << "#   value = " << maximum << std::endl;
+
+            if (inst->laplace)
+            {
+                std::vector<double> mode;
+                for (auto && p : inst->analysis)
+                {
+                    mode.push_back(p.parameter->evaluate());
+                }
+
+                LaplaceApproximation laplace(inst->analysis.clone(), LaplaceApproximation::Config::Default());
+                print_laplace_approximation(inst->analysis, laplace.compute(mode));
+            }
         }
         catch (OptimizerError & e)
         {
@@ -620,6 +693,7 @@ int main(int argc, char * argv[])
         std::cout << "  [--starting-point [{ PAR_VALUE1 PAR_VALUE2 ... PAR_VALUEN }]]" << std::endl;
         std::cout << "  [--max-iterations VALUE]" << std::endl;
         std::cout << "  [--target-precision VALUE]" << std::endl;
+        std::cout << "  [--laplace | --fisher]" << std::endl;
 
         std::cout << std::endl;
         std::cout << "Example:" << std::endl;
@@ -20,16 +20,22 @@
 #include <eos/observable.hh>
 #include <eos/utils/destringify.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/mutex.hh>
 #include <eos/utils/one-of.hh>
 #include <eos/utils/stringify.hh>
+#include <eos/utils/thread_pool.hh>
 #include <eos/utils/wilson-polynomial.hh>
 
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <exception>
 #include <iostream>
 #include <list>
+#include <memory>
+#include <vector>
 
 using namespace eos;
 
@@ -65,6 +71,8 @@ class CommandLine :
 
         std::list<ObservableInput> inputs;
 
+        std::string store_file;
+
         CommandLine() :
             parameters(Parameters::Defaults())
         {
@@ -98,6 +106,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--store" == argument)
+                {
+                    store_file = std::string(*(++a));
+
+                    continue;
+                }
+
                 if ("--observable" == argument)
                 {
                     std::string name(*(++a));
@@ -128,11 +143,73 @@ main(int argc, char * argv[])
         if (CommandLine::instance()->inputs.empty())
             throw DoUsage("No input specified");
 
+        // without a store file, the polynomials are only kept in memory
+        std::unique_ptr<WilsonPolynomialStore> store;
+        if (! CommandLine::instance()->store_file.empty())
+            store.reset(new WilsonPolynomialStore(CommandLine::instance()->store_file));
+
+        const auto & inputs = CommandLine::instance()->inputs;
+        const auto & coefficients = CommandLine::instance()->coefficients;
+        const Parameters & parameters = CommandLine::instance()->parameters;
+
+        // construct the polynomials in parallel; each task works on its own set of parameters,
+        // and the result is bound to the common parameters afterwards
+        std::vector<std::shared_ptr<WilsonPolynomial>> polynomials(inputs.size());
+        std::vector<std::exception_ptr> failures(inputs.size());
+        std::vector<Ticket> tickets;
+        Mutex clone_mutex;
+        unsigned index = 0;
+        for (auto i = inputs.cbegin(), i_end = inputs.cend() ; i != i_end ; ++i, ++index)
+        {
+            std::shared_ptr<WilsonPolynomial> * polynomial = &polynomials[index];
+            std::exception_ptr * failure = &failures[index];
+            ObservablePtr observable = i->observable;
+            WilsonPolynomialStore * s = store.get();
+            tickets.push_back(ThreadPool::instance()->enqueue([polynomial, failure, observable, s, &coefficients, &parameters, &clone_mutex] ()
+            {
+                try
+                {
+                    ObservablePtr clone;
+                    {
+                        // the construction of observables is not guaranteed to be thread safe
+                        Lock l(clone_mutex);
+                        clone = observable->clone(parameters.clone());
+                    }
+
+                    WilsonPolynomial result = s ? s->polynomial(clone, coefficients) : make_polynomial(clone, coefficients);
+
+                    Lock l(clone_mutex);
+                    WilsonPolynomialCloner cloner(parameters);
+                    polynomial->reset(new WilsonPolynomial(result.accept_returning<WilsonPolynomial>(cloner)));
+                }
+                catch (...)
+                {
+                    *failure = std::current_exception();
+                }
+            }));
+        }
+
+        for (auto t = tickets.begin(), t_end = tickets.end() ; t != t_end ; ++t)
+        {
+            t->wait();
+        }
+
+        // report the first failure only after all tasks have finished, as they refer to local state
+        for (auto f = failures.cbegin(), f_end = failures.cend() ; f != f_end ; ++f)
+        {
+            if (*f)
+                std::rethrow_exception(*f);
+        }
+
+        if (store)
+            store->write();
+
         WilsonPolynomialEvaluator evaluator;
         WilsonPolynomialPrinter printer;
-        for (auto i = CommandLine::instance()->inputs.cbegin(), i_end = CommandLine::instance()->inputs.cend() ; i != i_end ; ++i)
+        index = 0;
+        for (auto i = inputs.cbegin(), i_end = inputs.cend() ; i != i_end ; ++i, ++index)
         {
-            WilsonPolynomial polynomial = make_polynomial(i->observable, CommandLine::instance()->coefficients);
+            const WilsonPolynomial & polynomial = *polynomials[index];
 
             std::cout << i->observable->name() << "[";
 
@@ -157,6 +234,7 @@ main(int argc, char * argv[])
         std::cout << e.what() << std::endl;
         std::cout << "Usage: eos-print-polynomial" << std::endl;
         std::cout << "  [--coefficient WILSONCOEFFICIENT]*" << std::endl;
+        std::cout << "  [--store FILE]" << std::endl;
         std::cout << "  [[--kinematics NAME VALUE]* --observable NAME]+" << std::endl;
     }
     catch(Exception & e)
@@ -0,0 +1,372 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <eos/statistics/posterior-summary.hh>
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/destringify.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/stringify.hh>
+
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace eos;
+
+class DoUsage
+{
+    private:
+        std::string _what;
+
+    public:
+        DoUsage(const std::string & what) :
+            _what(what)
+        {
+        }
+
+        const std::string & what() const
+        {
+            return _what;
+        }
+};
+
+class CommandLine :
+    public InstantiationPolicy<CommandLine, Singleton>
+{
+    public:
+        PosteriorSummary::Config config;
+
+        std::string mcmc_file;
+
+        std::string mcmc_directory;
+
+        std::string pmc_sample_file;
+        unsigned pmc_sample_min, pmc_sample_max;
+
+        std::string pmc_sample_directory;
+
+        std::string uncertainty_file;
+
+        std::shared_ptr<std::fstream> output;
+
+        CommandLine() :
+            config(PosteriorSummary::Config::Default()),
+            mcmc_directory("/main run"),
+            pmc_sample_min(0),
+            pmc_sample_max(0),
+            pmc_sample_directory("/data")
+        {
+        }
+
+        void parse(int argc, char ** argv)
+        {
+            Log::instance()->set_log_level(ll_informational);
+            Log::instance()->set_program_name("eos-print-uncertainty");
+
+            for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+            {
+                std::string argument(*a);
+
+                if ("--chunk-size" == argument)
+                {
+                    config.chunk_size = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--compression" == argument)
+                {
+                    config.compression = destringify<double>(*(++a));
+
+                    continue;
+                }
+
+                if ("--debug" == argument)
+                {
+                    Log::instance()->set_log_level(ll_debug);
+
+                    continue;
+                }
+
+                if ("--exact-quantiles" == argument)
+                {
+                    config.exact_quantiles = true;
+
+                    continue;
+                }
+
+                if ("--mcmc-input" == argument)
+                {
+                    mcmc_file = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--mcmc-directory" == argument)
+                {
+                    mcmc_directory = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--output" == argument)
+                {
+                    std::string filename(*(++a));
+
+                    output = std::shared_ptr<std::fstream>(new std::fstream(filename, std::fstream::out | std::fstream::trunc));
+
+                    continue;
+                }
+
+                if ("--parallel" == argument)
+                {
+                    config.parallelize = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--pmc-sample-directory" == argument)
+                {
+                    pmc_sample_directory = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--pmc-input" == argument)
+                {
+                    pmc_sample_file = std::string(*(++a));
+                    pmc_sample_min = destringify<unsigned>(*(++a));
+                    pmc_sample_max = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--uncertainty-input" == argument)
+                {
+                    uncertainty_file = std::string(*(++a));
+
+                    continue;
+                }
+
+                throw DoUsage("Unknown command line argument: " + argument);
+            }
+        }
+};
+
+// Stream the observables produced by PriorSampler into the summary.
+std::shared_ptr<PosteriorSummary> summarize_uncertainty(const std::string & file_name, const PosteriorSummary::Config & config)
+{
+    auto file = hdf5::File::Open(file_name, H5F_ACC_RDONLY);
+
+    const hdf5::Composite<hdf5::Scalar<double>, hdf5::Scalar<double>> description_type
+    {
+        "kinematics",
+        hdf5::Scalar<double>("s_min"),
+        hdf5::Scalar<double>("s_max"),
+    };
+
+    std::vector<std::string> names;
+    const unsigned dimension = file.number_of_objects("/descriptions/observables");
+    for (unsigned i = 0 ; i < dimension ; ++i)
+    {
+        auto data_set = file.open_data_set("/descriptions/observables/" + stringify(i), description_type);
+        names.push_back(data_set.open_attribute("name", hdf5::Scalar<const char *>("name")).value());
+    }
+
+    auto summary = std::make_shared<PosteriorSummary>(names, config);
+
+    auto data_set = file.open_data_set("/data/observables", hdf5::Array<1, double>("observables", { dimension }));
+    const unsigned size = data_set.records();
+    const unsigned chunk_size = std::max(config.chunk_size, 1u);
+    std::vector<double> samples(chunk_size * dimension);
+    for (unsigned first = 0 ; first < size ; first += chunk_size)
+    {
+        const unsigned count = std::min(chunk_size, size - first);
+        data_set.read(first, count, samples.data());
+        summary->add(samples.data(), count);
+    }
+
+    return summary;
+}
+
+int main(int argc, char * argv[])
+{
+    try
+    {
+        auto inst = CommandLine::instance();
+
+        inst->parse(argc, argv);
+
+        if (inst->mcmc_file.empty() && inst->pmc_sample_file.empty() && inst->uncertainty_file.empty())
+            throw DoUsage("Either specify \n a) an MCMC input file\n b) a PMC input file\n c) an uncertainty input file");
+
+        std::shared_ptr<PosteriorSummary> summary;
+        if (! inst->uncertainty_file.empty())
+        {
+            summary = summarize_uncertainty(inst->uncertainty_file, inst->config);
+        }
+        else
+        {
+            std::shared_ptr<SampleStore> samples;
+            if (! inst->mcmc_file.empty())
+            {
+                // samples from Markov chains are equally weighted
+                samples.reset(new SampleStore(SampleStore::MarkovChains(inst->mcmc_file, inst->mcmc_directory,
+                        SampleStore::Config::Default())));
+            }
+            else if (inst->pmc_sample_min < inst->pmc_sample_max)
+            {
+                samples.reset(new SampleStore(SampleStore::PopulationMonteCarlo(inst->pmc_sample_file, inst->pmc_sample_directory,
+                        SampleStore::Config::Default()).slice(inst->pmc_sample_min, inst->pmc_sample_max)));
+            }
+            else
+            {
+                throw DoUsage("Empty range of PMC samples");
+            }
+
+            std::vector<std::string> names;
+            for (const auto & d : samples->descriptions())
+            {
+                names.push_back(d.parameter->name());
+            }
+
+            summary = std::make_shared<PosteriorSummary>(names, inst->config);
+            summary->add(*samples);
+        }
+
+        const auto & probabilities = summary->probabilities();
+        const auto columns = summary->columns();
+        const auto covariance = summary->covariance();
+        const auto correlation = summary->correlation();
+
+        std::cout << "# samples:               " << summary->number_of_samples() << std::endl;
+        std::cout << "# effective sample size: " << summary->effective_sample_size() << std::endl;
+        std::cout << "# quantiles:            ";
+        for (const auto & p : probabilities)
+        {
+            std::cout << ' ' << p;
+        }
+        std::cout << std::endl;
+
+        std::cout << std::scientific << std::setprecision(6);
+        for (const auto & c : columns)
+        {
+            std::cout << c.name << std::endl;
+            std::cout << "  mean +- std:  " << c.mean << " +- " << c.std_deviation << std::endl;
+            std::cout << "  skew, kurt:   " << c.skewness << ", " << c.kurtosis << std::endl;
+            std::cout << "  range:        [" << c.min << ", " << c.max << "]" << std::endl;
+            std::cout << "  quantiles:   ";
+            for (const auto & q : c.quantiles)
+            {
+                std::cout << ' ' << q;
+            }
+            std::cout << std::endl;
+        }
+
+        std::cout << "# correlation" << std::endl;
+        for (const auto & row : correlation)
+        {
+            for (const auto & c : row)
+            {
+                std::cout << std::setw(14) << c;
+            }
+            std::cout << std::endl;
+        }
+
+        if (inst->output.get())
+        {
+            YAML::Emitter out;
+            out.SetIndent(4);
+            out << YAML::Comment("file generated by eos-print-uncertainty");
+
+            out << YAML::BeginMap;
+            out << YAML::Key << "samples" << YAML::Value << summary->number_of_samples();
+            out << YAML::Key << "effective sample size" << YAML::Value << summary->effective_sample_size();
+            out << YAML::Key << "probabilities" << YAML::Value << YAML::Flow << probabilities;
+
+            out << YAML::Key << "columns" << YAML::Value;
+            out << YAML::BeginSeq;
+            for (const auto & c : columns)
+            {
+                out << YAML::BeginMap;
+                out << YAML::Key << "name"          << YAML::Value << c.name;
+                out << YAML::Key << "mean"          << YAML::Value << c.mean;
+                out << YAML::Key << "std deviation" << YAML::Value << c.std_deviation;
+                out << YAML::Key << "skewness"      << YAML::Value << c.skewness;
+                out << YAML::Key << "kurtosis"      << YAML::Value << c.kurtosis;
+                out << YAML::Key << "min"           << YAML::Value << c.min;
+                out << YAML::Key << "max"           << YAML::Value << c.max;
+                out << YAML::Key << "quantiles"     << YAML::Value << YAML::Flow << c.quantiles;
+                out << YAML::EndMap;
+            }
+            out << YAML::EndSeq;
+
+            out << YAML::Key << "covariance" << YAML::Value;
+            out << YAML::BeginSeq;
+            for (const auto & row : covariance)
+            {
+                out << YAML::Flow << row;
+            }
+            out << YAML::EndSeq;
+
+            out << YAML::Key << "correlation" << YAML::Value;
+            out << YAML::BeginSeq;
+            for (const auto & row : correlation)
+            {
+                out << YAML::Flow << row;
+            }
+            out << YAML::EndSeq;
+            out << YAML::EndMap;
+
+            *inst->output << out.c_str() << std::endl;
+            inst->output->close();
+        }
+    }
+    catch (DoUsage & e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << "Usage: eos-print-uncertainty" << std::endl;
+        std::cout << "  --mcmc-input FILE [--mcmc-directory DIRECTORY]" << std::endl;
+        std::cout << "  | --pmc-input FILE MIN MAX [--pmc-sample-directory DIRECTORY]" << std::endl;
+        std::cout << "  | --uncertainty-input FILE" << std::endl;
+        std::cout << "  [--output FILE]" << std::endl;
+        std::cout << "  [--exact-quantiles]" << std::endl;
+        std::cout << "  [--compression VALUE]" << std::endl;
+        std::cout << "  [--chunk-size NUMBER]" << std::endl;
+        std::cout << "  [--parallel [0|1]]" << std::endl;
+        std::cout << "  [--debug]" << std::endl;
+    }
+    catch (Exception & e)
+    {
+        std::cerr << "Caught exception: '" << e.what() << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (...)
+    {
+        std::cerr << "Aborting after unknown exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -22,6 +22,7 @@
 #include <eos/statistics/analysis.hh>
 #include <eos/statistics/log-prior.hh>
 #include <eos/statistics/prior-sampler.hh>
+#include <eos/statistics/sample-store.hh>
 #include <eos/utils/destringify.hh>
 #include <eos/utils/hdf5.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
@@ -29,10 +30,6 @@
 #include <eos/utils/stringify.hh>
 #include <eos/utils/verify.hh>
 
-#ifdef EOS_ENABLE_PMC
-#  include <eos/statistics/population-monte-carlo-sampler.hh>
-#endif
-
 #include <iomanip>
 #include <iostream>
 #include <limits>
@@ -118,6 +115,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--block-size" == argument)
+                {
+                    config.block_size = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
                 if ("--debug" == argument)
                 {
                     Log::instance()->set_log_level(ll_debug);
@@ -188,7 +192,6 @@ class CommandLine :
                     continue;
                 }
 
-#if EOS_ENABLE_PMC
                 if ("--pmc-sample-directory" == argument)
                 {
                         pmc_sample_directory = std::string(*(++a));
@@ -205,7 +208,6 @@ class CommandLine :
 
                     continue;
                 }
-#endif
 
                 if ("--seed" == argument)
                 {
@@ -351,15 +353,11 @@ int main(int argc, char * argv[])
 
         PriorSampler sampler(inst->unique_observables, inst->config);
 
-#if EOS_ENABLE_PMC
         // read in parameter samples from the file and calculate observables for them
         if ( ! inst->pmc_sample_file.empty() && inst->pmc_sample_min < inst->pmc_sample_max)
         {
-            auto f = hdf5::File::Open(inst->pmc_sample_file);
-            auto descriptions = Analysis::read_descriptions(f);
-            std::vector<std::vector<double>> samples;
-            samples.push_back(std::vector<double>(descriptions.size()));
-            PopulationMonteCarloSampler::read_samples(inst->pmc_sample_file, inst->pmc_sample_directory, inst->pmc_sample_min, inst->pmc_sample_max, samples);
+            auto samples = SampleStore::PopulationMonteCarlo(inst->pmc_sample_file, inst->pmc_sample_directory,
+                    SampleStore::Config::Default()).slice(inst->pmc_sample_min, inst->pmc_sample_max);
 
             if (! inst->priors.empty())
             {
@@ -373,11 +371,11 @@ int main(int argc, char * argv[])
                 std::cout << (**i).as_string() << std::endl;
             }
 
-            sampler.run(samples, descriptions);
+            sampler.run(samples);
 
             return EXIT_SUCCESS;
         }
-#endif
+
         // default: draw from priors
         {
             std::cout << "Varying the following parameters:" << std::endl;
@@ -398,15 +396,14 @@ int main(int argc, char * argv[])
         std::cout << "Usage: eos-propagate-uncertainty" << std::endl;
         std::cout << "  [ [--kinematics NAME VALUE]* --observable]+" << std::endl;
         std::cout << "  [--vary PARAMETER MIN MAX --prior [flat | [gaussian LOWER CENTRAL UPPER] ] ]+" << std::endl;
+        std::cout << "  [--block-size VALUE]" << std::endl;
         std::cout << "  [--chunks VALUE]" << std::endl;
         std::cout << "  [--chunk-size VALUE]" << std::endl;
         std::cout << "  [--fix PARAMETER VALUE]" << std::endl;
         std::cout << "  [--output FILENAME]" << std::endl;
         std::cout << "  [--parallel [0|1]]" << std::endl;
-#if EOS_ENABLE_PMC
         std::cout << "  [--pmc-sample-directory DIRECTORY]" << std::endl;
         std::cout << "  [--pmc-input FILENAME MIN_INDEX MAX_INDEX]" << std::endl;
-#endif
         std::cout << "  [--seed LONG_VALUE]" << std::endl;
         std::cout << "  [--store-parameters]" << std::endl;
         std::cout << std::endl;
@@ -415,13 +412,10 @@ int main(int argc, char * argv[])
         std::cout << "prior distributions and the observables are calculated and stored to disk." << std::endl;
         std::cout << "One thread is created for each chunk." << std::endl;
         std::cout << "Optionally, the drawn parameters are stored as well." << std::endl;
-#if EOS_ENABLE_PMC
         std::cout << std::endl;
         std::cout << "PMC options:" << std::endl;
         std::cout << "If an input file is specified, a slice of the samples is taken from there, and no new samples are drawn." << std::endl;
         std::cout << "Add a sample directory to extract samples from there within the hdf5 file. Else the default is to look for 'samples' in '/data'" << std::endl;
-#endif
-
     }
     catch (Exception & e)
     {
@@ -0,0 +1,259 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2018 Danny van Dyk
+ *
+ * This file is part of the EOS project. EOS is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * EOS is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <config.h>
+
+#include <eos/constraint.hh>
+#include <eos/statistics/importance-reweighting.hh>
+#include <eos/statistics/sample-store.hh>
+#include <eos/utils/destringify.hh>
+#include <eos/utils/hdf5.hh>
+#include <eos/utils/instantiation_policy-impl.hh>
+#include <eos/utils/log.hh>
+#include <eos/utils/stringify.hh>
+
+#include <iostream>
+
+using namespace eos;
+
+class DoUsage
+{
+    private:
+        std::string _what;
+
+    public:
+        DoUsage(const std::string & what) :
+            _what(what)
+        {
+        }
+
+        const std::string & what() const
+        {
+            return _what;
+        }
+};
+
+class CommandLine :
+    public InstantiationPolicy<CommandLine, Singleton>
+{
+    public:
+        ImportanceReweighting::Config config;
+
+        Parameters parameters;
+
+        Options global_options;
+
+        std::vector<std::string> constraint_names;
+
+        std::string mcmc_file;
+
+        std::string mcmc_directory;
+
+        std::string pmc_sample_file;
+        unsigned pmc_sample_min, pmc_sample_max;
+
+        std::string pmc_sample_directory;
+
+        CommandLine() :
+            config(ImportanceReweighting::Config::Default()),
+            parameters(Parameters::Defaults()),
+            mcmc_directory("/main run"),
+            pmc_sample_min(0),
+            pmc_sample_max(0),
+            pmc_sample_directory("/data")
+        {
+        }
+
+        void parse(int argc, char ** argv)
+        {
+            Log::instance()->set_log_level(ll_informational);
+            Log::instance()->set_program_name("eos-reweight");
+
+            for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
+            {
+                std::string argument(*a);
+
+                if ("--constraint" == argument)
+                {
+                    constraint_names.push_back(std::string(*(++a)));
+
+                    continue;
+                }
+
+                if ("--debug" == argument)
+                {
+                    Log::instance()->set_log_level(ll_debug);
+
+                    continue;
+                }
+
+                if ("--fix" == argument)
+                {
+                    std::string par_name = std::string(*(++a));
+                    double value = destringify<double>(*(++a));
+                    parameters[par_name] = value;
+
+                    continue;
+                }
+
+                if ("--global-option" == argument)
+                {
+                    std::string name(*(++a));
+                    std::string value(*(++a));
+
+                    global_options.set(name, value);
+
+                    continue;
+                }
+
+                if ("--mcmc-input" == argument)
+                {
+                    mcmc_file = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--mcmc-directory" == argument)
+                {
+                    mcmc_directory = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--output" == argument)
+                {
+                    std::string filename(*(++a));
+
+                    config.output_file.reset(new hdf5::File(hdf5::File::Create(filename)));
+
+                    continue;
+                }
+
+                if ("--parallel" == argument)
+                {
+                    config.parallelize = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--pmc-sample-directory" == argument)
+                {
+                    pmc_sample_directory = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--pmc-input" == argument)
+                {
+                    pmc_sample_file = std::string(*(++a));
+                    pmc_sample_min = destringify<unsigned>(*(++a));
+                    pmc_sample_max = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--workers" == argument)
+                {
+                    config.number_of_workers = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                throw DoUsage("Unknown command line argument: " + argument);
+            }
+        }
+};
+
+int main(int argc, char * argv[])
+{
+    try
+    {
+        auto inst = CommandLine::instance();
+
+        inst->parse(argc, argv);
+
+        if (inst->constraint_names.empty())
+            throw DoUsage("No constraints specified");
+
+        if (! inst->config.output_file)
+            throw DoUsage("No output file specified");
+
+        if (inst->mcmc_file.empty() && inst->pmc_sample_file.empty())
+            throw DoUsage("Either specify \n a) an MCMC input file\n b) a PMC input file");
+
+        std::shared_ptr<SampleStore> samples;
+        if (! inst->mcmc_file.empty())
+        {
+            // samples from Markov chains are equally weighted
+            samples.reset(new SampleStore(SampleStore::MarkovChains(inst->mcmc_file, inst->mcmc_directory,
+                    SampleStore::Config::Default())));
+        }
+        else if (inst->pmc_sample_min < inst->pmc_sample_max)
+        {
+            samples.reset(new SampleStore(SampleStore::PopulationMonteCarlo(inst->pmc_sample_file, inst->pmc_sample_directory,
+                    SampleStore::Config::Default()).slice(inst->pmc_sample_min, inst->pmc_sample_max)));
+        }
+        else
+        {
+            throw DoUsage("Empty range of PMC samples");
+        }
+
+        ImportanceReweighting reweighting(inst->parameters, samples->descriptions(), inst->config);
+
+        std::cout << "# Reweighting " << samples->size() << " samples with the following constraints:" << std::endl;
+        for (const auto & name : inst->constraint_names)
+        {
+            reweighting.add(Constraint::make(name, inst->global_options));
+
+            std::cout << "#   " << name << std::endl;
+        }
+
+        reweighting.run(*samples);
+
+        auto status = reweighting.status();
+        std::cout << "# relative effective sample size: " << status.eff_sample_size << std::endl;
+        std::cout << "# relative perplexity:            " << status.perplexity << std::endl;
+        std::cout << "# log(Z_new / Z_old):             " << status.log_evidence_ratio << std::endl;
+    }
+    catch (DoUsage & e)
+    {
+        std::cout << e.what() << std::endl;
+        std::cout << "Usage: eos-reweight" << std::endl;
+        std::cout << "  [--constraint NAME]+" << std::endl;
+        std::cout << "  --mcmc-input FILE [--mcmc-directory DIRECTORY]" << std::endl;
+        std::cout << "  | --pmc-input FILE MIN MAX [--pmc-sample-directory DIRECTORY]" << std::endl;
+        std::cout << "  --output FILE" << std::endl;
+        std::cout << "  [--fix PARAMETER VALUE]*" << std::endl;
+        std::cout << "  [--global-option NAME VALUE]*" << std::endl;
+        std::cout << "  [--parallel [0|1]]" << std::endl;
+        std::cout << "  [--workers NUMBER]" << std::endl;
+        std::cout << "  [--debug]" << std::endl;
+    }
+    catch (Exception & e)
+    {
+        std::cerr << "Caught exception: '" << e.what() << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+    catch (...)
+    {
+        std::cerr << "Aborting after unknown exception" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -21,10 +21,12 @@
 #include <eos/constraint.hh>
 #include <eos/observable.hh>
 #include <eos/statistics/analysis.hh>
+#include <eos/statistics/laplace-approximation.hh>
 #include <eos/statistics/markov-chain-sampler.hh>
 #include <eos/utils/destringify.hh>
 #include <eos/utils/instantiation_policy-impl.hh>
 #include <eos/utils/log.hh>
+#include <eos/utils/stringify.hh>
 
 #include <iostream>
 #include <limits>
@@ -97,13 +99,20 @@ class CommandLine :
         bool scale_nuisance;
         double scale_reduction;
 
+        // seed the proposal covariance with the Laplace approximation at the mode
+        bool laplace_proposal;
+
+        bool resume;
+
         CommandLine() :
             parameters(Parameters::Defaults()),
             likelihood(parameters),
             analysis(likelihood),
             mcmc_config(MarkovChainSampler::Config::Quick()),
             scale_nuisance(true),
-            scale_reduction(1)
+            scale_reduction(1),
+            laplace_proposal(false),
+            resume(false)
         {
             // todo these number should be in Config constructor
             mcmc_config.number_of_chains = 4;
@@ -241,6 +250,20 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--checkpoint" == argument)
+                {
+                    mcmc_config.checkpoint_file = std::string(*(++a));
+
+                    continue;
+                }
+
+                if ("--checkpoint-interval" == argument)
+                {
+                    mcmc_config.checkpoint_interval = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
                 if ("--chunk-size" == argument)
                 {
                     mcmc_config.chunk_size = destringify<unsigned>(*(++a));
@@ -423,6 +446,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--resume" == argument)
+                {
+                    resume = true;
+
+                    continue;
+                }
+
                 if ("--seed" == argument)
                 {
                     std::string value(*(++a));
@@ -453,6 +483,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--laplace-proposal" == argument)
+                {
+                    laplace_proposal = true;
+
+                    continue;
+                }
+
                 if ("--store-prerun" == argument)
                 {
                     mcmc_config.store_prerun = true;
@@ -460,6 +497,21 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--swap-interval" == argument)
+                {
+                    mcmc_config.swap_interval = destringify<unsigned>(*(++a));
+
+                    continue;
+                }
+
+                if ("--temperatures" == argument)
+                {
+                    mcmc_config.number_of_temperatures = destringify<unsigned>(*(++a));
+                    mcmc_config.max_temperature = destringify<double>(*(++a));
+
+                    continue;
+                }
+
                 throw DoUsage("Unknown command line argument: " + argument);
             }
         }
@@ -539,9 +591,33 @@ int main(int argc, char * argv[])
         /* create initial proposal covariance */
         inst->mcmc_config.proposal_initial_covariance = proposal_covariance(inst->analysis, inst->scale_reduction, inst->scale_nuisance);
 
+        if (inst->laplace_proposal)
+        {
+            // start the search for the mode at the prior means
+            std::vector<double> initial_guess;
+            for (auto & d : inst->analysis.parameter_descriptions())
+            {
+                initial_guess.push_back(inst->analysis.log_prior(d.parameter->name())->mean());
+            }
+
+            auto mode = inst->analysis.optimize(initial_guess, Analysis::OptimizationOptions::Defaults());
+
+            LaplaceApproximation laplace(inst->analysis.clone(), LaplaceApproximation::Config::Default());
+            inst->mcmc_config.proposal_initial_covariance = laplace.compute(mode.first).covariance;
+
+            std::cout << "# Proposal covariance from the Laplace approximation at " << stringify_container(mode.first, 4) << std::endl;
+        }
+
         MarkovChainSampler sampler(inst->analysis.clone(), inst->mcmc_config);
 
-        sampler.run();
+        if (inst->resume)
+        {
+            sampler.resume();
+        }
+        else
+        {
+            sampler.run();
+        }
     }
     catch (DoUsage & e)
     {
@@ -552,15 +628,19 @@ int main(int argc, char * argv[])
         std::cout << "  [--constraint NAME]+" << std::endl;
         std::cout << "  [ [ [--scan PARAMETER MIN MAX] | [--nuisance PARAMETER MIN MAX] ] --prior [flat | [gaussian LOWER CENTRAL UPPER] ] ]+" << std::endl;
         std::cout << "  [--chains VALUE]" << std::endl;
+        std::cout << "  [--checkpoint FILENAME [--checkpoint-interval VALUE] [--resume] ]" << std::endl;
         std::cout << "  [--chunks VALUE]" << std::endl;
         std::cout << "  [--chunksize VALUE]" << std::endl;
         std::cout << "  [--debug]" << std::endl;
         std::cout << "  [--fix PARAMETER VALUE]+" << std::endl;
+        std::cout << "  [--laplace-proposal]" << std::endl;
         std::cout << "  [--no-prerun]" << std::endl;
         std::cout << "  [--output FILENAME]" << std::endl;
         std::cout << "  [--scale VALUE]" << std::endl;
         std::cout << "  [--seed LONG_VALUE]" << std::endl;
         std::cout << "  [--store-prerun]" << std::endl;
+        std::cout << "  [--swap-interval VALUE]" << std::endl;
+        std::cout << "  [--temperatures NUMBER MAX_TEMPERATURE]" << std::endl;
 
         std::cout << std::endl;
         std::cout << "Example:" << std::endl;
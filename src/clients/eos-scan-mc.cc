@@ -37,6 +37,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <list>
 #include <vector>
 
 #include <Minuit2/FunctionMinimum.h>
@@ -131,6 +132,8 @@ class CommandLine :
 
         bool use_pmc;
 
+        bool use_polynomials;
+
         CommandLine() :
             parameters(Parameters::Defaults()),
             likelihood(parameters),
@@ -148,7 +151,8 @@ class CommandLine :
             pmc_update(false),
             optimize(false),
             goodness_of_fit(false),
-            use_pmc(false)
+            use_pmc(false),
+            use_polynomials(false)
         {
             mcmc_config.number_of_chains = 4;
             mcmc_config.need_prerun = true;
@@ -410,6 +414,13 @@ class CommandLine :
                     continue;
                 }
 
+                if ("--use-polynomials" == argument)
+                {
+                    use_polynomials = true;
+
+                    continue;
+                }
+
                 if ("--observable" == argument)
                 {
                     std::string observable_name(*(++a));
@@ -818,6 +829,23 @@ int main(int argc, char * argv[])
             }
         }
 
+        // predict observables by polynomials in the scan parameters, where possible
+        if (inst->use_polynomials)
+        {
+            std::list<std::string> coefficients;
+            for (auto d = inst->analysis.parameter_descriptions().cbegin(), d_end = inst->analysis.parameter_descriptions().cend() ;
+                 d != d_end ; ++d)
+            {
+                if (d->nuisance)
+                    continue;
+
+                coefficients.push_back(d->parameter->name());
+            }
+
+            unsigned n = inst->analysis.use_polynomials(coefficients);
+            std::cout << "# Polynomials: " << n << " out of " << inst->likelihood.observable_cache().size() << " observables" << std::endl;
+        }
+
         // run optimization. Use starting point if given, else sample a point from the prior.
         // Optionally calculate a p-value at the mode.
         if (inst->optimize)
@@ -922,6 +950,7 @@ int main(int argc, char * argv[])
         std::cout << "  [--scale VALUE]" << std::endl;
         std::cout << "  [--seed LONG_VALUE]" << std::endl;
         std::cout << "  [--store-prerun]" << std::endl;
+        std::cout << "  [--use-polynomials]" << std::endl;
 
 
         std::cout << std::endl;
@@ -21,17 +21,21 @@
 #include <eos/observable.hh>
 #include <eos/utils/cartesian-product.hh>
 #include <eos/utils/destringify.hh>
+#include <eos/utils/hdf5.hh>
 #include <eos/utils/lock.hh>
 #include <eos/utils/log.hh>
 #include <eos/utils/mutex.hh>
+#include <eos/utils/stringify.hh>
 #include <eos/utils/thread_pool.hh>
 
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
+#include <limits>
 #include <list>
 #include <map>
+#include <memory>
 #include <functional>
 #include <utility>
 #include <vector>
@@ -61,6 +65,40 @@ struct ScanData
     double max;
 };
 
+struct AdaptiveScanData
+{
+    // number of refinements of the initial grid; zero selects the uniform scan
+    unsigned levels;
+
+    // refine all cells with at least one corner within this distance in chi^2 of the minimum
+    double delta_chi_squared;
+
+    // refine all cells with a larger variation of chi^2 across their corners
+    double max_variation;
+
+    // name of the HDF5 output file; empty for output to stdout
+    std::string output_file;
+};
+
+// a grid point of the adaptive scan
+struct AdaptivePoint
+{
+    std::vector<double> wc_values;
+
+    // the refinement level at which this point was first evaluated
+    unsigned level;
+
+    double chi_squared;
+};
+
+// a cell of the adaptive scan, identified by its level and its lower corner in units of the finest grid spacing
+struct AdaptiveCell
+{
+    unsigned level;
+
+    std::vector<unsigned> corner;
+};
+
 class WilsonScan
 {
     public:
@@ -105,8 +143,7 @@ class WilsonScan
             }
         }
 
-        void calc_chi_square(const Input & input, const ObservablePtr & observable,
-                const CartesianProduct<std::vector<double>>::Iterator & wc_iterator)
+        double chi_square(const Input & input, const ObservablePtr & observable, const std::vector<double> & wc_values) const
         {
             Kinematics k = observable->kinematics();
             k.set("s_min", input.min);
@@ -116,7 +153,6 @@ class WilsonScan
             Parameters params = o->parameters();
 
             auto sd = scan_data.cbegin();
-            std::vector<double> wc_values = *wc_iterator;
             for (auto w = wc_values.cbegin() ; wc_values.cend() != w ; ++w, ++sd)
             {
                 params[sd->name] = *w;
@@ -166,7 +202,15 @@ class WilsonScan
                 chi = central - input.o - delta_min;
 
             chi /= (input.o_max - input.o_min);
-            double chi_squared = chi * chi;
+
+            return chi * chi;
+        }
+
+        void calc_chi_square(const Input & input, const ObservablePtr & observable,
+                const CartesianProduct<std::vector<double>>::Iterator & wc_iterator)
+        {
+            std::vector<double> wc_values = *wc_iterator;
+            double chi_squared = chi_square(input, observable, wc_values);
 
             {
                 Lock l(*mutex);
@@ -174,6 +218,18 @@ class WilsonScan
             }
         }
 
+        // sum of chi^2 over all inputs
+        void calc_total_chi_square(AdaptivePoint * point) const
+        {
+            double result = 0.0;
+            for (auto bin = bins.cbegin() ; bins.cend() != bin ; ++bin)
+            {
+                result += chi_square(bin->first, bin->second, point->wc_values);
+            }
+
+            point->chi_squared = result;
+        }
+
         void scan()
         {
             std::cout << "# Generated by eos-scan (" EOS_GITHEAD ")" << std::endl;
@@ -231,6 +287,204 @@ class WilsonScan
                 std::cout << r->second << std::endl;
             }
         }
+
+        /*
+         * Scan adaptively: Start with the grid of cells as given by the scan data, and
+         * successively bisect those cells along all dimensions that lie within delta_chi_squared
+         * of the minimal chi^2, or across which chi^2 varies by more than max_variation.
+         * Only the corners of the resulting cells are evaluated.
+         */
+        void adaptive_scan(const AdaptiveScanData & adaptive)
+        {
+            const unsigned dim = scan_data.size();
+            const unsigned corners = 1u << dim;
+
+            // spacing of the coarsest grid in units of the spacing of the finest grid
+            const unsigned scale = 1u << adaptive.levels;
+
+            std::vector<double> min, delta;
+            std::vector<std::vector<unsigned>> coarse_indices;
+            for (auto sd = scan_data.cbegin() ; scan_data.cend() != sd ; ++sd)
+            {
+                min.push_back(sd->min);
+                delta.push_back((sd->max - sd->min) / sd->points / scale);
+
+                std::vector<unsigned> indices;
+                for (unsigned i = 0 ; i < sd->points ; ++i)
+                {
+                    indices.push_back(i * scale);
+                }
+                coarse_indices.push_back(indices);
+            }
+
+            std::vector<AdaptiveCell> cells;
+            {
+                CartesianProduct<std::vector<unsigned>> cp;
+                for (auto i = coarse_indices.cbegin() ; coarse_indices.cend() != i ; ++i)
+                {
+                    cp.over(*i);
+                }
+
+                for (auto c = cp.begin() ; cp.end() != c ; ++c)
+                {
+                    cells.push_back(AdaptiveCell{ 0, *c });
+                }
+            }
+
+            std::vector<AdaptivePoint> points;
+            std::map<std::vector<unsigned>, unsigned> point_indices;
+            std::vector<AdaptiveCell> leaves;
+            double chi_squared_min = std::numeric_limits<double>::infinity();
+
+            // the corners of a cell of the given width
+            auto corner = [&] (const AdaptiveCell & cell, const unsigned & c, const unsigned & width)
+            {
+                std::vector<unsigned> result(cell.corner);
+                for (unsigned d = 0 ; d < dim ; ++d)
+                {
+                    if (c & (1u << d))
+                        result[d] += width;
+                }
+
+                return result;
+            };
+
+            for (unsigned level = 0 ; level <= adaptive.levels ; ++level)
+            {
+                const unsigned width = scale >> level;
+
+                // determine the grid points that have not been evaluated yet
+                std::vector<unsigned> pending;
+                for (auto cell = cells.cbegin() ; cells.cend() != cell ; ++cell)
+                {
+                    for (unsigned c = 0 ; c < corners ; ++c)
+                    {
+                        auto index = corner(*cell, c, width);
+                        if (point_indices.end() != point_indices.find(index))
+                            continue;
+
+                        std::vector<double> wc_values(dim);
+                        for (unsigned d = 0 ; d < dim ; ++d)
+                        {
+                            wc_values[d] = min[d] + delta[d] * index[d];
+                        }
+
+                        point_indices[index] = points.size();
+                        pending.push_back(points.size());
+                        points.push_back(AdaptivePoint{ wc_values, level, 0.0 });
+                    }
+                }
+
+                // points does not grow while the tickets are pending
+                TicketList tickets;
+                for (auto p = pending.cbegin() ; pending.cend() != p ; ++p)
+                {
+                    ThreadPool::instance()->wait_for_free_capacity();
+                    tickets.push_back(ThreadPool::instance()->enqueue(std::bind(&WilsonScan::calc_total_chi_square, this, &points[*p])));
+                }
+                tickets.wait();
+
+                for (auto p = pending.cbegin() ; pending.cend() != p ; ++p)
+                {
+                    chi_squared_min = std::min(chi_squared_min, points[*p].chi_squared);
+                }
+
+                // select the cells for refinement
+                std::vector<AdaptiveCell> refined;
+                for (auto cell = cells.cbegin() ; cells.cend() != cell ; ++cell)
+                {
+                    double lo = std::numeric_limits<double>::infinity(), hi = -std::numeric_limits<double>::infinity();
+                    for (unsigned c = 0 ; c < corners ; ++c)
+                    {
+                        const double value = points[point_indices[corner(*cell, c, width)]].chi_squared;
+                        lo = std::min(lo, value);
+                        hi = std::max(hi, value);
+                    }
+
+                    if ((level == adaptive.levels) || ((lo > chi_squared_min + adaptive.delta_chi_squared) && (hi - lo <= adaptive.max_variation)))
+                    {
+                        leaves.push_back(*cell);
+                        continue;
+                    }
+
+                    for (unsigned c = 0 ; c < corners ; ++c)
+                    {
+                        refined.push_back(AdaptiveCell{ level + 1, corner(*cell, c, width / 2) });
+                    }
+                }
+
+                Log::instance()->message("eos-scan.adaptive_scan", ll_informational)
+                    << "Level " << level << ": evaluated " << pending.size() << " new points, "
+                    << refined.size() << " cells selected for refinement, chi^2_min = " << chi_squared_min;
+
+                cells.swap(refined);
+            }
+
+            if (adaptive.output_file.empty())
+            {
+                std::cout << "# Generated by eos-scan (" EOS_GITHEAD ")" << std::endl;
+                std::cout << "# Adaptive scan with " << adaptive.levels << " levels of refinement" << std::endl;
+                std::cout << std::scientific << std::setprecision(7);
+                for (auto p = points.cbegin() ; points.cend() != p ; ++p)
+                {
+                    for (auto w = p->wc_values.cbegin(), w_end = p->wc_values.cend() ; w != w_end ; ++w)
+                    {
+                        std::cout << *w << '\t';
+                    }
+
+                    std::cout << p->level << '\t' << p->chi_squared << std::endl;
+                }
+
+                return;
+            }
+
+            hdf5::File file = hdf5::File::Create(adaptive.output_file);
+
+            // one record per point: coordinates, level, chi^2
+            const hdf5::Array<1, double> point_type
+            {
+                "point",
+                { dim + 2 },
+            };
+            auto data_set_points = file.create_data_set("/scan/points", point_type);
+            std::vector<double> point_record(dim + 2);
+            for (auto p = points.cbegin() ; points.cend() != p ; ++p)
+            {
+                std::copy(p->wc_values.cbegin(), p->wc_values.cend(), point_record.begin());
+                point_record[dim + 0] = p->level;
+                point_record[dim + 1] = p->chi_squared;
+                data_set_points << point_record;
+            }
+
+            // one record per final cell: level, lower corner, upper corner
+            const hdf5::Array<1, double> cell_type
+            {
+                "cell",
+                { 2 * dim + 1 },
+            };
+            auto data_set_cells = file.create_data_set("/scan/cells", cell_type);
+            std::vector<double> cell_record(2 * dim + 1);
+            for (auto c = leaves.cbegin() ; leaves.cend() != c ; ++c)
+            {
+                const unsigned width = scale >> c->level;
+
+                cell_record[0] = c->level;
+                for (unsigned d = 0 ; d < dim ; ++d)
+                {
+                    cell_record[1 + d]       = min[d] + delta[d] * c->corner[d];
+                    cell_record[1 + dim + d] = min[d] + delta[d] * (c->corner[d] + width);
+                }
+                data_set_cells << cell_record;
+            }
+
+            // record the names of the scan parameters
+            unsigned counter = 0;
+            for (auto sd = scan_data.cbegin() ; scan_data.cend() != sd ; ++sd, ++counter)
+            {
+                auto attr = data_set_points.create_or_open_attribute("parameter #" + stringify(counter), hdf5::Scalar<const char *>("name"));
+                attr = sd->name.c_str();
+            }
+        }
 };
 
 class DoUsage
@@ -260,6 +514,7 @@ main(int argc, char * argv[])
         std::list<std::string> variation_names;
         std::list<std::pair<std::string, double>> param_changes;
         double theory_uncertainty = 0.0;
+        AdaptiveScanData adaptive{ 0, 4.0, std::numeric_limits<double>::infinity(), "" };
 
         Log::instance()->set_program_name("eos-scan");
 
@@ -313,6 +568,28 @@ main(int argc, char * argv[])
                 continue;
             }
 
+            if ("--adaptive" == argument)
+            {
+                adaptive.levels = destringify<unsigned>(*(++a));
+                adaptive.delta_chi_squared = destringify<double>(*(++a));
+
+                continue;
+            }
+
+            if ("--max-variation" == argument)
+            {
+                adaptive.max_variation = destringify<double>(*(++a));
+
+                continue;
+            }
+
+            if ("--output" == argument)
+            {
+                adaptive.output_file = std::string(*(++a));
+
+                continue;
+            }
+
             throw DoUsage("Unknown command line argument: " + argument);
         }
 
@@ -322,8 +599,30 @@ main(int argc, char * argv[])
         if (input.empty())
             throw DoUsage("Need at least one input");
 
+        if ((0 == adaptive.levels) && ! adaptive.output_file.empty())
+            throw DoUsage("HDF5 output is only supported for adaptive scans");
+
+        // the adaptive scan addresses grid points in units of the finest grid spacing
+        if (adaptive.levels >= std::numeric_limits<unsigned>::digits)
+            throw DoUsage("LEVELS must be smaller than " + stringify(std::numeric_limits<unsigned>::digits));
+
+        if (0 != adaptive.levels)
+        {
+            if (scan_data.size() >= std::numeric_limits<unsigned>::digits)
+                throw DoUsage("Adaptive scans support at most " + stringify(std::numeric_limits<unsigned>::digits - 1) + " scan parameters");
+
+            for (auto sd = scan_data.cbegin() ; scan_data.cend() != sd ; ++sd)
+            {
+                if (sd->points > (std::numeric_limits<unsigned>::max() >> adaptive.levels))
+                    throw DoUsage("POINTS of scan parameter '" + sd->name + "' is too large for " + stringify(adaptive.levels) + " levels of refinement");
+            }
+        }
+
         WilsonScan scanner(scan_data, input, param_changes, variation_names, theory_uncertainty);
-        scanner.scan();
+        if (0 == adaptive.levels)
+            scanner.scan();
+        else
+            scanner.adaptive_scan(adaptive);
     }
     catch(DoUsage & e)
     {
@@ -334,6 +633,7 @@ main(int argc, char * argv[])
         std::cout << "  [--input NAME SMIN SMAX MIN CENTRAL MAX]+" << std::endl;
         std::cout << "  [--scan PARAMETER POINTS MIN MAX]+" << std::endl;
         std::cout << "  [--theory-uncertainty PERCENT]" << std::endl;
+        std::cout << "  [--adaptive LEVELS DELTACHISQUARED [--max-variation CHISQUARED] [--output HDF5FILE]]" << std::endl;
     }
     catch(Exception & e)
     {
@@ -20,6 +20,7 @@
 
 #include <eos/observable.hh>
 #include <eos/utils/destringify.hh>
+#include <eos/utils/uncertainty-budget.hh>
 
 #include <cmath>
 #include <cstdlib>
@@ -53,6 +54,7 @@ main(int argc, char * argv[])
         double s_min(0.0), s_max(0.0);
         std::list<std::tuple<std::string, std::list<Parameter>>> budgets;
         std::list<ObservablePtr> observables;
+        UncertaintyBudget::Config config = UncertaintyBudget::Config::Default();
 
         for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
         {
@@ -73,6 +75,12 @@ main(int argc, char * argv[])
                 continue;
             }
 
+            if ("--parallel" == argument)
+            {
+                config.parallelize = destringify<unsigned>(*(++a));
+                continue;
+            }
+
             if ("--budget" == argument)
             {
                 std::string name(*(++a));
@@ -107,43 +115,54 @@ main(int argc, char * argv[])
         kinematics.set("s_min", s_min);
         kinematics.set("s_max", s_max);
 
+        // evaluate all observables and variations in one go, so that they can be distributed among the threads
+        std::vector<Parameter> variations;
+        for (auto b(budgets.begin()), b_end(budgets.end()) ; b != b_end ; ++b)
+        {
+            variations.insert(variations.end(), std::get<1>(*b).begin(), std::get<1>(*b).end());
+        }
+
+        UncertaintyBudget budget(parameters, variations, config);
         for (auto o(observables.begin()), o_end(observables.end()) ; o != o_end ; ++o)
         {
-            double central = (*o)->evaluate();
+            budget.add(*o, { std::make_pair(std::string("s_min"), s_min), std::make_pair(std::string("s_max"), s_max) });
+        }
+
+        const std::vector<UncertaintyBudget::Result> results = budget.evaluate();
+        auto result = results.cbegin();
+
+        for (auto o(observables.begin()), o_end(observables.end()) ; o != o_end ; ++o, ++result)
+        {
+            double central = result->central;
             double delta_min = 0.0, delta_max = 0.0;
 
             std::list<std::tuple<std::string, double, double>> uncertainties;
 
+            unsigned v = 0;
             for (auto b(budgets.begin()), b_end(budgets.end()) ; b != b_end ; ++b)
             {
                 std::string name = std::get<0>(*b);
-                std::list<Parameter> variations = std::get<1>(*b);
 
                 double budget_max = 0.0, budget_min = 0.0;
 
-                for (auto p(variations.begin()), p_end(variations.end()) ; p != p_end ; ++p)
+                for (unsigned k = 0 ; k < std::get<1>(*b).size() ; ++k, ++v)
                 {
-                    double old_p = *p;
                     double max = 0.0, min = 0.0, value;
 
-                    *p = p->min();
-                    value = (*o)->evaluate();
+                    value = result->at_min[v];
                     if (value > central)
                         max = value - central;
 
                     if (value < central)
                         min = central - value;
 
-                    *p = p->max();
-                    value = (*o)->evaluate();
+                    value = result->at_max[v];
                     if (value > central)
                         max = std::max(max, value - central);
 
                     if (value < central)
                         min = std::max(min, central - value);
 
-                    *p = old_p;
-
                     delta_min += min * min;
                     delta_max += max * max;
 
@@ -183,7 +202,7 @@ main(int argc, char * argv[])
     catch (DoUsage & e)
     {
         std::cerr << e.what << std::endl;
-        std::cerr << "Usage: observables --range SMIN SMAX [--parameter NAME VALUE]* [--vary NAME]* [--observable NAME]+" << std::endl;
+        std::cerr << "Usage: observables --range SMIN SMAX [--parallel 0|1] [--parameter NAME VALUE]* [--vary NAME]* [--observable NAME]+" << std::endl;
         return EXIT_FAILURE;
     }
     catch (Exception & e)
@@ -19,6 +19,7 @@
 
 #include <eos/observable.hh>
 #include <eos/utils/destringify.hh>
+#include <eos/utils/uncertainty-budget.hh>
 
 #include <cmath>
 #include <cstdlib>
@@ -49,6 +50,7 @@ main(int argc, char * argv[])
         unsigned points = 50;
         std::list<std::tuple<std::string, std::list<Parameter>>> budgets;
         std::list<ObservablePtr> observables;
+        UncertaintyBudget::Config config = UncertaintyBudget::Config::Default();
 
         for (char ** a(argv + 1), ** a_end(argv + argc) ; a != a_end ; ++a)
         {
@@ -77,6 +79,12 @@ main(int argc, char * argv[])
                 continue;
             }
 
+            if ("--parallel" == argument)
+            {
+                config.parallelize = destringify<unsigned>(*(++a));
+                continue;
+            }
+
             if ("--budget" == argument)
             {
                 std::string name(*(++a));
@@ -116,52 +124,65 @@ main(int argc, char * argv[])
             std::cout << "# " << (*o)->name() << std::endl;
         }
 
+        // evaluate all points and variations in one go, so that they can be distributed among the threads
+        std::vector<Parameter> variations;
+        for (auto b(budgets.begin()), b_end(budgets.end()) ; b != b_end ; ++b)
+        {
+            variations.insert(variations.end(), std::get<1>(*b).begin(), std::get<1>(*b).end());
+        }
+
+        UncertaintyBudget budget(parameters, variations, config);
+        for (auto o(observables.begin()), o_end(observables.end()) ; o != o_end ; ++o)
+        {
+            for (unsigned j = 0 ; j <= points ; ++j)
+            {
+                double s = s_low + j * (s_high - s_low) / points;
+
+                budget.add(*o, { std::make_pair(std::string("s"), s) });
+            }
+        }
+
+        const std::vector<UncertaintyBudget::Result> results = budget.evaluate();
+        auto result = results.cbegin();
+
         std::cout << "## Data ##" << std::endl;
         for (auto o(observables.begin()), o_end(observables.end()) ; o != o_end ; ++o)
         {
             std::cout << "# " << (*o)->name() << std::endl;
-            for (unsigned j = 0 ; j <= points ; ++j)
+            for (unsigned j = 0 ; j <= points ; ++j, ++result)
             {
                 double s = s_low + j * (s_high - s_low) / points;
 
                 std::cout << s << std::flush;
-                kinematics.set("s", s);
 
-                double central = (*o)->evaluate();
+                double central = result->central;
                 double delta_min = 0.0, delta_max = 0.0;
 
                 std::cout << '\t' << central << std::flush;
 
+                unsigned v = 0;
                 for (auto b(budgets.begin()), b_end(budgets.end()) ; b != b_end ; ++b)
                 {
-                    std::string name = std::get<0>(*b);
-                    std::list<Parameter> variations = std::get<1>(*b);
-
                     double budget_max = 0.0, budget_min = 0.0;
 
-                    for (auto p(variations.begin()), p_end(variations.end()) ; p != p_end ; ++p)
+                    for (unsigned k = 0 ; k < std::get<1>(*b).size() ; ++k, ++v)
                     {
-                        double old_p = *p;
                         double max = 0.0, min = 0.0, value;
 
-                        *p = p->min();
-                        value = (*o)->evaluate();
+                        value = result->at_min[v];
                         if (value > central)
                             max = value - central;
 
                         if (value < central)
                             min = central - value;
 
-                        *p = p->max();
-                        value = (*o)->evaluate();
+                        value = result->at_max[v];
                         if (value > central)
                             max = std::max(max, value - central);
 
                         if (value < central)
                             min = std::max(min, central - value);
 
-                        *p = old_p;
-
                         delta_min += min * min;
                         delta_max += max * max;
 
@@ -184,7 +205,7 @@ main(int argc, char * argv[])
     catch (DoUsage & e)
     {
         std::cerr << e.what << std::endl;
-        std::cerr << "Usage: observables --range SMIN SMAX [--points N] [--parameter NAME VALUE]* [--vary NAME]* [--observable NAME]+" << std::endl;
+        std::cerr << "Usage: observables --range SMIN SMAX [--points N] [--parallel 0|1] [--parameter NAME VALUE]* [--vary NAME]* [--observable NAME]+" << std::endl;
         return EXIT_FAILURE;
     }
     catch (Exception & e)